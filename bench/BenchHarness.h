@@ -0,0 +1,236 @@
+#pragma once
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @file BenchHarness.h
+ * @brief Harness mínimo de benchmarks con la interfaz de Google Benchmark
+ *
+ * Cada benchmark es una función void(Bench::State&) que repite el trabajo
+ * mientras state.KeepRunning(); solo se mide el bucle, no la preparación.
+ * Las iteraciones se escalan hasta superar el tiempo mínimo y el resultado
+ * se imprime como tiempo por iteración y elementos por segundo.
+ *
+ *   static void BM_Algo(Bench::State& state) {
+ *       Preparar(state.range(0));
+ *       while (state.KeepRunning()) Trabajo();
+ *       state.SetItemsProcessed(state.iterations() * state.range(0));
+ *   }
+ *   BENCHMARK(BM_Algo)->Arg(64)->Arg(1024);
+ *   BENCHMARK_MAIN();
+ *
+ * Argumentos: --benchmark_filter=<subcadena> --benchmark_min_time=<segundos>
+ */
+namespace Bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Evitar que el compilador elimine un resultado no usado
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char*>(&value);
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    class State
+    {
+    public:
+        State(int64_t iterations, const std::vector<int64_t>& args)
+            : m_Iterations(iterations), m_Remaining(iterations), m_Args(args),
+              m_Items(0), m_Bytes(0), m_Started(false) {}
+
+        bool KeepRunning()
+        {
+            if (!m_Started)
+            {
+                m_Started = true;
+                m_Start = Clock::now();
+            }
+            if (m_Remaining-- > 0)
+                return true;
+            m_End = Clock::now();
+            return false;
+        }
+
+        int64_t range(size_t index = 0) const { return index < m_Args.size() ? m_Args[index] : 0; }
+        int64_t iterations() const { return m_Iterations; }
+
+        void SetItemsProcessed(int64_t items) { m_Items = items; }
+        void SetBytesProcessed(int64_t bytes) { m_Bytes = bytes; }
+        void SetLabel(const std::string& label) { m_Label = label; }
+        void SkipWithError(const std::string& error) { m_Error = error; m_Remaining = 0; }
+
+        double Seconds() const { return std::chrono::duration<double>(m_End - m_Start).count(); }
+        int64_t Items() const { return m_Items; }
+        int64_t Bytes() const { return m_Bytes; }
+        const std::string& Label() const { return m_Label; }
+        const std::string& Error() const { return m_Error; }
+
+    private:
+        int64_t m_Iterations;
+        int64_t m_Remaining;
+        std::vector<int64_t> m_Args;
+        int64_t m_Items;
+        int64_t m_Bytes;
+        bool m_Started;
+        Clock::time_point m_Start;
+        Clock::time_point m_End;
+        std::string m_Label;
+        std::string m_Error;
+    };
+
+    class Benchmark
+    {
+    public:
+        Benchmark(const char* name, void (*function)(State&)) : m_Name(name), m_Function(function) {}
+
+        Benchmark* Arg(int64_t value) { m_Args.push_back({ value }); return this; }
+        Benchmark* Args(const std::vector<int64_t>& values) { m_Args.push_back(values); return this; }
+
+        const std::string& Name() const { return m_Name; }
+        void (*Function() const)(State&) { return m_Function; }
+        const std::vector<std::vector<int64_t>>& ArgSets() const { return m_Args; }
+
+    private:
+        std::string m_Name;
+        void (*m_Function)(State&);
+        std::vector<std::vector<int64_t>> m_Args;
+    };
+
+    inline std::vector<Benchmark*>& Registry()
+    {
+        static std::vector<Benchmark*> benchmarks;
+        return benchmarks;
+    }
+
+    inline Benchmark* Register(const char* name, void (*function)(State&))
+    {
+        Registry().push_back(new Benchmark(name, function));
+        return Registry().back();
+    }
+
+    inline std::string FormatRate(double value, const char* unit)
+    {
+        const char* prefixes[] = { "", "k", "M", "G", "T" };
+        int prefix = 0;
+        while (value >= 1000.0 && prefix < 4)
+        {
+            value /= 1000.0;
+            prefix++;
+        }
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.2f %s%s/s", value, prefixes[prefix], unit);
+        return buffer;
+    }
+
+    inline void RunOne(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTime)
+    {
+        std::string name = benchmark.Name();
+        for (int64_t arg : args)
+            name += "/" + std::to_string(arg);
+
+        // Escalar iteraciones hasta superar el tiempo mínimo
+        int64_t iterations = 1;
+        for (;;)
+        {
+            State state(iterations, args);
+            benchmark.Function()(state);
+
+            if (!state.Error().empty())
+            {
+                printf("%-48s ERROR: %s\n", name.c_str(), state.Error().c_str());
+                return;
+            }
+
+            double seconds = state.Seconds();
+            if (seconds >= minTime || iterations >= (int64_t(1) << 40))
+            {
+                double nsPerIteration = seconds * 1e9 / (double)iterations;
+                std::string counters;
+                if (state.Items() > 0)
+                    counters += "  " + FormatRate((double)state.Items() / seconds, "items");
+                if (state.Bytes() > 0)
+                    counters += "  " + FormatRate((double)state.Bytes() / seconds, "B");
+                if (!state.Label().empty())
+                    counters += "  " + state.Label();
+
+                printf("%-48s %14.0f ns %12lld%s\n", name.c_str(), nsPerIteration,
+                       (long long)iterations, counters.c_str());
+                fflush(stdout);
+                return;
+            }
+
+            // Siguiente intento con margen del 40% sobre la estimación
+            double estimate = (seconds > 1e-9) ? minTime / seconds * 1.4 : 10.0;
+            estimate = (estimate < 10.0) ? estimate : 10.0;
+            int64_t next = (int64_t)((double)iterations * estimate);
+            iterations = (next > iterations) ? next : iterations + 1;
+        }
+    }
+
+    inline int RunAll(int argc, char** argv)
+    {
+        std::string filter;
+        double minTime = 0.5;
+
+        for (int i = 1; i < argc; i++)
+        {
+            if (strncmp(argv[i], "--benchmark_filter=", 19) == 0)
+                filter = argv[i] + 19;
+            else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0)
+                minTime = atof(argv[i] + 21);
+            else
+            {
+                fprintf(stderr, "Argumento desconocido: %s\n", argv[i]);
+                fprintf(stderr, "Uso: %s [--benchmark_filter=<texto>] [--benchmark_min_time=<segundos>]\n", argv[0]);
+                return 1;
+            }
+        }
+
+        printf("%-48s %17s %12s\n", "Benchmark", "Time", "Iterations");
+        printf("%s\n", std::string(80, '-').c_str());
+
+        for (const Benchmark* benchmark : Registry())
+        {
+            if (!filter.empty() && benchmark->Name().find(filter) == std::string::npos)
+                continue;
+
+            if (benchmark->ArgSets().empty())
+                RunOne(*benchmark, std::vector<int64_t>(), minTime);
+            for (const std::vector<int64_t>& args : benchmark->ArgSets())
+                RunOne(*benchmark, args, minTime);
+        }
+        return 0;
+    }
+}
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+#define BENCHMARK(function) \
+    static Bench::Benchmark* BENCH_CONCAT(s_Benchmark_, __LINE__) = Bench::Register(#function, function)
+
+#define BENCHMARK_MAIN() \
+    int main(int argc, char** argv) { return Bench::RunAll(argc, argv); }
+
+#endif // BENCH_HARNESS_H
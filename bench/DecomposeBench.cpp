@@ -0,0 +1,107 @@
+// ============================================================================
+// Benchmark: descomposición de matrices (DecomposeMatrices SSE vs escalar)
+// ============================================================================
+// Compara el kernel por lotes de MatrixConverter::DecomposeMatrices con la
+// ruta escalar anterior (longitud de filas + D3DXQuaternionRotationMatrix)
+// y con D3DXMatrixDecompose, sobre matrices TRS aleatorias (una de cada
+// ocho con espejo). Los elementos procesados son matrices.
+// ============================================================================
+
+#include "BenchHarness.h"
+#include "../src/MatrixConverter.h"
+
+#include <random>
+
+namespace
+{
+    vector<D3DXMATRIX> MakeMatrices(size_t count)
+    {
+        mt19937 random(1234);
+        uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        uniform_real_distribution<float> scale(0.25f, 4.0f);
+
+        vector<D3DXMATRIX> matrices(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            D3DXQUATERNION q(unit(random), unit(random), unit(random), unit(random));
+            D3DXQuaternionNormalize(&q, &q);
+
+            D3DXVECTOR3 s(scale(random), scale(random), scale(random));
+            if (i % 8 == 7)
+                s.x = -s.x;
+
+            D3DXVECTOR3 t(unit(random) * 100.0f, unit(random) * 100.0f, unit(random) * 100.0f);
+            D3DXMatrixTransformation(&matrices[i], nullptr, nullptr, &s, nullptr, &q, &t);
+        }
+        return matrices;
+    }
+
+    // Ruta escalar anterior de MatrixConverter::DecomposeMatrix
+    void DecomposeScalar(const D3DXMATRIX& matrix, D3DXVECTOR3& translation,
+                         D3DXQUATERNION& rotation, D3DXVECTOR3& scale)
+    {
+        translation = D3DXVECTOR3(matrix._41, matrix._42, matrix._43);
+
+        D3DXVECTOR3 rowX(matrix._11, matrix._12, matrix._13);
+        D3DXVECTOR3 rowY(matrix._21, matrix._22, matrix._23);
+        D3DXVECTOR3 rowZ(matrix._31, matrix._32, matrix._33);
+        scale = D3DXVECTOR3(D3DXVec3Length(&rowX), D3DXVec3Length(&rowY), D3DXVec3Length(&rowZ));
+
+        D3DXMATRIX rotationMatrix = matrix;
+        rotationMatrix._41 = rotationMatrix._42 = rotationMatrix._43 = 0.0f;
+        if (scale.x != 0.0f) { rotationMatrix._11 /= scale.x; rotationMatrix._12 /= scale.x; rotationMatrix._13 /= scale.x; }
+        if (scale.y != 0.0f) { rotationMatrix._21 /= scale.y; rotationMatrix._22 /= scale.y; rotationMatrix._23 /= scale.y; }
+        if (scale.z != 0.0f) { rotationMatrix._31 /= scale.z; rotationMatrix._32 /= scale.z; rotationMatrix._33 /= scale.z; }
+
+        D3DXQuaternionRotationMatrix(&rotation, &rotationMatrix);
+        D3DXQuaternionNormalize(&rotation, &rotation);
+    }
+}
+
+static void BM_DecomposeMatrices_SSE(Bench::State& state)
+{
+    vector<D3DXMATRIX> matrices = MakeMatrices((size_t)state.range(0));
+    DecomposedTransforms result;
+
+    while (state.KeepRunning())
+    {
+        MatrixConverter::DecomposeMatrices(matrices.data(), matrices.size(), result);
+        Bench::DoNotOptimize(result.rotations.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecomposeMatrices_SSE)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_DecomposeMatrix_Scalar(Bench::State& state)
+{
+    vector<D3DXMATRIX> matrices = MakeMatrices((size_t)state.range(0));
+    DecomposedTransforms result;
+    result.Resize(matrices.size());
+
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < matrices.size(); i++)
+            DecomposeScalar(matrices[i], result.translations[i], result.rotations[i], result.scales[i]);
+        Bench::DoNotOptimize(result.rotations.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecomposeMatrix_Scalar)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_D3DXMatrixDecompose(Bench::State& state)
+{
+    vector<D3DXMATRIX> matrices = MakeMatrices((size_t)state.range(0));
+    DecomposedTransforms result;
+    result.Resize(matrices.size());
+
+    while (state.KeepRunning())
+    {
+        for (size_t i = 0; i < matrices.size(); i++)
+            D3DXMatrixDecompose(&result.scales[i], &result.rotations[i], &result.translations[i], &matrices[i]);
+        Bench::DoNotOptimize(result.rotations.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_D3DXMatrixDecompose)->Arg(64)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
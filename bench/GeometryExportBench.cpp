@@ -0,0 +1,95 @@
+// ============================================================================
+// Benchmark: exportación de geometría al FbxMesh (FBXExporter::ExportGeometry)
+// ============================================================================
+// Rejilla de triángulos sintética (el mismo layout que genera D3DX: lista
+// de triángulos indexada). Cada iteración crea un FbxMesh en la escena del
+// exportador, llama ExportGeometry (control points LH -> RH y polígonos con
+// BeginPolygon/AddPolygon/EndPolygon tras reservar) y destruye el mesh.
+// Los elementos procesados son triángulos.
+//
+// Argumento: número aproximado de triángulos.
+// ============================================================================
+
+#include "BenchHarness.h"
+#include "../src/FBXExporter.h"
+
+#include <cmath>
+
+// Acceso a los miembros privados del exportador (friend de FBXExporter)
+struct GeometryExportBenchAccess
+{
+    static bool Initialize(FBXExporter& exporter, const ConversionOptions& options)
+    {
+        exporter.m_Options = options;
+        return exporter.Initialize();
+    }
+
+    static FbxScene* GetScene(FBXExporter& exporter) { return exporter.m_pScene; }
+
+    static void ExportGeometry(FBXExporter& exporter, MeshData* meshData, FbxMesh* fbxMesh)
+    {
+        exporter.ExportGeometry(meshData, fbxMesh);
+    }
+};
+
+namespace
+{
+    // Rejilla cuadrada con al menos 'triangleCount' triángulos
+    void MakeGrid(size_t triangleCount, MeshData& mesh)
+    {
+        size_t quads = (triangleCount + 1) / 2;
+        size_t side = (size_t)ceil(sqrt((double)quads)) + 1;
+
+        mesh.name = "Grid";
+        mesh.vertices.resize(side * side);
+        for (size_t y = 0; y < side; y++)
+        {
+            for (size_t x = 0; x < side; x++)
+            {
+                Vertex& vertex = mesh.vertices[y * side + x];
+                vertex.position = D3DXVECTOR3((float)x, 0.0f, (float)y);
+                vertex.texCoord = D3DXVECTOR2((float)x / (float)(side - 1), (float)y / (float)(side - 1));
+            }
+        }
+
+        mesh.indices.reserve((side - 1) * (side - 1) * 6);
+        for (size_t y = 0; y + 1 < side; y++)
+        {
+            for (size_t x = 0; x + 1 < side; x++)
+            {
+                DWORD i = (DWORD)(y * side + x);
+                DWORD quad[6] = { i, i + (DWORD)side, i + 1, i + 1, i + (DWORD)side, i + (DWORD)side + 1 };
+                mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+            }
+        }
+    }
+}
+
+static void BM_ExportGeometry(Bench::State& state)
+{
+    MeshData mesh;
+    MakeGrid((size_t)state.range(0), mesh);
+    const int64_t triangles = (int64_t)(mesh.indices.size() / 3);
+
+    ConversionOptions options;
+    FBXExporter exporter;
+    if (!GeometryExportBenchAccess::Initialize(exporter, options))
+    {
+        state.SkipWithError(exporter.GetLastError());
+        return;
+    }
+    FbxScene* scene = GeometryExportBenchAccess::GetScene(exporter);
+
+    while (state.KeepRunning())
+    {
+        FbxMesh* fbxMesh = FbxMesh::Create(scene, mesh.name.c_str());
+        GeometryExportBenchAccess::ExportGeometry(exporter, &mesh, fbxMesh);
+        Bench::DoNotOptimize(fbxMesh->GetPolygonCount());
+        fbxMesh->Destroy();
+    }
+    state.SetItemsProcessed(state.iterations() * triangles);
+    state.SetLabel(to_string(triangles) + " triangles");
+}
+BENCHMARK(BM_ExportGeometry)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,267 @@
+// ============================================================================
+// Benchmark: carga del paquete de runtime frente a la importación del FBX
+// ============================================================================
+// Escena sintética con una cadena de huesos, un mesh con skinning (rejilla de
+// vértices repartida entre los huesos) y un clip de 2 segundos a 30 FPS. Se
+// escribe una vez como .xpkg (RuntimePackageWriter) y como FBX binario
+// (NativeFBXExporter, un clip por archivo) en el directorio temporal.
+//
+//   Package     MappedPackage::Open (mapeo + validación) y lectura de todas
+//               las posiciones y todas las keys con PackageView
+//   NativeFBX   NativeFBXImporter::LoadScene hasta SceneData
+//
+// Argumentos: huesos, vértices del mesh. Los elementos procesados son
+// archivos cargados; los bytes, el tamaño del archivo.
+// ============================================================================
+
+#include "BenchHarness.h"
+#include "../include/RuntimePackage.h"
+#include "../src/RuntimePackageWriter.h"
+#include "../src/NativeFBXExporter.h"
+#include "../src/NativeFBXImporter.h"
+
+#include <cmath>
+#include <filesystem>
+#include <map>
+
+namespace
+{
+    const double CLIP_DURATION = 2.0;
+    const double KEY_RATE = 30.0;
+
+    struct SceneFiles
+    {
+        string package;
+        string fbx;
+        int64_t packageSize;
+        int64_t fbxSize;
+        bool valid;
+
+        SceneFiles() : packageSize(0), fbxSize(0), valid(false) {}
+    };
+
+    ConversionOptions MakeOptions()
+    {
+        ConversionOptions options;
+        options.exportTextures = false;
+        options.nativeFbx = true;
+        options.targetFPS = KEY_RATE;
+        return options;
+    }
+
+    // Cadena de huesos sobre el eje Y con un mesh de rejilla colgado de la raíz
+    void MakeScene(size_t boneCount, size_t vertexCount, SceneData& scene)
+    {
+        scene.rootFrame = new FrameData();
+        scene.rootFrame->name = "Root";
+
+        FrameData* parent = scene.rootFrame;
+        for (size_t b = 0; b < boneCount; b++)
+        {
+            FrameData* bone = new FrameData();
+            bone->name = "Bone" + to_string(b);
+            D3DXMatrixTranslation(&bone->transformMatrix, 0.0f, 1.0f, 0.0f);
+            D3DXMatrixTranslation(&bone->combinedMatrix, 0.0f, (float)(b + 1), 0.0f);
+            bone->parent = parent;
+            parent->children.push_back(bone);
+            parent = bone;
+        }
+
+        MaterialData material;
+        material.name = "Skin";
+        memset(&material.material, 0, sizeof(material.material));
+        material.material.Diffuse.r = material.material.Diffuse.g = 1.0f;
+        material.material.Diffuse.b = material.material.Diffuse.a = 1.0f;
+        scene.materials.push_back(material);
+
+        MeshData* mesh = new MeshData();
+        mesh->name = "Body";
+        mesh->materials.push_back(0);
+        mesh->texCoordSetCount = 1;
+        mesh->hasSkinning = true;
+
+        const size_t side = max<size_t>(2, (size_t)sqrt((double)vertexCount));
+        const float height = (float)boneCount;
+        mesh->vertices.resize(side * side);
+        for (size_t y = 0; y < side; y++)
+        {
+            for (size_t x = 0; x < side; x++)
+            {
+                Vertex& vertex = mesh->vertices[y * side + x];
+                float u = (float)x / (float)(side - 1);
+                float v = (float)y / (float)(side - 1);
+                vertex.position = D3DXVECTOR3(u - 0.5f, v * height, 0.0f);
+                vertex.normal = D3DXVECTOR3(0.0f, 0.0f, -1.0f);
+                vertex.texCoord = D3DXVECTOR2(u, v);
+
+                size_t bone = min(boneCount - 1, (size_t)(v * (float)boneCount));
+                vertex.boneIndices[0] = (DWORD)bone;
+                vertex.boneWeights[0] = 1.0f;
+            }
+        }
+
+        for (size_t y = 0; y + 1 < side; y++)
+        {
+            for (size_t x = 0; x + 1 < side; x++)
+            {
+                DWORD i = (DWORD)(y * side + x);
+                DWORD quad[6] = { i, i + (DWORD)side, i + 1, i + 1, i + (DWORD)side, i + (DWORD)side + 1 };
+                mesh->indices.insert(mesh->indices.end(), quad, quad + 6);
+            }
+        }
+
+        mesh->bones.resize(boneCount);
+        for (size_t b = 0; b < boneCount; b++)
+        {
+            BoneData& bone = mesh->bones[b];
+            bone.name = "Bone" + to_string(b);
+            D3DXMatrixTranslation(&bone.transformMatrix, 0.0f, (float)(b + 1), 0.0f);
+            D3DXMatrixTranslation(&bone.offsetMatrix, 0.0f, -(float)(b + 1), 0.0f);
+            bone.parentIndex = (int)b - 1;
+        }
+        scene.rootFrame->meshes.push_back(mesh);
+
+        AnimationClip clip;
+        clip.name = "Wave";
+        clip.duration = CLIP_DURATION;
+        clip.ticksPerSecond = KEY_RATE;
+        clip.tracks.resize(boneCount);
+
+        const size_t keyCount = (size_t)(CLIP_DURATION * KEY_RATE) + 1;
+        for (size_t b = 0; b < boneCount; b++)
+        {
+            vector<AnimationKey> keys(keyCount);
+            for (size_t k = 0; k < keyCount; k++)
+            {
+                AnimationKey& key = keys[k];
+                key.time = (double)k / KEY_RATE;
+                key.translation = D3DXVECTOR3(0.0f, 1.0f, 0.0f);
+                float angle = 0.3f * sinf((float)(key.time * 3.0 + (double)b * 0.5));
+                key.rotation = D3DXQUATERNION(0.0f, 0.0f, sinf(angle * 0.5f), cosf(angle * 0.5f));
+                key.scale = D3DXVECTOR3(1.0f, 1.0f, 1.0f);
+                key.channels = KEY_ALL;
+            }
+
+            clip.tracks[b].boneName = "Bone" + to_string(b);
+            clip.tracks[b].SetKeys(std::move(keys));
+        }
+        scene.animations.push_back(clip);
+    }
+
+    // Archivos de la escena para unos argumentos (se escriben una vez)
+    const SceneFiles& GetSceneFiles(size_t boneCount, size_t vertexCount)
+    {
+        static map<pair<size_t, size_t>, SceneFiles> cache;
+
+        auto key = make_pair(boneCount, vertexCount);
+        auto it = cache.find(key);
+        if (it != cache.end())
+            return it->second;
+
+        SceneFiles& files = cache[key];
+        const filesystem::path folder = filesystem::temp_directory_path();
+        const string base = "PackageLoadBench_" + to_string(boneCount) + "_" + to_string(vertexCount);
+        files.package = (folder / (base + ".xpkg")).string();
+        files.fbx = (folder / (base + ".fbx")).string();
+
+        SceneData scene;
+        MakeScene(boneCount, vertexCount, scene);
+        const ConversionOptions options = MakeOptions();
+
+        RuntimePackageWriter packageWriter;
+        NativeFBXExporter fbxExporter;
+        if (!packageWriter.WritePackage(scene, files.package, options) ||
+            !fbxExporter.ExportScene(scene, files.fbx, options))
+        {
+            return files;
+        }
+
+        files.packageSize = (int64_t)filesystem::file_size(files.package);
+        files.fbxSize = (int64_t)filesystem::file_size(files.fbx);
+        files.valid = true;
+        return files;
+    }
+}
+
+static void BM_LoadPackage(Bench::State& state)
+{
+    using namespace RuntimePackage;
+
+    const SceneFiles& files = GetSceneFiles((size_t)state.range(0), (size_t)state.range(1));
+    if (!files.valid)
+    {
+        state.SkipWithError("Cannot write " + files.package);
+        return;
+    }
+
+    while (state.KeepRunning())
+    {
+        MappedPackage package;
+        if (!package.Open(files.package.c_str()))
+        {
+            state.SkipWithError("Cannot open " + files.package);
+            return;
+        }
+
+        // Recorrer los datos que usaría el motor al subir el mesh y muestrear
+        const PackageView& view = package.View();
+        const Header& header = view.GetHeader();
+        float sum = 0.0f;
+
+        for (uint32_t m = 0; m < header.meshCount; m++)
+        {
+            const Mesh& mesh = view.GetMesh(m);
+            const float* positions = view.At<float>(mesh.positions);
+            for (uint32_t i = 0; i < mesh.vertexCount * 3; i++)
+                sum += positions[i];
+        }
+
+        for (uint32_t c = 0; c < header.clipCount; c++)
+        {
+            const Clip& clip = view.GetClip(c);
+            const Track* tracks = view.GetTracks(clip);
+            for (uint32_t t = 0; t < clip.trackCount; t++)
+            {
+                float value[4];
+                for (uint32_t k = 0; k < tracks[t].keyCount; k++)
+                {
+                    view.GetKeyValue(tracks[t], k, value);
+                    sum += value[0] + view.GetKeyTime(clip, tracks[t], k);
+                }
+            }
+        }
+        Bench::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * files.packageSize);
+}
+BENCHMARK(BM_LoadPackage)->Args({ 32, 4096 })->Args({ 64, 65536 })->Args({ 128, 262144 });
+
+static void BM_LoadNativeFBX(Bench::State& state)
+{
+    const SceneFiles& files = GetSceneFiles((size_t)state.range(0), (size_t)state.range(1));
+    if (!files.valid)
+    {
+        state.SkipWithError("Cannot write " + files.fbx);
+        return;
+    }
+
+    const ConversionOptions options = MakeOptions();
+
+    while (state.KeepRunning())
+    {
+        NativeFBXImporter importer;
+        SceneData scene;
+        if (!importer.LoadScene(files.fbx, options, scene))
+        {
+            state.SkipWithError(importer.GetLastError());
+            return;
+        }
+        Bench::DoNotOptimize(scene.rootFrame);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * files.fbxSize);
+}
+BENCHMARK(BM_LoadNativeFBX)->Args({ 32, 4096 })->Args({ 64, 65536 })->Args({ 128, 262144 });
+
+BENCHMARK_MAIN();
@@ -0,0 +1,172 @@
+// ============================================================================
+// Benchmark: evaluación de poses (PoseEvaluator)
+// ============================================================================
+// Clips sintéticos de 2 segundos a 30 FPS con traslación, rotación y escala
+// en todos los huesos. Cada iteración avanza un frame de 60 Hz y evalúa la
+// pose local de todos los clips, como un motor que reproduce varias
+// instancias a la vez. Los elementos procesados son huesos x clips.
+//
+//   Sequential  tiempos crecientes (la caché de keys acierta casi siempre)
+//   Random      tiempos aleatorios (búsqueda binaria en cada canal)
+//   Reference   búsqueda binaria + D3DXVec3Lerp/D3DXQuaternionSlerp por
+//               hueso, sobre los mismos tracks (AoS)
+//
+// Argumentos: huesos por clip, número de clips.
+// ============================================================================
+
+#include "BenchHarness.h"
+#include "../src/PoseEvaluator.h"
+
+#include <random>
+
+namespace
+{
+    const double CLIP_DURATION = 2.0;
+    const double KEY_RATE = 30.0;
+    const double FRAME_STEP = 1.0 / 60.0;
+
+    AnimationClip MakeClip(size_t boneCount, unsigned int seed)
+    {
+        mt19937 random(seed);
+        uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        AnimationClip clip;
+        clip.name = "Bench" + to_string(seed);
+        clip.duration = CLIP_DURATION;
+        clip.tracks.resize(boneCount);
+
+        const size_t keyCount = (size_t)(CLIP_DURATION * KEY_RATE) + 1;
+        for (size_t bone = 0; bone < boneCount; bone++)
+        {
+            vector<AnimationKey> keys(keyCount);
+            for (size_t k = 0; k < keyCount; k++)
+            {
+                AnimationKey& key = keys[k];
+                key.time = (double)k / KEY_RATE;
+                key.translation = D3DXVECTOR3(unit(random), unit(random), unit(random));
+                D3DXQUATERNION q(unit(random), unit(random), unit(random), 1.0f);
+                D3DXQuaternionNormalize(&key.rotation, &q);
+                key.scale = D3DXVECTOR3(1.0f + 0.1f * unit(random), 1.0f, 1.0f);
+                key.channels = KEY_ALL;
+            }
+
+            clip.tracks[bone].boneName = "Bone" + to_string(bone);
+            clip.tracks[bone].SetKeys(std::move(keys));
+        }
+        return clip;
+    }
+
+    struct PoseSet
+    {
+        vector<AnimationClip> clips;
+        vector<PoseEvaluator> evaluators;
+        vector<PoseEvaluationCache> caches;
+        vector<LocalPose> poses;
+
+        PoseSet(size_t boneCount, size_t clipCount)
+            : clips(clipCount), evaluators(clipCount), caches(clipCount), poses(clipCount)
+        {
+            for (size_t c = 0; c < clipCount; c++)
+            {
+                clips[c] = MakeClip(boneCount, (unsigned int)c + 1);
+                evaluators[c].Initialize(clips[c]);
+                poses[c].Resize(boneCount);
+            }
+        }
+    };
+
+    // Muestreo directo de un track (búsqueda binaria + slerp de D3DX)
+    void SampleTrack(const vector<AnimationKey>& keys, double time,
+                     D3DXVECTOR3& translation, D3DXQUATERNION& rotation, D3DXVECTOR3& scale)
+    {
+        auto next = lower_bound(keys.begin(), keys.end(), time,
+                                [](const AnimationKey& key, double t) { return key.time < t; });
+        if (next == keys.begin() || next == keys.end())
+        {
+            const AnimationKey& key = (next == keys.end()) ? keys.back() : keys.front();
+            translation = key.translation;
+            rotation = key.rotation;
+            scale = key.scale;
+            return;
+        }
+
+        const AnimationKey& a = *(next - 1);
+        const AnimationKey& b = *next;
+        float alpha = (float)((time - a.time) / (b.time - a.time));
+        D3DXVec3Lerp(&translation, &a.translation, &b.translation, alpha);
+        D3DXQuaternionSlerp(&rotation, &a.rotation, &b.rotation, alpha);
+        D3DXVec3Lerp(&scale, &a.scale, &b.scale, alpha);
+    }
+}
+
+static void BM_PoseEvaluator_Sequential(Bench::State& state)
+{
+    PoseSet set((size_t)state.range(0), (size_t)state.range(1));
+    double time = 0.0;
+
+    while (state.KeepRunning())
+    {
+        for (size_t c = 0; c < set.clips.size(); c++)
+            set.evaluators[c].Evaluate(time, set.caches[c], set.poses[c]);
+        Bench::DoNotOptimize(set.poses.back().r[3].back());
+
+        time += FRAME_STEP;
+        if (time > CLIP_DURATION)
+            time = 0.0;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_PoseEvaluator_Sequential)->Args({ 64, 1 })->Args({ 64, 16 })->Args({ 256, 16 })->Args({ 256, 64 });
+
+static void BM_PoseEvaluator_Random(Bench::State& state)
+{
+    PoseSet set((size_t)state.range(0), (size_t)state.range(1));
+
+    mt19937 random(99);
+    uniform_real_distribution<double> clipTime(0.0, CLIP_DURATION);
+    vector<double> times(1024);
+    for (double& t : times)
+        t = clipTime(random);
+    size_t next = 0;
+
+    while (state.KeepRunning())
+    {
+        for (size_t c = 0; c < set.clips.size(); c++)
+            set.evaluators[c].Evaluate(times[(next + c) % times.size()], set.caches[c], set.poses[c]);
+        Bench::DoNotOptimize(set.poses.back().r[3].back());
+        next = (next + 1) % times.size();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_PoseEvaluator_Random)->Args({ 64, 1 })->Args({ 64, 16 })->Args({ 256, 16 })->Args({ 256, 64 });
+
+static void BM_PoseReference_Sequential(Bench::State& state)
+{
+    PoseSet set((size_t)state.range(0), (size_t)state.range(1));
+    double time = 0.0;
+
+    while (state.KeepRunning())
+    {
+        for (size_t c = 0; c < set.clips.size(); c++)
+        {
+            LocalPose& pose = set.poses[c];
+            const vector<AnimationTrack>& tracks = set.clips[c].tracks;
+            for (size_t bone = 0; bone < tracks.size(); bone++)
+            {
+                D3DXVECTOR3 translation, scale;
+                D3DXQUATERNION rotation;
+                SampleTrack(tracks[bone].GetKeys(), time, translation, rotation, scale);
+                pose.Set(bone, translation, rotation, scale);
+            }
+        }
+        Bench::DoNotOptimize(set.poses.back().r[3].back());
+
+        time += FRAME_STEP;
+        if (time > CLIP_DURATION)
+            time = 0.0;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_PoseReference_Sequential)->Args({ 64, 1 })->Args({ 64, 16 })->Args({ 256, 16 })->Args({ 256, 64 });
+
+BENCHMARK_MAIN();
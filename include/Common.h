@@ -17,6 +17,12 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 
 // DirectX 9
 #include <d3d9.h>
@@ -37,6 +43,7 @@ using namespace std;
 
 // Constants
 #define MAX_BONE_INFLUENCES 4
+#define MAX_TEXCOORD_SETS 4
 #define EPSILON 0.0001f
 
 // Coordinate System
@@ -73,6 +80,28 @@ struct ConversionOptions
 	// Opciones de animación
 	double targetFPS = 30.0; // FPS objetivo para la exportación (30 o 60 recomendado)
 	bool resampleAnimation = true; // Resamplear animación al FPS objetivo
+	bool animSkeletonOnly = false; // Archivos de animación solo con skeleton (sin geometría), escena creada una vez
+	bool removeConstantChannels = true; // Colapsar canales constantes y eliminar los iguales a la pose de reposo
+	bool reduceKeys = true; // Eliminar keys que la interpolación reproduce dentro de la tolerancia
+	float keyPositionTolerance = 0.001f; // Error máximo de traslación (unidades)
+	float keyRotationTolerance = 0.01f; // Error máximo de rotación (grados)
+	float keyScaleTolerance = 0.001f; // Error máximo de escala
+	bool fitCurves = false; // Exportar curvas cúbicas ajustadas (Hermite) en vez de keys lineales
+	bool bakeRigidSkins = false; // Hornear skins sin animación o rígidos (un hueso) a geometría estática
+	size_t maxPaletteBones = 0; // Máximo de huesos por mesh (paleta de skinning en GPU, 0 = sin límite)
+	bool exportBounds = false; // Escribir AABBs por frame de los meshes con skinning (.bounds junto a cada clip)
+	bool nativeFbx = false; // Escribir el FBX con el escritor propio (sin FBX SDK)
+	int nativeFbxVersion = 7400; // Versión del FBX binario del escritor propio (7400 o 7500)
+	bool nativeFbxAscii = false; // Escribir el FBX propio en ASCII en vez de binario
+	int fbxCompressionLevel = 1; // Nivel zlib de los arrays del escritor propio (0 = sin comprimir)
+	size_t fbxCompressionThreshold = 1024; // Tamaño mínimo (bytes) de un array comprimido
+	bool exportGltf = false; // Escribir también un .glb (glTF 2.0 binario) con la escena y todos los clips
+	bool exportPackage = false; // Escribir también un .xpkg (paquete de runtime mapeable) con la escena y todos los clips
+	bool exportXFile = false; // Escribir también un .X binario comprimido (MSZIP) con la escena procesada y todos los clips
+	bool verifyOutput = false; // Recargar cada FBX propio escrito y compararlo con la escena original
+
+	// Paralelismo
+	int numThreads = 0; // Hilos de trabajo (0 = todos los núcleos disponibles)
 
 	ConversionOptions() {}
 };
@@ -84,6 +113,10 @@ struct Vertex
 	D3DXVECTOR3 normal;
 	D3DXVECTOR2 texCoord;
 
+	// Sets de UV adicionales (TEXCOORD1..n) y color de vértice
+	D3DXVECTOR2 extraTexCoords[MAX_TEXCOORD_SETS - 1];
+	D3DXCOLOR color;
+
 	// Skin weights (hasta 4 influencias)
 	DWORD boneIndices[MAX_BONE_INFLUENCES];
 	float boneWeights[MAX_BONE_INFLUENCES];
@@ -93,6 +126,12 @@ struct Vertex
 		position = D3DXVECTOR3(0, 0, 0);
 		normal = D3DXVECTOR3(0, 1, 0);
 		texCoord = D3DXVECTOR2(0, 0);
+		color = D3DXCOLOR(1, 1, 1, 1);
+
+		for (int i = 0; i < MAX_TEXCOORD_SETS - 1; i++)
+		{
+			extraTexCoords[i] = D3DXVECTOR2(0, 0);
+		}
 
 		for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
 		{
@@ -139,6 +178,12 @@ struct BoneData
 	}
 };
 
+// Canales presentes en un keyframe (máscara de bits)
+#define KEY_TRANSLATION 0x01
+#define KEY_ROTATION    0x02
+#define KEY_SCALE       0x04
+#define KEY_ALL         (KEY_TRANSLATION | KEY_ROTATION | KEY_SCALE)
+
 // Animation Keyframe
 struct AnimationKey
 {
@@ -147,22 +192,46 @@ struct AnimationKey
 	D3DXQUATERNION rotation;
 	D3DXVECTOR3 scale;
 
+	// Canales que realmente tienen key en este tiempo (KEY_*)
+	// Los demás valores son de relleno y no deben exportarse
+	BYTE channels;
+
 	AnimationKey()
 	{
 		time = 0.0;
 		translation = D3DXVECTOR3(0, 0, 0);
 		rotation = D3DXQUATERNION(0, 0, 0, 1);
 		scale = D3DXVECTOR3(1, 1, 1);
+		channels = KEY_ALL;
 	}
 };
 
 // Animation Track (por hueso)
+// Las keys son inmutables y pueden estar compartidas entre tracks idénticos
+// de varios clips (AnimationOptimizer::ShareDuplicateTracks): para
+// modificarlas se construye un array nuevo y se asigna con SetKeys()
 struct AnimationTrack
 {
 	string boneName;
-	vector<AnimationKey> keys;
+	shared_ptr<const vector<AnimationKey>> keyData;
 
-	AnimationTrack() {}
+	// keyData lo usan varios tracks (lo marca ShareDuplicateTracks); los
+	// exportadores convierten una sola vez las curvas de estos arrays
+	bool shared;
+
+	AnimationTrack() : shared(false) {}
+
+	const vector<AnimationKey>& GetKeys() const
+	{
+		static const vector<AnimationKey> noKeys;
+		return keyData ? *keyData : noKeys;
+	}
+
+	void SetKeys(vector<AnimationKey>&& keys)
+	{
+		keyData = make_shared<const vector<AnimationKey>>(std::move(keys));
+		shared = false;
+	}
 };
 
 // Animation Clip
@@ -187,7 +256,11 @@ struct MeshData
 	string name;
 	vector<Vertex> vertices;
 	vector<DWORD> indices;
-	vector<DWORD> materialIndices; // índice de material por triángulo
+	vector<DWORD> materials;       // índice en SceneData::materials de cada material del mesh
+	vector<DWORD> materialIndices; // material de cada triángulo (índice en materials)
+
+	DWORD texCoordSetCount; // sets de UV presentes (texCoord + extraTexCoords)
+	bool hasVertexColors;
 
 	bool hasSkinning;
 	vector<BoneData> bones;
@@ -195,6 +268,8 @@ struct MeshData
 	MeshData()
 	{
 		name = "Mesh";
+		texCoordSetCount = 0;
+		hasVertexColors = false;
 		hasSkinning = false;
 	}
 };
@@ -365,20 +440,125 @@ namespace Utils
     }
 
 	// Logging
+	// Buffer de log del hilo actual (nullptr = consola)
+	// Los workers que exportan en paralelo acumulan aquí su salida para
+	// imprimirla después en orden determinista
+	inline ostringstream*& LogCapture()
+	{
+		thread_local ostringstream* capture = nullptr;
+		return capture;
+	}
+
+	// Stream de log: el buffer del hilo si existe, si no la consola
+	inline ostream& LogStream(ostream& console = cout)
+	{
+		ostringstream* capture = LogCapture();
+		return capture ? *capture : console;
+	}
+
 	inline void Log(const string& message, bool verbose = true)
 	{
 		if (verbose)
-			cout << "[INFO] " << message << endl;
+			LogStream() << "[INFO] " << message << endl;
 	}
 
 	inline void LogWarning(const string& message)
 	{
-		cout << "[WARNING] " << message << endl;
+		LogStream() << "[WARNING] " << message << endl;
 	}
 
+	// Marca de las líneas de error dentro de un buffer capturado
+	const char LOG_ERROR_TAG = '\x01';
+
 	inline void LogError(const string& message)
 	{
-		cerr << "[ERROR] " << message << endl;
+		ostringstream* capture = LogCapture();
+		if (!capture)
+		{
+			cerr << "[ERROR] " << message << endl;
+			return;
+		}
+
+		// Capturado: cada línea lleva la marca para que FlushLog() la
+		// devuelva a cerr en su posición
+		istringstream lines("[ERROR] " + message);
+		string line;
+		while (getline(lines, line))
+			*capture << LOG_ERROR_TAG << line << "\n";
+	}
+
+	// Imprimir un buffer capturado: líneas de error a cerr, el resto a cout
+	inline void FlushLog(const string& text)
+	{
+		size_t start = 0;
+		while (start < text.size())
+		{
+			size_t end = text.find('\n', start);
+			end = (end == string::npos) ? text.size() : end + 1;
+
+			if (text[start] == LOG_ERROR_TAG)
+			{
+				cout << flush;
+				cerr << text.substr(start + 1, end - start - 1) << flush;
+			}
+			else
+			{
+				cout << text.substr(start, end - start);
+			}
+			start = end;
+		}
+		cout << flush;
+	}
+
+	// Número de hilos efectivo (0 = todos los núcleos)
+	inline int GetThreadCount(int requested)
+	{
+		if (requested > 0)
+			return requested;
+		unsigned int hardware = std::thread::hardware_concurrency();
+		return hardware > 0 ? (int)hardware : 1;
+	}
+
+	// Número de workers que usará ParallelFor para 'count' elementos
+	inline size_t GetWorkerCount(size_t count, int numThreads)
+	{
+		return max((size_t)1, min((size_t)GetThreadCount(numThreads), count));
+	}
+
+	// Ejecutar body(i, worker) para i en [0, count) repartido entre varios hilos
+	// 'worker' está en [0, GetWorkerCount()) y permite usar estado propio por hilo
+	// Los índices se asignan dinámicamente (los elementos pueden tener costos muy distintos)
+	inline void ParallelForWorker(size_t count, int numThreads, const function<void(size_t, size_t)>& body)
+	{
+		size_t workers = GetWorkerCount(count, numThreads);
+		if (workers <= 1)
+		{
+			for (size_t i = 0; i < count; i++)
+				body(i, 0);
+			return;
+		}
+
+		atomic<size_t> next(0);
+		auto worker = [&](size_t workerIndex)
+		{
+			for (size_t i = next++; i < count; i = next++)
+				body(i, workerIndex);
+		};
+
+		vector<std::thread> threads;
+		for (size_t t = 1; t < workers; t++)
+			threads.emplace_back(worker, t);
+
+		worker(0);
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	// Ejecutar body(i) para i en [0, count) repartido entre varios hilos
+	inline void ParallelFor(size_t count, int numThreads, const function<void(size_t)>& body)
+	{
+		ParallelForWorker(count, numThreads, [&](size_t i, size_t) { body(i); });
 	}
 }
 
@@ -0,0 +1,491 @@
+#pragma once
+
+#ifndef RUNTIME_PACKAGE_H
+#define RUNTIME_PACKAGE_H
+
+//==============================================================================
+// Runtime Package (.xpkg)
+// Formato binario listo para el motor que escribe RuntimePackageWriter y
+// lector header-only (sin dependencias del conversor).
+//
+// El archivo se mapea en memoria y se usa directamente: todas las tablas y
+// arrays están alineados a 16 bytes y se referencian con offsets de 64 bits
+// desde el inicio del archivo. PackageView::Open() valida la cabecera, que
+// cada rango esté alineado y dentro del archivo y que los índices (nodos,
+// materiales, strings, submeshes) apunten a elementos existentes; no copia
+// ni convierte datos.
+//
+// Espacio de coordenadas igual que el FBX/glTF exportado: Right-Handed,
+// Y-Up, escala global aplicada. Matrices con vectores fila (v * M), 16
+// floats fila a fila. Todos los valores en little-endian.
+//
+//   Header
+//   Nodos (SoA): padre, nombre, traslación, rotación, escala (pose de reposo)
+//   Meshes: streams de vértices, índices de 16 o 32 bits, submeshes,
+//           huesos (nodo + matriz inversa de enlace)
+//   Materiales
+//   Clips: tracks por canal (T, R, S) con tiempos en frames de 16 bits y
+//          valores cuantizados a 16 bits por componente cuando el error
+//          entra en las tolerancias de la conversión (si no, float)
+//   Tabla de strings (UTF-8 terminados en 0)
+//==============================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RuntimePackage
+{
+    static const uint32_t MAGIC = 0x474B5058;          // "XPKG"
+    static const uint16_t VERSION = 1;
+    static const uint32_t ALIGNMENT = 16;
+    static const uint32_t NO_INDEX = 0xFFFFFFFF;
+
+    // Streams presentes en un mesh (las posiciones siempre están)
+    enum StreamFlags
+    {
+        STREAM_NORMALS = 0x01,       // float3
+        STREAM_TEXCOORDS = 0x02,     // float2 (set 0)
+        STREAM_COLORS = 0x04,        // RGBA8 unorm
+        STREAM_SKIN = 0x08           // índices de hueso uint8x4/uint16x4 + pesos unorm8x4
+    };
+
+    enum Channel
+    {
+        CHANNEL_TRANSLATION = 0,     // float3
+        CHANNEL_ROTATION = 1,        // quaternion x, y, z, w
+        CHANNEL_SCALE = 2            // float3
+    };
+
+    enum TimeFormat
+    {
+        TIME_FRAME16 = 0,            // uint16: frame / Clip::sampleRate
+        TIME_FLOAT32 = 1             // float: segundos
+    };
+
+    enum ValueFormat
+    {
+        VALUE_UNORM16 = 0,           // uint16: rangeMin + q / 65535 * rangeExtent
+        VALUE_FLOAT32 = 1
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t headerSize;
+        uint64_t fileSize;
+
+        uint32_t nodeCount;
+        uint32_t meshCount;
+        uint32_t materialCount;
+        uint32_t clipCount;
+
+        uint64_t strings;            // char[stringsSize]
+        uint64_t stringsSize;
+
+        uint64_t nodeParents;        // int32[nodeCount] (-1 = raíz)
+        uint64_t nodeNames;          // uint32[nodeCount] (offset en strings)
+        uint64_t nodeTranslations;   // float[3 * nodeCount]
+        uint64_t nodeRotations;      // float[4 * nodeCount]
+        uint64_t nodeScales;         // float[3 * nodeCount]
+
+        uint64_t meshes;             // Mesh[meshCount]
+        uint64_t materials;          // Material[materialCount]
+        uint64_t clips;              // Clip[clipCount]
+    };
+
+    struct Mesh
+    {
+        uint32_t name;
+        uint32_t node;               // Nodo del que cuelga el mesh
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t indexSize;          // 2 o 4 bytes
+        uint32_t boneIndexSize;      // 1 o 2 bytes por índice de hueso
+        uint32_t streams;            // StreamFlags
+        uint32_t submeshCount;
+        uint32_t boneCount;
+        uint32_t reserved;
+
+        uint64_t indices;
+        uint64_t positions;
+        uint64_t normals;
+        uint64_t texCoords;
+        uint64_t colors;
+        uint64_t boneIndices;
+        uint64_t boneWeights;
+        uint64_t submeshes;          // Submesh[submeshCount]
+        uint64_t boneNodes;          // uint32[boneCount]
+        uint64_t inverseBindMatrices; // float[16 * boneCount]
+    };
+
+    struct Submesh
+    {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t material;           // NO_INDEX = sin material
+        uint32_t reserved;
+    };
+
+    struct Material
+    {
+        uint32_t name;
+        uint32_t texture;            // Offset en strings (NO_INDEX = sin textura)
+        float diffuse[4];
+        float ambient[3];
+        float specular[3];
+        float emissive[3];
+        float power;
+    };
+
+    struct Clip
+    {
+        uint32_t name;
+        uint32_t trackCount;
+        float duration;              // Segundos
+        float sampleRate;            // Frames por segundo de TIME_FRAME16
+        uint64_t tracks;             // Track[trackCount]
+    };
+
+    struct Track
+    {
+        uint32_t node;
+        uint16_t channel;            // Channel
+        uint8_t timeFormat;          // TimeFormat
+        uint8_t valueFormat;         // ValueFormat
+        uint32_t keyCount;
+        uint32_t components;         // 3 (T, S) o 4 (R)
+        float rangeMin[4];
+        float rangeExtent[4];
+        uint64_t times;
+        uint64_t values;
+    };
+
+    static_assert(sizeof(Header) == 112, "RuntimePackage::Header layout");
+    static_assert(sizeof(Mesh) == 120, "RuntimePackage::Mesh layout");
+    static_assert(sizeof(Submesh) == 16, "RuntimePackage::Submesh layout");
+    static_assert(sizeof(Material) == 64, "RuntimePackage::Material layout");
+    static_assert(sizeof(Clip) == 24, "RuntimePackage::Clip layout");
+    static_assert(sizeof(Track) == 64, "RuntimePackage::Track layout");
+
+    /**
+     * @class PackageView
+     * @brief Acceso directo a un paquete en memoria (mapeado o leído)
+     *
+     * Los punteros devueltos apuntan dentro del bloque de memoria, que
+     * debe seguir vivo mientras se use la vista.
+     */
+    class PackageView
+    {
+    public:
+        PackageView() : m_Data(nullptr), m_Size(0) {}
+
+        /**
+         * Validar la cabecera, todos los rangos y los índices del paquete
+         * @param data Inicio del paquete (alineado a 16 bytes)
+         * @param size Tamaño en bytes
+         * @return true si el paquete es válido
+         */
+        bool Open(const void* data, size_t size)
+        {
+            m_Data = static_cast<const uint8_t*>(data);
+            m_Size = size;
+
+            if (!m_Data || size < sizeof(Header))
+                return Fail();
+
+            const Header& header = GetHeader();
+            if (header.magic != MAGIC || header.version != VERSION ||
+                header.headerSize != sizeof(Header) || header.fileSize != size)
+            {
+                return Fail();
+            }
+
+            const uint64_t nodes = header.nodeCount;
+            if (!InRange(header.strings, header.stringsSize) || header.stringsSize == 0 ||
+                m_Data[header.strings + header.stringsSize - 1] != 0 ||
+                !InRange(header.nodeParents, nodes * 4) ||
+                !InRange(header.nodeNames, nodes * 4) ||
+                !InRange(header.nodeTranslations, nodes * 12) ||
+                !InRange(header.nodeRotations, nodes * 16) ||
+                !InRange(header.nodeScales, nodes * 12) ||
+                !InRange(header.meshes, (uint64_t)header.meshCount * sizeof(Mesh)) ||
+                !InRange(header.materials, (uint64_t)header.materialCount * sizeof(Material)) ||
+                !InRange(header.clips, (uint64_t)header.clipCount * sizeof(Clip)))
+            {
+                return Fail();
+            }
+
+            // Jerarquía: padres y nombres de los nodos
+            const int32_t* parents = At<int32_t>(header.nodeParents);
+            const uint32_t* names = At<uint32_t>(header.nodeNames);
+            for (uint32_t i = 0; i < header.nodeCount; i++)
+            {
+                if (parents[i] < -1 || (parents[i] >= 0 && (uint32_t)parents[i] >= header.nodeCount) ||
+                    !IsString(names[i], false))
+                {
+                    return Fail();
+                }
+            }
+
+            for (uint32_t i = 0; i < header.materialCount; i++)
+            {
+                const Material& material = GetMaterial(i);
+                if (!IsString(material.name, false) || !IsString(material.texture, true))
+                    return Fail();
+            }
+
+            for (uint32_t i = 0; i < header.meshCount; i++)
+            {
+                const Mesh& mesh = GetMesh(i);
+                const uint64_t vertices = mesh.vertexCount;
+                const bool skinned = (mesh.streams & STREAM_SKIN) != 0;
+
+                if ((mesh.indexSize != 2 && mesh.indexSize != 4) ||
+                    !InRange(mesh.indices, (uint64_t)mesh.indexCount * mesh.indexSize) ||
+                    !InRange(mesh.positions, vertices * 12) ||
+                    ((mesh.streams & STREAM_NORMALS) && !InRange(mesh.normals, vertices * 12)) ||
+                    ((mesh.streams & STREAM_TEXCOORDS) && !InRange(mesh.texCoords, vertices * 8)) ||
+                    ((mesh.streams & STREAM_COLORS) && !InRange(mesh.colors, vertices * 4)) ||
+                    (skinned && mesh.boneIndexSize != 1 && mesh.boneIndexSize != 2) ||
+                    (skinned && !InRange(mesh.boneIndices, vertices * 4 * mesh.boneIndexSize)) ||
+                    (skinned && !InRange(mesh.boneWeights, vertices * 4)) ||
+                    !InRange(mesh.submeshes, (uint64_t)mesh.submeshCount * sizeof(Submesh)) ||
+                    !InRange(mesh.boneNodes, (uint64_t)mesh.boneCount * 4) ||
+                    !InRange(mesh.inverseBindMatrices, (uint64_t)mesh.boneCount * 64) ||
+                    mesh.node >= header.nodeCount || !IsString(mesh.name, false))
+                {
+                    return Fail();
+                }
+
+                const Submesh* submeshes = At<Submesh>(mesh.submeshes);
+                for (uint32_t s = 0; s < mesh.submeshCount; s++)
+                {
+                    const Submesh& submesh = submeshes[s];
+                    if ((uint64_t)submesh.firstIndex + submesh.indexCount > mesh.indexCount ||
+                        (submesh.material != NO_INDEX && submesh.material >= header.materialCount))
+                    {
+                        return Fail();
+                    }
+                }
+
+                const uint32_t* boneNodes = At<uint32_t>(mesh.boneNodes);
+                for (uint32_t b = 0; b < mesh.boneCount; b++)
+                {
+                    if (boneNodes[b] >= header.nodeCount)
+                        return Fail();
+                }
+            }
+
+            for (uint32_t i = 0; i < header.clipCount; i++)
+            {
+                const Clip& clip = GetClip(i);
+                if (!(clip.sampleRate > 0.0f) || !IsString(clip.name, false) ||
+                    !InRange(clip.tracks, (uint64_t)clip.trackCount * sizeof(Track)))
+                {
+                    return Fail();
+                }
+
+                const Track* tracks = GetTracks(clip);
+                for (uint32_t t = 0; t < clip.trackCount; t++)
+                {
+                    const Track& track = tracks[t];
+                    const uint64_t timeSize = (track.timeFormat == TIME_FRAME16) ? 2 : 4;
+                    const uint64_t valueSize = (track.valueFormat == VALUE_UNORM16) ? 2 : 4;
+
+                    if (track.node >= header.nodeCount || track.channel > CHANNEL_SCALE ||
+                        track.timeFormat > TIME_FLOAT32 || track.valueFormat > VALUE_FLOAT32 ||
+                        track.components < 3 || track.components > 4 ||
+                        !InRange(track.times, track.keyCount * timeSize) ||
+                        !InRange(track.values, (uint64_t)track.keyCount * track.components * valueSize))
+                    {
+                        return Fail();
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        bool IsOpen() const { return m_Data != nullptr; }
+
+        const Header& GetHeader() const { return *At<Header>(0); }
+        const Mesh& GetMesh(uint32_t index) const { return At<Mesh>(GetHeader().meshes)[index]; }
+        const Material& GetMaterial(uint32_t index) const { return At<Material>(GetHeader().materials)[index]; }
+        const Clip& GetClip(uint32_t index) const { return At<Clip>(GetHeader().clips)[index]; }
+        const Track* GetTracks(const Clip& clip) const { return At<Track>(clip.tracks); }
+
+        // String de la tabla (nullptr para NO_INDEX)
+        const char* GetString(uint32_t offset) const
+        {
+            const Header& header = GetHeader();
+            if (offset == NO_INDEX || offset >= header.stringsSize)
+                return nullptr;
+            return reinterpret_cast<const char*>(m_Data + header.strings + offset);
+        }
+
+        // Array en un offset del paquete
+        template<class T>
+        const T* At(uint64_t offset) const
+        {
+            return reinterpret_cast<const T*>(m_Data + offset);
+        }
+
+        // Tiempo de una key en segundos
+        float GetKeyTime(const Clip& clip, const Track& track, uint32_t key) const
+        {
+            if (track.timeFormat == TIME_FRAME16)
+                return At<uint16_t>(track.times)[key] / clip.sampleRate;
+            return At<float>(track.times)[key];
+        }
+
+        // Valor de una key (track.components floats)
+        void GetKeyValue(const Track& track, uint32_t key, float* out) const
+        {
+            const uint32_t first = key * track.components;
+            for (uint32_t c = 0; c < track.components; c++)
+            {
+                if (track.valueFormat == VALUE_UNORM16)
+                    out[c] = track.rangeMin[c] + At<uint16_t>(track.values)[first + c] * (track.rangeExtent[c] / 65535.0f);
+                else
+                    out[c] = At<float>(track.values)[first + c];
+            }
+        }
+
+    private:
+        const uint8_t* m_Data;
+        size_t m_Size;
+
+        bool InRange(uint64_t offset, uint64_t size) const
+        {
+            return offset % ALIGNMENT == 0 && offset <= m_Size && size <= m_Size - offset;
+        }
+
+        // Offset de un string dentro de la tabla (la tabla termina en 0)
+        bool IsString(uint32_t offset, bool optional) const
+        {
+            if (offset == NO_INDEX)
+                return optional;
+            return offset < GetHeader().stringsSize;
+        }
+
+        bool Fail()
+        {
+            m_Data = nullptr;
+            m_Size = 0;
+            return false;
+        }
+    };
+
+    /**
+     * @class MappedPackage
+     * @brief Paquete mapeado en memoria de solo lectura
+     */
+    class MappedPackage
+    {
+    public:
+        MappedPackage() : m_Data(nullptr), m_Size(0)
+#ifdef _WIN32
+            , m_File(INVALID_HANDLE_VALUE), m_Mapping(nullptr)
+#endif
+        {
+        }
+
+        ~MappedPackage() { Close(); }
+
+        MappedPackage(const MappedPackage&) = delete;
+        MappedPackage& operator=(const MappedPackage&) = delete;
+
+        /**
+         * Mapear y validar un paquete
+         * @param filename Archivo .xpkg
+         * @return true si el archivo se mapeó y es un paquete válido
+         */
+        bool Open(const char* filename)
+        {
+            Close();
+
+#ifdef _WIN32
+            m_File = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+            if (m_File == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+            {
+                Close();
+                return false;
+            }
+
+            m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            m_Data = m_Mapping ? MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            m_Size = (size_t)size.QuadPart;
+#else
+            int file = open(filename, O_RDONLY);
+            if (file < 0)
+                return false;
+
+            struct stat info;
+            if (fstat(file, &info) == 0 && info.st_size > 0)
+            {
+                m_Size = (size_t)info.st_size;
+                m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+                if (m_Data == MAP_FAILED)
+                    m_Data = nullptr;
+            }
+            close(file);
+#endif
+
+            if (!m_Data || !m_View.Open(m_Data, m_Size))
+            {
+                Close();
+                return false;
+            }
+            return true;
+        }
+
+        void Close()
+        {
+#ifdef _WIN32
+            if (m_Data)
+                UnmapViewOfFile(m_Data);
+            if (m_Mapping)
+                CloseHandle(m_Mapping);
+            if (m_File != INVALID_HANDLE_VALUE)
+                CloseHandle(m_File);
+            m_Mapping = nullptr;
+            m_File = INVALID_HANDLE_VALUE;
+#else
+            if (m_Data)
+                munmap(m_Data, m_Size);
+#endif
+            m_Data = nullptr;
+            m_Size = 0;
+            m_View = PackageView();
+        }
+
+        const PackageView& View() const { return m_View; }
+
+    private:
+        void* m_Data;
+        size_t m_Size;
+        PackageView m_View;
+#ifdef _WIN32
+        HANDLE m_File;
+        HANDLE m_Mapping;
+#endif
+    };
+}
+
+#endif // RUNTIME_PACKAGE_H
@@ -0,0 +1,302 @@
+#include "AnimationBounds.h"
+#include "PoseBaker.h"
+#include "SimdMath.h"
+
+using namespace SimdMath;
+
+// Frames por tarea paralela
+static const size_t BOUNDS_BLOCK_FRAMES = 32;
+
+// ============================================================================
+// Auxiliares SSE (vectores fila: x, y, z en los carriles 0..2)
+// ============================================================================
+
+// Punto * matriz: x * fila0 + y * fila1 + z * fila2 + fila3
+static inline __m128 TransformPoint(__m128 x, __m128 y, __m128 z, const float* m)
+{
+    __m128 result = MulAdd(x, _mm_loadu_ps(m), _mm_loadu_ps(m + 12));
+    result = MulAdd(y, _mm_loadu_ps(m + 4), result);
+    return MulAdd(z, _mm_loadu_ps(m + 8), result);
+}
+
+// Caja (centro, semiextensión) * matriz, ampliando [boxMin, boxMax]
+// La semiextensión transformada es |e.x| * |fila0| + |e.y| * |fila1| + |e.z| * |fila2|
+static inline void AccumulateTransformedBox(
+    const float* center,
+    const float* extent,
+    const float* m,
+    __m128& boxMin,
+    __m128& boxMax)
+{
+    __m128 c = TransformPoint(Splat(center[0]), Splat(center[1]), Splat(center[2]), m);
+
+    __m128 e = _mm_mul_ps(Splat(extent[0]), Abs(_mm_loadu_ps(m)));
+    e = MulAdd(Splat(extent[1]), Abs(_mm_loadu_ps(m + 4)), e);
+    e = MulAdd(Splat(extent[2]), Abs(_mm_loadu_ps(m + 8)), e);
+
+    boxMin = _mm_min_ps(boxMin, _mm_sub_ps(c, e));
+    boxMax = _mm_max_ps(boxMax, _mm_add_ps(c, e));
+}
+
+static inline D3DXVECTOR3 StoreVector3(__m128 v)
+{
+    float values[4];
+    _mm_storeu_ps(values, v);
+    return D3DXVECTOR3(values[0], values[1], values[2]);
+}
+
+// Convertir una caja DirectX al espacio del FBX exportado (Y-up; el
+// cambio de eje vertical lo rechaza ComputeClipBounds)
+static void ConvertBox(D3DXVECTOR3& boxMin, D3DXVECTOR3& boxMax, const ConversionOptions& options)
+{
+    if (options.targetCoordSystem == CoordinateSystem::RIGHT_HANDED)
+    {
+        // LH -> RH: Z invertida (el mínimo pasa a ser el máximo)
+        float minZ = -boxMax.z;
+        boxMax.z = -boxMin.z;
+        boxMin.z = minZ;
+    }
+
+    if (options.scale != 1.0f)
+    {
+        D3DXVECTOR3 a = boxMin * options.scale;
+        D3DXVECTOR3 b = boxMax * options.scale;
+        boxMin = D3DXVECTOR3(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z));
+        boxMax = D3DXVECTOR3(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z));
+    }
+}
+
+// ============================================================================
+// Cajas por hueso en espacio de hueso
+// ============================================================================
+
+void AnimationBounds::ComputeBoneSpaceBounds(
+    const MeshData& mesh,
+    vector<D3DXVECTOR3>& boneMin,
+    vector<D3DXVECTOR3>& boneMax)
+{
+    const size_t boneCount = mesh.bones.size();
+
+    // Mínimo y máximo de cada hueso (4 floats por hueso, carril 3 sin uso)
+    vector<float> minimums(boneCount * 4, FLT_MAX);
+    vector<float> maximums(boneCount * 4, -FLT_MAX);
+
+    for (const Vertex& vertex : mesh.vertices)
+    {
+        __m128 x = Splat(vertex.position.x);
+        __m128 y = Splat(vertex.position.y);
+        __m128 z = Splat(vertex.position.z);
+
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            DWORD bone = vertex.boneIndices[i];
+            if (vertex.boneWeights[i] <= 0.0f || bone >= boneCount)
+                continue;
+
+            __m128 p = TransformPoint(x, y, z, mesh.bones[bone].offsetMatrix);
+            float* boneMinimum = &minimums[bone * 4];
+            float* boneMaximum = &maximums[bone * 4];
+            _mm_storeu_ps(boneMinimum, _mm_min_ps(_mm_loadu_ps(boneMinimum), p));
+            _mm_storeu_ps(boneMaximum, _mm_max_ps(_mm_loadu_ps(boneMaximum), p));
+        }
+    }
+
+    boneMin.resize(boneCount);
+    boneMax.resize(boneCount);
+    for (size_t b = 0; b < boneCount; b++)
+    {
+        boneMin[b] = D3DXVECTOR3(minimums[b * 4], minimums[b * 4 + 1], minimums[b * 4 + 2]);
+        boneMax[b] = D3DXVECTOR3(maximums[b * 4], maximums[b * 4 + 1], maximums[b * 4 + 2]);
+    }
+}
+
+// ============================================================================
+// Cajas por frame de un clip
+// ============================================================================
+
+bool AnimationBounds::ComputeClipBounds(
+    const AnimationClip& clip,
+    const FrameData* root,
+    const ConversionOptions& options,
+    int numThreads,
+    vector<SkinnedMeshBounds>& out)
+{
+    out.clear();
+
+    if (!root)
+        return false;
+
+    if (options.upAxis != UpAxis::Y_AXIS)
+    {
+        Utils::LogWarning("Animation bounds only support Y-up output; skipped");
+        return false;
+    }
+
+    // ========================================================================
+    // Meshes con skinning de la jerarquía
+    // ========================================================================
+    vector<const FrameData*> frames;
+    vector<int> parents;
+    PoseBaker::FlattenHierarchy(root, frames, parents);
+
+    vector<const MeshData*> meshes;
+    for (const FrameData* frame : frames)
+    {
+        for (const MeshData* mesh : frame->meshes)
+        {
+            if (mesh->hasSkinning && !mesh->bones.empty() && !mesh->vertices.empty())
+                meshes.push_back(mesh);
+        }
+    }
+
+    if (meshes.empty())
+        return false;
+
+    BakedPose pose;
+    if (!PoseBaker::BakeClip(clip, root, options.targetFPS, numThreads, pose))
+        return false;
+
+    // ========================================================================
+    // Cajas de hueso (centro + semiextensión) y hueso de la pose horneada
+    // ========================================================================
+    struct BoneBox
+    {
+        float center[4];
+        float extent[4];
+        int bakedBone;                 // -1 = hueso sin frame (caja fija)
+        D3DXMATRIX restMatrix;         // Inversa del offset (solo si bakedBone < 0)
+    };
+
+    vector<vector<BoneBox>> boneBoxes(meshes.size());
+
+    for (size_t m = 0; m < meshes.size(); m++)
+    {
+        const MeshData* mesh = meshes[m];
+
+        vector<D3DXVECTOR3> boneMin, boneMax;
+        ComputeBoneSpaceBounds(*mesh, boneMin, boneMax);
+
+        for (size_t b = 0; b < mesh->bones.size(); b++)
+        {
+            // Huesos sin vértices no aportan nada
+            if (boneMin[b].x > boneMax[b].x)
+                continue;
+
+            BoneBox box;
+            D3DXVECTOR3 center = (boneMin[b] + boneMax[b]) * 0.5f;
+            D3DXVECTOR3 extent = (boneMax[b] - boneMin[b]) * 0.5f;
+            box.center[0] = center.x; box.center[1] = center.y; box.center[2] = center.z; box.center[3] = 0.0f;
+            box.extent[0] = extent.x; box.extent[1] = extent.y; box.extent[2] = extent.z; box.extent[3] = 0.0f;
+
+            box.bakedBone = pose.FindBone(mesh->bones[b].name);
+            if (box.bakedBone < 0)
+            {
+                // Sin frame no hay animación: los vértices quedan en la pose de enlace
+                Utils::LogWarning("Bone '" + mesh->bones[b].name + "' of mesh '" + mesh->name +
+                                  "' not found in hierarchy (using bind pose bounds)");
+                D3DXMatrixInverse(&box.restMatrix, nullptr, &mesh->bones[b].offsetMatrix);
+            }
+
+            boneBoxes[m].push_back(box);
+        }
+    }
+
+    // ========================================================================
+    // Transformar las cajas de hueso por frame (bloques de frames en paralelo)
+    // ========================================================================
+    out.resize(meshes.size());
+    for (size_t m = 0; m < meshes.size(); m++)
+    {
+        out[m].meshName = meshes[m]->name;
+        out[m].frameMin.resize(pose.frameCount);
+        out[m].frameMax.resize(pose.frameCount);
+    }
+
+    size_t blockCount = (pose.frameCount + BOUNDS_BLOCK_FRAMES - 1) / BOUNDS_BLOCK_FRAMES;
+
+    Utils::ParallelFor(blockCount, numThreads, [&](size_t block)
+    {
+        size_t firstFrame = block * BOUNDS_BLOCK_FRAMES;
+        size_t lastFrame = min(firstFrame + BOUNDS_BLOCK_FRAMES, pose.frameCount);
+
+        for (size_t f = firstFrame; f < lastFrame; f++)
+        {
+            const D3DXMATRIX* globals = pose.Frame(f);
+
+            for (size_t m = 0; m < meshes.size(); m++)
+            {
+                __m128 boxMin = Splat(FLT_MAX);
+                __m128 boxMax = Splat(-FLT_MAX);
+
+                for (const BoneBox& box : boneBoxes[m])
+                {
+                    const D3DXMATRIX& matrix = (box.bakedBone >= 0) ? globals[box.bakedBone] : box.restMatrix;
+                    AccumulateTransformedBox(box.center, box.extent, matrix, boxMin, boxMax);
+                }
+
+                D3DXVECTOR3 frameMin = StoreVector3(boxMin);
+                D3DXVECTOR3 frameMax = StoreVector3(boxMax);
+                ConvertBox(frameMin, frameMax, options);
+
+                out[m].frameMin[f] = frameMin;
+                out[m].frameMax[f] = frameMax;
+            }
+        }
+    });
+
+    // Caja de todo el clip
+    for (SkinnedMeshBounds& bounds : out)
+    {
+        for (size_t f = 0; f < pose.frameCount; f++)
+        {
+            D3DXVec3Minimize(&bounds.clipMin, &bounds.clipMin, &bounds.frameMin[f]);
+            D3DXVec3Maximize(&bounds.clipMax, &bounds.clipMax, &bounds.frameMax[f]);
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Archivo sidecar
+// ============================================================================
+// Formato (texto, una línea por registro):
+//   clip <nombre> fps <fps> frames <n>
+//   mesh <nombre> min <x y z> max <x y z>
+//   frame <i> min <x y z> max <x y z>      (frames del mesh anterior)
+// El frame i corresponde a t = min(i / fps, duración del clip): el último
+// cae en el final del clip aunque no coincida con la rejilla.
+
+bool AnimationBounds::WriteBoundsFile(
+    const string& filename,
+    const AnimationClip& clip,
+    double fps,
+    const vector<SkinnedMeshBounds>& bounds)
+{
+    ofstream file(filename.c_str());
+    if (!file.is_open())
+    {
+        Utils::LogError("Cannot write bounds file: " + filename);
+        return false;
+    }
+
+    size_t frameCount = bounds.empty() ? 0 : bounds[0].frameMin.size();
+
+    file << "clip " << clip.name << " fps " << fps << " frames " << frameCount << "\n";
+
+    for (const SkinnedMeshBounds& mesh : bounds)
+    {
+        file << "mesh " << mesh.meshName
+             << " min " << mesh.clipMin.x << " " << mesh.clipMin.y << " " << mesh.clipMin.z
+             << " max " << mesh.clipMax.x << " " << mesh.clipMax.y << " " << mesh.clipMax.z << "\n";
+
+        for (size_t f = 0; f < mesh.frameMin.size(); f++)
+        {
+            file << "frame " << f
+                 << " min " << mesh.frameMin[f].x << " " << mesh.frameMin[f].y << " " << mesh.frameMin[f].z
+                 << " max " << mesh.frameMax[f].x << " " << mesh.frameMax[f].y << " " << mesh.frameMax[f].z << "\n";
+        }
+    }
+
+    return file.good();
+}
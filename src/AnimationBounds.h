@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef ANIMATION_BOUNDS_H
+#define ANIMATION_BOUNDS_H
+
+#include "../include/Common.h"
+
+/**
+ * @struct SkinnedMeshBounds
+ * @brief AABB de un mesh con skinning durante un clip
+ *
+ * Las cajas están en el espacio del FBX exportado (sistema de coordenadas
+ * y escala global de ConversionOptions). Solo se admite salida Y-up.
+ */
+struct SkinnedMeshBounds
+{
+    string meshName;
+
+    D3DXVECTOR3 clipMin;               // Unión de todos los frames
+    D3DXVECTOR3 clipMax;
+
+    vector<D3DXVECTOR3> frameMin;      // Un elemento por frame
+    vector<D3DXVECTOR3> frameMax;
+
+    SkinnedMeshBounds()
+    {
+        clipMin = D3DXVECTOR3(FLT_MAX, FLT_MAX, FLT_MAX);
+        clipMax = D3DXVECTOR3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    }
+};
+
+/**
+ * @class AnimationBounds
+ * @brief Calcula AABBs conservadoras por frame para meshes con skinning
+ *
+ * No se deforma ningún vértice por frame:
+ *   1. Una vez por mesh, se calcula la caja de los vértices de cada hueso
+ *      en espacio de hueso (vértice * offsetMatrix, solo vértices con peso)
+ *   2. Por frame, cada caja se transforma con la matriz global del hueso
+ *      (PoseBaker) y se unen todas
+ *
+ * Como los pesos están normalizados, el vértice deformado es una
+ * combinación convexa de sus posiciones por hueso y siempre queda dentro
+ * de la unión: la caja es conservadora (puede ser algo más grande que la
+ * real, nunca más pequeña).
+ */
+class AnimationBounds
+{
+public:
+    /**
+     * Calcular las cajas por frame de todos los meshes con skinning
+     * @param clip Clip de animación
+     * @param root Jerarquía de frames (huesos y meshes)
+     * @param options FPS objetivo, sistema de coordenadas y escala
+     * @param numThreads Número de hilos (0 = automático)
+     * @param out [out] Una entrada por mesh con skinning
+     * @return true si hay al menos un mesh con skinning (false si
+     *         options.upAxis no es Y)
+     */
+    static bool ComputeClipBounds(
+        const AnimationClip& clip,
+        const FrameData* root,
+        const ConversionOptions& options,
+        int numThreads,
+        vector<SkinnedMeshBounds>& out);
+
+    /**
+     * Escribir las cajas en un archivo de texto (sidecar del FBX del clip)
+     * @param filename Ruta del archivo
+     * @param clip Clip de animación (nombre)
+     * @param fps Frames por segundo del muestreo
+     * @param bounds Cajas calculadas con ComputeClipBounds
+     * @return true si se escribió correctamente
+     */
+    static bool WriteBoundsFile(
+        const string& filename,
+        const AnimationClip& clip,
+        double fps,
+        const vector<SkinnedMeshBounds>& bounds);
+
+    /**
+     * Caja de los vértices de cada hueso del mesh en espacio de hueso
+     * Los huesos sin vértices quedan vacíos (min = FLT_MAX, max = -FLT_MAX).
+     */
+    static void ComputeBoneSpaceBounds(
+        const MeshData& mesh,
+        vector<D3DXVECTOR3>& boneMin,
+        vector<D3DXVECTOR3>& boneMax);
+};
+
+#endif // ANIMATION_BOUNDS_H
@@ -0,0 +1,741 @@
+#include "AnimationOptimizer.h"
+#include "MatrixConverter.h"
+
+// ============================================================================
+// Error por canal
+// ============================================================================
+
+float AnimationOptimizer::ChannelError(const AnimationKey& a, const AnimationKey& b,
+                                       const AnimationKey& key, BYTE channel)
+{
+    double span = b.time - a.time;
+    float t = (span > 1e-12) ? (float)((key.time - a.time) / span) : 0.0f;
+
+    if (channel == KEY_TRANSLATION)
+    {
+        float dx = a.translation.x + (b.translation.x - a.translation.x) * t - key.translation.x;
+        float dy = a.translation.y + (b.translation.y - a.translation.y) * t - key.translation.y;
+        float dz = a.translation.z + (b.translation.z - a.translation.z) * t - key.translation.z;
+        return sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Escala: diferencia máxima por componente
+    float dx = fabsf(a.scale.x + (b.scale.x - a.scale.x) * t - key.scale.x);
+    float dy = fabsf(a.scale.y + (b.scale.y - a.scale.y) * t - key.scale.y);
+    float dz = fabsf(a.scale.z + (b.scale.z - a.scale.z) * t - key.scale.z);
+    return max(dx, max(dy, dz));
+}
+
+// ============================================================================
+// Diferencia entre dos valores de un canal
+// ============================================================================
+
+float AnimationOptimizer::ChannelDifference(const AnimationKey& a, const AnimationKey& b, BYTE channel)
+{
+    if (channel == KEY_TRANSLATION)
+    {
+        D3DXVECTOR3 d = a.translation - b.translation;
+        return sqrtf(d.x * d.x + d.y * d.y + d.z * d.z);
+    }
+
+    if (channel == KEY_SCALE)
+    {
+        return max(fabsf(a.scale.x - b.scale.x),
+                   max(fabsf(a.scale.y - b.scale.y), fabsf(a.scale.z - b.scale.z)));
+    }
+
+    const D3DXQUATERNION& p = a.rotation;
+    const D3DXQUATERNION& q = b.rotation;
+    float lenSq = (p.x * p.x + p.y * p.y + p.z * p.z + p.w * p.w) *
+                  (q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (lenSq < 1e-24f)
+        return 0.0f;
+
+    float d = fabsf(p.x * q.x + p.y * q.y + p.z * q.z + p.w * q.w) / sqrtf(lenSq);
+    return 2.0f * acosf(min(d, 1.0f)) * (180.0f / (float)D3DX_PI);
+}
+
+// ============================================================================
+// Douglas-Peucker por canal
+// ============================================================================
+
+void AnimationOptimizer::ReduceChannel(const vector<AnimationKey>& keys, BYTE channel,
+                                       float tolerance, vector<BYTE>& keepMask)
+{
+    if (channel == KEY_ROTATION)
+    {
+        ReduceRotationChannel(keys, tolerance, keepMask);
+        return;
+    }
+
+    // Índices de las keys que tienen este canal
+    vector<size_t> indices;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (keys[i].channels & channel)
+            indices.push_back(i);
+    }
+
+    if (indices.size() <= 2)
+    {
+        for (size_t index : indices)
+            keepMask[index] |= channel;
+        return;
+    }
+
+    keepMask[indices.front()] |= channel;
+    keepMask[indices.back()] |= channel;
+
+    // Pila explícita de segmentos [first, last] (posiciones en 'indices')
+    vector<pair<size_t, size_t>> stack;
+    stack.push_back(make_pair((size_t)0, indices.size() - 1));
+
+    while (!stack.empty())
+    {
+        size_t first = stack.back().first;
+        size_t last = stack.back().second;
+        stack.pop_back();
+
+        if (last - first < 2)
+            continue;
+
+        const AnimationKey& a = keys[indices[first]];
+        const AnimationKey& b = keys[indices[last]];
+
+        float maxError = 0.0f;
+        size_t maxIndex = first;
+
+        for (size_t i = first + 1; i < last; i++)
+        {
+            float error = ChannelError(a, b, keys[indices[i]], channel);
+            if (error > maxError)
+            {
+                maxError = error;
+                maxIndex = i;
+            }
+        }
+
+        if (maxError > tolerance)
+        {
+            keepMask[indices[maxIndex]] |= channel;
+            stack.push_back(make_pair(first, maxIndex));
+            stack.push_back(make_pair(maxIndex, last));
+        }
+    }
+}
+
+// ============================================================================
+// Douglas-Peucker de rotaciones sobre la curva Euler exportada
+// ============================================================================
+// Los exportadores FBX convierten las rotaciones conservadas a Euler XYZ
+// (RH, grados), aplican FilterEulerContinuity a esa secuencia e interpolan
+// linealmente cada ángulo. El filtro depende de las keys que quedan, así
+// que la curva se recalcula en cada pasada con las keys conservadas hasta
+// ese momento: en cada segmento se busca la key con mayor ángulo respecto
+// al Euler interpolado (convertido de vuelta a quaternion LH) y se conserva
+// si supera la tolerancia. Termina cuando ningún segmento la supera, es
+// decir, el error está acotado en la curva que realmente se escribe.
+// ============================================================================
+
+void AnimationOptimizer::ReduceRotationChannel(const vector<AnimationKey>& keys, float tolerance,
+                                               vector<BYTE>& keepMask)
+{
+    vector<size_t> indices;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (keys[i].channels & KEY_ROTATION)
+            indices.push_back(i);
+    }
+
+    if (indices.size() <= 2)
+    {
+        for (size_t index : indices)
+            keepMask[index] |= KEY_ROTATION;
+        return;
+    }
+
+    const size_t count = indices.size();
+    const float radiansToDegrees = 180.0f / (float)D3DX_PI;
+
+    // Posiciones (en 'indices') de las keys conservadas, ordenadas
+    vector<BYTE> kept(count, 0);
+    kept.front() = kept.back() = 1;
+
+    vector<size_t> keptPositions;
+    vector<D3DXQUATERNION> keptRotations;
+    vector<float> keptX, keptY, keptZ;
+    vector<size_t> samplePositions;
+    vector<float> sampleX, sampleY, sampleZ;
+    vector<D3DXQUATERNION> sampleRotations;
+
+    for (;;)
+    {
+        keptPositions.clear();
+        keptRotations.clear();
+        for (size_t i = 0; i < count; i++)
+        {
+            if (kept[i])
+            {
+                keptPositions.push_back(i);
+                keptRotations.push_back(keys[indices[i]].rotation);
+            }
+        }
+
+        // Curva Euler tal como la escribirán los exportadores
+        const size_t keptCount = keptPositions.size();
+        keptX.resize(keptCount);
+        keptY.resize(keptCount);
+        keptZ.resize(keptCount);
+        MatrixConverter::ConvertQuaternionsToEuler_LH_to_RH(
+            keptRotations.data(), keptCount, keptX.data(), keptY.data(), keptZ.data());
+        MatrixConverter::FilterEulerContinuity(keptX.data(), keptY.data(), keptZ.data(), keptCount);
+
+        // Euler interpolado en cada key descartada (por lotes)
+        samplePositions.clear();
+        sampleX.clear();
+        sampleY.clear();
+        sampleZ.clear();
+        for (size_t s = 0; s + 1 < keptCount; s++)
+        {
+            const AnimationKey& a = keys[indices[keptPositions[s]]];
+            const AnimationKey& b = keys[indices[keptPositions[s + 1]]];
+            const double span = b.time - a.time;
+
+            for (size_t i = keptPositions[s] + 1; i < keptPositions[s + 1]; i++)
+            {
+                float t = (span > 1e-12) ? (float)((keys[indices[i]].time - a.time) / span) : 0.0f;
+                samplePositions.push_back(i);
+                sampleX.push_back(keptX[s] + (keptX[s + 1] - keptX[s]) * t);
+                sampleY.push_back(keptY[s] + (keptY[s + 1] - keptY[s]) * t);
+                sampleZ.push_back(keptZ[s] + (keptZ[s + 1] - keptZ[s]) * t);
+            }
+        }
+
+        if (samplePositions.empty())
+            break;
+
+        sampleRotations.resize(samplePositions.size());
+        MatrixConverter::ConvertEulerToQuaternions_RH_to_LH(
+            sampleX.data(), sampleY.data(), sampleZ.data(), samplePositions.size(), sampleRotations.data());
+
+        // Peor key de cada segmento (las muestras están ordenadas por segmento)
+        bool added = false;
+        size_t segment = 0;
+        float maxError = 0.0f;
+        size_t maxPosition = 0;
+
+        for (size_t k = 0; k <= samplePositions.size(); k++)
+        {
+            // Cierre del segmento anterior
+            if (k == samplePositions.size() || samplePositions[k] > keptPositions[segment + 1])
+            {
+                if (maxError > tolerance)
+                {
+                    kept[maxPosition] = 1;
+                    added = true;
+                }
+
+                if (k == samplePositions.size())
+                    break;
+
+                while (samplePositions[k] > keptPositions[segment + 1])
+                    segment++;
+                maxError = 0.0f;
+            }
+
+            const D3DXQUATERNION& p = sampleRotations[k];
+            const D3DXQUATERNION& q = keys[indices[samplePositions[k]]].rotation;
+            float lenSq = (p.x * p.x + p.y * p.y + p.z * p.z + p.w * p.w) *
+                          (q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+            float d = (lenSq > 1e-24f) ? fabsf(p.x * q.x + p.y * q.y + p.z * q.z + p.w * q.w) / sqrtf(lenSq) : 1.0f;
+            float error = 2.0f * acosf(min(d, 1.0f)) * radiansToDegrees;
+
+            if (error > maxError)
+            {
+                maxError = error;
+                maxPosition = samplePositions[k];
+            }
+        }
+
+        if (!added)
+            break;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (kept[i])
+            keepMask[indices[i]] |= KEY_ROTATION;
+    }
+}
+
+// ============================================================================
+// Reducir un track
+// ============================================================================
+
+void AnimationOptimizer::ReduceTrack(AnimationTrack& track, const ConversionOptions& options)
+{
+    const vector<AnimationKey>& keys = track.GetKeys();
+    if (keys.size() <= 2)
+        return;
+
+    vector<BYTE> keepMask(keys.size(), 0);
+
+    ReduceChannel(keys, KEY_TRANSLATION, options.keyPositionTolerance, keepMask);
+    ReduceChannel(keys, KEY_ROTATION, options.keyRotationTolerance, keepMask);
+    ReduceChannel(keys, KEY_SCALE, options.keyScaleTolerance, keepMask);
+
+    // Conservar solo las keys con algún canal vivo (array nuevo: las keys
+    // originales pueden estar compartidas con otros tracks)
+    vector<AnimationKey> reduced;
+    reduced.reserve(count_if(keepMask.begin(), keepMask.end(), [](BYTE mask) { return mask != 0; }));
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (keepMask[i] == 0)
+            continue;
+
+        reduced.push_back(keys[i]);
+        reduced.back().channels = keepMask[i];
+    }
+
+    track.SetKeys(std::move(reduced));
+}
+
+// ============================================================================
+// Reducir varios clips (paralelo por track)
+// ============================================================================
+
+void AnimationOptimizer::ReduceClips(vector<AnimationClip>& clips, const ConversionOptions& options)
+{
+    // Aplanar (clip, track) para repartir el trabajo entre hilos por track
+    vector<AnimationTrack*> tracks;
+    vector<size_t> keysBefore(clips.size(), 0);
+
+    for (size_t c = 0; c < clips.size(); c++)
+    {
+        for (AnimationTrack& track : clips[c].tracks)
+        {
+            tracks.push_back(&track);
+            keysBefore[c] += track.GetKeys().size();
+        }
+    }
+
+    // El resultado solo depende de las keys: cada array compartido se reduce una vez
+    vector<size_t> firstTrack;
+    vector<size_t> trackGroup;
+    GroupTracksByKeys(tracks, nullptr, firstTrack, trackGroup);
+
+    Utils::ParallelFor(firstTrack.size(), options.numThreads, [&](size_t g)
+    {
+        ReduceTrack(*tracks[firstTrack[g]], options);
+    });
+
+    for (size_t i = 0; i < tracks.size(); i++)
+        tracks[i]->keyData = tracks[firstTrack[trackGroup[i]]]->keyData;
+    MarkSharedTracks(clips);
+
+    if (options.verbose)
+    {
+        size_t totalBefore = 0;
+        size_t totalAfter = 0;
+
+        for (size_t c = 0; c < clips.size(); c++)
+        {
+            size_t after = 0;
+            for (const AnimationTrack& track : clips[c].tracks)
+                after += track.GetKeys().size();
+
+            cout << "  Reduced '" << clips[c].name << "': "
+                 << keysBefore[c] << " -> " << after << " keys\n";
+
+            totalBefore += keysBefore[c];
+            totalAfter += after;
+        }
+
+        cout << "  Total keys: " << totalBefore << " -> " << totalAfter << "\n";
+    }
+}
+
+// ============================================================================
+// Canales constantes de un track
+// ============================================================================
+
+void AnimationOptimizer::EliminateTrackConstants(AnimationTrack& track, const RestPose& rest,
+                                                 const ConversionOptions& options,
+                                                 size_t& dropped, size_t& collapsed)
+{
+    const BYTE channels[3] = { KEY_TRANSLATION, KEY_ROTATION, KEY_SCALE };
+    const float tolerances[3] =
+    {
+        options.keyPositionTolerance,
+        options.keyRotationTolerance,
+        options.keyScaleTolerance
+    };
+
+    // Copia de trabajo (las keys originales pueden estar compartidas)
+    vector<AnimationKey> keys = track.GetKeys();
+
+    for (int c = 0; c < 3; c++)
+    {
+        BYTE channel = channels[c];
+
+        // Primera key con este canal y verificación de que todas coinciden
+        const AnimationKey* first = nullptr;
+        bool constant = true;
+
+        for (const AnimationKey& key : keys)
+        {
+            if (!(key.channels & channel))
+                continue;
+
+            if (!first)
+                first = &key;
+            else if (ChannelDifference(*first, key, channel) > tolerances[c])
+            {
+                constant = false;
+                break;
+            }
+        }
+
+        if (!first || !constant)
+            continue;
+
+        // Igual a la pose de reposo: eliminar el canal; si no, dejar solo la primera key
+        bool matchesRest = rest.valid && ChannelDifference(*first, rest.key, channel) <= tolerances[c];
+        size_t keysWithChannel = 0;
+
+        for (AnimationKey& key : keys)
+        {
+            if (!(key.channels & channel))
+                continue;
+
+            keysWithChannel++;
+            if (matchesRest || &key != first)
+                key.channels &= ~channel;
+        }
+
+        if (matchesRest)
+            dropped++;
+        else if (keysWithChannel > 1)
+            collapsed++;
+    }
+
+    if (dropped == 0 && collapsed == 0)
+        return;
+
+    // Compactar: eliminar keys sin canales
+    keys.erase(remove_if(keys.begin(), keys.end(),
+        [](const AnimationKey& key) { return key.channels == 0; }), keys.end());
+    keys.shrink_to_fit();
+
+    track.SetKeys(std::move(keys));
+}
+
+// ============================================================================
+// Canales constantes de varios clips (paralelo por track)
+// ============================================================================
+
+void AnimationOptimizer::EliminateConstantChannels(vector<AnimationClip>& clips, const FrameData* rootFrame,
+                                                   const ConversionOptions& options)
+{
+    // ========================================================================
+    // Poses de reposo: descomponer transformMatrix de todos los frames por lotes
+    // ========================================================================
+    vector<const FrameData*> frames;
+    if (rootFrame)
+    {
+        vector<const FrameData*> stack(1, rootFrame);
+        while (!stack.empty())
+        {
+            const FrameData* frame = stack.back();
+            stack.pop_back();
+            frames.push_back(frame);
+
+            for (const FrameData* child : frame->children)
+                stack.push_back(child);
+        }
+    }
+
+    vector<D3DXMATRIX> matrices(frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+        matrices[i] = frames[i]->transformMatrix;
+
+    DecomposedTransforms decomposed;
+    MatrixConverter::DecomposeMatrices(matrices.data(), matrices.size(), decomposed);
+
+    map<string, RestPose> restPoses;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        // Con espejo la descomposición no coincide con los valores Lcl* del nodo
+        if (frames[i]->name.empty() || decomposed.mirrored[i])
+            continue;
+
+        RestPose& rest = restPoses[frames[i]->name];
+        rest.key.translation = decomposed.translations[i];
+        rest.key.rotation = decomposed.rotations[i];
+        rest.key.scale = decomposed.scales[i];
+        rest.valid = true;
+    }
+
+    // ========================================================================
+    // Analizar tracks
+    // ========================================================================
+    vector<AnimationTrack*> tracks;
+    vector<const RestPose*> trackRest;
+    vector<size_t> trackClip;
+    const RestPose noRest;
+
+    for (size_t c = 0; c < clips.size(); c++)
+    {
+        for (AnimationTrack& track : clips[c].tracks)
+        {
+            auto it = restPoses.find(track.boneName);
+            tracks.push_back(&track);
+            trackRest.push_back(it != restPoses.end() ? &it->second : &noRest);
+            trackClip.push_back(c);
+        }
+    }
+
+    // El resultado depende de las keys y de la pose de reposo del hueso:
+    // los tracks que comparten ambas se procesan una sola vez
+    vector<size_t> firstTrack;
+    vector<size_t> trackGroup;
+    GroupTracksByKeys(tracks, &trackRest, firstTrack, trackGroup);
+
+    vector<size_t> groupDropped(firstTrack.size(), 0);
+    vector<size_t> groupCollapsed(firstTrack.size(), 0);
+
+    Utils::ParallelFor(firstTrack.size(), options.numThreads, [&](size_t g)
+    {
+        size_t i = firstTrack[g];
+        EliminateTrackConstants(*tracks[i], *trackRest[i], options, groupDropped[g], groupCollapsed[g]);
+    });
+
+    vector<size_t> dropped(tracks.size(), 0);
+    vector<size_t> collapsed(tracks.size(), 0);
+
+    for (size_t i = 0; i < tracks.size(); i++)
+    {
+        size_t g = trackGroup[i];
+        tracks[i]->keyData = tracks[firstTrack[g]]->keyData;
+        dropped[i] = groupDropped[g];
+        collapsed[i] = groupCollapsed[g];
+    }
+    MarkSharedTracks(clips);
+
+    if (options.verbose)
+    {
+        vector<size_t> clipDropped(clips.size(), 0);
+        vector<size_t> clipCollapsed(clips.size(), 0);
+
+        for (size_t i = 0; i < tracks.size(); i++)
+        {
+            clipDropped[trackClip[i]] += dropped[i];
+            clipCollapsed[trackClip[i]] += collapsed[i];
+        }
+
+        for (size_t c = 0; c < clips.size(); c++)
+        {
+            cout << "  Constant channels in '" << clips[c].name << "': "
+                 << clipDropped[c] << " dropped (rest pose), "
+                 << clipCollapsed[c] << " collapsed to one key ("
+                 << clips[c].tracks.size() * 3 << " channels)\n";
+        }
+    }
+}
+
+// ============================================================================
+// Agrupar tracks con el mismo array de keys
+// ============================================================================
+
+void AnimationOptimizer::GroupTracksByKeys(
+    const vector<AnimationTrack*>& tracks,
+    const vector<const RestPose*>* trackRest,
+    vector<size_t>& firstTrack,
+    vector<size_t>& trackGroup)
+{
+    firstTrack.clear();
+    trackGroup.assign(tracks.size(), 0);
+
+    map<pair<const void*, const void*>, size_t> groups;
+
+    for (size_t i = 0; i < tracks.size(); i++)
+    {
+        // Tracks sin keys no comparten nada (cada uno es su propio grupo)
+        const void* keys = tracks[i]->keyData.get();
+        const void* rest = trackRest ? (const void*)(*trackRest)[i] : nullptr;
+
+        if (keys)
+        {
+            auto it = groups.find(make_pair(keys, rest));
+            if (it != groups.end())
+            {
+                trackGroup[i] = it->second;
+                continue;
+            }
+
+            groups[make_pair(keys, rest)] = firstTrack.size();
+        }
+
+        trackGroup[i] = firstTrack.size();
+        firstTrack.push_back(i);
+    }
+}
+
+// ============================================================================
+// Hash y comparación de keys (solo los canales presentes en cada key)
+// ============================================================================
+// Los valores de los canales ausentes son relleno: dos tracks que solo
+// difieren en ellos se evalúan y exportan igual.
+
+static inline void HashBytes(UINT64& hash, const void* data, size_t size)
+{
+    // FNV-1a 64 bits
+    const BYTE* bytes = (const BYTE*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+UINT64 AnimationOptimizer::HashKeys(const vector<AnimationKey>& keys)
+{
+    UINT64 hash = 14695981039346656037ULL;
+
+    size_t count = keys.size();
+    HashBytes(hash, &count, sizeof(count));
+
+    for (const AnimationKey& key : keys)
+    {
+        HashBytes(hash, &key.time, sizeof(key.time));
+        HashBytes(hash, &key.channels, sizeof(key.channels));
+
+        if (key.channels & KEY_TRANSLATION)
+            HashBytes(hash, &key.translation, sizeof(D3DXVECTOR3));
+        if (key.channels & KEY_ROTATION)
+            HashBytes(hash, &key.rotation, sizeof(D3DXQUATERNION));
+        if (key.channels & KEY_SCALE)
+            HashBytes(hash, &key.scale, sizeof(D3DXVECTOR3));
+    }
+
+    return hash;
+}
+
+bool AnimationOptimizer::SameKeys(const vector<AnimationKey>& a, const vector<AnimationKey>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        const AnimationKey& ka = a[i];
+        const AnimationKey& kb = b[i];
+
+        if (ka.time != kb.time || ka.channels != kb.channels)
+            return false;
+        if ((ka.channels & KEY_TRANSLATION) && memcmp(&ka.translation, &kb.translation, sizeof(D3DXVECTOR3)) != 0)
+            return false;
+        if ((ka.channels & KEY_ROTATION) && memcmp(&ka.rotation, &kb.rotation, sizeof(D3DXQUATERNION)) != 0)
+            return false;
+        if ((ka.channels & KEY_SCALE) && memcmp(&ka.scale, &kb.scale, sizeof(D3DXVECTOR3)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Marcar tracks compartidos
+// ============================================================================
+// Se cuentan los usos de cada array solo entre los tracks de 'clips': las
+// copias de los clips (p. ej. la referencia de --verify) no lo marcan como
+// compartido.
+// ============================================================================
+
+void AnimationOptimizer::MarkSharedTracks(vector<AnimationClip>& clips)
+{
+    map<const vector<AnimationKey>*, size_t> users;
+    for (const AnimationClip& clip : clips)
+    {
+        for (const AnimationTrack& track : clip.tracks)
+        {
+            if (track.keyData)
+                users[track.keyData.get()]++;
+        }
+    }
+
+    for (AnimationClip& clip : clips)
+    {
+        for (AnimationTrack& track : clip.tracks)
+            track.shared = track.keyData && users[track.keyData.get()] > 1;
+    }
+}
+
+// ============================================================================
+// Compartir tracks idénticos entre clips
+// ============================================================================
+
+void AnimationOptimizer::ShareDuplicateTracks(vector<AnimationClip>& clips, const ConversionOptions& options)
+{
+    vector<AnimationTrack*> tracks;
+    for (AnimationClip& clip : clips)
+    {
+        for (AnimationTrack& track : clip.tracks)
+        {
+            if (track.keyData && !track.keyData->empty())
+                tracks.push_back(&track);
+        }
+    }
+
+    // Hash de cada track en paralelo
+    vector<UINT64> hashes(tracks.size());
+    Utils::ParallelFor(tracks.size(), options.numThreads, [&](size_t i)
+    {
+        hashes[i] = HashKeys(*tracks[i]->keyData);
+    });
+
+    // Primer array visto con cada contenido; los siguientes pasan a apuntar a él
+    // (se compara el contenido completo: un hash igual no basta)
+    map<UINT64, vector<shared_ptr<const vector<AnimationKey>>>> unique;
+    size_t sharedTracks = 0;
+    size_t sharedKeys = 0;
+
+    for (size_t i = 0; i < tracks.size(); i++)
+    {
+        vector<shared_ptr<const vector<AnimationKey>>>& candidates = unique[hashes[i]];
+        AnimationTrack& track = *tracks[i];
+
+        bool found = false;
+        for (const shared_ptr<const vector<AnimationKey>>& candidate : candidates)
+        {
+            if (candidate == track.keyData || SameKeys(*candidate, *track.keyData))
+            {
+                if (candidate != track.keyData)
+                {
+                    sharedTracks++;
+                    sharedKeys += track.keyData->size();
+                    track.keyData = candidate;
+                }
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            candidates.push_back(track.keyData);
+    }
+
+    MarkSharedTracks(clips);
+
+    if (options.verbose)
+    {
+        size_t uniqueArrays = 0;
+        for (const auto& entry : unique)
+            uniqueArrays += entry.second.size();
+
+        cout << "  Shared tracks: " << tracks.size() << " tracks -> " << uniqueArrays
+             << " unique key arrays (" << sharedTracks << " tracks, "
+             << sharedKeys << " keys deduplicated)\n";
+    }
+}
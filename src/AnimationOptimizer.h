@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef ANIMATION_OPTIMIZER_H
+#define ANIMATION_OPTIMIZER_H
+
+#include "../include/Common.h"
+
+/**
+ * @class AnimationOptimizer
+ * @brief Reduce el número de keyframes de los tracks de animación
+ *
+ * Aplica Douglas-Peucker por canal (traslación, rotación, escala):
+ *   1. Se conservan la primera y la última key del canal
+ *   2. Se busca la key con mayor error respecto a la interpolación lineal
+ *      entre los extremos del segmento
+ *   3. Si el error supera la tolerancia, se conserva y se subdivide
+ *
+ * Tolerancias (ConversionOptions):
+ *   - keyPositionTolerance: distancia máxima (unidades de la escena)
+ *   - keyRotationTolerance: ángulo máximo (grados)
+ *   - keyScaleTolerance:    diferencia máxima por componente
+ *
+ * Las rotaciones se miden contra la curva que se escribe en el FBX: los
+ * ángulos Euler de las keys conservadas (con el filtro de continuidad de
+ * MatrixConverter) interpolados linealmente, no contra un nlerp de los
+ * quaternions, que difiere cuando la rotación abarca varios ejes.
+ *
+ * Cada canal se reduce por separado: una key que deja de tener canales
+ * en AnimationKey::channels se elimina del track.
+ */
+class AnimationOptimizer
+{
+public:
+    /**
+     * Reducir las keys de un track
+     * @param track Track a modificar
+     * @param options Tolerancias por canal (keyPositionTolerance, etc.)
+     */
+    static void ReduceTrack(AnimationTrack& track, const ConversionOptions& options);
+
+    /**
+     * Reducir las keys de todos los tracks de varios clips en paralelo
+     * @param clips Clips a modificar
+     * @param options Tolerancias, numThreads y verbose
+     */
+    static void ReduceClips(vector<AnimationClip>& clips, const ConversionOptions& options);
+
+    /**
+     * Eliminar canales constantes de los tracks de varios clips en paralelo
+     *
+     * Un canal es constante si todas sus keys están dentro de la tolerancia
+     * de la primera. Si además coincide con la pose de reposo del hueso
+     * (transformMatrix del frame), se elimina por completo: el exportador
+     * no crea curvas para él. Si no, se colapsa a una sola key.
+     *
+     * @param clips Clips a modificar
+     * @param rootFrame Jerarquía con las poses de reposo (puede ser nullptr)
+     * @param options Tolerancias, numThreads y verbose
+     */
+    static void EliminateConstantChannels(vector<AnimationClip>& clips, const FrameData* rootFrame,
+                                          const ConversionOptions& options);
+
+    /**
+     * Compartir el array de keys entre tracks idénticos de todos los clips
+     *
+     * Se calcula un hash por track (en paralelo) de los canales presentes
+     * en sus keys; los tracks con el mismo hash se comparan completos y,
+     * si coinciden, pasan a apuntar al mismo array (AnimationTrack::keyData).
+     * Los tracks cuyo array usan varios tracks quedan marcados con
+     * AnimationTrack::shared; las etapas siguientes procesan cada array
+     * compartido una sola vez.
+     *
+     * @param clips Clips a modificar
+     * @param options numThreads y verbose
+     */
+    static void ShareDuplicateTracks(vector<AnimationClip>& clips, const ConversionOptions& options);
+
+private:
+    // Pose de reposo de un hueso (espacio DirectX)
+    struct RestPose
+    {
+        AnimationKey key;
+        bool valid;
+
+        RestPose() : valid(false) {}
+    };
+
+    // Error de un valor de canal respecto a otro (distancia, grados o escala)
+    static float ChannelDifference(const AnimationKey& a, const AnimationKey& b, BYTE channel);
+
+    // Colapsar o eliminar los canales constantes de un track
+    static void EliminateTrackConstants(AnimationTrack& track, const RestPose& rest,
+                                        const ConversionOptions& options,
+                                        size_t& dropped, size_t& collapsed);
+
+    // Error de una key respecto a la interpolación entre otras dos
+    // (traslación o escala)
+    static float ChannelError(const AnimationKey& a, const AnimationKey& b,
+                              const AnimationKey& key, BYTE channel);
+
+    // Douglas-Peucker sobre las keys que tienen 'channel'; marca las que se conservan
+    static void ReduceChannel(const vector<AnimationKey>& keys, BYTE channel,
+                              float tolerance, vector<BYTE>& keepMask);
+
+    // Douglas-Peucker de las rotaciones sobre la curva Euler que escriben los
+    // exportadores FBX (interpolación lineal de los ángulos tras el filtro
+    // de continuidad); marca las keys que se conservan
+    static void ReduceRotationChannel(const vector<AnimationKey>& keys, float tolerance,
+                                      vector<BYTE>& keepMask);
+
+    // Agrupar tracks con el mismo keyData (y la misma pose de reposo, si se da)
+    // firstTrack = primer track de cada grupo, trackGroup = grupo de cada track
+    static void GroupTracksByKeys(const vector<AnimationTrack*>& tracks,
+                                  const vector<const RestPose*>* trackRest,
+                                  vector<size_t>& firstTrack,
+                                  vector<size_t>& trackGroup);
+
+    // AnimationTrack::shared = keyData lo usa más de un track de los clips
+    static void MarkSharedTracks(vector<AnimationClip>& clips);
+
+    // Hash y comparación de keys (solo canales presentes)
+    static UINT64 HashKeys(const vector<AnimationKey>& keys);
+    static bool SameKeys(const vector<AnimationKey>& a, const vector<AnimationKey>& b);
+};
+
+#endif // ANIMATION_OPTIMIZER_H
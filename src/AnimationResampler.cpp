@@ -0,0 +1,101 @@
+#include "AnimationResampler.h"
+#include "PoseEvaluator.h"
+
+// ============================================================================
+// Remuestrear un clip
+// ============================================================================
+
+bool AnimationResampler::ResampleClip(AnimationClip& clip, double fps)
+{
+    if (fps <= 0.0 || clip.tracks.empty())
+        return false;
+
+    const size_t trackCount = clip.tracks.size();
+
+    // Un hueso por track; los canales sin keys no se escriben (channels)
+    PoseEvaluator evaluator;
+    evaluator.Initialize(clip);
+
+    double endTime = (clip.duration > 0.0) ? clip.duration : evaluator.GetLastKeyTime();
+    size_t frameCount = GetFrameCount(endTime, fps);
+
+    // ========================================================================
+    // Preparar tracks de salida (una key por frame)
+    // ========================================================================
+    vector<vector<AnimationKey>> newKeys(trackCount);
+    for (size_t i = 0; i < trackCount; i++)
+    {
+        BYTE channels = evaluator.GetChannelMask(i);
+        if (channels == 0)
+            continue;
+
+        newKeys[i].resize(frameCount);
+        for (size_t f = 0; f < frameCount; f++)
+        {
+            newKeys[i][f].time = min((double)f / fps, endTime);
+            newKeys[i][f].channels = channels;
+        }
+    }
+
+    // ========================================================================
+    // Evaluar frame a frame (todos los huesos en lotes SSE)
+    // ========================================================================
+    PoseEvaluationCache cache;
+    LocalPose pose;
+
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        evaluator.Evaluate(min((double)f / fps, endTime), cache, pose);
+
+        for (size_t i = 0; i < trackCount; i++)
+        {
+            if (newKeys[i].empty())
+                continue;
+
+            AnimationKey& key = newKeys[i][f];
+            key.translation = pose.GetTranslation(i);
+            key.rotation = pose.GetRotation(i);
+            key.scale = pose.GetScale(i);
+        }
+    }
+
+    // Reemplazar keys (arrays nuevos: los originales pueden estar compartidos)
+    for (size_t i = 0; i < trackCount; i++)
+        clip.tracks[i].SetKeys(std::move(newKeys[i]));
+
+    clip.duration = endTime;
+    return true;
+}
+
+// ============================================================================
+// Remuestrear varios clips en paralelo
+// ============================================================================
+
+void AnimationResampler::ResampleClips(vector<AnimationClip>& clips, double fps, int numThreads, bool verbose)
+{
+    if (clips.empty())
+        return;
+
+    vector<size_t> keysBefore(clips.size(), 0);
+    vector<size_t> keysAfter(clips.size(), 0);
+
+    Utils::ParallelFor(clips.size(), numThreads, [&](size_t i)
+    {
+        for (const AnimationTrack& track : clips[i].tracks)
+            keysBefore[i] += track.GetKeys().size();
+
+        ResampleClip(clips[i], fps);
+
+        for (const AnimationTrack& track : clips[i].tracks)
+            keysAfter[i] += track.GetKeys().size();
+    });
+
+    if (verbose)
+    {
+        for (size_t i = 0; i < clips.size(); i++)
+        {
+            cout << "  Resampled '" << clips[i].name << "' @ " << fps << " FPS: "
+                 << keysBefore[i] << " -> " << keysAfter[i] << " keys\n";
+        }
+    }
+}
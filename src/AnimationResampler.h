@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef ANIMATION_RESAMPLER_H
+#define ANIMATION_RESAMPLER_H
+
+#include "../include/Common.h"
+#include <cmath>
+
+/**
+ * @class AnimationResampler
+ * @brief Remuestrea clips de animación a una rejilla uniforme de frames
+ *
+ * Los archivos .X guardan keys en tiempos arbitrarios (y a menudo distintos
+ * por canal). El resampler evalúa cada track en t = frame / fps:
+ *   - Traslación y escala: interpolación lineal
+ *   - Rotación: nlerp con corrección de t (aproxima slerp)
+ *
+ * La evaluación la hace PoseEvaluator, frame a frame para TODOS los huesos
+ * del clip a la vez (lotes SSE de 4 huesos). Los clips se procesan en paralelo.
+ *
+ * El resultado son tracks con exactamente una key por frame y solo con los
+ * canales que el track original tenía animados.
+ */
+class AnimationResampler
+{
+public:
+    /**
+     * Remuestrear un clip a la rejilla de frames dada
+     * @param clip Clip a modificar (se reemplazan las keys de sus tracks)
+     * @param fps Frames por segundo de la rejilla
+     * @return true si el clip se remuestreó
+     */
+    static bool ResampleClip(AnimationClip& clip, double fps);
+
+    /**
+     * Remuestrear varios clips en paralelo
+     * @param clips Clips a modificar
+     * @param fps Frames por segundo de la rejilla
+     * @param numThreads Número de hilos (0 = automático)
+     * @param verbose Mostrar estadísticas de keys antes/después
+     */
+    static void ResampleClips(vector<AnimationClip>& clips, double fps, int numThreads, bool verbose);
+
+    /**
+     * Número de frames de la rejilla que cubre [0, endTime]
+     *
+     * Frame f en t = min(f / fps, endTime). Se redondea hacia arriba para que
+     * el último frame caiga exactamente en endTime aunque el clip termine
+     * entre dos frames (habitual en clips .X de 4800 ticks por segundo).
+     * @param endTime Duración del clip en segundos
+     * @param fps Frames por segundo de la rejilla
+     * @return Número de frames (al menos 1)
+     */
+    static size_t GetFrameCount(double endTime, double fps)
+    {
+        return (size_t)max(0.0, ceil(endTime * fps - 1e-6)) + 1;
+    }
+};
+
+#endif // ANIMATION_RESAMPLER_H
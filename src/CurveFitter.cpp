@@ -0,0 +1,152 @@
+#include "CurveFitter.h"
+
+// ============================================================================
+// Evaluación de Hermite
+// ============================================================================
+
+float CurveFitter::EvaluateHermite(const HermiteKey& a, const HermiteKey& b, double time)
+{
+    double span = b.time - a.time;
+    if (span <= 1e-12)
+        return a.value;
+
+    double u = (time - a.time) / span;
+    double u2 = u * u;
+    double u3 = u2 * u;
+
+    // Bases de Hermite (pendientes escaladas por la duración del segmento)
+    double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+    double h10 = u3 - 2.0 * u2 + u;
+    double h01 = -2.0 * u3 + 3.0 * u2;
+    double h11 = u3 - u2;
+
+    return (float)(h00 * a.value + h10 * span * a.slope + h01 * b.value + h11 * span * b.slope);
+}
+
+// ============================================================================
+// Estimación de pendientes
+// ============================================================================
+
+void CurveFitter::EstimateSlopes(
+    const vector<double>& times,
+    const vector<float>& values,
+    vector<float>& slopes)
+{
+    size_t count = values.size();
+    slopes.assign(count, 0.0f);
+
+    if (count < 2)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t prev = (i > 0) ? i - 1 : i;
+        size_t next = (i + 1 < count) ? i + 1 : i;
+
+        double span = times[next] - times[prev];
+        if (span > 1e-12)
+            slopes[i] = (float)((values[next] - values[prev]) / span);
+    }
+}
+
+// ============================================================================
+// Verificación de un segmento
+// ============================================================================
+
+bool CurveFitter::SegmentFits(
+    const vector<double>& times,
+    const vector<float>& values,
+    const vector<float>& slopes,
+    size_t first,
+    size_t last,
+    float tolerance)
+{
+    HermiteKey a, b;
+    a.time = times[first];
+    a.value = values[first];
+    a.slope = slopes[first];
+    b.time = times[last];
+    b.value = values[last];
+    b.slope = slopes[last];
+
+    for (size_t i = first + 1; i < last; i++)
+    {
+        if (fabsf(EvaluateHermite(a, b, times[i]) - values[i]) > tolerance)
+            return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Ajuste de un canal
+// ============================================================================
+
+void CurveFitter::FitHermite(
+    const vector<double>& times,
+    const vector<float>& values,
+    float tolerance,
+    vector<HermiteKey>& keys)
+{
+    keys.clear();
+
+    size_t count = values.size();
+    if (count == 0)
+        return;
+
+    vector<float> slopes;
+    EstimateSlopes(times, values, slopes);
+
+    auto addKey = [&](size_t index)
+    {
+        HermiteKey key;
+        key.time = times[index];
+        key.value = values[index];
+        key.slope = slopes[index];
+        keys.push_back(key);
+    };
+
+    addKey(0);
+
+    size_t start = 0;
+    while (start + 1 < count)
+    {
+        // Búsqueda exponencial: duplicar el largo mientras el segmento ajuste
+        size_t good = start + 1;
+        size_t bad = count;
+        size_t step = 2;
+
+        while (start + step < count)
+        {
+            if (!SegmentFits(times, values, slopes, start, start + step, tolerance))
+            {
+                bad = start + step;
+                break;
+            }
+            good = start + step;
+            step *= 2;
+        }
+
+        // Probar el final de la curva si la búsqueda no llegó hasta él
+        if (bad == count && good != count - 1)
+        {
+            if (SegmentFits(times, values, slopes, start, count - 1, tolerance))
+                good = count - 1;
+            else
+                bad = count - 1;
+        }
+
+        // Búsqueda binaria entre el último largo válido y el primero inválido
+        while (bad - good > 1)
+        {
+            size_t mid = good + (bad - good) / 2;
+            if (SegmentFits(times, values, slopes, start, mid, tolerance))
+                good = mid;
+            else
+                bad = mid;
+        }
+
+        addKey(good);
+        start = good;
+    }
+}
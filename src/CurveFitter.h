@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef CURVE_FITTER_H
+#define CURVE_FITTER_H
+
+#include "../include/Common.h"
+
+/**
+ * @struct HermiteKey
+ * @brief Key de una curva cúbica de Hermite (valor + pendiente)
+ *
+ * La pendiente está en unidades por segundo, igual que las derivadas
+ * de FbxAnimCurve con tangentes de usuario.
+ */
+struct HermiteKey
+{
+    double time;
+    float value;
+    float slope;
+
+    HermiteKey() : time(0.0), value(0.0f), slope(0.0f) {}
+};
+
+/**
+ * @class CurveFitter
+ * @brief Ajusta segmentos cúbicos de Hermite a canales escalares muestreados
+ *
+ * Entrada: muestras densas (tiempo, valor) de un componente de animación.
+ * Salida: un subconjunto de keys con pendientes tales que la curva de
+ * Hermite entre keys consecutivas reproduce TODAS las muestras originales
+ * dentro de la tolerancia.
+ *
+ * Las pendientes se estiman con diferencias centrales sobre las muestras
+ * originales; cada segmento se extiende lo máximo posible (búsqueda
+ * exponencial + binaria) mientras siga dentro de la tolerancia.
+ */
+class CurveFitter
+{
+public:
+    /**
+     * Ajustar un canal escalar
+     * @param times Tiempos de las muestras (en segundos, crecientes)
+     * @param values Valores de las muestras
+     * @param tolerance Error absoluto máximo permitido
+     * @param keys [out] Keys de Hermite resultantes
+     */
+    static void FitHermite(
+        const vector<double>& times,
+        const vector<float>& values,
+        float tolerance,
+        vector<HermiteKey>& keys);
+
+    /**
+     * Evaluar el segmento de Hermite entre dos keys
+     * @param a Key inicial
+     * @param b Key final
+     * @param time Tiempo a evaluar (entre a.time y b.time)
+     * @return Valor interpolado
+     */
+    static float EvaluateHermite(const HermiteKey& a, const HermiteKey& b, double time);
+
+private:
+    // Pendiente por muestra (diferencias centrales, laterales en los extremos)
+    static void EstimateSlopes(
+        const vector<double>& times,
+        const vector<float>& values,
+        vector<float>& slopes);
+
+    // ¿El segmento [first, last] reproduce las muestras intermedias?
+    static bool SegmentFits(
+        const vector<double>& times,
+        const vector<float>& values,
+        const vector<float>& slopes,
+        size_t first,
+        size_t last,
+        float tolerance);
+};
+
+#endif // CURVE_FITTER_H
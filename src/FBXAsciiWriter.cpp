@@ -0,0 +1,373 @@
+#include "FBXAsciiWriter.h"
+#include <charconv>
+#include <cstring>
+
+// Bytes acumulados antes de volcar el buffer al archivo
+static const size_t FLUSH_THRESHOLD = 1 << 20;
+
+// Valores por línea de un array (múltiplo de 2, 3 y 4: UVs, posiciones y colores)
+static const size_t ARRAY_VALUES_PER_LINE = 12;
+
+static const char BASE64_CHARS[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+FBXAsciiWriter::FBXAsciiWriter()
+    : m_BaseDepth(0)
+    , m_IsFragment(false)
+    , m_Failed(false)
+{
+}
+
+FBXAsciiWriter::~FBXAsciiWriter()
+{
+    if (m_File.is_open())
+        m_File.close();
+}
+
+// ============================================================================
+// Archivo
+// ============================================================================
+
+bool FBXAsciiWriter::Open(const std::string& filename, uint32_t version)
+{
+    m_Buffer.clear();
+    m_Buffer.reserve(FLUSH_THRESHOLD * 2);
+    m_Stack.clear();
+    m_Failed = false;
+    m_LastError.clear();
+
+    // Binario para que los saltos de línea sean '\n' en todas las plataformas
+    m_File.open(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!m_File.is_open())
+    {
+        m_LastError = "Cannot create file: " + filename;
+        m_Failed = true;
+        return false;
+    }
+
+    Write((version >= 7500) ? "; FBX 7.5.0 project file\n" : "; FBX 7.4.0 project file\n");
+    Write("; ----------------------------------------------------\n\n");
+    return true;
+}
+
+bool FBXAsciiWriter::Close()
+{
+    if (!m_File.is_open())
+        return false;
+
+    if (!m_Stack.empty())
+    {
+        m_LastError = "Unclosed FBX node at end of file";
+        m_Failed = true;
+    }
+
+    Flush();
+    m_File.close();
+
+    if (m_File.fail() && m_LastError.empty())
+    {
+        m_LastError = "Error writing FBX file";
+        m_Failed = true;
+    }
+
+    return !m_Failed;
+}
+
+// ============================================================================
+// Salida con buffer
+// ============================================================================
+
+void FBXAsciiWriter::Write(const char* text, size_t length)
+{
+    // Bloques grandes (fragmentos): volcar lo pendiente y escribir directamente
+    if (length >= FLUSH_THRESHOLD && !m_IsFragment)
+    {
+        Flush();
+        m_File.write(text, (std::streamsize)length);
+        return;
+    }
+
+    m_Buffer.insert(m_Buffer.end(), text, text + length);
+
+    if (m_Buffer.size() >= FLUSH_THRESHOLD && !m_IsFragment)
+        Flush();
+}
+
+void FBXAsciiWriter::Write(const char* text)
+{
+    Write(text, strlen(text));
+}
+
+void FBXAsciiWriter::WriteIndent(size_t depth)
+{
+    m_Buffer.insert(m_Buffer.end(), depth, '\t');
+}
+
+void FBXAsciiWriter::Flush()
+{
+    if (m_Buffer.empty())
+        return;
+
+    m_File.write(m_Buffer.data(), (std::streamsize)m_Buffer.size());
+    m_Buffer.clear();
+}
+
+template<class T>
+void FBXAsciiWriter::WriteNumber(T value)
+{
+    char text[32];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    Write(text, (size_t)(result.ptr - text));
+}
+
+void FBXAsciiWriter::WriteQuoted(const char* data, size_t length)
+{
+    Write("\"", 1);
+
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != '"')
+            continue;
+
+        Write(data + start, i - start);
+        Write("&quot;", 6);
+        start = i + 1;
+    }
+
+    Write(data + start, length - start);
+    Write("\"", 1);
+}
+
+// ============================================================================
+// Nodos
+// ============================================================================
+
+void FBXAsciiWriter::OpenChildren()
+{
+    if (m_Stack.empty())
+        return;
+
+    OpenNode& parent = m_Stack.back();
+    if (!parent.hasChildren)
+    {
+        Write(" {\n", 3);
+        parent.hasChildren = true;
+    }
+}
+
+void FBXAsciiWriter::BeginNode(const char* name)
+{
+    OpenChildren();
+
+    WriteIndent(m_BaseDepth + m_Stack.size());
+    Write(name);
+    Write(":", 1);
+
+    OpenNode node = {};
+    m_Stack.push_back(node);
+}
+
+void FBXAsciiWriter::EndNode()
+{
+    if (m_Stack.empty())
+        return;
+
+    OpenNode node = m_Stack.back();
+    m_Stack.pop_back();
+
+    size_t depth = m_BaseDepth + m_Stack.size();
+
+    if (node.hasChildren)
+    {
+        WriteIndent(depth);
+        Write("}\n", 2);
+    }
+    else if (node.propertyCount == 0)
+    {
+        // Nodo vacío: bloque sin hijos
+        Write(" {\n", 3);
+        WriteIndent(depth);
+        Write("}\n", 2);
+    }
+    else
+    {
+        Write("\n", 1);
+    }
+
+    // Línea en blanco entre secciones de primer nivel
+    if (depth == 0)
+        Write("\n", 1);
+}
+
+void FBXAsciiWriter::BeginProperty()
+{
+    OpenNode& node = m_Stack.back();
+    Write(node.propertyCount == 0 ? " " : ", ");
+    node.propertyCount++;
+}
+
+// ============================================================================
+// Propiedades
+// ============================================================================
+
+void FBXAsciiWriter::AddBool(bool value)
+{
+    BeginProperty();
+    Write(value ? "T" : "F", 1);
+}
+
+void FBXAsciiWriter::AddInt32(int32_t value)
+{
+    BeginProperty();
+    WriteNumber(value);
+}
+
+void FBXAsciiWriter::AddInt64(int64_t value)
+{
+    BeginProperty();
+    WriteNumber(value);
+}
+
+void FBXAsciiWriter::AddFloat(float value)
+{
+    BeginProperty();
+    WriteNumber(value);
+}
+
+void FBXAsciiWriter::AddDouble(double value)
+{
+    BeginProperty();
+    WriteNumber(value);
+}
+
+void FBXAsciiWriter::AddString(const char* data, size_t length)
+{
+    BeginProperty();
+    WriteQuoted(data, length);
+}
+
+void FBXAsciiWriter::AddObjectName(const std::string& name, const char* className)
+{
+    std::string fullName = className;
+    fullName += "::";
+    fullName += name;
+    AddString(fullName);
+}
+
+void FBXAsciiWriter::AddRaw(const void* data, size_t size)
+{
+    // Bytes en base64, entre comillas (como el contenido embebido de Video)
+    const unsigned char* bytes = (const unsigned char*)data;
+    std::string encoded;
+    encoded.reserve(((size + 2) / 3) * 4);
+
+    for (size_t i = 0; i < size; i += 3)
+    {
+        uint32_t group = (uint32_t)bytes[i] << 16;
+        if (i + 1 < size) group |= (uint32_t)bytes[i + 1] << 8;
+        if (i + 2 < size) group |= (uint32_t)bytes[i + 2];
+
+        encoded += BASE64_CHARS[(group >> 18) & 0x3f];
+        encoded += BASE64_CHARS[(group >> 12) & 0x3f];
+        encoded += (i + 1 < size) ? BASE64_CHARS[(group >> 6) & 0x3f] : '=';
+        encoded += (i + 2 < size) ? BASE64_CHARS[group & 0x3f] : '=';
+    }
+
+    BeginProperty();
+    WriteQuoted(encoded.data(), encoded.size());
+}
+
+// ============================================================================
+// Arrays
+// ============================================================================
+
+template<class T>
+void FBXAsciiWriter::WriteArray(const T* values, size_t count)
+{
+    size_t depth = m_BaseDepth + m_Stack.size();
+
+    BeginProperty();
+    Write("*", 1);
+    WriteNumber(count);
+    Write(" {\n", 3);
+
+    WriteIndent(depth);
+    Write("a: ", 3);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            Write(",", 1);
+            if (i % ARRAY_VALUES_PER_LINE == 0)
+            {
+                Write("\n", 1);
+                WriteIndent(depth);
+                Write("   ", 3);
+            }
+        }
+        WriteNumber(values[i]);
+    }
+
+    Write("\n", 1);
+    WriteIndent(depth - 1);
+    Write("}", 1);
+}
+
+void FBXAsciiWriter::AddInt32Array(const int32_t* values, size_t count)
+{
+    WriteArray(values, count);
+}
+
+void FBXAsciiWriter::AddInt64Array(const int64_t* values, size_t count)
+{
+    WriteArray(values, count);
+}
+
+void FBXAsciiWriter::AddFloatArray(const float* values, size_t count)
+{
+    WriteArray(values, count);
+}
+
+void FBXAsciiWriter::AddDoubleArray(const double* values, size_t count)
+{
+    WriteArray(values, count);
+}
+
+// ============================================================================
+// Fragmentos
+// ============================================================================
+
+std::unique_ptr<FBXRecordWriter> FBXAsciiWriter::CreateFragment() const
+{
+    std::unique_ptr<FBXAsciiWriter> fragment(new FBXAsciiWriter());
+    fragment->m_IsFragment = true;
+    fragment->m_BaseDepth = m_BaseDepth + m_Stack.size();
+    return std::unique_ptr<FBXRecordWriter>(fragment.release());
+}
+
+void FBXAsciiWriter::AppendFragments(std::vector<std::unique_ptr<FBXRecordWriter>>& fragments)
+{
+    bool hasNodes = false;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        FBXAsciiWriter* fragment = static_cast<FBXAsciiWriter*>(fragments[i].get());
+        hasNodes = hasNodes || !fragment->m_Buffer.empty();
+    }
+
+    if (hasNodes)
+        OpenChildren();
+
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        FBXAsciiWriter* fragment = static_cast<FBXAsciiWriter*>(fragments[i].get());
+        Write(fragment->m_Buffer.data(), fragment->m_Buffer.size());
+        fragment->m_Buffer.clear();
+        fragment->m_Buffer.shrink_to_fit();
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef FBX_ASCII_WRITER_H
+#define FBX_ASCII_WRITER_H
+
+#include "FBXRecordWriter.h"
+#include <fstream>
+#include <vector>
+
+/**
+ * @class FBXAsciiWriter
+ * @brief Escribe nodos FBX en formato ASCII (FBX 7.4/7.5, "project file")
+ *
+ * Misma secuencia de nodos que FBXBinaryWriter, en texto:
+ *
+ *   Model: 1000, "Model::Hips", "LimbNode" {
+ *       Version: 232
+ *       Properties70:  {
+ *           P: "Lcl Translation", "Lcl Translation", "", "A",0,1.5,0
+ *       }
+ *   }
+ *
+ * Los arrays se escriben como "*N { a: v,v,... }" con un número fijo de
+ * valores por línea, para que un cambio en un vértice solo cambie su línea
+ * en un diff. Los números usan std::to_chars (representación más corta que
+ * se lee de vuelta al mismo valor), sin iostream ni locale; el texto se
+ * acumula en un buffer que se vuelca al archivo por bloques.
+ *
+ * Los fragmentos son buffers de texto con la indentación del nodo padre;
+ * al agregarlos solo se copian en orden.
+ *
+ * Solo depende de la biblioteca estándar.
+ */
+class FBXAsciiWriter : public FBXRecordWriter
+{
+public:
+    FBXAsciiWriter();
+    ~FBXAsciiWriter();
+
+    /**
+     * Crear el archivo y escribir el encabezado de comentarios
+     * @param filename Archivo de salida
+     * @param version 7400 o 7500
+     * @return true si se pudo crear el archivo
+     */
+    bool Open(const std::string& filename, uint32_t version = 7400);
+
+    /**
+     * Volcar lo pendiente y cerrar el archivo
+     * @return true si todo el archivo se escribió correctamente
+     */
+    bool Close();
+
+    /**
+     * Obtener último mensaje de error
+     */
+    const std::string& GetLastError() const { return m_LastError; }
+
+    // FBXRecordWriter
+    void BeginNode(const char* name) override;
+    void EndNode() override;
+
+    void AddBool(bool value) override;
+    void AddInt32(int32_t value) override;
+    void AddInt64(int64_t value) override;
+    void AddFloat(float value) override;
+    void AddDouble(double value) override;
+    void AddString(const char* data, size_t length) override;
+    void AddObjectName(const std::string& name, const char* className) override;
+    void AddRaw(const void* data, size_t size) override;
+
+    void AddInt32Array(const int32_t* values, size_t count) override;
+    void AddInt64Array(const int64_t* values, size_t count) override;
+    void AddFloatArray(const float* values, size_t count) override;
+    void AddDoubleArray(const double* values, size_t count) override;
+
+    std::unique_ptr<FBXRecordWriter> CreateFragment() const override;
+    void AppendFragments(std::vector<std::unique_ptr<FBXRecordWriter>>& fragments) override;
+
+    using FBXRecordWriter::AddString;
+
+private:
+    // Nodo abierto
+    struct OpenNode
+    {
+        size_t propertyCount;
+        bool hasChildren;       // Ya se escribió " {" y su primer hijo
+    };
+
+    std::ofstream m_File;
+    std::vector<char> m_Buffer;     // Texto aún no volcado al archivo
+    std::vector<OpenNode> m_Stack;
+    size_t m_BaseDepth;             // Indentación de los nodos de primer nivel
+    bool m_IsFragment;
+    bool m_Failed;
+    std::string m_LastError;
+
+    void Write(const char* text, size_t length);
+    void Write(const char* text);
+    void WriteIndent(size_t depth);
+    void Flush();
+
+    // Número con std::to_chars (enteros o la forma más corta de float/double)
+    template<class T>
+    void WriteNumber(T value);
+
+    // String entre comillas; las comillas internas como &quot;
+    void WriteQuoted(const char* data, size_t length);
+
+    // Separador antes de la siguiente propiedad del nodo abierto
+    void BeginProperty();
+
+    // Abrir el bloque de hijos del nodo actual si todavía no se abrió
+    void OpenChildren();
+
+    // Array: "*N {", línea(s) "a: ..." y "}"
+    template<class T>
+    void WriteArray(const T* values, size_t count);
+};
+
+#endif // FBX_ASCII_WRITER_H
@@ -0,0 +1,621 @@
+#include "FBXBinaryWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <zlib.h>
+
+// Bytes acumulados antes de volcar el buffer al archivo
+static const size_t FLUSH_THRESHOLD = 1 << 20;
+
+// Bytes de array que se comprimen como un bloque independiente
+static const size_t COMPRESSION_BLOCK_SIZE = 256 * 1024;
+
+// Ventana de deflate: cada bloque usa como diccionario el final del anterior
+static const size_t DEFLATE_WINDOW = 32 * 1024;
+
+// ============================================================================
+// Constantes del formato
+// ============================================================================
+
+// "Kaydara FBX Binary  " + '\0' + 0x1A 0x00
+static const char FBX_BINARY_MAGIC[23] =
+{
+    'K', 'a', 'y', 'd', 'a', 'r', 'a', ' ', 'F', 'B', 'X', ' ',
+    'B', 'i', 'n', 'a', 'r', 'y', ' ', ' ', '\0', '\x1a', '\0'
+};
+
+// Identificador del pie; corresponde al FileId/CreationTime fijos que
+// escribe NativeFBXExporter (los mismos valores que usan otros escritores)
+static const unsigned char FBX_FOOTER_ID[16] =
+{
+    0xfa, 0xbc, 0xab, 0x09, 0xd0, 0xc8, 0xd4, 0x66,
+    0xb1, 0x76, 0xfb, 0x83, 0x1c, 0xf7, 0x26, 0x7e
+};
+
+static const unsigned char FBX_FOOTER_MAGIC[16] =
+{
+    0xf8, 0x5a, 0x8c, 0x6a, 0xde, 0xf5, 0xd9, 0x7e,
+    0xec, 0xe9, 0x0c, 0xe3, 0x75, 0x8f, 0x29, 0x0b
+};
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+FBXBinaryWriter::FBXBinaryWriter()
+    : m_FlushedBytes(0)
+    , m_Version(7400)
+    , m_CompressionLevel(0)
+    , m_CompressionThreshold(0)
+    , m_NumThreads(1)
+    , m_Failed(false)
+    , m_IsFragment(false)
+{
+}
+
+FBXBinaryWriter::~FBXBinaryWriter()
+{
+    if (m_File.is_open())
+        m_File.close();
+}
+
+// ============================================================================
+// Archivo
+// ============================================================================
+
+bool FBXBinaryWriter::Open(const std::string& filename, uint32_t version)
+{
+    m_Version = (version >= 7500) ? 7500 : 7400;
+    m_Buffer.clear();
+    m_Buffer.reserve(FLUSH_THRESHOLD * 2);
+    m_FlushedBytes = 0;
+    m_Stack.clear();
+    m_Failed = false;
+    m_LastError.clear();
+
+    m_File.open(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!m_File.is_open())
+    {
+        m_LastError = "Cannot create file: " + filename;
+        m_Failed = true;
+        return false;
+    }
+
+    Write(FBX_BINARY_MAGIC, sizeof(FBX_BINARY_MAGIC));
+    WriteValue<uint32_t>(m_Version);
+    return true;
+}
+
+void FBXBinaryWriter::SetCompression(int level, size_t threshold, int numThreads)
+{
+    m_CompressionLevel = std::max(0, std::min(level, 9));
+    m_CompressionThreshold = threshold;
+    m_NumThreads = numThreads;
+}
+
+bool FBXBinaryWriter::Close()
+{
+    if (!m_File.is_open())
+        return false;
+
+    if (!m_Stack.empty())
+    {
+        m_LastError = "Unclosed FBX node at end of file";
+        m_Failed = true;
+    }
+
+    // Terminador de la lista de nodos de primer nivel
+    WriteZeros(HeaderSize());
+
+    // Pie: id, 4 ceros, relleno hasta múltiplo de 16 (16 si ya está alineado),
+    // versión, 120 ceros y magic final
+    Write(FBX_FOOTER_ID, sizeof(FBX_FOOTER_ID));
+    WriteZeros(4);
+
+    size_t padding = (size_t)(((Tell() + 15) & ~(uint64_t)15) - Tell());
+    WriteZeros(padding == 0 ? 16 : padding);
+
+    WriteValue<uint32_t>(m_Version);
+    WriteZeros(120);
+    Write(FBX_FOOTER_MAGIC, sizeof(FBX_FOOTER_MAGIC));
+
+    Flush();
+    m_File.close();
+
+    if (m_File.fail() && m_LastError.empty())
+    {
+        m_LastError = "Error writing FBX file";
+        m_Failed = true;
+    }
+
+    return !m_Failed;
+}
+
+// ============================================================================
+// Salida con buffer
+// ============================================================================
+
+void FBXBinaryWriter::Write(const void* data, size_t size)
+{
+    // Arrays grandes: volcar lo pendiente y escribir directamente
+    if (size >= FLUSH_THRESHOLD && !m_IsFragment)
+    {
+        Flush();
+        m_File.write((const char*)data, (std::streamsize)size);
+        m_FlushedBytes += size;
+        return;
+    }
+
+    const char* bytes = (const char*)data;
+    m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+
+    if (m_Buffer.size() >= FLUSH_THRESHOLD && !m_IsFragment)
+        Flush();
+}
+
+void FBXBinaryWriter::WriteZeros(size_t count)
+{
+    m_Buffer.resize(m_Buffer.size() + count, 0);
+}
+
+void FBXBinaryWriter::Flush()
+{
+    if (m_Buffer.empty())
+        return;
+
+    m_File.write(m_Buffer.data(), (std::streamsize)m_Buffer.size());
+    m_FlushedBytes += m_Buffer.size();
+    m_Buffer.clear();
+}
+
+void FBXBinaryWriter::Patch(uint64_t offset, const void* data, size_t size)
+{
+    if (offset >= m_FlushedBytes)
+    {
+        // Todavía en el buffer
+        memcpy(&m_Buffer[(size_t)(offset - m_FlushedBytes)], data, size);
+        return;
+    }
+
+    // Ya volcado: sobrescribir en el archivo y volver al final
+    m_File.seekp((std::streamoff)offset);
+    m_File.write((const char*)data, (std::streamsize)size);
+    m_File.seekp((std::streamoff)m_FlushedBytes);
+}
+
+void FBXBinaryWriter::PatchHeaderField(uint64_t offset, uint64_t value)
+{
+    if (m_Version >= 7500)
+    {
+        Patch(offset, &value, sizeof(uint64_t));
+    }
+    else
+    {
+        uint32_t value32 = (uint32_t)value;
+        Patch(offset, &value32, sizeof(uint32_t));
+    }
+}
+
+// ============================================================================
+// Nodos
+// ============================================================================
+// Encabezado de un nodo (7400: campos de 32 bits, 7500: de 64 bits):
+//   EndOffset, NumProperties, PropertyListLen, NameLen (1 byte), Name
+// Los hijos van después de las propiedades, seguidos de un registro nulo
+// (encabezado lleno de ceros).
+
+void FBXBinaryWriter::BeginNode(const char* name)
+{
+    if (!m_Stack.empty())
+    {
+        OpenNode& parent = m_Stack.back();
+        FinishProperties(parent);
+        parent.hasChildren = true;
+    }
+
+    size_t nameLength = strlen(name);
+    if (nameLength > 255)
+        nameLength = 255;
+
+    OpenNode node;
+    node.headerOffset = Tell();
+    node.propertyCount = 0;
+    node.propertiesDone = false;
+    node.hasChildren = false;
+
+    // El SDK cierra estos nodos con terminador aunque no tengan hijos
+    node.alwaysTerminate = (strcmp(name, "AnimationStack") == 0 || strcmp(name, "AnimationLayer") == 0);
+
+    WriteZeros(HeaderSize() - 1);
+    WriteValue<uint8_t>((uint8_t)nameLength);
+    Write(name, nameLength);
+
+    node.propertyStart = Tell();
+    m_Stack.push_back(node);
+}
+
+void FBXBinaryWriter::EndNode()
+{
+    if (m_Stack.empty())
+    {
+        m_LastError = "EndNode without BeginNode";
+        m_Failed = true;
+        return;
+    }
+
+    OpenNode& node = m_Stack.back();
+    FinishProperties(node);
+
+    if (node.hasChildren || node.propertyCount == 0 || node.alwaysTerminate)
+        WriteZeros(HeaderSize());
+
+    PatchHeaderField(node.headerOffset, Tell());
+    if (m_IsFragment)
+        m_EndOffsetFields.push_back(node.headerOffset);
+    m_Stack.pop_back();
+}
+
+void FBXBinaryWriter::FinishProperties(OpenNode& node)
+{
+    if (node.propertiesDone)
+        return;
+
+    size_t fieldSize = (m_Version >= 7500) ? 8 : 4;
+    PatchHeaderField(node.headerOffset + fieldSize, node.propertyCount);
+    PatchHeaderField(node.headerOffset + fieldSize * 2, Tell() - node.propertyStart);
+    node.propertiesDone = true;
+}
+
+// ============================================================================
+// Fragmentos
+// ============================================================================
+// Los nodos de cada fragmento se serializan en su propio buffer (en otro
+// hilo) como si empezaran en la posición 0. Al agregarlos se conocen sus
+// posiciones reales: se corrigen los EndOffset y los buffers se escriben
+// directamente en el archivo, uno detrás de otro, sin copiarlos al buffer
+// de salida.
+// ============================================================================
+
+std::unique_ptr<FBXRecordWriter> FBXBinaryWriter::CreateFragment() const
+{
+    std::unique_ptr<FBXBinaryWriter> fragment(new FBXBinaryWriter());
+    fragment->m_Version = m_Version;
+    fragment->m_IsFragment = true;
+
+    // Los fragmentos ya se serializan en paralelo: cada uno comprime en su hilo
+    fragment->SetCompression(m_CompressionLevel, m_CompressionThreshold, 1);
+
+    return std::unique_ptr<FBXRecordWriter>(fragment.release());
+}
+
+void FBXBinaryWriter::AppendFragments(std::vector<std::unique_ptr<FBXRecordWriter>>& fragments)
+{
+    if (m_Stack.empty())
+    {
+        m_LastError = "FBX fragments appended outside a node";
+        m_Failed = true;
+        return;
+    }
+
+    OpenNode& parent = m_Stack.back();
+    FinishProperties(parent);
+
+    // Las posiciones finales dependen del tamaño de los fragmentos anteriores
+    uint64_t base = Tell();
+    for (std::unique_ptr<FBXRecordWriter>& writer : fragments)
+    {
+        FBXBinaryWriter* fragment = static_cast<FBXBinaryWriter*>(writer.get());
+        if (!fragment->m_Stack.empty() || fragment->m_Failed)
+        {
+            m_LastError = fragment->m_LastError.empty() ? "Unclosed node in FBX fragment" : fragment->m_LastError;
+            m_Failed = true;
+            return;
+        }
+
+        fragment->Relocate(base);
+        base += fragment->m_Buffer.size();
+
+        if (!fragment->m_Buffer.empty())
+            parent.hasChildren = true;
+    }
+
+    if (m_IsFragment)
+    {
+        for (std::unique_ptr<FBXRecordWriter>& writer : fragments)
+        {
+            FBXBinaryWriter* fragment = static_cast<FBXBinaryWriter*>(writer.get());
+            for (uint64_t field : fragment->m_EndOffsetFields)
+                m_EndOffsetFields.push_back(field);
+            Write(fragment->m_Buffer.data(), fragment->m_Buffer.size());
+        }
+        return;
+    }
+
+    Flush();
+    for (std::unique_ptr<FBXRecordWriter>& writer : fragments)
+    {
+        FBXBinaryWriter* fragment = static_cast<FBXBinaryWriter*>(writer.get());
+        m_File.write(fragment->m_Buffer.data(), (std::streamsize)fragment->m_Buffer.size());
+        m_FlushedBytes += fragment->m_Buffer.size();
+    }
+}
+
+void FBXBinaryWriter::Relocate(uint64_t base)
+{
+    // Las posiciones también pasan a ser relativas al destino (por si el
+    // destino es a su vez un fragmento)
+    for (uint64_t& field : m_EndOffsetFields)
+    {
+        if (m_Version >= 7500)
+        {
+            uint64_t value;
+            memcpy(&value, &m_Buffer[(size_t)field], sizeof(value));
+            value += base;
+            memcpy(&m_Buffer[(size_t)field], &value, sizeof(value));
+        }
+        else
+        {
+            uint32_t value;
+            memcpy(&value, &m_Buffer[(size_t)field], sizeof(value));
+            value += (uint32_t)base;
+            memcpy(&m_Buffer[(size_t)field], &value, sizeof(value));
+        }
+
+        field += base;
+    }
+}
+
+// ============================================================================
+// Propiedades
+// ============================================================================
+
+void FBXBinaryWriter::BeginProperty(char type)
+{
+    if (m_Stack.empty() || m_Stack.back().propertiesDone)
+    {
+        m_LastError = "FBX property written outside its node";
+        m_Failed = true;
+        return;
+    }
+
+    m_Stack.back().propertyCount++;
+    WriteValue<char>(type);
+}
+
+void FBXBinaryWriter::AddBool(bool value)
+{
+    BeginProperty('C');
+    WriteValue<uint8_t>(value ? 1 : 0);
+}
+
+void FBXBinaryWriter::AddInt32(int32_t value)
+{
+    BeginProperty('I');
+    WriteValue<int32_t>(value);
+}
+
+void FBXBinaryWriter::AddInt64(int64_t value)
+{
+    BeginProperty('L');
+    WriteValue<int64_t>(value);
+}
+
+void FBXBinaryWriter::AddFloat(float value)
+{
+    BeginProperty('F');
+    WriteValue<float>(value);
+}
+
+void FBXBinaryWriter::AddDouble(double value)
+{
+    BeginProperty('D');
+    WriteValue<double>(value);
+}
+
+void FBXBinaryWriter::AddString(const char* data, size_t length)
+{
+    BeginProperty('S');
+    WriteValue<uint32_t>((uint32_t)length);
+    Write(data, length);
+}
+
+void FBXBinaryWriter::AddObjectName(const std::string& name, const char* className)
+{
+    // Nombre y clase separados por "\x00\x01"
+    std::string value = name;
+    value.push_back('\0');
+    value.push_back('\x01');
+    value += className;
+    AddString(value.data(), value.size());
+}
+
+void FBXBinaryWriter::AddRaw(const void* data, size_t size)
+{
+    BeginProperty('R');
+    WriteValue<uint32_t>((uint32_t)size);
+    Write(data, size);
+}
+
+void FBXBinaryWriter::WriteArray(char type, const void* values, size_t count, size_t elementSize)
+{
+    size_t byteLength = count * elementSize;
+
+    if (m_CompressionLevel > 0 && byteLength > 0 && byteLength >= m_CompressionThreshold)
+    {
+        // Solo si la compresión reduce el tamaño (datos aleatorios no se comprimen)
+        size_t compressedLength = CompressArray(values, byteLength);
+        if (compressedLength > 0 && compressedLength < byteLength)
+        {
+            BeginProperty(type);
+            WriteValue<uint32_t>((uint32_t)count);
+            WriteValue<uint32_t>(1);                 // zlib
+            WriteValue<uint32_t>((uint32_t)compressedLength);
+
+            for (const std::vector<unsigned char>& block : m_CompressedBlocks)
+                Write(block.data(), block.size());
+            return;
+        }
+    }
+
+    BeginProperty(type);
+    WriteValue<uint32_t>((uint32_t)count);
+    WriteValue<uint32_t>(0);                     // Sin comprimir
+    WriteValue<uint32_t>((uint32_t)byteLength);
+    Write(values, byteLength);
+}
+
+void FBXBinaryWriter::AddInt32Array(const int32_t* values, size_t count)
+{
+    WriteArray('i', values, count, sizeof(int32_t));
+}
+
+void FBXBinaryWriter::AddInt64Array(const int64_t* values, size_t count)
+{
+    WriteArray('l', values, count, sizeof(int64_t));
+}
+
+void FBXBinaryWriter::AddFloatArray(const float* values, size_t count)
+{
+    WriteArray('f', values, count, sizeof(float));
+}
+
+void FBXBinaryWriter::AddDoubleArray(const double* values, size_t count)
+{
+    WriteArray('d', values, count, sizeof(double));
+}
+
+// ============================================================================
+// Compresión de arrays
+// ============================================================================
+// Stream zlib = encabezado (2 bytes) + datos deflate + adler32 (big-endian).
+// Los datos se dividen en bloques de COMPRESSION_BLOCK_SIZE bytes que se
+// comprimen en paralelo como deflate crudo: los bloques intermedios terminan
+// con Z_SYNC_FLUSH (alineados a byte, sin marcar fin de stream) y el último
+// con Z_FINISH, así que concatenados en orden forman un único stream válido.
+// Cada bloque usa los últimos 32 KB del anterior como diccionario, que es
+// el historial que verá el descompresor, para no perder referencias entre
+// bloques. El adler32 de cada bloque se combina al final.
+// ============================================================================
+
+size_t FBXBinaryWriter::CompressArray(const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    const size_t blockCount = (size + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+    const int level = m_CompressionLevel;
+
+    // [0] = encabezado zlib, [1..blockCount] = deflate, [blockCount + 1] = adler32
+    m_CompressedBlocks.resize(blockCount + 2);
+    m_BlockChecksums.resize(blockCount);
+
+    std::atomic<bool> failed(false);
+
+    auto compressBlock = [&](size_t block)
+    {
+        const size_t offset = block * COMPRESSION_BLOCK_SIZE;
+        const size_t length = std::min(COMPRESSION_BLOCK_SIZE, size - offset);
+        const bool last = (block + 1 == blockCount);
+        const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+
+        m_BlockChecksums[block] = adler32(adler32(0, nullptr, 0), bytes + offset, (uInt)length);
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            failed = true;
+            return;
+        }
+
+        if (offset > 0)
+        {
+            size_t dictionaryLength = std::min(DEFLATE_WINDOW, offset);
+            deflateSetDictionary(&stream, bytes + offset - dictionaryLength, (uInt)dictionaryLength);
+        }
+
+        std::vector<unsigned char>& out = m_CompressedBlocks[block + 1];
+        out.resize(deflateBound(&stream, (uLong)length) + 16);
+
+        stream.next_in = (Bytef*)(bytes + offset);
+        stream.avail_in = (uInt)length;
+        stream.next_out = out.data();
+        stream.avail_out = (uInt)out.size();
+
+        // deflateBound alcanza casi siempre; si se llena la salida se agranda
+        int result;
+        for (;;)
+        {
+            result = deflate(&stream, flush);
+
+            bool done = last ? (result == Z_STREAM_END) : (result == Z_OK && stream.avail_out > 0);
+            if (done || (result != Z_OK && result != Z_BUF_ERROR))
+                break;
+
+            size_t used = out.size() - stream.avail_out;
+            out.resize(out.size() * 2);
+            stream.next_out = out.data() + used;
+            stream.avail_out = (uInt)(out.size() - used);
+        }
+
+        if (last ? (result != Z_STREAM_END) : (result != Z_OK))
+            failed = true;
+
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+    };
+
+    size_t workers = (size_t)(m_NumThreads > 0 ? m_NumThreads : (int)std::thread::hardware_concurrency());
+    workers = std::max((size_t)1, std::min(workers, blockCount));
+
+    if (workers <= 1)
+    {
+        for (size_t block = 0; block < blockCount; block++)
+            compressBlock(block);
+    }
+    else
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&]()
+        {
+            for (size_t block = next++; block < blockCount; block = next++)
+                compressBlock(block);
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < workers; t++)
+            threads.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    if (failed)
+        return 0;
+
+    // Encabezado: deflate con ventana de 32 KB y nivel de compresión (FLEVEL)
+    const unsigned char cmf = 0x78;
+    unsigned char flg = (unsigned char)(((level <= 1) ? 0 : (level <= 5) ? 1 : (level == 6) ? 2 : 3) << 6);
+    flg = (unsigned char)(flg + 31 - ((cmf * 256 + flg) % 31));
+    m_CompressedBlocks[0].assign({ cmf, flg });
+
+    unsigned long checksum = m_BlockChecksums[0];
+    for (size_t block = 1; block < blockCount; block++)
+    {
+        size_t length = std::min(COMPRESSION_BLOCK_SIZE, size - block * COMPRESSION_BLOCK_SIZE);
+        checksum = adler32_combine(checksum, m_BlockChecksums[block], (z_off_t)length);
+    }
+
+    m_CompressedBlocks[blockCount + 1].assign(
+    {
+        (unsigned char)(checksum >> 24), (unsigned char)(checksum >> 16),
+        (unsigned char)(checksum >> 8), (unsigned char)checksum
+    });
+
+    size_t total = 0;
+    for (const std::vector<unsigned char>& block : m_CompressedBlocks)
+        total += block.size();
+
+    return total;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#ifndef FBX_BINARY_WRITER_H
+#define FBX_BINARY_WRITER_H
+
+#include "FBXRecordWriter.h"
+#include <fstream>
+#include <vector>
+
+/**
+ * @class FBXBinaryWriter
+ * @brief Escribe nodos FBX en formato binario (versiones 7400 y 7500)
+ *
+ * Los nodos se escriben a medida que llegan, sin construir la escena en
+ * memoria. Cada registro empieza con un encabezado (offset del final del
+ * registro, número de propiedades y tamaño de la lista de propiedades) que
+ * solo se conoce al cerrar el nodo: se reserva al abrirlo y se completa
+ * después, en el buffer de salida si todavía no se volcó o con un seek en
+ * el archivo si ya se volcó.
+ *
+ * FBX 7500 usa offsets de 64 bits en los encabezados; 7400, de 32 bits.
+ * Todos los valores se escriben en little-endian.
+ *
+ * Los arrays a partir de cierto tamaño se comprimen con zlib (encoding 1).
+ * Los arrays grandes se dividen en bloques que se comprimen en paralelo y
+ * se unen en orden en un solo stream zlib (cada bloque termina alineado a
+ * byte y usa los últimos 32 KB del anterior como diccionario).
+ *
+ * Los fragmentos (CreateFragment) son writers en memoria con offsets
+ * relativos al inicio de su buffer; guardan la posición del EndOffset de
+ * cada nodo y al agregarlos (AppendFragments) se les suma su posición
+ * final en el archivo antes de escribir los buffers uno tras otro.
+ *
+ * Solo depende de la biblioteca estándar y de zlib.
+ */
+class FBXBinaryWriter : public FBXRecordWriter
+{
+public:
+    FBXBinaryWriter();
+    ~FBXBinaryWriter();
+
+    /**
+     * Crear el archivo y escribir el encabezado
+     * @param filename Archivo de salida
+     * @param version 7400 o 7500
+     * @return true si se pudo crear el archivo
+     */
+    bool Open(const std::string& filename, uint32_t version = 7400);
+
+    /**
+     * Configurar la compresión de arrays
+     * @param level Nivel de zlib (0 = sin comprimir, 1-9)
+     * @param threshold Tamaño mínimo en bytes de un array comprimido
+     * @param numThreads Hilos para comprimir arrays grandes (0 = todos los núcleos)
+     */
+    void SetCompression(int level, size_t threshold, int numThreads);
+
+    /**
+     * Escribir el terminador y el pie del archivo y cerrarlo
+     * @return true si todo el archivo se escribió correctamente
+     */
+    bool Close();
+
+    /**
+     * Obtener último mensaje de error
+     */
+    const std::string& GetLastError() const { return m_LastError; }
+
+    // FBXRecordWriter
+    void BeginNode(const char* name) override;
+    void EndNode() override;
+
+    void AddBool(bool value) override;
+    void AddInt32(int32_t value) override;
+    void AddInt64(int64_t value) override;
+    void AddFloat(float value) override;
+    void AddDouble(double value) override;
+    void AddString(const char* data, size_t length) override;
+    void AddObjectName(const std::string& name, const char* className) override;
+    void AddRaw(const void* data, size_t size) override;
+
+    void AddInt32Array(const int32_t* values, size_t count) override;
+    void AddInt64Array(const int64_t* values, size_t count) override;
+    void AddFloatArray(const float* values, size_t count) override;
+    void AddDoubleArray(const double* values, size_t count) override;
+
+    std::unique_ptr<FBXRecordWriter> CreateFragment() const override;
+    void AppendFragments(std::vector<std::unique_ptr<FBXRecordWriter>>& fragments) override;
+
+    using FBXRecordWriter::AddString;
+
+private:
+    // Nodo abierto (su encabezado está pendiente de completar)
+    struct OpenNode
+    {
+        uint64_t headerOffset;      // Posición del encabezado en el archivo
+        uint64_t propertyStart;     // Posición de la primera propiedad
+        uint64_t propertyCount;
+        bool propertiesDone;        // Ya se escribió el tamaño de las propiedades
+        bool hasChildren;
+        bool alwaysTerminate;       // Escribir terminador aunque no tenga hijos
+    };
+
+    std::ofstream m_File;
+    std::vector<char> m_Buffer;     // Bytes aún no volcados al archivo
+    uint64_t m_FlushedBytes;        // Bytes ya volcados (posición de m_Buffer[0])
+    uint32_t m_Version;
+    std::vector<OpenNode> m_Stack;
+
+    // Compresión de arrays
+    int m_CompressionLevel;
+    size_t m_CompressionThreshold;
+    int m_NumThreads;
+    std::vector<std::vector<unsigned char>> m_CompressedBlocks;  // Reutilizados entre arrays
+    std::vector<unsigned long> m_BlockChecksums;
+    bool m_Failed;
+    std::string m_LastError;
+
+    // Fragmento: todo queda en m_Buffer, con offsets relativos a su inicio
+    bool m_IsFragment;
+    std::vector<uint64_t> m_EndOffsetFields;    // Posición del EndOffset de cada nodo
+
+    // Posición actual en el archivo
+    uint64_t Tell() const { return m_FlushedBytes + m_Buffer.size(); }
+
+    // Tamaño del encabezado de un nodo (y del terminador)
+    size_t HeaderSize() const { return (m_Version >= 7500) ? 25 : 13; }
+
+    void Write(const void* data, size_t size);
+    void WriteZeros(size_t count);
+    void Flush();
+
+    template<class T>
+    void WriteValue(T value) { Write(&value, sizeof(T)); }
+
+    // Escribir un offset/contador del encabezado (32 o 64 bits según versión)
+    void PatchHeaderField(uint64_t offset, uint64_t value);
+    void Patch(uint64_t offset, const void* data, size_t size);
+
+    // Completar número y tamaño de propiedades del nodo abierto
+    void FinishProperties(OpenNode& node);
+
+    // Encabezado de una propiedad escalar
+    void BeginProperty(char type);
+
+    // Array: tipo, número de elementos, codificación (0 = sin comprimir,
+    // 1 = zlib), tamaño en bytes y datos
+    void WriteArray(char type, const void* values, size_t count, size_t elementSize);
+
+    // Sumar 'base' a los EndOffset de un fragmento
+    void Relocate(uint64_t base);
+
+    // Comprimir los datos en m_CompressedBlocks (stream zlib completo, en orden)
+    // y devolver su tamaño total
+    size_t CompressArray(const void* data, size_t size);
+};
+
+#endif // FBX_BINARY_WRITER_H
@@ -10,6 +10,9 @@ namespace fs = std::filesystem;
 FBXExporter::FBXExporter()
     : m_pManager(nullptr)
     , m_pScene(nullptr)
+    , m_pMaterials(nullptr)
+    , m_FittedSampleCount(0)
+    , m_FittedKeyCount(0)
 {
 }
 
@@ -27,12 +30,13 @@ bool FBXExporter::Initialize()
     // Si ya está inicializado, solo crear una nueva escena
     if (m_pManager)
     {
-        // Destruir escena anterior si existe
+        // Destruir escena anterior si existe (sus nodos dejan de ser válidos)
         if (m_pScene)
         {
             m_pScene->Destroy();
             m_pScene = nullptr;
         }
+        m_GlobalTransforms.clear();
 
         // Crear nueva escena
         m_pScene = FbxScene::Create(m_pManager, "Scene");
@@ -82,6 +86,8 @@ void FBXExporter::Shutdown()
     }
 
     m_BoneNodeMap.clear();
+    m_GlobalTransforms.clear();
+    m_FrameTransforms.clear();
 }
 
 // ============================================================================
@@ -94,6 +100,7 @@ bool FBXExporter::ExportScene(
     const ConversionOptions& options)
 {
     m_Options = options;
+    m_SharedCurveData.clear();
 
     Utils::Log("Starting FBX export to: " + filename, options.verbose);
 
@@ -115,41 +122,14 @@ bool FBXExporter::ExportScene(
     SetupSceneProperties();
     SetupCoordinateSystem();
 
-    // Crear exporter
-    FbxExporter* pExporter = FbxExporter::Create(m_pScene, "");
-
-    // Determinar formato de exportación
-    int format = m_pManager->GetIOPluginRegistry()->GetNativeWriterFormat();
-
-    // FBX SDK 2020.3.7: Use default format or find by description
-    // The eFBX_* constants no longer exist, so we use the registry
-    if (format < 0)
-    {
-        format = m_pManager->GetIOPluginRegistry()->FindWriterIDByDescription("FBX binary (*.fbx)");
-    }
+    // Escribir archivo
+    bool result = WriteScene(filename);
 
-    // Inicializar exporter
-    if (!pExporter->Initialize(filename.c_str(), format, m_pManager->GetIOSettings()))
-    {
-        m_LastError = "Failed to initialize FBX Exporter: " + string(pExporter->GetStatus().GetErrorString());
-        pExporter->Destroy();
-        return false;
-    }
-
-    // Exportar escena
-    bool result = pExporter->Export(m_pScene);
-
-    if (!result)
-    {
-        m_LastError = "Failed to export FBX: " + string(pExporter->GetStatus().GetErrorString());
-    }
-    else
+    if (result)
     {
         Utils::Log("FBX export completed successfully", options.verbose);
     }
 
-    pExporter->Destroy();
-
     return result;
 }
 
@@ -169,6 +149,8 @@ bool FBXExporter::ExportSingleAnimation(
 
     // Limpiar mapa de huesos para esta animación
     m_BoneNodeMap.clear();
+    m_GlobalTransforms.clear();
+    m_SharedCurveData.clear();
 
     // Inicializar FBX SDK (creará nueva escena si es necesario)
     if (!Initialize())
@@ -186,8 +168,10 @@ bool FBXExporter::ExportSingleAnimation(
 
     // Obtener nodo raíz de la escena
     FbxNode* rootNode = m_pScene->GetRootNode();
+    m_pMaterials = &sceneData.materials;
 
     // Exportar jerarquía de frames (sin animaciones)
+    PrecomputeFrameTransforms(sceneData.rootFrame);
     ExportFrame(sceneData.rootFrame, rootNode);
 
     // Exportar solo esta animación
@@ -197,11 +181,101 @@ bool FBXExporter::ExportSingleAnimation(
     SetupSceneProperties();
     SetupCoordinateSystem();
 
+    // Escribir archivo
+    bool result = WriteScene(filename);
+
+    if (result)
+    {
+        Utils::Log("Animation export completed successfully", options.verbose);
+    }
+
+    return result;
+}
+
+// ============================================================================
+// Exportar Animaciones sobre un Skeleton compartido
+// ============================================================================
+// ExportSingleAnimation() reconstruye la escena completa (meshes, materiales,
+// skin, bind poses) por cada clip. En este modo la jerarquía de nodos se crea
+// una sola vez y cada clip solo agrega/quita su AnimStack: el costo por clip
+// depende del número de keys, no del tamaño de la escena.
+// ============================================================================
+
+bool FBXExporter::BeginAnimationExport(
+    const SceneData& sceneData,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+
+    m_BoneNodeMap.clear();
+    m_GlobalTransforms.clear();
+    m_SharedCurveData.clear();
+
+    if (!Initialize())
+    {
+        Utils::LogError(m_LastError);
+        return false;
+    }
+
+    if (!sceneData.rootFrame)
+    {
+        m_LastError = "No root frame in scene data";
+        return false;
+    }
+
+    // Solo nodos del skeleton: sin geometría
+    PrecomputeFrameTransforms(sceneData.rootFrame);
+    ExportFrame(sceneData.rootFrame, m_pScene->GetRootNode(), false);
+
+    SetupSceneProperties();
+    SetupCoordinateSystem();
+
+    return true;
+}
+
+bool FBXExporter::ExportAnimationOnly(
+    const AnimationClip& animation,
+    const string& filename)
+{
+    if (!m_pScene)
+    {
+        m_LastError = "BeginAnimationExport() was not called";
+        return false;
+    }
+
+    Utils::Log("Exporting animation '" + animation.name + "' to: " + filename, m_Options.verbose);
+
+    FbxAnimStack* animStack = ExportAnimationClip(animation);
+    m_pScene->SetCurrentAnimationStack(animStack);
+
+    bool result = WriteScene(filename);
+
+    // Quitar el clip de la escena (AnimStack, AnimLayer, curve nodes y curvas)
+    // para que el siguiente archivo solo contenga su propia animación
+    animStack->Destroy(true);
+
+    if (result)
+    {
+        Utils::Log("Animation export completed successfully", m_Options.verbose);
+    }
+
+    return result;
+}
+
+// ============================================================================
+// Escritura del archivo FBX
+// ============================================================================
+
+bool FBXExporter::WriteScene(const string& filename)
+{
     // Crear exporter
     FbxExporter* pExporter = FbxExporter::Create(m_pScene, "");
 
     // Determinar formato de exportación
     int format = m_pManager->GetIOPluginRegistry()->GetNativeWriterFormat();
+
+    // FBX SDK 2020.3.7: Use default format or find by description
+    // The eFBX_* constants no longer exist, so we use the registry
     if (format < 0)
     {
         format = m_pManager->GetIOPluginRegistry()->FindWriterIDByDescription("FBX binary (*.fbx)");
@@ -222,10 +296,6 @@ bool FBXExporter::ExportSingleAnimation(
     {
         m_LastError = "Failed to export FBX: " + string(pExporter->GetStatus().GetErrorString());
     }
-    else
-    {
-        Utils::Log("Animation export completed successfully", options.verbose);
-    }
 
     pExporter->Destroy();
 
@@ -246,8 +316,10 @@ bool FBXExporter::CreateFBXScene(const SceneData& sceneData)
 
     // Obtener nodo raíz de la escena
     FbxNode* rootNode = m_pScene->GetRootNode();
+    m_pMaterials = &sceneData.materials;
 
     // Exportar jerarquía de frames
+    PrecomputeFrameTransforms(sceneData.rootFrame);
     ExportFrame(sceneData.rootFrame, rootNode);
 
     // Exportar animaciones
@@ -263,7 +335,39 @@ bool FBXExporter::CreateFBXScene(const SceneData& sceneData)
 // Exportación de Frames (Jerarquía)
 // ============================================================================
 
-FbxNode* FBXExporter::ExportFrame(FrameData* frameData, FbxNode* parentNode)
+void FBXExporter::PrecomputeFrameTransforms(FrameData* rootFrame)
+{
+    m_FrameTransforms.clear();
+
+    // Aplanar la jerarquía (orden DFS) para convertir todas las matrices juntas
+    vector<const FrameData*> frames;
+    vector<D3DXMATRIX> matrices;
+    vector<const FrameData*> stack;
+    if (rootFrame)
+        stack.push_back(rootFrame);
+
+    while (!stack.empty())
+    {
+        const FrameData* frame = stack.back();
+        stack.pop_back();
+
+        frames.push_back(frame);
+        matrices.push_back(frame->transformMatrix);
+
+        for (const FrameData* child : frame->children)
+            stack.push_back(child);
+    }
+
+    vector<FbxAMatrix> converted;
+    MatrixConverter::ConvertMatricesWithOptions(matrices.data(), matrices.size(), m_Options, converted);
+
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        m_FrameTransforms[frames[i]] = converted[i];
+    }
+}
+
+FbxNode* FBXExporter::ExportFrame(FrameData* frameData, FbxNode* parentNode, bool includeMeshes)
 {
     if (!frameData)
         return nullptr;
@@ -271,11 +375,20 @@ FbxNode* FBXExporter::ExportFrame(FrameData* frameData, FbxNode* parentNode)
     // Crear nodo FBX para este frame
     FbxNode* node = FbxNode::Create(m_pScene, frameData->name.c_str());
 
-    // Convertir matriz de transformación
-    FbxAMatrix transform = MatrixConverter::ConvertMatrixWithOptions(
-        frameData->transformMatrix,
-        m_Options
-    );
+    // Usar la matriz ya convertida por lotes (o convertirla ahora si no está)
+    FbxAMatrix transform;
+    auto cached = m_FrameTransforms.find(frameData);
+    if (cached != m_FrameTransforms.end())
+    {
+        transform = cached->second;
+    }
+    else
+    {
+        transform = MatrixConverter::ConvertMatrixWithOptions(
+            frameData->transformMatrix,
+            m_Options
+        );
+    }
 
     // Aplicar transformación al nodo
     node->LclTranslation.Set(transform.GetT());
@@ -291,20 +404,21 @@ FbxNode* FBXExporter::ExportFrame(FrameData* frameData, FbxNode* parentNode)
         m_BoneNodeMap[frameData->name] = node;
     }
 
-    // Exportar meshes de este frame
-    for (MeshData* mesh : frameData->meshes)
+    // Exportar meshes de este frame (no en modo solo skeleton)
+    if (includeMeshes)
     {
-        // Necesitamos pasar materials, pero no están en frameData
-        // Los obtendremos del sceneData global
-        // Por ahora, usamos vector vacío
-        vector<MaterialData> emptyMaterials;
-        ExportMesh(mesh, node, emptyMaterials);
+        for (MeshData* mesh : frameData->meshes)
+        {
+            // Los meshes guardan índices en los materiales de la escena
+            static const vector<MaterialData> noMaterials;
+            ExportMesh(mesh, node, m_pMaterials ? *m_pMaterials : noMaterials);
+        }
     }
 
     // Exportar hijos recursivamente
     for (FrameData* child : frameData->children)
     {
-        ExportFrame(child, node);
+        ExportFrame(child, node, includeMeshes);
     }
 
     return node;
@@ -334,12 +448,15 @@ FbxNode* FBXExporter::ExportMesh(
     // Exportar normales
     ExportNormals(meshData, fbxMesh);
 
+    // Exportar colores de vértice
+    ExportVertexColors(meshData, fbxMesh);
+
     // Crear nodo para el mesh
     FbxNode* meshNode = FbxNode::Create(m_pScene, (meshData->name + "_node").c_str());
     meshNode->SetNodeAttribute(fbxMesh);
 
     // Exportar materiales
-    if (!materials.empty())
+    if (!materials.empty() && !meshData->materials.empty())
     {
         ExportMaterials(materials, meshNode, meshData);
     }
@@ -375,66 +492,116 @@ void FBXExporter::ExportGeometry(MeshData* meshData, FbxMesh* fbxMesh)
     fbxMesh->InitControlPoints(numVertices);
     FbxVector4* controlPoints = fbxMesh->GetControlPoints();
 
-    // Copiar posiciones de vértices
-    for (int i = 0; i < numVertices; i++)
+    // Copiar posiciones de vértices (LH -> RH y escala global, en su sitio)
+    if (numVertices > 0)
     {
-        const Vertex& vertex = meshData->vertices[i];
-        FbxVector4 pos = MatrixConverter::ConvertPosition_LH_to_RH(vertex.position);
-
-        // Aplicar escala global
-        if (m_Options.scale != 1.0f)
-        {
-            pos = MatrixConverter::ApplyGlobalScale(pos, m_Options.scale);
-        }
-
-        controlPoints[i] = pos;
+        MatrixConverter::ConvertPositions_LH_to_RH(
+            &meshData->vertices[0].position, sizeof(Vertex), numVertices,
+            m_Options.scale, controlPoints);
     }
 
+    // ========================================================================
     // Crear polígonos (triángulos)
-    for (int i = 0; i < numPolygons; i++)
+    // ========================================================================
+    // Reservar de una vez los polígonos y sus índices de vértice: sin la
+    // reserva el SDK hace crecer sus arrays internos triángulo a triángulo.
+    // Los arrays internos (mPolygons, mPolygonVertices) no se tocan
+    // directamente; BeginPolygon/AddPolygon/EndPolygon mantienen su estado
+    fbxMesh->ReservePolygonCount(numPolygons);
+    fbxMesh->ReservePolygonVertexCount(numPolygons * 3);
+
+    // FIX: NO invertir winding order manualmente
+    // Al convertir posiciones de LH a RH (invertir Z), el winding order
+    // ya se invierte automáticamente. Invertir manualmente causa doble inversión.
+    // Resultado: mantener el orden original de índices
+    //
+    // MeshData solo contiene triángulos (D3DX los genera así): el número de
+    // polígonos e índices se conoce de antemano y no hay casos especiales
+    const DWORD* indices = meshData->indices.data();
+    const DWORD* indicesEnd = indices + (size_t)numPolygons * 3;
+
+    for (; indices != indicesEnd; indices += 3)
     {
         fbxMesh->BeginPolygon(-1, -1, false);
+        fbxMesh->AddPolygon((int)indices[0]);
+        fbxMesh->AddPolygon((int)indices[1]);
+        fbxMesh->AddPolygon((int)indices[2]);
+        fbxMesh->EndPolygon();
+    }
+}
 
-        // FIX: NO invertir winding order manualmente
-        // Al convertir posiciones de LH a RH (invertir Z), el winding order
-        // ya se invierte automáticamente. Invertir manualmente causa doble inversión.
-        // Resultado: mantener el orden original de índices
-        fbxMesh->AddPolygon(meshData->indices[i * 3 + 0]);
-        fbxMesh->AddPolygon(meshData->indices[i * 3 + 1]);
-        fbxMesh->AddPolygon(meshData->indices[i * 3 + 2]);
+// Dimensionar el direct array de un layer y rellenarlo en su sitio
+template<class T, class FillFunction>
+static void FillDirectArray(FbxLayerElementArrayTemplate<T>& directArray, int count, FillFunction fill)
+{
+    directArray.Resize(count);
+    if (count == 0)
+        return;
 
-        fbxMesh->EndPolygon();
+    T* data = directArray.GetLocked(FbxLayerElementArray::eWriteLock);
+    if (data)
+    {
+        fill(data);
+        directArray.Release(&data);
     }
 }
 
 void FBXExporter::ExportUVs(MeshData* meshData, FbxMesh* fbxMesh)
 {
-    // Crear layer de UVs
-    FbxGeometryElementUV* uvElement = fbxMesh->CreateElementUV("DiffuseUV");
-    uvElement->SetMappingMode(FbxGeometryElement::eByControlPoint);
-    uvElement->SetReferenceMode(FbxGeometryElement::eDirect);
+    const vector<Vertex>& vertices = meshData->vertices;
+    int numVertices = (int)vertices.size();
 
-    // Agregar UVs
-    for (const Vertex& vertex : meshData->vertices)
+    // El set 0 se exporta siempre (DiffuseUV); los adicionales solo si existen
+    DWORD setCount = max(meshData->texCoordSetCount, (DWORD)1);
+
+    for (DWORD set = 0; set < setCount; set++)
     {
-        FbxVector2 uv(vertex.texCoord.x, 1.0 - vertex.texCoord.y);  // Invertir V (DirectX vs FBX)
-        uvElement->GetDirectArray().Add(uv);
+        string layerName = (set == 0) ? "DiffuseUV" : "UV" + to_string(set);
+
+        FbxGeometryElementUV* uvElement = fbxMesh->CreateElementUV(layerName.c_str());
+        uvElement->SetMappingMode(FbxGeometryElement::eByControlPoint);
+        uvElement->SetReferenceMode(FbxGeometryElement::eDirect);
+
+        FillDirectArray(uvElement->GetDirectArray(), numVertices, [&](FbxVector2* uvs)
+        {
+            const D3DXVECTOR2* first = (set == 0) ? &vertices[0].texCoord : &vertices[0].extraTexCoords[set - 1];
+            MatrixConverter::ConvertTexCoords(first, sizeof(Vertex), numVertices, uvs);
+        });
     }
 }
 
 void FBXExporter::ExportNormals(MeshData* meshData, FbxMesh* fbxMesh)
 {
+    const vector<Vertex>& vertices = meshData->vertices;
+    int numVertices = (int)vertices.size();
+
     // Crear layer de normales
     FbxGeometryElementNormal* normalElement = fbxMesh->CreateElementNormal();
     normalElement->SetMappingMode(FbxGeometryElement::eByControlPoint);
     normalElement->SetReferenceMode(FbxGeometryElement::eDirect);
 
-    // Agregar normales
-    for (const Vertex& vertex : meshData->vertices)
+    FillDirectArray(normalElement->GetDirectArray(), numVertices, [&](FbxVector4* normals)
     {
-        FbxVector4 normal = MatrixConverter::ConvertNormal_LH_to_RH(vertex.normal);
-        normalElement->GetDirectArray().Add(normal);
-    }
+        MatrixConverter::ConvertNormals_LH_to_RH(&vertices[0].normal, sizeof(Vertex), numVertices, normals);
+    });
+}
+
+void FBXExporter::ExportVertexColors(MeshData* meshData, FbxMesh* fbxMesh)
+{
+    if (!meshData->hasVertexColors)
+        return;
+
+    const vector<Vertex>& vertices = meshData->vertices;
+    int numVertices = (int)vertices.size();
+
+    FbxGeometryElementVertexColor* colorElement = fbxMesh->CreateElementVertexColor();
+    colorElement->SetMappingMode(FbxGeometryElement::eByControlPoint);
+    colorElement->SetReferenceMode(FbxGeometryElement::eDirect);
+
+    FillDirectArray(colorElement->GetDirectArray(), numVertices, [&](FbxColor* colors)
+    {
+        MatrixConverter::ConvertColors(&vertices[0].color, sizeof(Vertex), numVertices, colors);
+    });
 }
 
 // ============================================================================
@@ -446,25 +613,36 @@ void FBXExporter::ExportMaterials(
     FbxNode* meshNode,
     MeshData* meshData)
 {
-    for (size_t i = 0; i < materials.size(); i++)
+    // Un material FBX por cada material del mesh, en el orden de sus índices
+    for (DWORD materialIndex : meshData->materials)
     {
-        FbxSurfacePhong* fbxMaterial = CreateMaterial(materials[i]);
+        if (materialIndex >= materials.size())
+            continue;
+
+        FbxSurfacePhong* fbxMaterial = CreateMaterial(materials[materialIndex]);
         meshNode->AddMaterial(fbxMaterial);
     }
 
-    // Si hay materiales por triángulo, crear element de material
-    if (!meshData->materialIndices.empty())
+    FbxMesh* fbxMesh = meshNode->GetMesh();
+    FbxGeometryElementMaterial* matElement = fbxMesh->CreateElementMaterial();
+    matElement->SetReferenceMode(FbxGeometryElement::eIndexToDirect);
+
+    if (meshData->materialIndices.size() == meshData->indices.size() / 3)
     {
-        FbxMesh* fbxMesh = meshNode->GetMesh();
-        FbxGeometryElementMaterial* matElement = fbxMesh->CreateElementMaterial();
+        // Material por triángulo
         matElement->SetMappingMode(FbxGeometryElement::eByPolygon);
-        matElement->SetReferenceMode(FbxGeometryElement::eIndexToDirect);
 
-        // Asignar índice de material a cada polígono
-        for (DWORD matIndex : meshData->materialIndices)
-        {
-            matElement->GetIndexArray().Add(matIndex);
-        }
+        FbxLayerElementArrayTemplate<int>& indexArray = matElement->GetIndexArray();
+        int count = (int)meshData->materialIndices.size();
+        indexArray.Resize(count);
+        for (int i = 0; i < count; i++)
+            indexArray.SetAt(i, (int)meshData->materialIndices[i]);
+    }
+    else
+    {
+        // Sin attribute buffer: el primer material para todo el mesh
+        matElement->SetMappingMode(FbxGeometryElement::eAllSame);
+        matElement->GetIndexArray().Add(0);
     }
 }
 
@@ -508,7 +686,7 @@ FbxSurfacePhong* FBXExporter::CreateMaterial(const MaterialData& matData)
         // Copiar textura si se solicitó
         if (m_Options.exportTextures)
         {
-            texturePath = CopyTexture(matData.textureFilename);
+            texturePath = CopyTexture(matData.textureFilename, m_Options.outputFile);
         }
 
         texture->SetFileName(texturePath.c_str());
@@ -538,11 +716,56 @@ void FBXExporter::ExportSkinWeights(
     if (!meshData->hasSkinning || meshData->bones.empty())
         return;
 
+    const size_t boneCount = meshData->bones.size();
+    const size_t vertexCount = meshData->vertices.size();
+
+    // ========================================================================
+    // Agrupar influencias por hueso en una sola pasada por los vértices
+    // ========================================================================
+    // boneStart[b]..boneStart[b+1] son las influencias del hueso b en
+    // influenceVertices/influenceWeights (en orden de vértice)
+    vector<size_t> boneStart(boneCount + 1, 0);
+
+    for (const Vertex& vertex : meshData->vertices)
+    {
+        for (int iInfl = 0; iInfl < MAX_BONE_INFLUENCES; iInfl++)
+        {
+            if (vertex.boneWeights[iInfl] > 0.0f && vertex.boneIndices[iInfl] < boneCount)
+                boneStart[vertex.boneIndices[iInfl] + 1]++;
+        }
+    }
+
+    for (size_t iBone = 0; iBone < boneCount; iBone++)
+        boneStart[iBone + 1] += boneStart[iBone];
+
+    vector<int> influenceVertices(boneStart[boneCount]);
+    vector<double> influenceWeights(boneStart[boneCount]);
+    vector<size_t> cursor(boneStart.begin(), boneStart.end() - 1);
+
+    for (size_t iVert = 0; iVert < vertexCount; iVert++)
+    {
+        const Vertex& vertex = meshData->vertices[iVert];
+
+        for (int iInfl = 0; iInfl < MAX_BONE_INFLUENCES; iInfl++)
+        {
+            DWORD bone = vertex.boneIndices[iInfl];
+            if (vertex.boneWeights[iInfl] <= 0.0f || bone >= boneCount)
+                continue;
+
+            size_t slot = cursor[bone]++;
+            influenceVertices[slot] = (int)iVert;
+            influenceWeights[slot] = vertex.boneWeights[iInfl];
+        }
+    }
+
+    // Matriz global del mesh en bind pose (igual para todos los clusters)
+    FbxAMatrix meshMatrix = meshNode->EvaluateGlobalTransform();
+
     // Crear FbxSkin
     FbxSkin* skin = FbxSkin::Create(m_pScene, "");
 
     // Crear cluster para cada hueso
-    for (size_t iBone = 0; iBone < meshData->bones.size(); iBone++)
+    for (size_t iBone = 0; iBone < boneCount; iBone++)
     {
         const BoneData& bone = meshData->bones[iBone];
 
@@ -564,18 +787,26 @@ void FBXExporter::ExportSkinWeights(
         cluster->SetLink(boneNode);
         cluster->SetLinkMode(FbxCluster::eTotalOne);
 
-        // Agregar vértices influenciados por este hueso
-        for (size_t iVert = 0; iVert < meshData->vertices.size(); iVert++)
-        {
-            const Vertex& vertex = meshData->vertices[iVert];
+        // Agregar vértices influenciados por este hueso: se dimensionan los
+        // arrays del cluster una vez y se copian directamente
+        int influenceCount = (int)(boneStart[iBone + 1] - boneStart[iBone]);
+        const int* vertices = influenceVertices.data() + boneStart[iBone];
+        const double* weights = influenceWeights.data() + boneStart[iBone];
 
-            for (int iInfl = 0; iInfl < MAX_BONE_INFLUENCES; iInfl++)
-            {
-                if (vertex.boneIndices[iInfl] == iBone && vertex.boneWeights[iInfl] > 0.0f)
-                {
-                    cluster->AddControlPointIndex((int)iVert, vertex.boneWeights[iInfl]);
-                }
-            }
+        cluster->SetControlPointIWCount(influenceCount);
+        int* clusterIndices = cluster->GetControlPointIndices();
+        double* clusterWeights = cluster->GetControlPointWeights();
+
+        if (clusterIndices && clusterWeights && cluster->GetControlPointIndicesCount() == influenceCount)
+        {
+            copy(vertices, vertices + influenceCount, clusterIndices);
+            copy(weights, weights + influenceCount, clusterWeights);
+        }
+        else
+        {
+            cluster->SetControlPointIWCount(0);
+            for (int i = 0; i < influenceCount; i++)
+                cluster->AddControlPointIndex(vertices[i], weights[i]);
         }
 
         // ====================================================================
@@ -593,11 +824,10 @@ void FBXExporter::ExportSkinWeights(
         // Por lo tanto, NO debemos invertirla de nuevo.
         // ====================================================================
 
-        FbxAMatrix meshMatrix = meshNode->EvaluateGlobalTransform();
-
         // FIX: Usar la transformación global actual del hueso en la escena FBX
         // Esto asegura que el binding se hace con la posición correcta del hueso
-        FbxAMatrix boneGlobalMatrix = boneNode->EvaluateGlobalTransform();
+        // (caché por nodo: cada hueso se evalúa una vez por escena)
+        const FbxAMatrix& boneGlobalMatrix = GetGlobalTransform(boneNode);
 
         // Configurar las matrices del cluster
         cluster->SetTransformMatrix(meshMatrix);           // Matriz del mesh en bind pose
@@ -605,7 +835,7 @@ void FBXExporter::ExportSkinWeights(
 
         if (m_Options.verbose && iBone < 3)  // Solo mostrar los primeros 3 huesos
         {
-            cout << "  Bone: " << bone.name << " configured with bind pose matrices\n";
+            Utils::LogStream() << "  Bone: " << bone.name << " configured with bind pose matrices\n";
         }
 
         skin->AddCluster(cluster);
@@ -661,7 +891,7 @@ void FBXExporter::CreateBindPose(
 
         // FIX: Usar la transformación global actual del hueso
         // Esto asegura consistencia con las matrices usadas en los clusters
-        FbxAMatrix boneBindPoseMatrix = boneNode->EvaluateGlobalTransform();
+        const FbxAMatrix& boneBindPoseMatrix = GetGlobalTransform(boneNode);
 
         // Convertir a FbxMatrix (requerido por FbxPose::Add)
         FbxMatrix boneMatrix = boneBindPoseMatrix;
@@ -679,6 +909,22 @@ void FBXExporter::CreateBindPose(
     Utils::Log("Bind pose created successfully", m_Options.verbose);
 }
 
+// ============================================================================
+// Caché de transformaciones globales de nodos
+// ============================================================================
+// Los clusters y el bind pose de cada mesh consultan la matriz global de los
+// mismos huesos: se evalúa una vez por nodo (la jerarquía no cambia mientras
+// se exportan los meshes)
+
+const FbxAMatrix& FBXExporter::GetGlobalTransform(FbxNode* node)
+{
+    auto it = m_GlobalTransforms.find(node);
+    if (it == m_GlobalTransforms.end())
+        it = m_GlobalTransforms.insert(make_pair(node, node->EvaluateGlobalTransform())).first;
+
+    return it->second;
+}
+
 FbxNode* FBXExporter::CreateBone(
     const string& boneName,
     const D3DXMATRIX& transformMatrix,
@@ -731,8 +977,11 @@ void FBXExporter::ExportAnimations(const vector<AnimationClip>& animations)
 //   └─ AnimLayer (capa, permite mezclar múltiples animaciones)
 //       └─ AnimCurves (curvas para cada propiedad: TX, TY, TZ, RX, RY, RZ, SX, SY, SZ)
 // ============================================================================
-void FBXExporter::ExportAnimationClip(const AnimationClip& clip)
+FbxAnimStack* FBXExporter::ExportAnimationClip(const AnimationClip& clip)
 {
+    m_FittedSampleCount = 0;
+    m_FittedKeyCount = 0;
+
     // ========================================================================
     // PASO 1: Crear estructura de animación en FBX
     // ========================================================================
@@ -763,6 +1012,9 @@ void FBXExporter::ExportAnimationClip(const AnimationClip& clip)
     // PASO 3: Exportar tracks de animación (uno por cada hueso animado)
     // ========================================================================
 
+    // Buffers por canal, reutilizados entre tracks (conservan su capacidad)
+    TrackCurveData curveData;
+
     // Cada AnimationTrack contiene los keyframes para un hueso específico
     for (const AnimationTrack& track : clip.tracks)
     {
@@ -780,7 +1032,24 @@ void FBXExporter::ExportAnimationClip(const AnimationClip& clip)
         FbxNode* boneNode = it->second;
 
         // ====================================================================
-        // Crear 9 curvas de animación: Translation (X,Y,Z), Rotation (X,Y,Z), Scale (X,Y,Z)
+        // Canales animados del track
+        // ====================================================================
+        // Los canales sin keys (constantes iguales a la pose de reposo, ver
+        // AnimationOptimizer::EliminateConstantChannels) no necesitan curva:
+        // el valor Lcl* del nodo ya es la pose de reposo.
+        BYTE animatedChannels = 0;
+        for (const AnimationKey& key : track.GetKeys())
+            animatedChannels |= key.channels;
+
+        if (animatedChannels == 0)
+            continue;
+
+        const bool hasTranslation = (animatedChannels & KEY_TRANSLATION) != 0;
+        const bool hasRotation = (animatedChannels & KEY_ROTATION) != 0;
+        const bool hasScale = (animatedChannels & KEY_SCALE) != 0;
+
+        // ====================================================================
+        // Crear curvas de animación: Translation (X,Y,Z), Rotation (X,Y,Z), Scale (X,Y,Z)
         // ====================================================================
         // FBX almacena animaciones como curvas separadas para cada componente.
         // Cada curva contiene keyframes (tiempo, valor).
@@ -789,132 +1058,262 @@ void FBXExporter::ExportAnimationClip(const AnimationClip& clip)
         //   - animLayer: capa donde se almacena la curva
         //   - COMPONENT_X/Y/Z: componente específico (X, Y o Z)
         //   - true: crear la curva si no existe
+        //
+        // Solo se crean las curvas de los canales animados (nullptr en el resto)
 
         // Curvas de TRASLACIÓN (posición del hueso en el espacio)
-        FbxAnimCurve* curveTX = boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true);
-        FbxAnimCurve* curveTY = boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true);
-        FbxAnimCurve* curveTZ = boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true);
+        FbxAnimCurve* curveTX = hasTranslation ? boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true) : nullptr;
+        FbxAnimCurve* curveTY = hasTranslation ? boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true) : nullptr;
+        FbxAnimCurve* curveTZ = hasTranslation ? boneNode->LclTranslation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true) : nullptr;
 
         // Curvas de ROTACIÓN (orientación del hueso, en grados Euler)
-        FbxAnimCurve* curveRX = boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true);
-        FbxAnimCurve* curveRY = boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true);
-        FbxAnimCurve* curveRZ = boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true);
+        FbxAnimCurve* curveRX = hasRotation ? boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true) : nullptr;
+        FbxAnimCurve* curveRY = hasRotation ? boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true) : nullptr;
+        FbxAnimCurve* curveRZ = hasRotation ? boneNode->LclRotation.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true) : nullptr;
 
         // Curvas de ESCALA (tamaño del hueso)
-        FbxAnimCurve* curveSX = boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true);
-        FbxAnimCurve* curveSY = boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true);
-        FbxAnimCurve* curveSZ = boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true);
+        FbxAnimCurve* curveSX = hasScale ? boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_X, true) : nullptr;
+        FbxAnimCurve* curveSY = hasScale ? boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Y, true) : nullptr;
+        FbxAnimCurve* curveSZ = hasScale ? boneNode->LclScaling.GetCurve(animLayer, FBXSDK_CURVENODE_COMPONENT_Z, true) : nullptr;
+
+        FbxAnimCurve* curves[9] =
+        {
+            curveTX, curveTY, curveTZ,
+            curveRX, curveRY, curveRZ,
+            curveSX, curveSY, curveSZ
+        };
 
         // ====================================================================
-        // OPTIMIZACIÓN: Iniciar modificación de TODAS las curvas una sola vez
+        // Preparar arrays contiguos de tiempos y valores por canal
         // ====================================================================
-        // Esto es mucho más eficiente que llamar Begin/End para cada keyframe
-        curveTX->KeyModifyBegin();
-        curveTY->KeyModifyBegin();
-        curveTZ->KeyModifyBegin();
-        curveRX->KeyModifyBegin();
-        curveRY->KeyModifyBegin();
-        curveRZ->KeyModifyBegin();
-        curveSX->KeyModifyBegin();
-        curveSY->KeyModifyBegin();
-        curveSZ->KeyModifyBegin();
+        // Conversión LH -> RH, escala global y quaternion -> Euler por lotes
+        // (una sola vez por exportación si el array de keys está compartido,
+        // ver AnimationOptimizer::ShareDuplicateTracks)
+        const TrackCurveData* trackData = &curveData;
+
+        if (track.shared)
+        {
+            auto cached = m_SharedCurveData.find(track.keyData);
+            if (cached == m_SharedCurveData.end())
+            {
+                cached = m_SharedCurveData.insert(make_pair(track.keyData, TrackCurveData())).first;
+                BuildTrackCurveData(track, cached->second);
+                cached->second.rotations.clear();
+                cached->second.rotations.shrink_to_fit();
+            }
+            trackData = &cached->second;
+        }
+        else
+        {
+            BuildTrackCurveData(track, curveData);
+        }
 
         // ====================================================================
-        // Agregar keyframes a las curvas
+        // Curvas cúbicas ajustadas (opcional)
         // ====================================================================
-        // Iterar sobre cada keyframe en este track
-        for (const AnimationKey& key : track.keys)
+        if (m_Options.fitCurves)
         {
-            // ================================================================
-            // Convertir tiempo del keyframe a FbxTime
-            // ================================================================
-            FbxTime keyTime;
-            keyTime.SetSecondDouble(key.time);  // Tiempo en segundos
-
-            // ================================================================
-            // CONVERSIÓN CRÍTICA: DirectX (LH) → FBX (RH)
-            // ================================================================
-            // DirectX usa Left-Handed (Z hacia adelante)
-            // FBX usa Right-Handed (Z hacia atrás)
-            // Debemos convertir TODAS las transformaciones
-
-            // Convertir POSICIÓN (invierte Z)
-            FbxVector4 pos = MatrixConverter::ConvertPosition_LH_to_RH(key.translation);
-
-            // Convertir ROTACIÓN (quaternion → negar X,Y para cambio de coordenadas)
-            FbxQuaternion rot = MatrixConverter::ConvertQuaternion_LH_to_RH(key.rotation);
-
-            // FIX: Usar quaternion directamente en lugar de convertir a Euler
-            // Esto evita problemas de gimbal lock y rotaciones discontinuas
-            // DecomposeSphericalXYZ() puede causar saltos y orientaciones incorrectas
-
-            // Convertir ESCALA (sin cambios entre LH y RH)
-            FbxVector4 scale = MatrixConverter::ConvertScale(key.scale);
-
-            // ================================================================
-            // AGREGAR KEYFRAMES DE TRASLACIÓN (TX, TY, TZ)
-            // ================================================================
-
-            // Keyframe para Translation X
-            int keyIndexTX = curveTX->KeyAdd(keyTime);
-            curveTX->KeySet(keyIndexTX, keyTime, (float)pos[0]);
-
-            // Keyframe para Translation Y
-            int keyIndexTY = curveTY->KeyAdd(keyTime);
-            curveTY->KeySet(keyIndexTY, keyTime, (float)pos[1]);
-
-            // Keyframe para Translation Z
-            int keyIndexTZ = curveTZ->KeyAdd(keyTime);
-            curveTZ->KeySet(keyIndexTZ, keyTime, (float)pos[2]);
-
-            // ================================================================
-            // AGREGAR KEYFRAMES DE ROTACIÓN (RX, RY, RZ)
-            // ================================================================
-            // FIX: Convertir quaternion a Euler usando el método correcto de FBX
-            // que mantiene continuidad y evita gimbal lock
-
-            // Crear una matriz temporal desde el quaternion y extraer Euler angles
-            FbxAMatrix tempMatrix;
-            tempMatrix.SetQ(rot);
-            FbxVector4 euler = tempMatrix.GetR();  // Obtiene Euler en GRADOS directamente
-
-            // Keyframe para Rotation X (ya en grados)
-            int keyIndexRX = curveRX->KeyAdd(keyTime);
-            curveRX->KeySet(keyIndexRX, keyTime, (float)euler[0]);
-
-            // Keyframe para Rotation Y (ya en grados)
-            int keyIndexRY = curveRY->KeyAdd(keyTime);
-            curveRY->KeySet(keyIndexRY, keyTime, (float)euler[1]);
-
-            // Keyframe para Rotation Z (ya en grados)
-            int keyIndexRZ = curveRZ->KeyAdd(keyTime);
-            curveRZ->KeySet(keyIndexRZ, keyTime, (float)euler[2]);
-
-            // ================================================================
-            // AGREGAR KEYFRAMES DE ESCALA (SX, SY, SZ)
-            // ================================================================
-            int keyIndexSX = curveSX->KeyAdd(keyTime);
-            curveSX->KeySet(keyIndexSX, keyTime, (float)scale[0]);
-
-            int keyIndexSY = curveSY->KeyAdd(keyTime);
-            curveSY->KeySet(keyIndexSY, keyTime, (float)scale[1]);
-
-            int keyIndexSZ = curveSZ->KeyAdd(keyTime);
-            curveSZ->KeySet(keyIndexSZ, keyTime, (float)scale[2]);
+            ExportFittedCurves(*trackData, curves);
+            continue;
         }
 
         // ====================================================================
-        // OPTIMIZACIÓN: Finalizar modificación de TODAS las curvas una vez
+        // Llenar cada curva de una vez con sus keys (lineales)
         // ====================================================================
-        curveTX->KeyModifyEnd();
-        curveTY->KeyModifyEnd();
-        curveTZ->KeyModifyEnd();
-        curveRX->KeyModifyEnd();
-        curveRY->KeyModifyEnd();
-        curveRZ->KeyModifyEnd();
-        curveSX->KeyModifyEnd();
-        curveSY->KeyModifyEnd();
-        curveSZ->KeyModifyEnd();
+        for (int c = 0; c < 9; c++)
+        {
+            if (curves[c])
+                WriteLinearCurve(curves[c], trackData->times[c / 3], trackData->values[c]);
+        }
+    }
+
+    if (m_Options.fitCurves && m_Options.verbose)
+    {
+        Utils::LogStream() << "  Curve fitting '" << clip.name << "': " << m_FittedSampleCount
+             << " samples -> " << m_FittedKeyCount << " cubic keys\n";
+    }
+
+    return animStack;
+}
+
+// ============================================================================
+// ARRAYS DE CURVAS POR CANAL
+// ============================================================================
+// Separa las keys del track en arrays contiguos por canal (T, R, S) ya
+// convertidos al espacio FBX:
+//   - Traslación: LH -> RH (Z invertida) y escala global
+//   - Rotación: quaternion -> Euler XYZ en grados (SSE, 4 por instrucción)
+//     con filtro de continuidad para evitar saltos de ±180°/360°
+//   - Escala: sin cambios
+// Los tiempos se convierten a FbxTime una sola vez por canal.
+// ============================================================================
+void FBXExporter::BuildTrackCurveData(const AnimationTrack& track, TrackCurveData& data)
+{
+    for (int c = 0; c < 3; c++)
+        data.times[c].clear();
+    for (int c = 0; c < 9; c++)
+        data.values[c].clear();
+    data.rotations.clear();
+
+    const vector<AnimationKey>& keys = track.GetKeys();
+    size_t keyCount = keys.size();
+    for (int c = 0; c < 3; c++)
+        data.times[c].reserve(keyCount);
+    for (int c = 0; c < 9; c++)
+        data.values[c].reserve(keyCount);
+    data.rotations.reserve(keyCount);
+
+    const float scale = m_Options.scale;
+
+    for (const AnimationKey& key : keys)
+    {
+        FbxTime keyTime;
+        keyTime.SetSecondDouble(key.time);  // Tiempo en segundos
+
+        if (key.channels & KEY_TRANSLATION)
+        {
+            // LH -> RH: invertir Z; misma escala global que los nodos (ApplyOptions)
+            data.times[0].push_back(keyTime);
+            data.values[0].push_back(key.translation.x * scale);
+            data.values[1].push_back(key.translation.y * scale);
+            data.values[2].push_back(-key.translation.z * scale);
+        }
+
+        if (key.channels & KEY_ROTATION)
+        {
+            data.times[1].push_back(keyTime);
+            data.rotations.push_back(key.rotation);
+        }
+
+        if (key.channels & KEY_SCALE)
+        {
+            // La escala no cambia entre LH y RH
+            data.times[2].push_back(keyTime);
+            data.values[6].push_back(key.scale.x);
+            data.values[7].push_back(key.scale.y);
+            data.values[8].push_back(key.scale.z);
+        }
+    }
+
+    // Rotaciones: conversión por lotes y continuidad entre keys
+    size_t rotationCount = data.rotations.size();
+    for (int c = 3; c < 6; c++)
+        data.values[c].resize(rotationCount);
+
+    MatrixConverter::ConvertQuaternionsToEuler_LH_to_RH(
+        data.rotations.data(), rotationCount,
+        data.values[3].data(), data.values[4].data(), data.values[5].data());
+
+    MatrixConverter::FilterEulerContinuity(
+        data.values[3].data(), data.values[4].data(), data.values[5].data(), rotationCount);
+}
+
+// ============================================================================
+// Llenado de una curva con keys lineales
+// ============================================================================
+// La capacidad se reserva de una vez con ResizeKeyBuffer(). Si el buffer ya
+// quedó con 'count' keys, se escriben directamente por índice; si solo se
+// reservó memoria, se agregan con KeyAdd() pasando el índice de la última
+// key (pLast) para que la inserción al final no busque en toda la curva.
+// ============================================================================
+void FBXExporter::WriteLinearCurve(
+    FbxAnimCurve* curve,
+    const vector<FbxTime>& times,
+    const vector<float>& values)
+{
+    // Interpolación lineal entre keys: la reducción de keys (AnimationOptimizer)
+    // mide el error contra la interpolación lineal, con tangentes automáticas
+    // la curva se desviaría entre keys distantes
+    const FbxAnimCurveDef::EInterpolationType interpolation = FbxAnimCurveDef::eInterpolationLinear;
+
+    int count = (int)times.size();
+
+    curve->KeyModifyBegin();
+    curve->ResizeKeyBuffer(count);
+
+    if (curve->KeyGetCount() == count)
+    {
+        for (int i = 0; i < count; i++)
+            curve->KeySet(i, times[i], values[i], interpolation);
+    }
+    else
+    {
+        int last = 0;
+        for (int i = 0; i < count; i++)
+        {
+            int keyIndex = curve->KeyAdd(times[i], &last);
+            curve->KeySet(keyIndex, times[i], values[i], interpolation);
+        }
+    }
+
+    curve->KeyModifyEnd();
+}
+
+// ============================================================================
+// CURVAS CÚBICAS AJUSTADAS
+// ============================================================================
+// En lugar de una key lineal por muestra, cada componente se ajusta con
+// segmentos de Hermite (CurveFitter) y se escribe con tangentes explícitas.
+// Las muestras densas (p.ej. tras el resampleo) se reducen a pocas keys
+// cúbicas que reproducen la curva dentro de la tolerancia del canal.
+// ============================================================================
+void FBXExporter::ExportFittedCurves(const TrackCurveData& data, FbxAnimCurve* curves[9])
+{
+    const float tolerances[3] =
+    {
+        m_Options.keyPositionTolerance,
+        m_Options.keyRotationTolerance,
+        m_Options.keyScaleTolerance
+    };
+
+    vector<double> seconds;
+    vector<HermiteKey> fitted;
+
+    for (int channel = 0; channel < 3; channel++)
+    {
+        const vector<FbxTime>& times = data.times[channel];
+        if (times.empty())
+            continue;
+
+        seconds.resize(times.size());
+        for (size_t i = 0; i < times.size(); i++)
+            seconds[i] = times[i].GetSecondDouble();
+
+        for (int component = 0; component < 3; component++)
+        {
+            int curve = channel * 3 + component;
+            const vector<float>& values = data.values[curve];
+
+            CurveFitter::FitHermite(seconds, values, tolerances[channel], fitted);
+
+            FbxAnimCurve* fbxCurve = curves[curve];
+            fbxCurve->KeyModifyBegin();
+            fbxCurve->ResizeKeyBuffer((int)fitted.size());
+
+            int last = 0;
+            for (size_t k = 0; k < fitted.size(); k++)
+            {
+                FbxTime keyTime;
+                keyTime.SetSecondDouble(fitted[k].time);
+
+                // Tangente de usuario: pendiente derecha de esta key e izquierda de la siguiente
+                float nextSlope = (k + 1 < fitted.size()) ? fitted[k + 1].slope : fitted[k].slope;
+
+                int keyIndex = (fbxCurve->KeyGetCount() == (int)fitted.size())
+                    ? (int)k
+                    : fbxCurve->KeyAdd(keyTime, &last);
+
+                fbxCurve->KeySet(keyIndex, keyTime, fitted[k].value,
+                                 FbxAnimCurveDef::eInterpolationCubic,
+                                 FbxAnimCurveDef::eTangentUser,
+                                 fitted[k].slope, nextSlope);
+            }
+
+            fbxCurve->KeyModifyEnd();
+
+            m_FittedSampleCount += values.size();
+            m_FittedKeyCount += fitted.size();
+        }
     }
 }
 
@@ -963,7 +1362,7 @@ void FBXExporter::SetupSceneProperties()
 
     if (m_Options.verbose)
     {
-        cout << "FBX Scene framerate set to: " << m_Options.targetFPS << " FPS\n";
+        Utils::LogStream() << "FBX Scene framerate set to: " << m_Options.targetFPS << " FPS\n";
     }
 }
 
@@ -1024,7 +1423,7 @@ FrameData* FBXExporter::FindFrameByName(FrameData* root, const string& name)
     return nullptr;
 }
 
-string FBXExporter::CopyTexture(const string& textureFilename)
+string FBXExporter::CopyTexture(const string& textureFilename, const string& outputFile)
 {
     if (!Utils::FileExists(textureFilename))
         return textureFilename;
@@ -1032,7 +1431,7 @@ string FBXExporter::CopyTexture(const string& textureFilename)
     try
     {
         fs::path srcPath(textureFilename);
-        fs::path dstDir = fs::path(m_Options.outputFile).parent_path() / "textures";
+        fs::path dstDir = fs::path(outputFile).parent_path() / "textures";
 
         // Crear directorio de texturas
         fs::create_directories(dstDir);
@@ -5,6 +5,7 @@
 
 #include "../include/Common.h"
 #include "MatrixConverter.h"
+#include "CurveFitter.h"
 
 /**
  * @class FBXExporter
@@ -20,6 +21,20 @@
 class FBXExporter
 {
 public:
+    /**
+     * Keys de un track separadas por canal y convertidas al espacio FBX
+     *
+     * times[0..2]: tiempos de traslación, rotación y escala
+     * values[0..8]: TX, TY, TZ, RX, RY, RZ (grados), SX, SY, SZ
+     * values[3*c + i] tiene el mismo tamaño que times[c]
+     */
+    struct TrackCurveData
+    {
+        vector<FbxTime> times[3];
+        vector<float> values[9];
+        vector<D3DXQUATERNION> rotations;   // Quaternions DirectX de entrada
+    };
+
     FBXExporter();
     ~FBXExporter();
 
@@ -49,13 +64,49 @@ public:
         const string& filename,
         const ConversionOptions& options);
 
+    /**
+     * Preparar la exportación de animaciones en modo "solo skeleton"
+     *
+     * Construye UNA vez la jerarquía de nodos (sin meshes, materiales,
+     * skin ni bind pose). Después, cada ExportAnimationOnly() solo agrega
+     * un AnimStack con sus curvas, escribe el archivo y lo destruye.
+     *
+     * @param sceneData Datos de la escena (solo se usa la jerarquía)
+     * @param options Opciones de conversión
+     * @return true si la escena se creó correctamente
+     */
+    bool BeginAnimationExport(
+        const SceneData& sceneData,
+        const ConversionOptions& options);
+
+    /**
+     * Exportar un clip sobre el skeleton creado por BeginAnimationExport()
+     * @param animation Clip de animación a exportar
+     * @param filename Archivo FBX de salida
+     * @return true si se exportó exitosamente
+     */
+    bool ExportAnimationOnly(
+        const AnimationClip& animation,
+        const string& filename);
+
     /**
      * Obtener último mensaje de error
      * @return Mensaje de error
      */
     string GetLastError() const { return m_LastError; }
 
+    /**
+     * Copiar una textura a la carpeta "textures" junto al archivo de salida
+     * @param textureFilename Ruta de la textura original
+     * @param outputFile Archivo FBX de salida
+     * @return Ruta de la textura copiada (la original si no se pudo copiar)
+     */
+    static string CopyTexture(const string& textureFilename, const string& outputFile);
+
 private:
+    // bench/GeometryExportBench.cpp mide ExportGeometry directamente
+    friend struct GeometryExportBenchAccess;
+
     // FBX SDK Manager y Scene
     FbxManager* m_pManager;
     FbxScene* m_pScene;
@@ -63,9 +114,26 @@ private:
     // Opciones actuales
     ConversionOptions m_Options;
 
+    // Materiales de la escena que se está exportando (MeshData::materials indexa aquí)
+    const vector<MaterialData>* m_pMaterials;
+
     // Mapeo de nombres de huesos a FbxNode* (para animaciones)
     map<string, FbxNode*> m_BoneNodeMap;
 
+    // Transformaciones globales de nodos ya evaluadas (ver GetGlobalTransform)
+    map<FbxNode*, FbxAMatrix> m_GlobalTransforms;
+
+    // Transformaciones locales de todos los frames, convertidas por lotes
+    map<const FrameData*, FbxAMatrix> m_FrameTransforms;
+
+    // Curvas convertidas de los tracks compartidos (AnimationTrack::shared)
+    // de la exportación en curso; se vacía al empezar cada exportación
+    map<shared_ptr<const vector<AnimationKey>>, TrackCurveData> m_SharedCurveData;
+
+    // Estadísticas del ajuste de curvas del clip actual (muestras -> keys cúbicas)
+    size_t m_FittedSampleCount;
+    size_t m_FittedKeyCount;
+
     // Último error
     string m_LastError;
 
@@ -87,13 +155,21 @@ private:
      */
     bool CreateFBXScene(const SceneData& sceneData);
 
+    /**
+     * Convertir de una vez las matrices de todos los frames de la jerarquía
+     * (descomposición por lotes) y guardarlas en m_FrameTransforms
+     * @param rootFrame Frame raíz
+     */
+    void PrecomputeFrameTransforms(FrameData* rootFrame);
+
     /**
      * Exportar jerarquía de frames
      * @param frameData Frame a exportar
      * @param parentNode Nodo padre en FBX
+     * @param includeMeshes Exportar también los meshes de cada frame
      * @return FbxNode* creado
      */
-    FbxNode* ExportFrame(FrameData* frameData, FbxNode* parentNode);
+    FbxNode* ExportFrame(FrameData* frameData, FbxNode* parentNode, bool includeMeshes = true);
 
     /**
      * Exportar mesh
@@ -114,7 +190,7 @@ private:
     void ExportGeometry(MeshData* meshData, FbxMesh* fbxMesh);
 
     /**
-     * Exportar UVs del mesh
+     * Exportar UVs del mesh (un layer por set de UV)
      * @param meshData Datos del mesh
      * @param fbxMesh Mesh FBX
      */
@@ -127,6 +203,13 @@ private:
      */
     void ExportNormals(MeshData* meshData, FbxMesh* fbxMesh);
 
+    /**
+     * Exportar colores de vértice del mesh (si los tiene)
+     * @param meshData Datos del mesh
+     * @param fbxMesh Mesh FBX
+     */
+    void ExportVertexColors(MeshData* meshData, FbxMesh* fbxMesh);
+
     /**
      * Exportar materiales
      * @param materials Lista de materiales
@@ -156,6 +239,11 @@ private:
         FbxNode* meshNode,
         FrameData* rootFrame);
 
+    /**
+     * Matriz global de un nodo (EvaluateGlobalTransform con caché por nodo)
+     */
+    const FbxAMatrix& GetGlobalTransform(FbxNode* node);
+
     /**
      * Crear hueso (skeleton node)
      * @param boneName Nombre del hueso
@@ -197,8 +285,41 @@ private:
     /**
      * Exportar un clip de animación
      * @param clip Clip a exportar
+     * @return FbxAnimStack* creado para el clip
      */
-    void ExportAnimationClip(const AnimationClip& clip);
+    FbxAnimStack* ExportAnimationClip(const AnimationClip& clip);
+
+    /**
+     * Separar las keys de un track en arrays contiguos por canal (espacio FBX)
+     * @param track Track a convertir
+     * @param data [out] Tiempos por canal y valores por componente
+     */
+    void BuildTrackCurveData(const AnimationTrack& track, TrackCurveData& data);
+
+    /**
+     * Llenar una curva con keys lineales en una sola pasada
+     * @param curve Curva FBX (vacía)
+     * @param times Tiempos de las keys
+     * @param values Valores de las keys
+     */
+    void WriteLinearCurve(
+        FbxAnimCurve* curve,
+        const vector<FbxTime>& times,
+        const vector<float>& values);
+
+    /**
+     * Escribir las curvas de un track como keys cúbicas ajustadas
+     * @param data Arrays por canal del track
+     * @param curves Curvas TX, TY, TZ, RX, RY, RZ, SX, SY, SZ
+     */
+    void ExportFittedCurves(const TrackCurveData& data, FbxAnimCurve* curves[9]);
+
+    /**
+     * Escribir la escena actual a un archivo FBX
+     * @param filename Archivo FBX de salida
+     * @return true si se escribió correctamente
+     */
+    bool WriteScene(const string& filename);
 
     /**
      * Configurar propiedades globales de la escena
@@ -217,13 +338,6 @@ private:
      * @return FrameData* encontrado o nullptr
      */
     FrameData* FindFrameByName(FrameData* root, const string& name);
-
-    /**
-     * Copiar texturas al directorio de salida
-     * @param textureFilename Ruta de la textura original
-     * @return Ruta de la textura copiada
-     */
-    string CopyTexture(const string& textureFilename);
 };
 
 #endif // FBX_EXPORTER_H
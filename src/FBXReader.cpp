@@ -0,0 +1,693 @@
+#include "FBXReader.h"
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <zlib.h>
+
+// "Kaydara FBX Binary  " + '\0'
+static const char FBX_BINARY_MAGIC[21] = "Kaydara FBX Binary  ";
+
+// Límite de anidamiento (protege la recursión ante archivos dañados)
+static const int MAX_DEPTH = 64;
+
+// ============================================================================
+// FBXProperty
+// ============================================================================
+
+int64_t FBXProperty::AsInt() const
+{
+    if (type == 'F' || type == 'D')
+        return (int64_t)doubleValue;
+    return intValue;
+}
+
+double FBXProperty::AsDouble() const
+{
+    if (type == 'F' || type == 'D')
+        return doubleValue;
+    return (double)intValue;
+}
+
+size_t FBXProperty::ArraySize() const
+{
+    return intArray.size() + doubleArray.size();
+}
+
+void FBXProperty::GetArray(std::vector<double>& out) const
+{
+    if (!doubleArray.empty())
+    {
+        out = doubleArray;
+        return;
+    }
+
+    out.resize(intArray.size());
+    for (size_t i = 0; i < intArray.size(); i++)
+        out[i] = (double)intArray[i];
+}
+
+void FBXProperty::GetArray(std::vector<float>& out) const
+{
+    out.resize(ArraySize());
+    for (size_t i = 0; i < doubleArray.size(); i++)
+        out[i] = (float)doubleArray[i];
+    for (size_t i = 0; i < intArray.size(); i++)
+        out[i] = (float)intArray[i];
+}
+
+void FBXProperty::GetArray(std::vector<int64_t>& out) const
+{
+    if (!intArray.empty())
+    {
+        out = intArray;
+        return;
+    }
+
+    out.resize(doubleArray.size());
+    for (size_t i = 0; i < doubleArray.size(); i++)
+        out[i] = (int64_t)doubleArray[i];
+}
+
+void FBXProperty::GetArray(std::vector<int32_t>& out) const
+{
+    out.resize(ArraySize());
+    for (size_t i = 0; i < intArray.size(); i++)
+        out[i] = (int32_t)intArray[i];
+    for (size_t i = 0; i < doubleArray.size(); i++)
+        out[i] = (int32_t)doubleArray[i];
+}
+
+// ============================================================================
+// FBXNode
+// ============================================================================
+
+const FBXNode* FBXNode::Find(const char* childName) const
+{
+    for (const FBXNode& child : children)
+    {
+        if (child.name == childName)
+            return &child;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Constructor / Carga
+// ============================================================================
+
+FBXReader::FBXReader()
+    : m_Position(0)
+    , m_Version(0)
+    , m_Binary(false)
+{
+}
+
+bool FBXReader::Fail(const std::string& message)
+{
+    if (m_LastError.empty())
+        m_LastError = message;
+    return false;
+}
+
+bool FBXReader::Load(const std::string& filename, FBXNode& root)
+{
+    m_Data.clear();
+    m_Position = 0;
+    m_Version = 0;
+    m_LastError.clear();
+
+    root.name.clear();
+    root.properties.clear();
+    root.children.clear();
+
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return Fail("Cannot open file: " + filename);
+
+    std::streamsize size = file.tellg();
+    file.seekg(0);
+    m_Data.resize((size_t)size);
+    if (size > 0 && !file.read(m_Data.data(), size))
+        return Fail("Error reading file: " + filename);
+
+    m_Binary = m_Data.size() >= sizeof(FBX_BINARY_MAGIC) &&
+               memcmp(m_Data.data(), FBX_BINARY_MAGIC, sizeof(FBX_BINARY_MAGIC)) == 0;
+
+    bool result = m_Binary ? ParseBinary(root) : ParseAscii(root);
+
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+    return result;
+}
+
+void FBXReader::SplitObjectName(const std::string& value, std::string& name, std::string& className)
+{
+    size_t separator = value.find(std::string("\x00\x01", 2));
+    if (separator != std::string::npos)
+    {
+        name = value.substr(0, separator);
+        className = value.substr(separator + 2);
+        return;
+    }
+
+    separator = value.find("::");
+    if (separator != std::string::npos)
+    {
+        className = value.substr(0, separator);
+        name = value.substr(separator + 2);
+        return;
+    }
+
+    name = value;
+    className.clear();
+}
+
+// ============================================================================
+// Binario
+// ============================================================================
+// Encabezado: magic (21 bytes), 0x1A 0x00 y versión (uint32). Cada nodo:
+// EndOffset, NumProperties, PropertyListLen (uint32 o uint64 desde 7500),
+// longitud del nombre (uint8), nombre, propiedades e hijos. Un registro con
+// todos los campos a cero termina una lista de nodos.
+// ============================================================================
+
+template<class T>
+bool FBXReader::ReadValue(T& value)
+{
+    if (m_Position + sizeof(T) > m_Data.size())
+        return Fail("Unexpected end of FBX file");
+
+    memcpy(&value, &m_Data[m_Position], sizeof(T));
+    m_Position += sizeof(T);
+    return true;
+}
+
+bool FBXReader::ParseBinary(FBXNode& root)
+{
+    m_Position = 23;
+    if (!ReadValue(m_Version))
+        return false;
+
+    // Nodos de primer nivel hasta el registro nulo (después viene el pie)
+    while (m_Position < m_Data.size())
+    {
+        FBXNode node;
+        bool isNull = false;
+        if (!ParseBinaryNode(node, isNull, 0))
+            return false;
+
+        if (isNull)
+            break;
+
+        root.children.push_back(std::move(node));
+    }
+
+    return true;
+}
+
+bool FBXReader::ParseBinaryNode(FBXNode& node, bool& isNull, int depth)
+{
+    uint64_t endOffset = 0, propertyCount = 0, propertyLength = 0;
+    if (m_Version >= 7500)
+    {
+        if (!ReadValue(endOffset) || !ReadValue(propertyCount) || !ReadValue(propertyLength))
+            return false;
+    }
+    else
+    {
+        uint32_t end32 = 0, count32 = 0, length32 = 0;
+        if (!ReadValue(end32) || !ReadValue(count32) || !ReadValue(length32))
+            return false;
+        endOffset = end32;
+        propertyCount = count32;
+        propertyLength = length32;
+    }
+
+    uint8_t nameLength = 0;
+    if (!ReadValue(nameLength))
+        return false;
+
+    isNull = (endOffset == 0);
+    if (isNull)
+        return true;
+
+    if (endOffset > m_Data.size() || m_Position + nameLength > endOffset)
+        return Fail("Invalid FBX node record");
+
+    node.name.assign(&m_Data[m_Position], nameLength);
+    m_Position += nameLength;
+
+    const size_t propertyEnd = m_Position + (size_t)propertyLength;
+    if (propertyEnd > endOffset || propertyCount > propertyLength)
+        return Fail("Invalid FBX property list in node " + node.name);
+
+    node.properties.resize((size_t)propertyCount);
+    for (FBXProperty& property : node.properties)
+    {
+        if (!ParseBinaryProperty(property))
+            return false;
+    }
+    m_Position = propertyEnd;
+
+    // Hijos hasta el registro nulo o el final del nodo
+    if (m_Position < endOffset && depth >= MAX_DEPTH)
+        return Fail("FBX node hierarchy too deep");
+
+    while (m_Position < endOffset)
+    {
+        FBXNode child;
+        bool childNull = false;
+        if (!ParseBinaryNode(child, childNull, depth + 1))
+            return false;
+
+        if (childNull)
+            break;
+
+        node.children.push_back(std::move(child));
+    }
+
+    m_Position = (size_t)endOffset;
+    return true;
+}
+
+bool FBXReader::ParseBinaryProperty(FBXProperty& property)
+{
+    char type = 0;
+    if (!ReadValue(type))
+        return false;
+
+    property.type = type;
+
+    switch (type)
+    {
+    case 'C':
+    {
+        uint8_t value = 0;
+        if (!ReadValue(value)) return false;
+        property.intValue = value;
+        return true;
+    }
+    case 'Y':
+    {
+        int16_t value = 0;
+        if (!ReadValue(value)) return false;
+        property.intValue = value;
+        return true;
+    }
+    case 'I':
+    {
+        int32_t value = 0;
+        if (!ReadValue(value)) return false;
+        property.intValue = value;
+        return true;
+    }
+    case 'L':
+        return ReadValue(property.intValue);
+    case 'F':
+    {
+        float value = 0.0f;
+        if (!ReadValue(value)) return false;
+        property.doubleValue = value;
+        return true;
+    }
+    case 'D':
+        return ReadValue(property.doubleValue);
+    case 'S':
+    case 'R':
+    {
+        uint32_t length = 0;
+        if (!ReadValue(length))
+            return false;
+        if (m_Position + length > m_Data.size())
+            return Fail("Unexpected end of FBX file");
+        property.stringValue.assign(&m_Data[m_Position], length);
+        m_Position += length;
+        return true;
+    }
+    case 'b':
+        return ReadArray(property, 1);
+    case 'i':
+    case 'f':
+        return ReadArray(property, 4);
+    case 'l':
+    case 'd':
+        return ReadArray(property, 8);
+    default:
+        return Fail(std::string("Unknown FBX property type '") + type + "'");
+    }
+}
+
+bool FBXReader::ReadArray(FBXProperty& property, size_t elementSize)
+{
+    uint32_t count = 0, encoding = 0, byteLength = 0;
+    if (!ReadValue(count) || !ReadValue(encoding) || !ReadValue(byteLength))
+        return false;
+
+    if (m_Position + byteLength > m_Data.size())
+        return Fail("Unexpected end of FBX file");
+
+    const size_t size = (size_t)count * elementSize;
+    const unsigned char* source = (const unsigned char*)&m_Data[m_Position];
+    std::vector<unsigned char> inflated;
+
+    if (encoding == 1)
+    {
+        inflated.resize(size);
+        uLongf inflatedSize = (uLongf)size;
+        if (uncompress(inflated.data(), &inflatedSize, source, (uLong)byteLength) != Z_OK || inflatedSize != size)
+            return Fail("Corrupt compressed FBX array");
+        source = inflated.data();
+    }
+    else if (byteLength != size)
+    {
+        return Fail("Invalid FBX array length");
+    }
+
+    m_Position += byteLength;
+
+    switch (property.type)
+    {
+    case 'b':
+        property.intArray.assign(source, source + count);
+        break;
+    case 'i':
+    {
+        property.intArray.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            int32_t value;
+            memcpy(&value, source + i * 4, 4);
+            property.intArray[i] = value;
+        }
+        break;
+    }
+    case 'l':
+        property.intArray.resize(count);
+        memcpy(property.intArray.data(), source, size);
+        break;
+    case 'f':
+    {
+        property.doubleArray.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float value;
+            memcpy(&value, source + i * 4, 4);
+            property.doubleArray[i] = value;
+        }
+        break;
+    }
+    case 'd':
+        property.doubleArray.resize(count);
+        memcpy(property.doubleArray.data(), source, size);
+        break;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// ASCII
+// ============================================================================
+// Nombre: propiedades separadas por comas y, opcionalmente, "{ hijos }".
+// Los arrays son "*N { a: v,v,... }". Los comentarios empiezan con ';'.
+// Un identificador seguido de ':' abre el siguiente nodo; cualquier otro
+// identificador es un valor sin comillas (T, F, Y, N...).
+// ============================================================================
+
+void FBXReader::SkipWhitespace()
+{
+    const size_t size = m_Data.size();
+    while (m_Position < size)
+    {
+        char c = m_Data[m_Position];
+        if (c == ';')
+        {
+            while (m_Position < size && m_Data[m_Position] != '\n')
+                m_Position++;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        {
+            m_Position++;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+size_t FBXReader::IdentifierLength() const
+{
+    size_t end = m_Position;
+    while (end < m_Data.size())
+    {
+        char c = m_Data[end];
+        if (!(isalnum((unsigned char)c) || c == '_' || c == '|'))
+            break;
+        end++;
+    }
+    return end - m_Position;
+}
+
+bool FBXReader::ParseAscii(FBXNode& root)
+{
+    // Versión desde el comentario "; FBX 7.4.0 project file"
+    const char* versionTag = "; FBX ";
+    if (m_Data.size() > 12 && memcmp(m_Data.data(), versionTag, 6) == 0)
+    {
+        int major = m_Data[6] - '0', minor = m_Data[8] - '0';
+        m_Version = (uint32_t)(major * 1000 + minor * 100);
+    }
+
+    m_Position = 0;
+    SkipWhitespace();
+
+    while (m_Position < m_Data.size())
+    {
+        FBXNode node;
+        if (!ParseAsciiNode(node, 0))
+            return false;
+
+        root.children.push_back(std::move(node));
+        SkipWhitespace();
+    }
+
+    return true;
+}
+
+bool FBXReader::ParseAsciiNode(FBXNode& node, int depth)
+{
+    size_t nameLength = IdentifierLength();
+    if (nameLength == 0 || m_Position + nameLength >= m_Data.size() || m_Data[m_Position + nameLength] != ':')
+        return Fail("Expected FBX node name at offset " + std::to_string(m_Position));
+
+    node.name.assign(&m_Data[m_Position], nameLength);
+    m_Position += nameLength + 1;
+
+    // Propiedades
+    for (;;)
+    {
+        SkipWhitespace();
+        if (m_Position >= m_Data.size())
+            break;
+
+        char c = m_Data[m_Position];
+        FBXProperty property;
+
+        if (c == '"')
+        {
+            size_t end = m_Position + 1;
+            while (end < m_Data.size() && m_Data[end] != '"')
+                end++;
+            if (end >= m_Data.size())
+                return Fail("Unterminated string in FBX node " + node.name);
+
+            property.type = 'S';
+            property.stringValue.assign(&m_Data[m_Position + 1], end - m_Position - 1);
+
+            // Comillas internas escritas como &quot;
+            size_t quote = 0;
+            while ((quote = property.stringValue.find("&quot;", quote)) != std::string::npos)
+                property.stringValue.replace(quote, 6, "\"");
+
+            m_Position = end + 1;
+        }
+        else if (c == '*')
+        {
+            if (!ParseAsciiArray(property))
+                return false;
+        }
+        else if (isdigit((unsigned char)c) || c == '-' || c == '+' || c == '.')
+        {
+            ParseAsciiNumber(property);
+        }
+        else if (isalpha((unsigned char)c) || c == '_')
+        {
+            // ¿Valor sin comillas o nombre del siguiente nodo?
+            size_t length = IdentifierLength();
+            size_t next = m_Position + length;
+            while (next < m_Data.size() && (m_Data[next] == ' ' || m_Data[next] == '\t'))
+                next++;
+            if (next < m_Data.size() && m_Data[next] == ':')
+                break;
+
+            property.type = 'C';
+            property.stringValue.assign(&m_Data[m_Position], length);
+            property.intValue = (c == 'T' || c == 'Y' || c == 'W') ? 1 : 0;
+            m_Position += length;
+        }
+        else
+        {
+            break;
+        }
+
+        node.properties.push_back(std::move(property));
+
+        SkipWhitespace();
+        if (m_Position < m_Data.size() && m_Data[m_Position] == ',')
+        {
+            m_Position++;
+            continue;
+        }
+        break;
+    }
+
+    // Hijos
+    SkipWhitespace();
+    if (m_Position < m_Data.size() && m_Data[m_Position] == '{')
+    {
+        m_Position++;
+
+        if (depth >= MAX_DEPTH)
+            return Fail("FBX node hierarchy too deep");
+
+        for (;;)
+        {
+            SkipWhitespace();
+            if (m_Position >= m_Data.size())
+                return Fail("Unterminated FBX node " + node.name);
+
+            if (m_Data[m_Position] == '}')
+            {
+                m_Position++;
+                break;
+            }
+
+            FBXNode child;
+            if (!ParseAsciiNode(child, depth + 1))
+                return false;
+            node.children.push_back(std::move(child));
+        }
+    }
+
+    return true;
+}
+
+void FBXReader::ParseAsciiNumber(FBXProperty& property)
+{
+    const char* start = &m_Data[m_Position];
+    const char* end = m_Data.data() + m_Data.size();
+
+    const char* tokenEnd = start;
+    bool integral = true;
+    while (tokenEnd < end)
+    {
+        char c = *tokenEnd;
+        if (c == '.' || c == 'e' || c == 'E' || isalpha((unsigned char)c) || c == '#')
+            integral = false;
+        else if (!(isdigit((unsigned char)c) || c == '-' || c == '+'))
+            break;
+        tokenEnd++;
+    }
+
+    // "+" no es aceptado por from_chars
+    const char* first = (*start == '+') ? start + 1 : start;
+
+    if (integral)
+    {
+        property.type = 'L';
+        std::from_chars(first, tokenEnd, property.intValue);
+        property.doubleValue = (double)property.intValue;
+    }
+    else
+    {
+        property.type = 'D';
+        std::from_chars(first, tokenEnd, property.doubleValue);
+    }
+
+    m_Position = (size_t)(tokenEnd - m_Data.data());
+}
+
+bool FBXReader::ParseAsciiArray(FBXProperty& property)
+{
+    // *N {
+    m_Position++;
+    size_t count = 0;
+    const char* end = m_Data.data() + m_Data.size();
+    std::from_chars_result result = std::from_chars(&m_Data[m_Position], end, count);
+    m_Position = (size_t)(result.ptr - m_Data.data());
+
+    SkipWhitespace();
+    if (m_Position >= m_Data.size() || m_Data[m_Position] != '{')
+        return Fail("Invalid FBX ASCII array");
+    m_Position++;
+
+    // a: v,v,...
+    SkipWhitespace();
+    if (m_Position + 1 < m_Data.size() && m_Data[m_Position] == 'a' && m_Data[m_Position + 1] == ':')
+        m_Position += 2;
+
+    std::vector<double> doubles;
+    std::vector<int64_t> ints;
+    bool integral = true;
+    doubles.reserve(count);
+    ints.reserve(count);
+
+    for (;;)
+    {
+        SkipWhitespace();
+        if (m_Position >= m_Data.size())
+            return Fail("Unterminated FBX ASCII array");
+
+        char c = m_Data[m_Position];
+        if (c == '}')
+        {
+            m_Position++;
+            break;
+        }
+        if (c == ',')
+        {
+            m_Position++;
+            continue;
+        }
+
+        FBXProperty value;
+        size_t before = m_Position;
+        ParseAsciiNumber(value);
+        if (m_Position == before)
+            return Fail("Invalid value in FBX ASCII array");
+
+        if (value.type == 'D')
+            integral = false;
+        doubles.push_back(value.doubleValue);
+        if (integral)
+            ints.push_back(value.intValue);
+    }
+
+    if (integral)
+    {
+        property.type = 'l';
+        property.intArray.swap(ints);
+    }
+    else
+    {
+        property.type = 'd';
+        property.doubleArray.swap(doubles);
+    }
+
+    if (property.ArraySize() != count)
+        return Fail("FBX ASCII array size mismatch");
+
+    return true;
+}
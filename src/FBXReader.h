@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef FBX_READER_H
+#define FBX_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct FBXProperty
+ * @brief Propiedad de un nodo FBX leído (escalar, string o array)
+ *
+ * Los valores se guardan en el tipo más ancho de su familia: enteros y
+ * booleanos en int64, float y double en double. En ASCII el tipo no está
+ * escrito: los números sin parte decimal ni exponente se leen como enteros
+ * y los accesores convierten entre familias.
+ */
+struct FBXProperty
+{
+    char type;                          // Código del formato binario ('I', 'D', 'S', 'd', 'i'...)
+    int64_t intValue;
+    double doubleValue;
+    std::string stringValue;            // 'S' y 'R'
+    std::vector<int64_t> intArray;      // 'i', 'l', 'b'
+    std::vector<double> doubleArray;    // 'f', 'd'
+
+    FBXProperty() : type(0), intValue(0), doubleValue(0.0) {}
+
+    bool IsArray() const { return type >= 'a' && type <= 'z'; }
+    bool IsString() const { return type == 'S' || type == 'R'; }
+
+    int64_t AsInt() const;
+    double AsDouble() const;
+
+    // Número de elementos del array (0 si no es un array)
+    size_t ArraySize() const;
+
+    // Copiar el array convirtiendo al tipo pedido
+    void GetArray(std::vector<double>& out) const;
+    void GetArray(std::vector<float>& out) const;
+    void GetArray(std::vector<int64_t>& out) const;
+    void GetArray(std::vector<int32_t>& out) const;
+};
+
+/**
+ * @struct FBXNode
+ * @brief Nodo de un documento FBX: nombre, propiedades e hijos
+ */
+struct FBXNode
+{
+    std::string name;
+    std::vector<FBXProperty> properties;
+    std::vector<FBXNode> children;
+
+    /**
+     * Primer hijo con el nombre dado
+     * @return nullptr si no existe
+     */
+    const FBXNode* Find(const char* childName) const;
+
+    // Propiedad 'index' (nullptr si no existe)
+    const FBXProperty* Property(size_t index) const
+    {
+        return index < properties.size() ? &properties[index] : nullptr;
+    }
+};
+
+/**
+ * @class FBXReader
+ * @brief Lee un archivo FBX 7.x (binario o ASCII) como árbol de nodos
+ *
+ * Es la lectura inversa de FBXBinaryWriter/FBXAsciiWriter y no interpreta
+ * la escena (eso lo hace NativeFBXImporter). El archivo se lee completo
+ * en memoria con una sola lectura:
+ *   - Binario: registros con offsets de 32 bits (< 7500) o 64 bits, arrays
+ *     sin comprimir o zlib (se descomprimen directamente a su tamaño final)
+ *   - ASCII: tokenizador sobre el buffer, números con std::from_chars
+ *
+ * Solo depende de la biblioteca estándar y de zlib.
+ */
+class FBXReader
+{
+public:
+    FBXReader();
+
+    /**
+     * Leer un archivo
+     * @param filename Archivo FBX
+     * @param root [out] Nodo raíz sin nombre; sus hijos son los nodos de primer nivel
+     * @return true si el archivo se leyó completo
+     */
+    bool Load(const std::string& filename, FBXNode& root);
+
+    // Versión del archivo (7400, 7500...) y formato
+    uint32_t GetVersion() const { return m_Version; }
+    bool IsBinary() const { return m_Binary; }
+
+    /**
+     * Obtener último mensaje de error
+     */
+    const std::string& GetLastError() const { return m_LastError; }
+
+    /**
+     * Separar el nombre de un objeto en nombre y clase
+     * Binario: "nombre\x00\x01Clase", ASCII: "Clase::nombre"
+     */
+    static void SplitObjectName(const std::string& value, std::string& name, std::string& className);
+
+private:
+    std::vector<char> m_Data;
+    size_t m_Position;
+    uint32_t m_Version;
+    bool m_Binary;
+    std::string m_LastError;
+
+    bool Fail(const std::string& message);
+
+    // Binario
+    bool ParseBinary(FBXNode& root);
+    bool ParseBinaryNode(FBXNode& node, bool& isNull, int depth);
+    bool ParseBinaryProperty(FBXProperty& property);
+    bool ReadArray(FBXProperty& property, size_t elementSize);
+
+    template<class T>
+    bool ReadValue(T& value);
+
+    // ASCII
+    bool ParseAscii(FBXNode& root);
+    bool ParseAsciiNode(FBXNode& node, int depth);
+    bool ParseAsciiArray(FBXProperty& property);
+    void ParseAsciiNumber(FBXProperty& property);
+    void SkipWhitespace();
+    size_t IdentifierLength() const;
+};
+
+#endif // FBX_READER_H
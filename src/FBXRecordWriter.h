@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef FBX_RECORD_WRITER_H
+#define FBX_RECORD_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class FBXRecordWriter
+ * @brief Interfaz de escritura de nodos FBX (formato de registros de FBX 7.x)
+ *
+ * Un archivo FBX es una lista de nodos; cada nodo tiene un nombre, una lista
+ * de propiedades (escalares, strings o arrays) y nodos hijos:
+ *
+ *   BeginNode("Model");
+ *   AddInt64(id); AddObjectName("Hips", "Model"); AddString("LimbNode");
+ *       BeginNode("Version"); AddInt32(232); EndNode();
+ *   EndNode();
+ *
+ * Las propiedades de un nodo se agregan antes de su primer hijo. Cada
+ * formato (binario, ASCII) implementa la codificación; el recorrido de la
+ * escena (NativeFBXExporter) es el mismo para todos.
+ *
+ * Un formato puede ofrecer fragmentos: writers en memoria donde otros hilos
+ * serializan nodos hijos del nodo actual, que después se agregan en orden
+ * con AppendFragments().
+ *
+ * No depende de DirectX ni del FBX SDK.
+ */
+class FBXRecordWriter
+{
+public:
+    virtual ~FBXRecordWriter() {}
+
+    /**
+     * Abrir un nodo hijo del nodo actual (o de primer nivel)
+     * @param name Nombre del nodo
+     */
+    virtual void BeginNode(const char* name) = 0;
+
+    /**
+     * Cerrar el nodo actual
+     */
+    virtual void EndNode() = 0;
+
+    // Propiedades escalares
+    virtual void AddBool(bool value) = 0;
+    virtual void AddInt32(int32_t value) = 0;
+    virtual void AddInt64(int64_t value) = 0;
+    virtual void AddFloat(float value) = 0;
+    virtual void AddDouble(double value) = 0;
+
+    /**
+     * Agregar una propiedad string
+     * @param data Caracteres (pueden incluir '\0')
+     * @param length Número de bytes
+     */
+    virtual void AddString(const char* data, size_t length) = 0;
+
+    void AddString(const std::string& value) { AddString(value.data(), value.size()); }
+    void AddString(const char* value) { AddString(std::string(value)); }
+
+    /**
+     * Agregar el nombre de un objeto con su clase
+     * Binario: "nombre\x00\x01Clase", ASCII: "Clase::nombre"
+     */
+    virtual void AddObjectName(const std::string& name, const char* className) = 0;
+
+    /**
+     * Agregar una propiedad de bytes sin interpretar (tipo 'R')
+     */
+    virtual void AddRaw(const void* data, size_t size) = 0;
+
+    // Propiedades array
+    virtual void AddInt32Array(const int32_t* values, size_t count) = 0;
+    virtual void AddInt64Array(const int64_t* values, size_t count) = 0;
+    virtual void AddFloatArray(const float* values, size_t count) = 0;
+    virtual void AddDoubleArray(const double* values, size_t count) = 0;
+
+    /**
+     * Crear un writer en memoria para nodos hijos del nodo actual
+     * Cada fragmento se usa desde un solo hilo.
+     * @return nullptr si el formato no admite fragmentos
+     */
+    virtual std::unique_ptr<FBXRecordWriter> CreateFragment() const { return nullptr; }
+
+    /**
+     * Agregar los nodos de los fragmentos como hijos del nodo actual, en orden
+     * @param fragments Fragmentos creados con CreateFragment() de este writer
+     */
+    virtual void AppendFragments(std::vector<std::unique_ptr<FBXRecordWriter>>& /*fragments*/) {}
+};
+
+#endif // FBX_RECORD_WRITER_H
@@ -0,0 +1,1065 @@
+#include "GLTFExporter.h"
+#include "FBXExporter.h"
+#include "MatrixConverter.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+// ============================================================================
+// Constantes del formato
+// ============================================================================
+
+static const uint32_t GLB_MAGIC = 0x46546C67;          // "glTF"
+static const uint32_t GLB_VERSION = 2;
+static const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;     // "JSON"
+static const uint32_t GLB_CHUNK_BIN = 0x004E4942;      // "BIN\0"
+
+// componentType de los accessors
+static const int GLTF_UNSIGNED_BYTE = 5121;
+static const int GLTF_UNSIGNED_SHORT = 5123;
+static const int GLTF_UNSIGNED_INT = 5125;
+static const int GLTF_FLOAT = 5126;
+
+// target de los bufferViews (0 = sin target: animación, matrices)
+static const int GLTF_ARRAY_BUFFER = 34962;
+static const int GLTF_ELEMENT_ARRAY_BUFFER = 34963;
+
+// ============================================================================
+// Helpers de JSON
+// ============================================================================
+
+static void AppendNumber(string& json, double value)
+{
+    if (!std::isfinite(value))
+        value = 0.0;
+
+    char text[32];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    json.append(text, result.ptr);
+}
+
+static void AppendNumber(string& json, float value)
+{
+    if (!std::isfinite(value))
+        value = 0.0f;
+
+    char text[32];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    json.append(text, result.ptr);
+}
+
+static void AppendNumber(string& json, size_t value)
+{
+    char text[32];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    json.append(text, result.ptr);
+}
+
+static void AppendNumber(string& json, int value)
+{
+    char text[16];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    json.append(text, result.ptr);
+}
+
+static void AppendString(string& json, const string& value)
+{
+    json += '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            json += '\\';
+            json += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            static const char HEX[] = "0123456789abcdef";
+            json += "\\u00";
+            json += HEX[(c >> 4) & 0xf];
+            json += HEX[c & 0xf];
+        }
+        else
+        {
+            json += c;
+        }
+    }
+    json += '"';
+}
+
+template<class T>
+static void AppendArray(string& json, const T* values, size_t count)
+{
+    json += '[';
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            json += ',';
+        AppendNumber(json, values[i]);
+    }
+    json += ']';
+}
+
+// Separador antes de un nuevo elemento de una lista JSON
+static void BeginElement(string& list)
+{
+    if (!list.empty())
+        list += ',';
+}
+
+// Ruta de textura como URI relativa (barras normales, espacios escapados)
+static string MakeUri(const string& path)
+{
+    string uri;
+    for (char c : path)
+    {
+        if (c == '\\')
+            uri += '/';
+        else if (c == ' ')
+            uri += "%20";
+        else
+            uri += c;
+    }
+    return uri;
+}
+
+// Matriz DirectX (LH) a glTF (RH, Z invertida) con escala global en la
+// traslación (igual que NativeFBXExporter)
+static D3DXMATRIX ConvertMatrix_LH_to_RH(const D3DXMATRIX& matrix, float scale)
+{
+    D3DXMATRIX result = matrix;
+    result.m[0][2] = -result.m[0][2];
+    result.m[1][2] = -result.m[1][2];
+    result.m[2][0] = -result.m[2][0];
+    result.m[2][1] = -result.m[2][1];
+    result.m[2][3] = -result.m[2][3];
+    result.m[3][2] = -result.m[3][2];
+
+    result.m[3][0] *= scale;
+    result.m[3][1] *= scale;
+    result.m[3][2] *= scale;
+    return result;
+}
+
+// Quaternion DirectX (LH) a glTF (RH): X e Y negadas, normalizado
+// (ver MatrixConverter::ConvertQuaternion_LH_to_RH)
+static void ConvertQuaternion_LH_to_RH(const D3DXQUATERNION& q, float* out)
+{
+    float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    float inverse = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+    out[0] = -q.x * inverse;
+    out[1] = -q.y * inverse;
+    out[2] = q.z * inverse;
+    out[3] = (length > 0.0f) ? q.w * inverse : 1.0f;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+GLTFExporter::GLTFExporter()
+    : m_BinaryLength(0)
+    , m_AccessorCount(0)
+    , m_MeshCount(0)
+    , m_SkinCount(0)
+{
+    D3DXMatrixIdentity(&m_Identity);
+}
+
+// ============================================================================
+// Exportación Principal
+// ============================================================================
+
+bool GLTFExporter::ExportScene(
+    const SceneData& sceneData,
+    const string& filename,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+    m_LastError.clear();
+    m_Nodes.clear();
+    m_NodeByName.clear();
+    m_BufferViews.clear();
+    m_BinaryLength = 0;
+    m_Storage.clear();
+    m_TrackAccessors.clear();
+    m_TextureByUri.clear();
+    m_AccessorsJson.clear();
+    m_MeshesJson.clear();
+    m_MaterialsJson.clear();
+    m_TexturesJson.clear();
+    m_ImagesJson.clear();
+    m_SkinsJson.clear();
+    m_AnimationsJson.clear();
+    m_AccessorCount = m_MeshCount = m_SkinCount = 0;
+
+    if (!sceneData.rootFrame)
+    {
+        m_LastError = "No root frame in scene data";
+        return false;
+    }
+
+    if (m_Options.targetCoordSystem != CoordinateSystem::RIGHT_HANDED || m_Options.upAxis != UpAxis::Y_AXIS)
+        Utils::LogWarning("glTF is always right-handed Y-up; axis options ignored for " + filename);
+
+    Utils::Log("Exporting glTF binary: " + filename, options.verbose);
+
+    CollectNodes(sceneData.rootFrame);
+    WriteMaterials(sceneData, filename);
+
+    for (NodeEntry& node : m_Nodes)
+    {
+        if (node.meshData)
+            WriteMesh(*node.meshData, node);
+    }
+
+    for (const AnimationClip& clip : sceneData.animations)
+        WriteAnimation(clip);
+
+    if (!WriteFile(filename, BuildJson()))
+        return false;
+
+    if (options.verbose)
+    {
+        Utils::LogStream() << "  glTF: " << m_Nodes.size() << " nodes, " << m_MeshCount << " meshes, "
+                           << m_SkinCount << " skins, " << m_AccessorCount << " accessors, "
+                           << m_BinaryLength << " bytes of binary data\n";
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Nodos
+// ============================================================================
+// Frames en DFS (padres antes que hijos), un nodo "<mesh>_node" hijo del
+// frame por cada mesh y los huesos sin frame como nodos raíz con su matriz
+// de enlace (igual que NativeFBXExporter).
+// ============================================================================
+
+void GLTFExporter::CollectNodes(const FrameData* root)
+{
+    vector<pair<const FrameData*, int>> stack;
+    vector<pair<const FrameData*, int>> frames;
+    stack.push_back(make_pair(root, -1));
+
+    while (!stack.empty())
+    {
+        const FrameData* frame = stack.back().first;
+        const int parent = stack.back().second;
+        stack.pop_back();
+
+        NodeEntry node;
+        node.name = frame->name;
+        node.localMatrix = &frame->transformMatrix;
+        node.parent = parent;
+        node.meshData = nullptr;
+        node.mesh = -1;
+        node.skin = -1;
+
+        const int index = (int)m_Nodes.size();
+        m_Nodes.push_back(node);
+        if (parent >= 0)
+            m_Nodes[parent].children.push_back(index);
+        if (!frame->name.empty())
+            m_NodeByName[frame->name] = index;
+
+        frames.push_back(make_pair(frame, index));
+
+        for (size_t i = frame->children.size(); i-- > 0;)
+            stack.push_back(make_pair(frame->children[i], index));
+    }
+
+    for (const auto& entry : frames)
+    {
+        for (const MeshData* mesh : entry.first->meshes)
+        {
+            if (!mesh || mesh->vertices.empty())
+                continue;
+
+            NodeEntry meshNode;
+            meshNode.name = mesh->name + "_node";
+            meshNode.localMatrix = &m_Identity;
+            meshNode.parent = entry.second;
+            meshNode.meshData = mesh;
+            meshNode.mesh = -1;
+            meshNode.skin = -1;
+
+            m_Nodes[entry.second].children.push_back((int)m_Nodes.size());
+            m_Nodes.push_back(meshNode);
+
+            if (!mesh->hasSkinning)
+                continue;
+
+            for (const BoneData& bone : mesh->bones)
+            {
+                if (m_NodeByName.find(bone.name) != m_NodeByName.end())
+                    continue;
+
+                NodeEntry dummy;
+                dummy.name = bone.name;
+                dummy.localMatrix = &bone.transformMatrix;
+                dummy.parent = -1;
+                dummy.meshData = nullptr;
+                dummy.mesh = -1;
+                dummy.skin = -1;
+
+                m_NodeByName[bone.name] = (int)m_Nodes.size();
+                m_Nodes.push_back(dummy);
+            }
+        }
+    }
+
+    // TRS de todos los nodos en un lote, convertidos a RH
+    const size_t nodeCount = m_Nodes.size();
+    const float scale = m_Options.scale;
+
+    vector<D3DXMATRIX> locals(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++)
+        locals[i] = *m_Nodes[i].localMatrix;
+
+    DecomposedTransforms trs;
+    MatrixConverter::DecomposeMatrices(locals.data(), nodeCount, trs);
+
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        NodeEntry& node = m_Nodes[i];
+        node.translation[0] = trs.translations[i].x * scale;
+        node.translation[1] = trs.translations[i].y * scale;
+        node.translation[2] = -trs.translations[i].z * scale;
+        ConvertQuaternion_LH_to_RH(trs.rotations[i], node.rotation);
+        node.scale[0] = trs.scales[i].x;
+        node.scale[1] = trs.scales[i].y;
+        node.scale[2] = trs.scales[i].z;
+    }
+}
+
+// ============================================================================
+// Materiales
+// ============================================================================
+// D3DMATERIAL9 -> pbrMetallicRoughness: color difuso como baseColor, sin
+// metal, rugosidad desde el exponente especular (Blinn-Phong -> GGX:
+// sqrt(2 / (Power + 2))) y emisivo. Cada textura distinta es un image con
+// su URI relativa (copiada a textures/ si se exportan las texturas).
+// ============================================================================
+
+void GLTFExporter::WriteMaterials(const SceneData& sceneData, const string& filename)
+{
+    for (const MaterialData& material : sceneData.materials)
+    {
+        const D3DMATERIAL9& m = material.material;
+
+        float baseColor[4] =
+        {
+            min(max(m.Diffuse.r, 0.0f), 1.0f),
+            min(max(m.Diffuse.g, 0.0f), 1.0f),
+            min(max(m.Diffuse.b, 0.0f), 1.0f),
+            min(max(m.Diffuse.a, 0.0f), 1.0f)
+        };
+        float emissive[3] =
+        {
+            min(max(m.Emissive.r, 0.0f), 1.0f),
+            min(max(m.Emissive.g, 0.0f), 1.0f),
+            min(max(m.Emissive.b, 0.0f), 1.0f)
+        };
+        float roughness = min(sqrtf(2.0f / (max(m.Power, 0.0f) + 2.0f)), 1.0f);
+
+        BeginElement(m_MaterialsJson);
+        m_MaterialsJson += "{\"name\":";
+        AppendString(m_MaterialsJson, material.name);
+        m_MaterialsJson += ",\"pbrMetallicRoughness\":{\"baseColorFactor\":";
+        AppendArray(m_MaterialsJson, baseColor, 4);
+        m_MaterialsJson += ",\"metallicFactor\":0,\"roughnessFactor\":";
+        AppendNumber(m_MaterialsJson, roughness);
+
+        if (!material.textureFilename.empty())
+        {
+            string uri;
+            if (m_Options.exportTextures)
+            {
+                FBXExporter::CopyTexture(material.textureFilename, filename);
+
+                string textureName = material.textureFilename;
+                size_t slash = textureName.find_last_of("\\/");
+                if (slash != string::npos)
+                    textureName = textureName.substr(slash + 1);
+                uri = MakeUri("textures/" + textureName);
+            }
+            else
+            {
+                uri = MakeUri(material.textureFilename);
+            }
+
+            auto it = m_TextureByUri.find(uri);
+            if (it == m_TextureByUri.end())
+            {
+                // Un texture por image, con el sampler común
+                int index = (int)m_TextureByUri.size();
+                it = m_TextureByUri.insert(make_pair(uri, index)).first;
+
+                BeginElement(m_ImagesJson);
+                m_ImagesJson += "{\"uri\":";
+                AppendString(m_ImagesJson, uri);
+                m_ImagesJson += "}";
+
+                BeginElement(m_TexturesJson);
+                m_TexturesJson += "{\"sampler\":0,\"source\":";
+                AppendNumber(m_TexturesJson, index);
+                m_TexturesJson += "}";
+            }
+
+            m_MaterialsJson += ",\"baseColorTexture\":{\"index\":";
+            AppendNumber(m_MaterialsJson, it->second);
+            m_MaterialsJson += "}";
+        }
+
+        m_MaterialsJson += "}";
+
+        if (emissive[0] > 0.0f || emissive[1] > 0.0f || emissive[2] > 0.0f)
+        {
+            m_MaterialsJson += ",\"emissiveFactor\":";
+            AppendArray(m_MaterialsJson, emissive, 3);
+        }
+
+        if (baseColor[3] < 1.0f)
+            m_MaterialsJson += ",\"alphaMode\":\"BLEND\"";
+
+        m_MaterialsJson += "}";
+    }
+}
+
+// ============================================================================
+// Meshes y Skins
+// ============================================================================
+// Atributos como arrays SoA convertidos (posiciones y normales con Z
+// invertida, UVs sin cambios). Los índices se escriben tal cual desde
+// MeshData::indices (mismo winding que el original, ver
+// FBXExporter::ExportGeometry); solo con varios materiales se reordenan
+// los triángulos por material para tener una primitiva contigua por cada uno.
+// ============================================================================
+
+void GLTFExporter::WriteMesh(const MeshData& mesh, NodeEntry& node)
+{
+    const vector<Vertex>& vertices = mesh.vertices;
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = mesh.indices.size() / 3;
+    const float scale = m_Options.scale;
+
+    if (triangleCount == 0)
+        return;
+
+    string attributes;
+
+    // Posiciones (con min/max, obligatorios en POSITION)
+    float* positions = Allocate<float>(vertexCount * 3);
+    float minPosition[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maxPosition[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const D3DXVECTOR3& p = vertices[i].position;
+        float* out = positions + i * 3;
+        out[0] = p.x * scale;
+        out[1] = p.y * scale;
+        out[2] = -p.z * scale;
+
+        for (int c = 0; c < 3; c++)
+        {
+            minPosition[c] = min(minPosition[c], out[c]);
+            maxPosition[c] = max(maxPosition[c], out[c]);
+        }
+    }
+
+    int view = AddBufferView(positions, vertexCount * 3 * sizeof(float), GLTF_ARRAY_BUFFER);
+    attributes += "\"POSITION\":";
+    AppendNumber(attributes, AddAccessor(view, 0, GLTF_FLOAT, vertexCount, "VEC3", minPosition, maxPosition, 3));
+
+    // Normales (glTF exige longitud 1)
+    float* normals = Allocate<float>(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const D3DXVECTOR3& n = vertices[i].normal;
+        float length = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+        float inverse = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+        float* out = normals + i * 3;
+        out[0] = n.x * inverse;
+        out[1] = (length > 0.0f) ? n.y * inverse : 1.0f;
+        out[2] = -n.z * inverse;
+    }
+
+    view = AddBufferView(normals, vertexCount * 3 * sizeof(float), GLTF_ARRAY_BUFFER);
+    attributes += ",\"NORMAL\":";
+    AppendNumber(attributes, AddAccessor(view, 0, GLTF_FLOAT, vertexCount, "VEC3"));
+
+    // UVs
+    for (DWORD set = 0; set < mesh.texCoordSetCount && set < MAX_TEXCOORD_SETS; set++)
+    {
+        float* texCoords = Allocate<float>(vertexCount * 2);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const D3DXVECTOR2& uv = (set == 0) ? vertices[i].texCoord : vertices[i].extraTexCoords[set - 1];
+            texCoords[i * 2 + 0] = uv.x;
+            texCoords[i * 2 + 1] = uv.y;
+        }
+
+        view = AddBufferView(texCoords, vertexCount * 2 * sizeof(float), GLTF_ARRAY_BUFFER);
+        attributes += ",\"TEXCOORD_";
+        AppendNumber(attributes, (int)set);
+        attributes += "\":";
+        AppendNumber(attributes, AddAccessor(view, 0, GLTF_FLOAT, vertexCount, "VEC2"));
+    }
+
+    // Colores de vértice
+    if (mesh.hasVertexColors)
+    {
+        float* colors = Allocate<float>(vertexCount * 4);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const D3DXCOLOR& c = vertices[i].color;
+            colors[i * 4 + 0] = c.r;
+            colors[i * 4 + 1] = c.g;
+            colors[i * 4 + 2] = c.b;
+            colors[i * 4 + 3] = c.a;
+        }
+
+        view = AddBufferView(colors, vertexCount * 4 * sizeof(float), GLTF_ARRAY_BUFFER);
+        attributes += ",\"COLOR_0\":";
+        AppendNumber(attributes, AddAccessor(view, 0, GLTF_FLOAT, vertexCount, "VEC4"));
+    }
+
+    // Skin: joints = huesos del mesh en orden, pesos normalizados
+    const size_t boneCount = mesh.bones.size();
+    if (mesh.hasSkinning && boneCount > 0)
+    {
+        const bool wideJoints = boneCount > 256;
+        BYTE* joints8 = wideJoints ? nullptr : Allocate<BYTE>(vertexCount * 4);
+        uint16_t* joints16 = wideJoints ? Allocate<uint16_t>(vertexCount * 4) : nullptr;
+        float* weights = Allocate<float>(vertexCount * 4);
+
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const Vertex& vertex = vertices[i];
+
+            float total = 0.0f;
+            for (int k = 0; k < MAX_BONE_INFLUENCES; k++)
+            {
+                if (vertex.boneWeights[k] > 0.0f && vertex.boneIndices[k] < boneCount)
+                    total += vertex.boneWeights[k];
+            }
+
+            for (int k = 0; k < 4; k++)
+            {
+                DWORD joint = 0;
+                float weight = 0.0f;
+                if (k < MAX_BONE_INFLUENCES && total > 0.0f &&
+                    vertex.boneWeights[k] > 0.0f && vertex.boneIndices[k] < boneCount)
+                {
+                    joint = vertex.boneIndices[k];
+                    weight = vertex.boneWeights[k] / total;
+                }
+
+                if (wideJoints)
+                    joints16[i * 4 + k] = (uint16_t)joint;
+                else
+                    joints8[i * 4 + k] = (BYTE)joint;
+                weights[i * 4 + k] = weight;
+            }
+        }
+
+        if (wideJoints)
+        {
+            view = AddBufferView(joints16, vertexCount * 4 * sizeof(uint16_t), GLTF_ARRAY_BUFFER);
+            attributes += ",\"JOINTS_0\":";
+            AppendNumber(attributes, AddAccessor(view, 0, GLTF_UNSIGNED_SHORT, vertexCount, "VEC4"));
+        }
+        else
+        {
+            view = AddBufferView(joints8, vertexCount * 4, GLTF_ARRAY_BUFFER);
+            attributes += ",\"JOINTS_0\":";
+            AppendNumber(attributes, AddAccessor(view, 0, GLTF_UNSIGNED_BYTE, vertexCount, "VEC4"));
+        }
+
+        view = AddBufferView(weights, vertexCount * 4 * sizeof(float), GLTF_ARRAY_BUFFER);
+        attributes += ",\"WEIGHTS_0\":";
+        AppendNumber(attributes, AddAccessor(view, 0, GLTF_FLOAT, vertexCount, "VEC4"));
+
+        // inverseBindMatrices: offsetMatrix en RH. Con vectores fila, la
+        // matriz D3DX fila a fila es la matriz glTF columna a columna
+        float* inverseBind = Allocate<float>(boneCount * 16);
+        string jointNodes;
+        for (size_t b = 0; b < boneCount; b++)
+        {
+            D3DXMATRIX offset = ConvertMatrix_LH_to_RH(mesh.bones[b].offsetMatrix, scale);
+            memcpy(inverseBind + b * 16, &offset.m[0][0], 16 * sizeof(float));
+
+            BeginElement(jointNodes);
+            AppendNumber(jointNodes, m_NodeByName[mesh.bones[b].name]);
+        }
+
+        view = AddBufferView(inverseBind, boneCount * 16 * sizeof(float), 0);
+
+        BeginElement(m_SkinsJson);
+        m_SkinsJson += "{\"name\":";
+        AppendString(m_SkinsJson, mesh.name);
+        m_SkinsJson += ",\"inverseBindMatrices\":";
+        AppendNumber(m_SkinsJson, AddAccessor(view, 0, GLTF_FLOAT, boneCount, "MAT4"));
+        m_SkinsJson += ",\"joints\":[" + jointNodes + "]}";
+
+        node.skin = (int)m_SkinCount++;
+    }
+
+    // Índices: una primitiva por material
+    const size_t groupCount = mesh.materials.size();
+    const bool split = groupCount > 1 && mesh.materialIndices.size() == triangleCount;
+    string primitives;
+
+    auto appendPrimitive = [&](int accessor, int material)
+    {
+        BeginElement(primitives);
+        primitives += "{\"attributes\":{" + attributes + "},\"indices\":";
+        AppendNumber(primitives, accessor);
+        if (material >= 0)
+        {
+            primitives += ",\"material\":";
+            AppendNumber(primitives, material);
+        }
+        primitives += ",\"mode\":4}";
+    };
+
+    if (!split)
+    {
+        // Sin copia: el bufferView apunta a MeshData::indices
+        view = AddBufferView(mesh.indices.data(), triangleCount * 3 * sizeof(DWORD), GLTF_ELEMENT_ARRAY_BUFFER);
+        appendPrimitive(AddAccessor(view, 0, GLTF_UNSIGNED_INT, triangleCount * 3, "SCALAR"),
+                        groupCount > 0 ? (int)mesh.materials[0] : -1);
+    }
+    else
+    {
+        // Triángulos ordenados por material (counting sort) en un bufferView
+        vector<size_t> groupStart(groupCount + 1, 0);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            DWORD group = mesh.materialIndices[t] < groupCount ? mesh.materialIndices[t] : 0;
+            groupStart[group + 1]++;
+        }
+        for (size_t g = 0; g < groupCount; g++)
+            groupStart[g + 1] += groupStart[g];
+
+        DWORD* sorted = Allocate<DWORD>(triangleCount * 3);
+        vector<size_t> cursor(groupStart.begin(), groupStart.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            DWORD group = mesh.materialIndices[t] < groupCount ? mesh.materialIndices[t] : 0;
+            memcpy(sorted + cursor[group]++ * 3, &mesh.indices[t * 3], 3 * sizeof(DWORD));
+        }
+
+        view = AddBufferView(sorted, triangleCount * 3 * sizeof(DWORD), GLTF_ELEMENT_ARRAY_BUFFER);
+        for (size_t g = 0; g < groupCount; g++)
+        {
+            const size_t count = groupStart[g + 1] - groupStart[g];
+            if (count == 0)
+                continue;
+
+            appendPrimitive(AddAccessor(view, groupStart[g] * 3 * sizeof(DWORD), GLTF_UNSIGNED_INT, count * 3, "SCALAR"),
+                            (int)mesh.materials[g]);
+        }
+    }
+
+    BeginElement(m_MeshesJson);
+    m_MeshesJson += "{\"name\":";
+    AppendString(m_MeshesJson, mesh.name);
+    m_MeshesJson += ",\"primitives\":[" + primitives + "]}";
+
+    node.mesh = (int)m_MeshCount++;
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// Un sampler LINEAR por canal con keys (T, R, S) de cada track. Los
+// canales sin keys no se escriben: el TRS del nodo es la pose de reposo.
+// ============================================================================
+
+void GLTFExporter::WriteAnimation(const AnimationClip& clip)
+{
+    static const char* channelPaths[3] = { "translation", "rotation", "scale" };
+
+    string samplers, channels;
+    int samplerCount = 0;
+
+    for (const AnimationTrack& track : clip.tracks)
+    {
+        auto node = m_NodeByName.find(track.boneName);
+        if (node == m_NodeByName.end() || track.GetKeys().empty())
+            continue;
+
+        // Accessors compartidos entre tracks con el mismo array de keys
+        // (ver AnimationOptimizer::ShareDuplicateTracks)
+        auto it = m_TrackAccessors.find(track.keyData.get());
+        if (it == m_TrackAccessors.end())
+        {
+            TrackAccessors accessors;
+            WriteTrackAccessors(track, accessors);
+            it = m_TrackAccessors.insert(make_pair(track.keyData.get(), accessors)).first;
+        }
+
+        for (int c = 0; c < 3; c++)
+        {
+            if (it->second.output[c] < 0)
+                continue;
+
+            BeginElement(samplers);
+            samplers += "{\"input\":";
+            AppendNumber(samplers, it->second.input[c]);
+            samplers += ",\"interpolation\":\"LINEAR\",\"output\":";
+            AppendNumber(samplers, it->second.output[c]);
+            samplers += "}";
+
+            BeginElement(channels);
+            channels += "{\"sampler\":";
+            AppendNumber(channels, samplerCount);
+            channels += ",\"target\":{\"node\":";
+            AppendNumber(channels, node->second);
+            channels += ",\"path\":\"";
+            channels += channelPaths[c];
+            channels += "\"}}";
+
+            samplerCount++;
+        }
+    }
+
+    if (samplerCount == 0)
+        return;
+
+    BeginElement(m_AnimationsJson);
+    m_AnimationsJson += "{\"name\":";
+    AppendString(m_AnimationsJson, clip.name);
+    m_AnimationsJson += ",\"channels\":[" + channels + "],\"samplers\":[" + samplers + "]}";
+}
+
+void GLTFExporter::WriteTrackAccessors(const AnimationTrack& track, TrackAccessors& accessors)
+{
+    static const int components[3] = { 3, 4, 3 };
+    static const char* types[3] = { "VEC3", "VEC4", "VEC3" };
+
+    const vector<AnimationKey>& keys = track.GetKeys();
+    const float scale = m_Options.scale;
+
+    size_t counts[3] = { 0, 0, 0 };
+    for (const AnimationKey& key : keys)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            if (key.channels & (1 << c))
+                counts[c]++;
+        }
+    }
+
+    float* times[3] = { nullptr, nullptr, nullptr };
+    float* values[3] = { nullptr, nullptr, nullptr };
+    for (int c = 0; c < 3; c++)
+    {
+        accessors.input[c] = -1;
+        accessors.output[c] = -1;
+        if (counts[c] == 0)
+            continue;
+
+        times[c] = Allocate<float>(counts[c]);
+        values[c] = Allocate<float>(counts[c] * components[c]);
+    }
+
+    size_t cursor[3] = { 0, 0, 0 };
+    for (const AnimationKey& key : keys)
+    {
+        if (key.channels & KEY_TRANSLATION)
+        {
+            size_t i = cursor[0]++;
+            times[0][i] = (float)key.time;
+            values[0][i * 3 + 0] = key.translation.x * scale;
+            values[0][i * 3 + 1] = key.translation.y * scale;
+            values[0][i * 3 + 2] = -key.translation.z * scale;
+        }
+
+        if (key.channels & KEY_ROTATION)
+        {
+            size_t i = cursor[1]++;
+            times[1][i] = (float)key.time;
+
+            float* q = values[1] + i * 4;
+            ConvertQuaternion_LH_to_RH(key.rotation, q);
+
+            // Mismo hemisferio que la key anterior (camino más corto)
+            if (i > 0)
+            {
+                const float* previous = q - 4;
+                if (q[0] * previous[0] + q[1] * previous[1] + q[2] * previous[2] + q[3] * previous[3] < 0.0f)
+                {
+                    for (int k = 0; k < 4; k++)
+                        q[k] = -q[k];
+                }
+            }
+        }
+
+        if (key.channels & KEY_SCALE)
+        {
+            size_t i = cursor[2]++;
+            times[2][i] = (float)key.time;
+            values[2][i * 3 + 0] = key.scale.x;
+            values[2][i * 3 + 1] = key.scale.y;
+            values[2][i * 3 + 2] = key.scale.z;
+        }
+    }
+
+    for (int c = 0; c < 3; c++)
+    {
+        const size_t count = counts[c];
+        if (count == 0)
+            continue;
+
+        // Los canales con los mismos tiempos comparten el accessor de entrada
+        for (int p = 0; p < c && accessors.input[c] < 0; p++)
+        {
+            if (counts[p] == count && memcmp(times[p], times[c], count * sizeof(float)) == 0)
+                accessors.input[c] = accessors.input[p];
+        }
+
+        if (accessors.input[c] < 0)
+        {
+            int view = AddBufferView(times[c], count * sizeof(float), 0);
+            accessors.input[c] = AddAccessor(view, 0, GLTF_FLOAT, count, "SCALAR", &times[c][0], &times[c][count - 1], 1);
+        }
+
+        int view = AddBufferView(values[c], count * components[c] * sizeof(float), 0);
+        accessors.output[c] = AddAccessor(view, 0, GLTF_FLOAT, count, types[c]);
+    }
+}
+
+// ============================================================================
+// Buffers y Accessors
+// ============================================================================
+
+template<class T>
+T* GLTFExporter::Allocate(size_t count)
+{
+    m_Storage.push_back(vector<BYTE>(count * sizeof(T)));
+    return reinterpret_cast<T*>(m_Storage.back().data());
+}
+
+int GLTFExporter::AddBufferView(const void* data, size_t size, int target)
+{
+    BufferView view;
+    view.data = data;
+    view.size = size;
+    view.offset = (m_BinaryLength + 3) & ~(size_t)3;
+    view.target = target;
+
+    m_BinaryLength = view.offset + size;
+    m_BufferViews.push_back(view);
+    return (int)m_BufferViews.size() - 1;
+}
+
+int GLTFExporter::AddAccessor(
+    int bufferView,
+    size_t byteOffset,
+    int componentType,
+    size_t count,
+    const char* type,
+    const float* minValues,
+    const float* maxValues,
+    int components)
+{
+    BeginElement(m_AccessorsJson);
+    m_AccessorsJson += "{\"bufferView\":";
+    AppendNumber(m_AccessorsJson, bufferView);
+    if (byteOffset > 0)
+    {
+        m_AccessorsJson += ",\"byteOffset\":";
+        AppendNumber(m_AccessorsJson, byteOffset);
+    }
+    m_AccessorsJson += ",\"componentType\":";
+    AppendNumber(m_AccessorsJson, componentType);
+    m_AccessorsJson += ",\"count\":";
+    AppendNumber(m_AccessorsJson, count);
+    m_AccessorsJson += ",\"type\":\"";
+    m_AccessorsJson += type;
+    m_AccessorsJson += "\"";
+
+    if (minValues && maxValues)
+    {
+        m_AccessorsJson += ",\"min\":";
+        AppendArray(m_AccessorsJson, minValues, (size_t)components);
+        m_AccessorsJson += ",\"max\":";
+        AppendArray(m_AccessorsJson, maxValues, (size_t)components);
+    }
+
+    m_AccessorsJson += "}";
+    return (int)m_AccessorCount++;
+}
+
+// ============================================================================
+// Documento y archivo GLB
+// ============================================================================
+
+string GLTFExporter::BuildJson() const
+{
+    string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"XtoFBXConverter\"}";
+
+    string roots;
+    for (size_t i = 0; i < m_Nodes.size(); i++)
+    {
+        if (m_Nodes[i].parent >= 0)
+            continue;
+        BeginElement(roots);
+        AppendNumber(roots, i);
+    }
+    json += ",\"scene\":0,\"scenes\":[{\"nodes\":[" + roots + "]}]";
+
+    json += ",\"nodes\":[";
+    for (size_t i = 0; i < m_Nodes.size(); i++)
+    {
+        const NodeEntry& node = m_Nodes[i];
+        if (i > 0)
+            json += ',';
+
+        json += "{\"name\":";
+        AppendString(json, node.name);
+        if (!node.children.empty())
+        {
+            json += ",\"children\":";
+            AppendArray(json, node.children.data(), node.children.size());
+        }
+        if (node.mesh >= 0)
+        {
+            json += ",\"mesh\":";
+            AppendNumber(json, node.mesh);
+        }
+        if (node.skin >= 0)
+        {
+            json += ",\"skin\":";
+            AppendNumber(json, node.skin);
+        }
+        json += ",\"translation\":";
+        AppendArray(json, node.translation, 3);
+        json += ",\"rotation\":";
+        AppendArray(json, node.rotation, 4);
+        json += ",\"scale\":";
+        AppendArray(json, node.scale, 3);
+        json += "}";
+    }
+    json += "]";
+
+    // Las listas vacías no se escriben (glTF exige al menos un elemento)
+    if (!m_MeshesJson.empty())
+        json += ",\"meshes\":[" + m_MeshesJson + "]";
+    if (!m_MaterialsJson.empty())
+        json += ",\"materials\":[" + m_MaterialsJson + "]";
+    if (!m_TexturesJson.empty())
+    {
+        json += ",\"textures\":[" + m_TexturesJson + "]";
+        json += ",\"images\":[" + m_ImagesJson + "]";
+        json += ",\"samplers\":[{\"magFilter\":9729,\"minFilter\":9987,\"wrapS\":10497,\"wrapT\":10497}]";
+    }
+    if (!m_SkinsJson.empty())
+        json += ",\"skins\":[" + m_SkinsJson + "]";
+    if (!m_AnimationsJson.empty())
+        json += ",\"animations\":[" + m_AnimationsJson + "]";
+
+    if (m_BinaryLength > 0)
+    {
+        json += ",\"accessors\":[" + m_AccessorsJson + "]";
+
+        json += ",\"bufferViews\":[";
+        for (size_t i = 0; i < m_BufferViews.size(); i++)
+        {
+            const BufferView& view = m_BufferViews[i];
+            if (i > 0)
+                json += ',';
+
+            json += "{\"buffer\":0,\"byteOffset\":";
+            AppendNumber(json, view.offset);
+            json += ",\"byteLength\":";
+            AppendNumber(json, view.size);
+            if (view.target != 0)
+            {
+                json += ",\"target\":";
+                AppendNumber(json, view.target);
+            }
+            json += "}";
+        }
+        json += "]";
+
+        json += ",\"buffers\":[{\"byteLength\":";
+        AppendNumber(json, m_BinaryLength);
+        json += "}]";
+    }
+
+    json += "}";
+    return json;
+}
+
+bool GLTFExporter::WriteFile(const string& filename, const string& json)
+{
+    // Chunks alineados a 4 bytes: JSON con espacios, BIN con ceros
+    const size_t jsonLength = (json.size() + 3) & ~(size_t)3;
+    const size_t binaryLength = (m_BinaryLength + 3) & ~(size_t)3;
+    const size_t totalLength = 12 + 8 + jsonLength + (binaryLength > 0 ? 8 + binaryLength : 0);
+
+    if (totalLength > 0xFFFFFFFFull)
+    {
+        m_LastError = "GLB file would exceed 4 GB: " + filename;
+        return false;
+    }
+
+    ofstream file(filename.c_str(), ios::binary | ios::out | ios::trunc);
+    if (!file.is_open())
+    {
+        m_LastError = "Cannot create file: " + filename;
+        return false;
+    }
+
+    auto writeUInt32 = [&file](uint32_t value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    static const char zeros[4] = { 0, 0, 0, 0 };
+    static const char spaces[4] = { ' ', ' ', ' ', ' ' };
+
+    writeUInt32(GLB_MAGIC);
+    writeUInt32(GLB_VERSION);
+    writeUInt32((uint32_t)totalLength);
+
+    writeUInt32((uint32_t)jsonLength);
+    writeUInt32(GLB_CHUNK_JSON);
+    file.write(json.data(), (streamsize)json.size());
+    file.write(spaces, (streamsize)(jsonLength - json.size()));
+
+    if (binaryLength > 0)
+    {
+        writeUInt32((uint32_t)binaryLength);
+        writeUInt32(GLB_CHUNK_BIN);
+
+        size_t position = 0;
+        for (const BufferView& view : m_BufferViews)
+        {
+            file.write(zeros, (streamsize)(view.offset - position));
+            file.write(static_cast<const char*>(view.data), (streamsize)view.size);
+            position = view.offset + view.size;
+        }
+        file.write(zeros, (streamsize)(binaryLength - position));
+    }
+
+    file.close();
+    if (file.fail())
+    {
+        m_LastError = "Error writing GLB file: " + filename;
+        return false;
+    }
+
+    // Los arrays convertidos ya están en el archivo
+    m_Storage.clear();
+    m_BufferViews.clear();
+    return true;
+}
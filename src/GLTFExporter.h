@@ -0,0 +1,136 @@
+#pragma once
+
+#ifndef GLTF_EXPORTER_H
+#define GLTF_EXPORTER_H
+
+#include "../include/Common.h"
+#include <deque>
+
+/**
+ * @class GLTFExporter
+ * @brief Exporta SceneData a glTF 2.0 binario (.glb)
+ *
+ * Un solo archivo con la escena completa (nodos, meshes, materiales,
+ * skins y todos los clips de animación), con la misma conversión que
+ * NativeFBXExporter: Right-Handed, Y-Up, Z invertida y escala global.
+ * Las UVs no se invierten (glTF y DirectX tienen el origen arriba a la
+ * izquierda).
+ *
+ *   Frame               -> node (TRS); cada mesh en un nodo "<mesh>_node"
+ *   MeshData            -> mesh con una primitiva por material
+ *   BoneData            -> skin (joints por nombre de hueso,
+ *                          inverseBindMatrices = offsetMatrix)
+ *   AnimationClip       -> animation con un sampler LINEAR por canal
+ *
+ * El chunk BIN no se arma en memoria: cada bufferView apunta a su array
+ * (índices de la escena o arrays SoA convertidos) y se escribe
+ * directamente en el archivo, alineado a 4 bytes.
+ */
+class GLTFExporter
+{
+public:
+    GLTFExporter();
+
+    /**
+     * Exportar la escena completa a un archivo .glb
+     * @param sceneData Datos de la escena (con animaciones)
+     * @param filename Archivo GLB de salida
+     * @param options Opciones de conversión (escala, texturas)
+     * @return true si se exportó exitosamente
+     */
+    bool ExportScene(
+        const SceneData& sceneData,
+        const string& filename,
+        const ConversionOptions& options);
+
+    /**
+     * Obtener último mensaje de error
+     * @return Mensaje de error
+     */
+    string GetLastError() const { return m_LastError; }
+
+private:
+    // Nodo glTF: frame, "<mesh>_node" o hueso sin frame
+    struct NodeEntry
+    {
+        string name;
+        const D3DXMATRIX* localMatrix;
+        int parent;
+        vector<int> children;
+        const MeshData* meshData;      // Solo en los nodos "<mesh>_node"
+        int mesh;
+        int skin;
+        float translation[3];
+        float rotation[4];
+        float scale[3];
+    };
+
+    // Segmento del chunk BIN (los datos no se copian)
+    struct BufferView
+    {
+        const void* data;
+        size_t size;
+        size_t offset;
+        int target;
+    };
+
+    // Accessors de un track (-1 = canal sin keys), compartidos entre
+    // clips si el array de keys lo está
+    struct TrackAccessors
+    {
+        int input[3];
+        int output[3];
+    };
+
+    ConversionOptions m_Options;
+    string m_LastError;
+    D3DXMATRIX m_Identity;             // Matriz local de los nodos "<mesh>_node"
+
+    vector<NodeEntry> m_Nodes;
+    map<string, int> m_NodeByName;
+
+    vector<BufferView> m_BufferViews;
+    size_t m_BinaryLength;
+    deque<vector<BYTE>> m_Storage;     // Arrays convertidos (direcciones estables)
+
+    map<const vector<AnimationKey>*, TrackAccessors> m_TrackAccessors;
+    map<string, int> m_TextureByUri;
+
+    // JSON de cada sección (elementos separados por comas)
+    string m_AccessorsJson;
+    string m_MeshesJson;
+    string m_MaterialsJson;
+    string m_TexturesJson;
+    string m_ImagesJson;
+    string m_SkinsJson;
+    string m_AnimationsJson;
+    size_t m_AccessorCount;
+    size_t m_MeshCount;
+    size_t m_SkinCount;
+
+    void CollectNodes(const FrameData* root);
+    void WriteMaterials(const SceneData& sceneData, const string& filename);
+    void WriteMesh(const MeshData& mesh, NodeEntry& node);
+    void WriteAnimation(const AnimationClip& clip);
+    void WriteTrackAccessors(const AnimationTrack& track, TrackAccessors& accessors);
+    string BuildJson() const;
+    bool WriteFile(const string& filename, const string& json);
+
+    // Nuevo array en m_Storage (válido hasta el final de la exportación)
+    template<class T>
+    T* Allocate(size_t count);
+
+    int AddBufferView(const void* data, size_t size, int target);
+
+    int AddAccessor(
+        int bufferView,
+        size_t byteOffset,
+        int componentType,
+        size_t count,
+        const char* type,
+        const float* minValues = nullptr,
+        const float* maxValues = nullptr,
+        int components = 0);
+};
+
+#endif // GLTF_EXPORTER_H
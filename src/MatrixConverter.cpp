@@ -1,21 +1,22 @@
 #include "MatrixConverter.h"
+#include "SimdMath.h"
 
 // Matriz de conversión estática: Invierte Z
 // FBX SDK 2020.3.7: FbxAMatrix constructor changed - use SetIdentity and SetRow
 FbxAMatrix MatrixConverter::s_ConversionMatrix_LH_to_RH;
-bool MatrixConverter::s_ConversionMatrixInitialized = false;
+once_flag MatrixConverter::s_ConversionMatrixOnce;
 
 void MatrixConverter::InitializeConversionMatrix()
 {
-    if (!s_ConversionMatrixInitialized)
+    // call_once: varios exportadores pueden convertir matrices en paralelo
+    call_once(s_ConversionMatrixOnce, []()
     {
         s_ConversionMatrix_LH_to_RH.SetIdentity();
         s_ConversionMatrix_LH_to_RH.SetRow(0, FbxVector4(1.0, 0.0, 0.0, 0.0));
         s_ConversionMatrix_LH_to_RH.SetRow(1, FbxVector4(0.0, 1.0, 0.0, 0.0));
         s_ConversionMatrix_LH_to_RH.SetRow(2, FbxVector4(0.0, 0.0, -1.0, 0.0));
         s_ConversionMatrix_LH_to_RH.SetRow(3, FbxVector4(0.0, 0.0, 0.0, 1.0));
-        s_ConversionMatrixInitialized = true;
-    }
+    });
 }
 
 // ============================================================================
@@ -82,6 +83,18 @@ FbxAMatrix MatrixConverter::ConvertMatrix_LH_to_RH(const D3DXMATRIX& dxMatrix)
     return result;
 }
 
+FbxAMatrix MatrixConverter::ComposeMatrix_LH_to_RH(
+    const D3DXVECTOR3& translation,
+    const D3DXQUATERNION& rotation,
+    const D3DXVECTOR3& scale)
+{
+    FbxAMatrix result;
+    result.SetT(ConvertPosition_LH_to_RH(translation));
+    result.SetQ(ConvertQuaternion_LH_to_RH(rotation));
+    result.SetS(ConvertScale(scale));
+    return result;
+}
+
 FbxAMatrix MatrixConverter::D3DMatrixToFbxAMatrix(const D3DXMATRIX& dxMatrix)
 {
     // Conversión directa sin cambiar el sistema de coordenadas
@@ -170,6 +183,81 @@ FbxVector4 MatrixConverter::ConvertScale(const D3DXVECTOR3& dxScale)
     return FbxVector4(dxScale.x, dxScale.y, dxScale.z, 1.0);
 }
 
+// ============================================================================
+// Conversión de Vectores por Lotes
+// ============================================================================
+// Escriben directamente en los arrays del FBX (control points o direct array
+// de un layer ya dimensionado), sin construir temporales por elemento.
+// stride en bytes: sizeof(elemento) para arrays SoA, sizeof(Vertex) para AoS.
+
+template<class T>
+static inline const T& StridedAt(const T* first, size_t stride, size_t index)
+{
+    return *(const T*)((const BYTE*)first + index * stride);
+}
+
+void MatrixConverter::ConvertPositions_LH_to_RH(
+    const D3DXVECTOR3* positions,
+    size_t stride,
+    size_t count,
+    float scale,
+    FbxVector4* out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const D3DXVECTOR3& p = StridedAt(positions, stride, i);
+        FbxVector4& result = out[i];
+        result[0] = p.x * scale;
+        result[1] = p.y * scale;
+        result[2] = -p.z * scale;
+        result[3] = 1.0;
+    }
+}
+
+void MatrixConverter::ConvertNormals_LH_to_RH(
+    const D3DXVECTOR3* normals,
+    size_t stride,
+    size_t count,
+    FbxVector4* out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const D3DXVECTOR3& n = StridedAt(normals, stride, i);
+        FbxVector4& result = out[i];
+        result[0] = n.x;
+        result[1] = n.y;
+        result[2] = -n.z;
+        result[3] = 0.0;
+    }
+}
+
+void MatrixConverter::ConvertTexCoords(
+    const D3DXVECTOR2* texCoords,
+    size_t stride,
+    size_t count,
+    FbxVector2* out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const D3DXVECTOR2& uv = StridedAt(texCoords, stride, i);
+        out[i][0] = uv.x;
+        out[i][1] = 1.0 - uv.y;  // Invertir V (DirectX vs FBX)
+    }
+}
+
+void MatrixConverter::ConvertColors(
+    const D3DXCOLOR* colors,
+    size_t stride,
+    size_t count,
+    FbxColor* out)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const D3DXCOLOR& c = StridedAt(colors, stride, i);
+        out[i].Set(c.r, c.g, c.b, c.a);
+    }
+}
+
 // ============================================================================
 // Conversión de Quaternions
 // ============================================================================
@@ -214,6 +302,160 @@ FbxQuaternion MatrixConverter::ConvertQuaternion_LH_to_RH(const D3DXQUATERNION&
     return fbxQuat;
 }
 
+// ============================================================================
+// Quaternions -> Euler XYZ por lotes (SSE)
+// ============================================================================
+// FBX usa orden eEulerXYZ: se rota primero en X, luego Y, luego Z
+// (M = Rz * Ry * Rx con vectores columna, q = qz * qy * qx). Para un
+// quaternion unitario (x, y, z, w):
+//
+//   X = atan2(2(wx + yz), 1 - 2(x² + y²))
+//   Y = asin (2(wy - zx))
+//   Z = atan2(2(wz + xy), 1 - 2(y² + z²))
+//
+// Antes se aplica la misma conversión LH -> RH que ConvertQuaternion_LH_to_RH
+// (negar X e Y) y se normaliza.
+// ============================================================================
+
+void MatrixConverter::ConvertQuaternionsToEuler_LH_to_RH(
+    const D3DXQUATERNION* quats,
+    size_t count,
+    float* outX,
+    float* outY,
+    float* outZ)
+{
+    using namespace SimdMath;
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 toDegrees = _mm_set1_ps(57.29577951308232f);
+    const __m128 negateXY = _mm_set_ps(0.0f, 0.0f, -0.0f, -0.0f);
+
+    for (size_t base = 0; base < count; base += LANES)
+    {
+        size_t lanes = min((size_t)LANES, count - base);
+
+        // Cargar 4 quaternions (AoS) y rellenar los carriles sobrantes con identidad
+        __m128 q[LANES];
+        for (size_t i = 0; i < (size_t)LANES; i++)
+        {
+            q[i] = (i < lanes)
+                ? _mm_loadu_ps(&quats[base + i].x)
+                : _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+            // LH -> RH: negar X e Y
+            q[i] = _mm_xor_ps(q[i], negateXY);
+        }
+
+        // AoS -> SoA: q[0] = x, q[1] = y, q[2] = z, q[3] = w
+        _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+        __m128 x = q[0], y = q[1], z = q[2], w = q[3];
+        NormalizeQuat(x, y, z, w);
+
+        __m128 xx = _mm_mul_ps(x, x);
+        __m128 yy = _mm_mul_ps(y, y);
+        __m128 zz = _mm_mul_ps(z, z);
+
+        __m128 rx = Atan2(
+            _mm_mul_ps(two, MulAdd(w, x, _mm_mul_ps(y, z))),
+            _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))));
+
+        __m128 ry = Asin(
+            _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(w, y), _mm_mul_ps(z, x))));
+
+        __m128 rz = Atan2(
+            _mm_mul_ps(two, MulAdd(w, z, _mm_mul_ps(x, y))),
+            _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))));
+
+        float bufX[LANES], bufY[LANES], bufZ[LANES];
+        _mm_storeu_ps(bufX, _mm_mul_ps(rx, toDegrees));
+        _mm_storeu_ps(bufY, _mm_mul_ps(ry, toDegrees));
+        _mm_storeu_ps(bufZ, _mm_mul_ps(rz, toDegrees));
+
+        for (size_t i = 0; i < lanes; i++)
+        {
+            outX[base + i] = bufX[i];
+            outY[base + i] = bufY[i];
+            outZ[base + i] = bufZ[i];
+        }
+    }
+}
+
+// ============================================================================
+// Filtro de continuidad Euler
+// ============================================================================
+
+void MatrixConverter::FilterEulerContinuity(float* x, float* y, float* z, size_t count)
+{
+    // Desplazar 'angle' en múltiplos de 360° para acercarlo a 'reference'
+    auto unwrap = [](float angle, float reference)
+    {
+        return angle - 360.0f * floorf((angle - reference) / 360.0f + 0.5f);
+    };
+
+    for (size_t i = 1; i < count; i++)
+    {
+        float px = x[i - 1], py = y[i - 1], pz = z[i - 1];
+
+        // Solución original
+        float ax = unwrap(x[i], px);
+        float ay = unwrap(y[i], py);
+        float az = unwrap(z[i], pz);
+
+        // Solución equivalente: (x + 180, 180 - y, z + 180)
+        float bx = unwrap(x[i] + 180.0f, px);
+        float by = unwrap(180.0f - y[i], py);
+        float bz = unwrap(z[i] + 180.0f, pz);
+
+        float distanceA = fabsf(ax - px) + fabsf(ay - py) + fabsf(az - pz);
+        float distanceB = fabsf(bx - px) + fabsf(by - py) + fabsf(bz - pz);
+
+        if (distanceB < distanceA)
+        {
+            x[i] = bx; y[i] = by; z[i] = bz;
+        }
+        else
+        {
+            x[i] = ax; y[i] = ay; z[i] = az;
+        }
+    }
+}
+
+// ============================================================================
+// Euler XYZ -> Quaternions (inversa de ConvertQuaternionsToEuler_LH_to_RH)
+// ============================================================================
+// q = qz * qy * qx con medios ángulos; después RH -> LH negando X e Y (la
+// conversión es su propia inversa).
+// ============================================================================
+
+void MatrixConverter::ConvertEulerToQuaternions_RH_to_LH(
+    const float* x,
+    const float* y,
+    const float* z,
+    size_t count,
+    D3DXQUATERNION* out)
+{
+    const double toHalfRadians = 0.5 * 3.14159265358979323846 / 180.0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        double hx = x[i] * toHalfRadians;
+        double hy = y[i] * toHalfRadians;
+        double hz = z[i] * toHalfRadians;
+
+        double cx = cos(hx), sx = sin(hx);
+        double cy = cos(hy), sy = sin(hy);
+        double cz = cos(hz), sz = sin(hz);
+
+        double qx = cz * cy * sx - sz * sy * cx;
+        double qy = cz * sy * cx + sz * cy * sx;
+        double qz = sz * cy * cx - cz * sy * sx;
+        double qw = cz * cy * cx + sz * sy * sx;
+
+        out[i] = D3DXQUATERNION((float)-qx, (float)-qy, (float)qz, (float)qw);
+    }
+}
+
 // ============================================================================
 // Descomposición de Matrices
 // ============================================================================
@@ -224,17 +466,14 @@ FbxQuaternion MatrixConverter::ConvertQuaternion_LH_to_RH(const D3DXQUATERNION&
 // Una matriz de transformación 4x4 combina traslación, rotación y escala.
 // Esta función la descompone en sus componentes individuales.
 //
-// Estructura de una matriz 4x4:
-//   [ Rx*Sx  Ry*Sx  Rz*Sx  Tx ]     R = Rotación (3x3)
-//   [ Rx*Sy  Ry*Sy  Rz*Sy  Ty ]     S = Escala (diagonal)
-//   [ Rx*Sz  Ry*Sz  Rz*Sz  Tz ]     T = Traslación (última columna)
-//   [   0      0      0     1  ]
+// Estructura de una matriz 4x4 DirectX (vectores fila):
+//   [ Rx*Sx  Ry*Sx  Rz*Sx  0 ]     R = Rotación (3x3)
+//   [ Rx*Sy  Ry*Sy  Rz*Sy  0 ]     S = Escala (una por fila)
+//   [ Rx*Sz  Ry*Sz  Rz*Sz  0 ]     T = Traslación (última fila)
+//   [  Tx     Ty     Tz    1 ]
 //
-// Proceso de descomposición:
-//   1. Extraer T (última columna) → trivial
-//   2. Extraer S (longitud de vectores columna) → cálculo de magnitud
-//   3. Extraer R (matriz normalizada sin escala) → división
-//   4. Convertir R a quaternion → algoritmo de conversión
+// La versión escalar usa el mismo kernel que DecomposeMatrices() para que
+// frames, huesos y keys horneadas se descompongan de forma idéntica.
 // ============================================================================
 void MatrixConverter::DecomposeMatrix(
     const D3DXMATRIX& matrix,
@@ -242,76 +481,196 @@ void MatrixConverter::DecomposeMatrix(
     D3DXQUATERNION& rotation,
     D3DXVECTOR3& scale)
 {
-    // ========================================================================
-    // PASO 1: Extraer TRASLACIÓN (última columna de la matriz)
-    // ========================================================================
-    // En una matriz 4x4, la traslación está en (m41, m42, m43)
-    //   [ ..  ..  ..  Tx ]
-    //   [ ..  ..  ..  Ty ]
-    //   [ ..  ..  ..  Tz ]
-    //   [  0   0   0   1 ]
+    DecomposedTransforms result;
+    DecomposeMatrices(&matrix, 1, result);
 
-    translation = ExtractTranslation(matrix);
+    translation = result.translations[0];
+    rotation = result.rotations[0];
+    scale = result.scales[0];
+}
 
-    // ========================================================================
-    // PASO 2: Extraer ESCALA (longitud de vectores columna)
-    // ========================================================================
-    // Cada columna de la matriz 3x3 superior izquierda es un vector de base.
-    // La longitud de cada vector es el factor de escala en ese eje.
-    //
-    // Ejemplo: Si la primera columna es (2, 0, 0), la escala en X es 2.
+// ============================================================================
+// DESCOMPOSICIÓN POR LOTES (SSE, 4 matrices por iteración)
+// ============================================================================
+// Proceso por carril:
+//   1. det(M) < 0 → la matriz es un espejo: negar la fila X antes de seguir
+//      y devolver la escala X negativa al final.
+//   2. Normalizar cada fila (elimina la escala no uniforme del estimado inicial).
+//   3. Descomposición polar por Newton: Q = 0.5 * (Q + Q^-T)
+//      Q^-T se obtiene con productos cruz: filas = (q1×q2, q2×q0, q0×q1) / det
+//      Converge cuadráticamente; con filas ya normalizadas bastan pocas
+//      iteraciones, y el shear residual termina absorbido en la escala.
+//   4. Escala_i = fila_i(M) · fila_i(Q)
+//   5. Q → quaternion con el método de Shepperd sin ramas (se elige la
+//      componente dominante por carril con máscaras).
+// ============================================================================
+namespace
+{
+    const int POLAR_ITERATIONS = 5;
+    const float DEGENERATE_EPSILON = 1e-8f;
+}
 
-    scale = ExtractScale(matrix);
+void MatrixConverter::DecomposeMatrices(
+    const D3DXMATRIX* matrices,
+    size_t count,
+    DecomposedTransforms& out)
+{
+    using namespace SimdMath;
 
-    // ========================================================================
-    // PASO 3: Construir matriz de rotación PURA (sin escala ni traslación)
-    // ========================================================================
-    // Necesitamos aislar solo la rotación, eliminando escala y traslación.
+    out.Resize(count);
 
-    D3DXMATRIX rotationMatrix = matrix;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const __m128 epsilon = _mm_set1_ps(DEGENERATE_EPSILON);
 
-    // Eliminar traslación (poner última columna en 0)
-    rotationMatrix._41 = 0.0f;  // Tx = 0
-    rotationMatrix._42 = 0.0f;  // Ty = 0
-    rotationMatrix._43 = 0.0f;  // Tz = 0
+    for (size_t base = 0; base < count; base += LANES)
+    {
+        size_t lanes = min(count - base, (size_t)LANES);
+
+        // ====================================================================
+        // Transponer 4 matrices a formato SoA (los carriles sobrantes repiten
+        // la última matriz válida para no introducir NaN)
+        // ====================================================================
+        alignas(16) float m[12][LANES];
+        for (size_t lane = 0; lane < (size_t)LANES; lane++)
+        {
+            const D3DXMATRIX& src = matrices[base + min(lane, lanes - 1)];
+            for (int row = 0; row < 3; row++)
+            {
+                for (int col = 0; col < 3; col++)
+                    m[row * 3 + col][lane] = src.m[row][col];
+            }
+            m[9][lane] = src._41;
+            m[10][lane] = src._42;
+            m[11][lane] = src._43;
+        }
 
-    // Eliminar escala dividiendo cada COLUMNA por su longitud (factor de escala)
-    // Esto normaliza los vectores de base a longitud 1.0
+        __m128 r0x = _mm_load_ps(m[0]), r0y = _mm_load_ps(m[1]), r0z = _mm_load_ps(m[2]);
+        __m128 r1x = _mm_load_ps(m[3]), r1y = _mm_load_ps(m[4]), r1z = _mm_load_ps(m[5]);
+        __m128 r2x = _mm_load_ps(m[6]), r2y = _mm_load_ps(m[7]), r2z = _mm_load_ps(m[8]);
 
-    // Normalizar columna X (primera columna)
-    if (scale.x != 0.0f)  // Evitar división por cero
-    {
-        rotationMatrix._11 /= scale.x;
-        rotationMatrix._12 /= scale.x;
-        rotationMatrix._13 /= scale.x;
-    }
+        // PASO 1: Detectar espejo (determinante negativo)
+        __m128 cx, cy, cz;
+        Cross3(r1x, r1y, r1z, r2x, r2y, r2z, cx, cy, cz);
+        __m128 det = Dot3(r0x, r0y, r0z, cx, cy, cz);
+        __m128 mirrorMask = _mm_cmplt_ps(det, zero);
+        __m128 mirrorSign = Select(mirrorMask, _mm_set1_ps(-1.0f), one);
 
-    // Normalizar columna Y (segunda columna)
-    if (scale.y != 0.0f)
-    {
-        rotationMatrix._21 /= scale.y;
-        rotationMatrix._22 /= scale.y;
-        rotationMatrix._23 /= scale.y;
-    }
+        r0x = _mm_mul_ps(r0x, mirrorSign);
+        r0y = _mm_mul_ps(r0y, mirrorSign);
+        r0z = _mm_mul_ps(r0z, mirrorSign);
 
-    // Normalizar columna Z (tercera columna)
-    if (scale.z != 0.0f)
-    {
-        rotationMatrix._31 /= scale.z;
-        rotationMatrix._32 /= scale.z;
-        rotationMatrix._33 /= scale.z;
-    }
+        // PASO 2: Normalizar filas
+        __m128 len0 = _mm_sqrt_ps(Dot3(r0x, r0y, r0z, r0x, r0y, r0z));
+        __m128 len1 = _mm_sqrt_ps(Dot3(r1x, r1y, r1z, r1x, r1y, r1z));
+        __m128 len2 = _mm_sqrt_ps(Dot3(r2x, r2y, r2z, r2x, r2y, r2z));
 
-    // ========================================================================
-    // PASO 4: Convertir matriz de rotación a quaternion
-    // ========================================================================
-    // DirectX proporciona una función para convertir matriz 3x3 → quaternion
-    // Usa el algoritmo de Shepperd's method para estabilidad numérica
+        __m128 degenerate = _mm_or_ps(
+            _mm_cmplt_ps(len0, epsilon),
+            _mm_or_ps(_mm_cmplt_ps(len1, epsilon), _mm_cmplt_ps(len2, epsilon)));
+
+        __m128 inv0 = _mm_div_ps(one, _mm_max_ps(len0, epsilon));
+        __m128 inv1 = _mm_div_ps(one, _mm_max_ps(len1, epsilon));
+        __m128 inv2 = _mm_div_ps(one, _mm_max_ps(len2, epsilon));
 
-    D3DXQuaternionRotationMatrix(&rotation, &rotationMatrix);
+        __m128 q0x = _mm_mul_ps(r0x, inv0), q0y = _mm_mul_ps(r0y, inv0), q0z = _mm_mul_ps(r0z, inv0);
+        __m128 q1x = _mm_mul_ps(r1x, inv1), q1y = _mm_mul_ps(r1y, inv1), q1z = _mm_mul_ps(r1z, inv1);
+        __m128 q2x = _mm_mul_ps(r2x, inv2), q2y = _mm_mul_ps(r2y, inv2), q2z = _mm_mul_ps(r2z, inv2);
 
-    // Normalizar para asegurar que es un quaternion unitario válido
-    rotation = NormalizeQuaternion(rotation);
+        // PASO 3: Iteración polar de Newton
+        for (int iter = 0; iter < POLAR_ITERATIONS; iter++)
+        {
+            __m128 c0x, c0y, c0z, c1x, c1y, c1z, c2x, c2y, c2z;
+            Cross3(q1x, q1y, q1z, q2x, q2y, q2z, c0x, c0y, c0z);
+            Cross3(q2x, q2y, q2z, q0x, q0y, q0z, c1x, c1y, c1z);
+            Cross3(q0x, q0y, q0z, q1x, q1y, q1z, c2x, c2y, c2z);
+
+            __m128 d = _mm_max_ps(Dot3(q0x, q0y, q0z, c0x, c0y, c0z), epsilon);
+            __m128 invD = _mm_div_ps(one, d);
+
+            q0x = _mm_mul_ps(half, MulAdd(c0x, invD, q0x));
+            q0y = _mm_mul_ps(half, MulAdd(c0y, invD, q0y));
+            q0z = _mm_mul_ps(half, MulAdd(c0z, invD, q0z));
+            q1x = _mm_mul_ps(half, MulAdd(c1x, invD, q1x));
+            q1y = _mm_mul_ps(half, MulAdd(c1y, invD, q1y));
+            q1z = _mm_mul_ps(half, MulAdd(c1z, invD, q1z));
+            q2x = _mm_mul_ps(half, MulAdd(c2x, invD, q2x));
+            q2y = _mm_mul_ps(half, MulAdd(c2y, invD, q2y));
+            q2z = _mm_mul_ps(half, MulAdd(c2z, invD, q2z));
+        }
+
+        // Matrices degeneradas (alguna fila nula): rotación identidad
+        q0x = Select(degenerate, one, q0x);  q0y = Select(degenerate, zero, q0y); q0z = Select(degenerate, zero, q0z);
+        q1x = Select(degenerate, zero, q1x); q1y = Select(degenerate, one, q1y);  q1z = Select(degenerate, zero, q1z);
+        q2x = Select(degenerate, zero, q2x); q2y = Select(degenerate, zero, q2y); q2z = Select(degenerate, one, q2z);
+
+        // PASO 4: Escala proyectando cada fila original sobre la fila ortonormal
+        __m128 sx = Select(degenerate, len0, Dot3(r0x, r0y, r0z, q0x, q0y, q0z));
+        __m128 sy = Select(degenerate, len1, Dot3(r1x, r1y, r1z, q1x, q1y, q1z));
+        __m128 sz = Select(degenerate, len2, Dot3(r2x, r2y, r2z, q2x, q2y, q2z));
+        sx = _mm_mul_ps(sx, mirrorSign);
+
+        // PASO 5: Matriz de rotación → quaternion (Shepperd sin ramas)
+        // Con la convención de DirectX (vectores fila):
+        //   q12 - q21 = 4xw   q20 - q02 = 4yw   q01 - q10 = 4zw
+        //   q01 + q10 = 4xy   q20 + q02 = 4xz   q12 + q21 = 4yz
+        __m128 tw = _mm_add_ps(q0x, _mm_add_ps(q1y, q2z));
+        __m128 tx = _mm_sub_ps(q0x, _mm_add_ps(q1y, q2z));
+        __m128 ty = _mm_sub_ps(q1y, _mm_add_ps(q0x, q2z));
+        __m128 tz = _mm_sub_ps(q2z, _mm_add_ps(q0x, q1y));
+
+        __m128 useW = _mm_and_ps(_mm_cmpge_ps(tw, tx), _mm_and_ps(_mm_cmpge_ps(tw, ty), _mm_cmpge_ps(tw, tz)));
+        __m128 useX = _mm_andnot_ps(useW, _mm_and_ps(_mm_cmpge_ps(tx, ty), _mm_cmpge_ps(tx, tz)));
+        __m128 useY = _mm_andnot_ps(_mm_or_ps(useW, useX), _mm_cmpge_ps(ty, tz));
+
+        __m128 tMax = Select(useW, tw, Select(useX, tx, Select(useY, ty, tz)));
+        __m128 major = _mm_mul_ps(half, _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(one, tMax), epsilon)));
+        __m128 f = _mm_div_ps(quarter, major);
+
+        __m128 p = _mm_mul_ps(_mm_sub_ps(q1z, q2y), f);   // x*w
+        __m128 q = _mm_mul_ps(_mm_sub_ps(q2x, q0z), f);   // y*w
+        __m128 r = _mm_mul_ps(_mm_sub_ps(q0y, q1x), f);   // z*w
+        __m128 a = _mm_mul_ps(_mm_add_ps(q0y, q1x), f);   // x*y
+        __m128 b = _mm_mul_ps(_mm_add_ps(q2x, q0z), f);   // x*z
+        __m128 c = _mm_mul_ps(_mm_add_ps(q1z, q2y), f);   // y*z
+
+        __m128 qx = Select(useW, p, Select(useX, major, Select(useY, a, b)));
+        __m128 qy = Select(useW, q, Select(useX, a, Select(useY, major, c)));
+        __m128 qz = Select(useW, r, Select(useX, b, Select(useY, c, major)));
+        __m128 qw = Select(useW, major, Select(useX, p, Select(useY, q, r)));
+
+        // Forma canónica (w >= 0) y normalización final
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(qw, zero), _mm_set1_ps(-0.0f));
+        qx = _mm_xor_ps(qx, flip);
+        qy = _mm_xor_ps(qy, flip);
+        qz = _mm_xor_ps(qz, flip);
+        qw = _mm_xor_ps(qw, flip);
+        NormalizeQuat(qx, qy, qz, qw);
+
+        // ====================================================================
+        // Escribir resultados de los carriles válidos
+        // ====================================================================
+        alignas(16) float res[7][LANES];
+        _mm_store_ps(res[0], qx);
+        _mm_store_ps(res[1], qy);
+        _mm_store_ps(res[2], qz);
+        _mm_store_ps(res[3], qw);
+        _mm_store_ps(res[4], sx);
+        _mm_store_ps(res[5], sy);
+        _mm_store_ps(res[6], sz);
+        int mirrorBits = _mm_movemask_ps(mirrorMask);
+
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+            size_t i = base + lane;
+            out.translations[i] = D3DXVECTOR3(m[9][lane], m[10][lane], m[11][lane]);
+            out.rotations[i] = D3DXQUATERNION(res[0][lane], res[1][lane], res[2][lane], res[3][lane]);
+            out.scales[i] = D3DXVECTOR3(res[4][lane], res[5][lane], res[6][lane]);
+            out.mirrored[i] = (mirrorBits >> lane) & 1 ? 1 : 0;
+        }
+    }
 }
 
 D3DXVECTOR3 MatrixConverter::ExtractTranslation(const D3DXMATRIX& matrix)
@@ -397,12 +756,52 @@ FbxAMatrix MatrixConverter::ConvertMatrixWithOptions(
         result = D3DMatrixToFbxAMatrix(matrix);
     }
 
+    ApplyOptions(result, options);
+
+    return result;
+}
+
+void MatrixConverter::ConvertMatricesWithOptions(
+    const D3DXMATRIX* matrices,
+    size_t count,
+    const ConversionOptions& options,
+    vector<FbxAMatrix>& out)
+{
+    out.resize(count);
+
+    if (options.targetCoordSystem == CoordinateSystem::RIGHT_HANDED)
+    {
+        // Descomponer todo el lote de una vez y recomponer en RH
+        DecomposedTransforms trs;
+        DecomposeMatrices(matrices, count, trs);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = ComposeMatrix_LH_to_RH(trs.translations[i], trs.rotations[i], trs.scales[i]);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = D3DMatrixToFbxAMatrix(matrices[i]);
+        }
+    }
+
+    for (FbxAMatrix& matrix : out)
+    {
+        ApplyOptions(matrix, options);
+    }
+}
+
+void MatrixConverter::ApplyOptions(FbxAMatrix& matrix, const ConversionOptions& options)
+{
     // Aplicar escala global si es necesario
     if (options.scale != 1.0f)
     {
-        FbxVector4 translation = result.GetT();
+        FbxVector4 translation = matrix.GetT();
         translation = ApplyGlobalScale(translation, options.scale);
-        result.SetT(translation);
+        matrix.SetT(translation);
     }
 
     // Ajustar eje vertical si es necesario
@@ -412,8 +811,6 @@ FbxAMatrix MatrixConverter::ConvertMatrixWithOptions(
         FbxAMatrix rotationMatrix;
         FbxVector4 rotation(-90.0, 0.0, 0.0);  // Rotar -90° en X
         rotationMatrix.SetR(rotation);
-        result = rotationMatrix * result;
+        matrix = rotationMatrix * matrix;
     }
-
-    return result;
 }
@@ -5,6 +5,32 @@
 
 #include "../include/Common.h"
 
+/**
+ * @struct DecomposedTransforms
+ * @brief Resultado de una descomposición por lotes (Structure of Arrays)
+ *
+ * Cada array tiene un elemento por matriz de entrada, en el mismo orden.
+ * Si la matriz tenía determinante negativo (espejo), mirrored[i] = 1 y el
+ * signo del reflejo queda en scales[i].x.
+ */
+struct DecomposedTransforms
+{
+    vector<D3DXVECTOR3> translations;
+    vector<D3DXQUATERNION> rotations;
+    vector<D3DXVECTOR3> scales;
+    vector<BYTE> mirrored;
+
+    void Resize(size_t count)
+    {
+        translations.resize(count);
+        rotations.resize(count);
+        scales.resize(count);
+        mirrored.resize(count);
+    }
+
+    size_t Size() const { return translations.size(); }
+};
+
 /**
  * @class MatrixConverter
  * @brief Maneja la conversión de matrices entre sistemas de coordenadas
@@ -62,6 +88,117 @@ public:
      */
     static FbxVector4 ConvertScale(const D3DXVECTOR3& dxScale);
 
+    /**
+     * Convertir posiciones DirectX (LH) a control points FBX (RH) por lotes
+     *
+     * Equivale a ConvertPosition_LH_to_RH() + ApplyGlobalScale() por elemento.
+     * stride permite leer tanto arrays de posiciones (SoA) como el campo
+     * position de un array de Vertex (AoS).
+     *
+     * @param positions Primera posición
+     * @param stride Bytes entre posiciones consecutivas
+     * @param count Número de posiciones
+     * @param scale Escala global
+     * @param out [out] Posiciones FBX (count elementos)
+     */
+    static void ConvertPositions_LH_to_RH(
+        const D3DXVECTOR3* positions,
+        size_t stride,
+        size_t count,
+        float scale,
+        FbxVector4* out
+    );
+
+    /**
+     * Convertir normales DirectX (LH) a FBX (RH) por lotes (Z invertida, w = 0)
+     * @param normals Primera normal
+     * @param stride Bytes entre normales consecutivas
+     * @param count Número de normales
+     * @param out [out] Normales FBX (count elementos)
+     */
+    static void ConvertNormals_LH_to_RH(
+        const D3DXVECTOR3* normals,
+        size_t stride,
+        size_t count,
+        FbxVector4* out
+    );
+
+    /**
+     * Convertir coordenadas de textura DirectX a FBX por lotes (V invertida)
+     * @param texCoords Primera coordenada
+     * @param stride Bytes entre coordenadas consecutivas
+     * @param count Número de coordenadas
+     * @param out [out] UVs FBX (count elementos)
+     */
+    static void ConvertTexCoords(
+        const D3DXVECTOR2* texCoords,
+        size_t stride,
+        size_t count,
+        FbxVector2* out
+    );
+
+    /**
+     * Convertir colores de vértice a FBX por lotes
+     * @param colors Primer color
+     * @param stride Bytes entre colores consecutivos
+     * @param count Número de colores
+     * @param out [out] Colores FBX (count elementos)
+     */
+    static void ConvertColors(
+        const D3DXCOLOR* colors,
+        size_t stride,
+        size_t count,
+        FbxColor* out
+    );
+
+    /**
+     * Convertir quaternions DirectX (LH) a ángulos Euler XYZ de FBX (RH) por lotes
+     *
+     * Equivale a ConvertQuaternion_LH_to_RH() + FbxAMatrix::SetQ() + GetR()
+     * para cada elemento, pero procesa 4 quaternions por instrucción SSE.
+     *
+     * @param quats Quaternions de DirectX
+     * @param count Número de quaternions
+     * @param outX [out] Rotación X en grados (count elementos)
+     * @param outY [out] Rotación Y en grados
+     * @param outZ [out] Rotación Z en grados
+     */
+    static void ConvertQuaternionsToEuler_LH_to_RH(
+        const D3DXQUATERNION* quats,
+        size_t count,
+        float* outX,
+        float* outY,
+        float* outZ);
+
+    /**
+     * Convertir ángulos Euler XYZ de FBX (RH, grados) a quaternions DirectX (LH)
+     *
+     * Inversa de ConvertQuaternionsToEuler_LH_to_RH() (la usa la lectura de
+     * FBX para verificar lo exportado).
+     *
+     * @param x Rotación X en grados (count elementos)
+     * @param y Rotación Y en grados
+     * @param z Rotación Z en grados
+     * @param count Número de rotaciones
+     * @param out [out] Quaternions de DirectX (count elementos)
+     */
+    static void ConvertEulerToQuaternions_RH_to_LH(
+        const float* x,
+        const float* y,
+        const float* z,
+        size_t count,
+        D3DXQUATERNION* out);
+
+    /**
+     * Filtro de continuidad para secuencias de ángulos Euler (grados)
+     *
+     * Para cada key elige, entre la solución original y su equivalente
+     * (x+180, 180-y, z+180), desplazadas ±360°, la más cercana a la key
+     * anterior. Evita saltos que la interpolación de curvas convertiría
+     * en giros completos.
+     */
+    static void FilterEulerContinuity(float* x, float* y, float* z, size_t count);
+
     /**
      * Descomponer matriz D3DXMATRIX en Translation, Rotation, Scale
      * @param matrix Matriz a descomponer
@@ -76,6 +213,36 @@ public:
         D3DXVECTOR3& scale
     );
 
+    /**
+     * Descomponer un lote de matrices en TRS (4 matrices por iteración SSE)
+     *
+     * Usa descomposición polar (iteración de Newton) sobre la parte 3x3,
+     * por lo que tolera shear y matrices con determinante negativo.
+     *
+     * @param matrices Array de matrices a descomponer
+     * @param count Número de matrices
+     * @param out [out] Traslaciones, rotaciones y escalas en arrays separados
+     */
+    static void DecomposeMatrices(
+        const D3DXMATRIX* matrices,
+        size_t count,
+        DecomposedTransforms& out
+    );
+
+    /**
+     * Versión por lotes de ConvertMatrixWithOptions
+     * @param matrices Array de matrices DirectX
+     * @param count Número de matrices
+     * @param options Opciones de conversión
+     * @param out [out] Matrices FBX convertidas (mismo orden que la entrada)
+     */
+    static void ConvertMatricesWithOptions(
+        const D3DXMATRIX* matrices,
+        size_t count,
+        const ConversionOptions& options,
+        vector<FbxAMatrix>& out
+    );
+
     /**
      * Extraer rotación de una matriz
      * @param matrix Matriz
@@ -135,9 +302,23 @@ private:
      * Invierte el eje Z: [1,0,0,0; 0,1,0,0; 0,0,-1,0; 0,0,0,1]
      */
     static FbxAMatrix s_ConversionMatrix_LH_to_RH;
-    static bool s_ConversionMatrixInitialized;
+    static once_flag s_ConversionMatrixOnce;  // Inicialización segura entre hilos
     static void InitializeConversionMatrix();
 
+    /**
+     * Helper: Construir matriz FBX (RH) desde componentes TRS de DirectX
+     */
+    static FbxAMatrix ComposeMatrix_LH_to_RH(
+        const D3DXVECTOR3& translation,
+        const D3DXQUATERNION& rotation,
+        const D3DXVECTOR3& scale
+    );
+
+    /**
+     * Helper: Aplicar escala global y eje vertical de las opciones
+     */
+    static void ApplyOptions(FbxAMatrix& matrix, const ConversionOptions& options);
+
     /**
      * Helper: Normalizar quaternion
      */
@@ -0,0 +1,627 @@
+#include "MeshOptimizer.h"
+#include "SimdMath.h"
+
+#include <set>
+
+// Peso mínimo para considerar que un vértice pertenece solo a un hueso
+static const float RIGID_WEIGHT = 1.0f - EPSILON;
+
+// Máximo de huesos distintos en un triángulo
+static const size_t TRIANGLE_MAX_BONES = 3 * MAX_BONE_INFLUENCES;
+
+// ============================================================================
+// Detección de skin rígido
+// ============================================================================
+
+int MeshOptimizer::FindRigidBone(const MeshData& mesh)
+{
+    int rigidBone = -1;
+
+    for (const Vertex& vertex : mesh.vertices)
+    {
+        int vertexBone = -1;
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            if (vertex.boneWeights[i] >= RIGID_WEIGHT)
+            {
+                vertexBone = (int)vertex.boneIndices[i];
+                break;
+            }
+        }
+
+        if (vertexBone < 0 || vertexBone >= (int)mesh.bones.size())
+            return -1;
+        if (rigidBone >= 0 && vertexBone != rigidBone)
+            return -1;
+
+        rigidBone = vertexBone;
+    }
+
+    return rigidBone;
+}
+
+// ============================================================================
+// Huesos sin uso
+// ============================================================================
+
+size_t MeshOptimizer::RemoveUnusedBones(MeshData& mesh)
+{
+    vector<char> used(mesh.bones.size(), 0);
+    for (const Vertex& vertex : mesh.vertices)
+    {
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            if (vertex.boneWeights[i] > 0.0f && vertex.boneIndices[i] < mesh.bones.size())
+                used[vertex.boneIndices[i]] = 1;
+        }
+    }
+
+    // Índice nuevo de cada hueso conservado
+    vector<DWORD> remap(mesh.bones.size(), 0);
+    vector<BoneData> bones;
+    for (size_t b = 0; b < mesh.bones.size(); b++)
+    {
+        if (!used[b])
+            continue;
+
+        remap[b] = (DWORD)bones.size();
+        bones.push_back(mesh.bones[b]);
+    }
+
+    size_t removed = mesh.bones.size() - bones.size();
+    if (removed == 0)
+        return 0;
+
+    for (Vertex& vertex : mesh.vertices)
+    {
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            if (vertex.boneWeights[i] > 0.0f && vertex.boneIndices[i] < remap.size())
+                vertex.boneIndices[i] = remap[vertex.boneIndices[i]];
+            else
+                vertex.boneIndices[i] = 0;
+        }
+    }
+
+    mesh.bones.swap(bones);
+
+    // Sin huesos con peso el mesh ya no se deforma
+    if (mesh.bones.empty())
+        ClearSkinning(mesh);
+
+    return removed;
+}
+
+// ============================================================================
+// Deformación de vértices
+// ============================================================================
+
+void MeshOptimizer::SkinVertices(MeshData& mesh, const vector<D3DXMATRIX>& boneMatrices)
+{
+    for (Vertex& vertex : mesh.vertices)
+    {
+        D3DXVECTOR3 position(0, 0, 0);
+        D3DXVECTOR3 normal(0, 0, 0);
+
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            float weight = vertex.boneWeights[i];
+            DWORD bone = vertex.boneIndices[i];
+            if (weight <= 0.0f || bone >= boneMatrices.size())
+                continue;
+
+            D3DXVECTOR3 p, n;
+            D3DXVec3TransformCoord(&p, &vertex.position, &boneMatrices[bone]);
+            D3DXVec3TransformNormal(&n, &vertex.normal, &boneMatrices[bone]);
+
+            position += p * weight;
+            normal += n * weight;
+        }
+
+        vertex.position = position;
+        D3DXVec3Normalize(&vertex.normal, &normal);
+    }
+}
+
+void MeshOptimizer::ClearSkinning(MeshData& mesh)
+{
+    for (Vertex& vertex : mesh.vertices)
+    {
+        for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+        {
+            vertex.boneIndices[i] = 0;
+            vertex.boneWeights[i] = 0.0f;
+        }
+    }
+
+    mesh.bones.clear();
+    mesh.hasSkinning = false;
+}
+
+// ============================================================================
+// Hornear skins estáticos y rígidos
+// ============================================================================
+
+void MeshOptimizer::BakeRigidSkins(SceneData& sceneData, const ConversionOptions& options)
+{
+    if (!sceneData.rootFrame)
+        return;
+
+    // ========================================================================
+    // Jerarquía en orden DFS (padres antes que hijos) y matrices globales
+    // ========================================================================
+    vector<FrameData*> frames;
+    vector<int> parents;
+    {
+        vector<pair<FrameData*, int>> stack(1, make_pair(sceneData.rootFrame, -1));
+        while (!stack.empty())
+        {
+            FrameData* frame = stack.back().first;
+            int parent = stack.back().second;
+            stack.pop_back();
+
+            int index = (int)frames.size();
+            frames.push_back(frame);
+            parents.push_back(parent);
+
+            for (size_t i = frame->children.size(); i-- > 0;)
+                stack.push_back(make_pair(frame->children[i], index));
+        }
+    }
+
+    const size_t frameCount = frames.size();
+    vector<D3DXMATRIX> globals(frameCount);
+    map<string, size_t> frameIndex;
+
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        if (parents[f] < 0)
+            globals[f] = frames[f]->transformMatrix;
+        else
+            SimdMath::MatrixMultiply(frames[f]->transformMatrix, globals[parents[f]], globals[f]);
+
+        if (!frames[f]->name.empty())
+            frameIndex[frames[f]->name] = f;
+    }
+
+    // ========================================================================
+    // Frames animados (con keys en algún clip, o con un ancestro animado)
+    // ========================================================================
+    set<string> animatedNames;
+    for (const AnimationClip& clip : sceneData.animations)
+    {
+        for (const AnimationTrack& track : clip.tracks)
+        {
+            if (!track.GetKeys().empty())
+                animatedNames.insert(track.boneName);
+        }
+    }
+
+    vector<char> animated(frameCount, 0);
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        animated[f] = animatedNames.count(frames[f]->name) > 0 ||
+                      (parents[f] >= 0 && animated[parents[f]]);
+    }
+
+    // ========================================================================
+    // Clasificar meshes con skinning
+    // ========================================================================
+    enum SkinAction { KEEP_SKIN, BAKE_STATIC, BAKE_RIGID };
+
+    struct SkinnedMesh
+    {
+        MeshData* mesh;
+        size_t frame;                  // Frame dueño del mesh
+        SkinAction action;
+        size_t targetFrame;            // Frame del hueso (BAKE_RIGID)
+        vector<D3DXMATRIX> boneMatrices;
+        size_t removedBones;
+    };
+
+    vector<SkinnedMesh> skinned;
+    vector<char> wasBone(frameCount, 0);
+
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        for (MeshData* mesh : frames[f]->meshes)
+        {
+            if (!mesh->hasSkinning || mesh->bones.empty())
+                continue;
+
+            SkinnedMesh entry;
+            entry.mesh = mesh;
+            entry.frame = f;
+            entry.action = KEEP_SKIN;
+            entry.targetFrame = f;
+            entry.removedBones = 0;
+
+            // Frame de cada hueso (-1 si no está en la jerarquía)
+            vector<int> boneFrames(mesh->bones.size(), -1);
+            bool anyAnimated = animated[f] != 0;
+
+            for (size_t b = 0; b < mesh->bones.size(); b++)
+            {
+                auto it = frameIndex.find(mesh->bones[b].name);
+                if (it == frameIndex.end())
+                    continue;
+
+                boneFrames[b] = (int)it->second;
+                wasBone[it->second] = 1;
+                anyAnimated = anyAnimated || animated[it->second];
+            }
+
+            int rigidBone = FindRigidBone(*mesh);
+
+            if (!anyAnimated)
+            {
+                // Pose de reposo en el espacio local del frame del mesh:
+                //   vértice * offset * Global(hueso) * Inversa(Global(frame))
+                D3DXMATRIX inverseFrame;
+                if (!D3DXMatrixInverse(&inverseFrame, nullptr, &globals[f]))
+                    D3DXMatrixIdentity(&inverseFrame);
+
+                entry.boneMatrices.resize(mesh->bones.size());
+                for (size_t b = 0; b < mesh->bones.size(); b++)
+                {
+                    D3DXMATRIX boneMatrix;
+                    if (boneFrames[b] >= 0)
+                        D3DXMatrixMultiply(&boneMatrix, &mesh->bones[b].offsetMatrix, &globals[boneFrames[b]]);
+                    else
+                        D3DXMatrixIdentity(&boneMatrix);
+
+                    D3DXMatrixMultiply(&entry.boneMatrices[b], &boneMatrix, &inverseFrame);
+                }
+
+                entry.action = BAKE_STATIC;
+            }
+            else if (rigidBone >= 0 && boneFrames[rigidBone] >= 0)
+            {
+                // Espacio del hueso: vértice * offset; el nodo del hueso lo anima
+                entry.boneMatrices.resize(mesh->bones.size());
+                for (size_t b = 0; b < mesh->bones.size(); b++)
+                    entry.boneMatrices[b] = mesh->bones[b].offsetMatrix;
+
+                entry.action = BAKE_RIGID;
+                entry.targetFrame = (size_t)boneFrames[rigidBone];
+            }
+
+            skinned.push_back(entry);
+        }
+    }
+
+    if (skinned.empty())
+        return;
+
+    // ========================================================================
+    // Deformar vértices (en paralelo por mesh)
+    // ========================================================================
+    Utils::ParallelFor(skinned.size(), options.numThreads, [&](size_t i)
+    {
+        SkinnedMesh& entry = skinned[i];
+
+        if (entry.action == KEEP_SKIN)
+        {
+            entry.removedBones = RemoveUnusedBones(*entry.mesh);
+            return;
+        }
+
+        SkinVertices(*entry.mesh, entry.boneMatrices);
+        entry.removedBones = entry.mesh->bones.size();
+        ClearSkinning(*entry.mesh);
+    });
+
+    // ========================================================================
+    // Mover los meshes rígidos al frame de su hueso
+    // ========================================================================
+    size_t bakedStatic = 0;
+    size_t bakedRigid = 0;
+    size_t removedBones = 0;
+
+    for (SkinnedMesh& entry : skinned)
+    {
+        removedBones += entry.removedBones;
+
+        if (entry.action == BAKE_STATIC)
+        {
+            bakedStatic++;
+            Utils::Log("  Mesh '" + entry.mesh->name + "': baked to static geometry", options.verbose);
+        }
+        else if (entry.action == BAKE_RIGID)
+        {
+            bakedRigid++;
+
+            vector<MeshData*>& owner = frames[entry.frame]->meshes;
+            owner.erase(remove(owner.begin(), owner.end(), entry.mesh), owner.end());
+            frames[entry.targetFrame]->meshes.push_back(entry.mesh);
+
+            Utils::Log("  Mesh '" + entry.mesh->name + "': rigid, attached to '" +
+                       frames[entry.targetFrame]->name + "'", options.verbose);
+        }
+    }
+
+    // ========================================================================
+    // Eliminar frames que solo eran huesos de los skins horneados
+    // ========================================================================
+    vector<char> stillBone(frameCount, 0);
+    for (const SkinnedMesh& entry : skinned)
+    {
+        for (const BoneData& bone : entry.mesh->bones)
+        {
+            auto it = frameIndex.find(bone.name);
+            if (it != frameIndex.end())
+                stillBone[it->second] = 1;
+        }
+    }
+
+    // Orden inverso: los hijos se procesan antes que su padre, que puede
+    // quedar como hoja en la misma pasada
+    size_t removedFrames = 0;
+    for (size_t f = frameCount; f-- > 1;)
+    {
+        FrameData* frame = frames[f];
+        if (!wasBone[f] || stillBone[f] || animatedNames.count(frame->name) ||
+            !frame->children.empty() || !frame->meshes.empty())
+            continue;
+
+        vector<FrameData*>& siblings = frames[parents[f]]->children;
+        siblings.erase(remove(siblings.begin(), siblings.end(), frame), siblings.end());
+        delete frame;
+        removedFrames++;
+    }
+
+    cout << "  Skinned meshes: " << skinned.size() << " (" << bakedStatic << " baked static, "
+         << bakedRigid << " baked rigid), " << removedBones << " bone(s) and "
+         << removedFrames << " frame(s) removed\n";
+}
+
+// ============================================================================
+// Partición por paletas de huesos
+// ============================================================================
+
+bool MeshOptimizer::PartitionMesh(const MeshData& mesh, size_t maxBones, vector<MeshData*>& parts)
+{
+    parts.clear();
+
+    const size_t boneCount = mesh.bones.size();
+    if (!mesh.hasSkinning || boneCount <= maxBones)
+        return false;
+
+    // Un triángulo debe caber siempre en una paleta vacía
+    maxBones = max(maxBones, TRIANGLE_MAX_BONES);
+
+    // ========================================================================
+    // Huesos de cada triángulo (sin repetir)
+    // ========================================================================
+    struct TriangleBones
+    {
+        DWORD bones[TRIANGLE_MAX_BONES];
+        DWORD count;
+    };
+
+    const size_t triangleCount = mesh.indices.size() / 3;
+    vector<TriangleBones> triangleBones(triangleCount);
+
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        TriangleBones& tri = triangleBones[t];
+        tri.count = 0;
+
+        for (int k = 0; k < 3; k++)
+        {
+            const Vertex& vertex = mesh.vertices[mesh.indices[t * 3 + k]];
+            for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+            {
+                DWORD bone = vertex.boneIndices[i];
+                if (vertex.boneWeights[i] <= 0.0f || bone >= boneCount)
+                    continue;
+
+                if (find(tri.bones, tri.bones + tri.count, bone) == tri.bones + tri.count)
+                    tri.bones[tri.count++] = bone;
+            }
+        }
+    }
+
+    // ========================================================================
+    // Agrupación voraz
+    // ========================================================================
+    vector<char> assigned(triangleCount, 0);
+    vector<char> inPalette(boneCount, 0);
+    vector<int> vertexRemap(mesh.vertices.size(), -1);
+    vector<DWORD> boneRemap(boneCount, 0);
+
+    size_t firstFree = 0;
+    size_t remaining = triangleCount;
+
+    while (remaining > 0)
+    {
+        vector<DWORD> palette;
+        vector<DWORD> triangles;
+
+        auto addTriangle = [&](size_t t)
+        {
+            const TriangleBones& tri = triangleBones[t];
+            for (DWORD i = 0; i < tri.count; i++)
+            {
+                if (!inPalette[tri.bones[i]])
+                {
+                    inPalette[tri.bones[i]] = 1;
+                    palette.push_back(tri.bones[i]);
+                }
+            }
+
+            assigned[t] = 1;
+            triangles.push_back((DWORD)t);
+            remaining--;
+        };
+
+        while (assigned[firstFree])
+            firstFree++;
+        addTriangle(firstFree);
+
+        for (;;)
+        {
+            // Agregar los triángulos que no suman huesos y buscar el que
+            // suma menos entre los que todavía caben
+            size_t best = triangleCount;
+            size_t bestNewBones = TRIANGLE_MAX_BONES + 1;
+
+            for (size_t t = firstFree; t < triangleCount; t++)
+            {
+                if (assigned[t])
+                    continue;
+
+                const TriangleBones& tri = triangleBones[t];
+                size_t newBones = 0;
+                for (DWORD i = 0; i < tri.count; i++)
+                    newBones += inPalette[tri.bones[i]] ? 0 : 1;
+
+                if (newBones == 0)
+                    addTriangle(t);
+                else if (newBones < bestNewBones && palette.size() + newBones <= maxBones)
+                {
+                    best = t;
+                    bestNewBones = newBones;
+                }
+            }
+
+            if (best == triangleCount)
+                break;
+
+            addTriangle(best);
+        }
+
+        // ====================================================================
+        // Crear la parte (vértices duplicados solo si ya los usó otra parte)
+        // ====================================================================
+        MeshData* part = new MeshData();
+        part->name = mesh.name + "_part" + std::to_string(parts.size() + 1);
+        part->materials = mesh.materials;
+        part->texCoordSetCount = mesh.texCoordSetCount;
+        part->hasVertexColors = mesh.hasVertexColors;
+        part->hasSkinning = true;
+
+        sort(palette.begin(), palette.end());
+        part->bones.reserve(palette.size());
+        for (size_t i = 0; i < palette.size(); i++)
+        {
+            boneRemap[palette[i]] = (DWORD)i;
+            part->bones.push_back(mesh.bones[palette[i]]);
+        }
+
+        vector<DWORD> sourceVertices;
+        part->indices.reserve(triangles.size() * 3);
+        if (!mesh.materialIndices.empty())
+            part->materialIndices.reserve(triangles.size());
+
+        for (DWORD t : triangles)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                DWORD source = mesh.indices[t * 3 + k];
+                if (vertexRemap[source] < 0)
+                {
+                    vertexRemap[source] = (int)part->vertices.size();
+                    sourceVertices.push_back(source);
+
+                    Vertex vertex = mesh.vertices[source];
+                    for (int i = 0; i < MAX_BONE_INFLUENCES; i++)
+                    {
+                        if (vertex.boneWeights[i] > 0.0f && vertex.boneIndices[i] < boneCount)
+                            vertex.boneIndices[i] = boneRemap[vertex.boneIndices[i]];
+                        else
+                        {
+                            vertex.boneIndices[i] = 0;
+                            vertex.boneWeights[i] = 0.0f;
+                        }
+                    }
+                    part->vertices.push_back(vertex);
+                }
+
+                part->indices.push_back((DWORD)vertexRemap[source]);
+            }
+
+            if (t < mesh.materialIndices.size())
+                part->materialIndices.push_back(mesh.materialIndices[t]);
+        }
+
+        // Preparar los mapas para la parte siguiente
+        for (DWORD source : sourceVertices)
+            vertexRemap[source] = -1;
+        for (DWORD bone : palette)
+            inPalette[bone] = 0;
+
+        parts.push_back(part);
+    }
+
+    return true;
+}
+
+void MeshOptimizer::PartitionBonePalettes(SceneData& sceneData, const ConversionOptions& options)
+{
+    if (!sceneData.rootFrame || options.maxPaletteBones == 0)
+        return;
+
+    // Meshes que no caben en una paleta
+    vector<pair<FrameData*, MeshData*>> meshes;
+    vector<FrameData*> stack(1, sceneData.rootFrame);
+
+    while (!stack.empty())
+    {
+        FrameData* frame = stack.back();
+        stack.pop_back();
+
+        for (MeshData* mesh : frame->meshes)
+        {
+            if (mesh->hasSkinning && mesh->bones.size() > options.maxPaletteBones)
+                meshes.push_back(make_pair(frame, mesh));
+        }
+
+        for (FrameData* child : frame->children)
+            stack.push_back(child);
+    }
+
+    if (options.maxPaletteBones < TRIANGLE_MAX_BONES && !meshes.empty())
+    {
+        Utils::LogWarning("Bone palette smaller than " + std::to_string(TRIANGLE_MAX_BONES) +
+                          " bones, using " + std::to_string(TRIANGLE_MAX_BONES));
+    }
+
+    vector<vector<MeshData*>> parts(meshes.size());
+    Utils::ParallelFor(meshes.size(), options.numThreads, [&](size_t i)
+    {
+        PartitionMesh(*meshes[i].second, options.maxPaletteBones, parts[i]);
+    });
+
+    // Reemplazar cada mesh por sus partes (en la misma posición del frame)
+    size_t partCount = 0;
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        if (parts[i].empty())
+            continue;
+
+        FrameData* frame = meshes[i].first;
+        MeshData* mesh = meshes[i].second;
+
+        if (options.verbose)
+        {
+            size_t vertexCount = 0;
+            for (const MeshData* part : parts[i])
+                vertexCount += part->vertices.size();
+
+            cout << "  Mesh '" << mesh->name << "': " << mesh->bones.size() << " bones -> "
+                 << parts[i].size() << " part(s), " << mesh->vertices.size() << " -> "
+                 << vertexCount << " vertices\n";
+        }
+
+        auto it = find(frame->meshes.begin(), frame->meshes.end(), mesh);
+        it = frame->meshes.erase(it);
+        frame->meshes.insert(it, parts[i].begin(), parts[i].end());
+
+        partCount += parts[i].size();
+        delete mesh;
+    }
+
+    cout << "  Bone palettes (" << options.maxPaletteBones << " bones): " << meshes.size()
+         << " mesh(es) split into " << partCount << " part(s)\n";
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "../include/Common.h"
+
+/**
+ * @class MeshOptimizer
+ * @brief Simplifica meshes con skinning que no necesitan deformarse
+ *
+ * Para cada mesh con skinning:
+ *   - Estático: si ni sus huesos ni su frame (ni sus ancestros) tienen
+ *     animación, los vértices se deforman una vez en la pose de reposo y se
+ *     guardan en el espacio local de su frame. Se quita el skin.
+ *   - Rígido: si todos los vértices están 100% asignados al mismo hueso, los
+ *     vértices pasan al espacio de ese hueso (vértice * offsetMatrix) y el
+ *     mesh se mueve a su frame: la animación del nodo lo mueve igual que el
+ *     skinning. Se quita el skin.
+ *   - Resto: se eliminan los huesos que no influyen en ningún vértice.
+ *
+ * Después se eliminan los frames hoja que solo existían como huesos de
+ * esos skins (sin meshes, sin hijos, sin animación y sin otro skin que los use).
+ *
+ * También divide los meshes con más huesos de los que admite una paleta de
+ * skinning en GPU (PartitionBonePalettes).
+ */
+class MeshOptimizer
+{
+public:
+    /**
+     * Hornear skins estáticos/rígidos y eliminar huesos sin uso
+     * @param sceneData Escena a modificar (jerarquía y meshes)
+     * @param options numThreads y verbose
+     */
+    static void BakeRigidSkins(SceneData& sceneData, const ConversionOptions& options);
+
+    /**
+     * Hueso al que están asignados al 100% todos los vértices
+     * @return Índice en mesh.bones, o -1 si el mesh no es rígido
+     */
+    static int FindRigidBone(const MeshData& mesh);
+
+    /**
+     * Eliminar los huesos sin vértices y reindexar boneIndices
+     * @return Número de huesos eliminados
+     */
+    static size_t RemoveUnusedBones(MeshData& mesh);
+
+    /**
+     * Dividir los meshes con skinning que superan options.maxPaletteBones
+     * Cada parte reemplaza al mesh original en su frame (nodo propio en el FBX).
+     * @param sceneData Escena a modificar
+     * @param options maxPaletteBones, numThreads y verbose
+     */
+    static void PartitionBonePalettes(SceneData& sceneData, const ConversionOptions& options);
+
+    /**
+     * Dividir un mesh en partes cuyos huesos caben en una paleta
+     *
+     * Agrupación voraz de triángulos: cada parte empieza con el primer
+     * triángulo libre y, mientras quepa, agrega primero todos los triángulos
+     * cuyos huesos ya están en la paleta y después el que agrega menos
+     * huesos nuevos. Solo se duplican los vértices compartidos entre partes.
+     *
+     * @param mesh Mesh con skinning
+     * @param maxBones Huesos por paleta (al menos 3 * MAX_BONE_INFLUENCES)
+     * @param parts [out] Partes nuevas (el llamador es dueño)
+     * @return false si el mesh ya cabe en una paleta (no se crean partes)
+     */
+    static bool PartitionMesh(const MeshData& mesh, size_t maxBones, vector<MeshData*>& parts);
+
+private:
+    // Deformar posiciones y normales con una matriz por hueso (suma ponderada)
+    static void SkinVertices(MeshData& mesh, const vector<D3DXMATRIX>& boneMatrices);
+
+    // Quitar el skinning del mesh (pesos, índices y huesos)
+    static void ClearSkinning(MeshData& mesh);
+};
+
+#endif // MESH_OPTIMIZER_H
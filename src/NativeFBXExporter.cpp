@@ -0,0 +1,1723 @@
+#include "NativeFBXExporter.h"
+#include "FBXBinaryWriter.h"
+#include "FBXAsciiWriter.h"
+#include "FBXExporter.h"
+#include "MatrixConverter.h"
+#include "PoseBaker.h"
+#include "CurveFitter.h"
+#include <cmath>
+#include <ctime>
+
+// ============================================================================
+// Constantes del formato
+// ============================================================================
+
+// Unidades de tiempo FBX (KTime) por segundo
+static const double FBX_KTIME_PER_SECOND = 46186158000.0;
+
+// Primer id de objeto (0 es la raíz de la escena en las conexiones)
+static const INT64 FBX_FIRST_OBJECT_ID = 1000000;
+
+// Flags de key de FbxAnimCurve (FbxAnimCurveDef)
+static const int32_t FBX_KEY_LINEAR = 0x00000004 | 0x00000100;     // eInterpolationLinear | eTangentAuto
+static const int32_t FBX_KEY_CUBIC_USER = 0x00000008 | 0x00000400; // eInterpolationCubic | eTangentUser
+
+// Pesos de tangente por defecto (1/3, 1/3) empaquetados como los escribe el SDK
+static const float FBX_KEY_DEFAULT_WEIGHTS = 9.419963346924634e-30f;
+
+// Valores fijos del encabezado; FBXBinaryWriter escribe el pie que les corresponde
+static const unsigned char FBX_FILE_ID[16] =
+{
+    0x28, 0xb3, 0x2a, 0xeb, 0xb6, 0x24, 0xcc, 0xc2,
+    0xbf, 0xc8, 0xb0, 0x2a, 0xa9, 0x2b, 0xfc, 0xf1
+};
+static const char* FBX_CREATION_TIME = "1970-01-01 10:00:00:000";
+static const char* FBX_CREATOR = "XtoFBX Converter";
+
+// ============================================================================
+// Helpers de escritura
+// ============================================================================
+
+static INT64 SecondsToKTime(double seconds)
+{
+    return (INT64)llround(seconds * FBX_KTIME_PER_SECOND);
+}
+
+// Nodo con una sola propiedad
+static void WriteInt32Node(FBXRecordWriter& writer, const char* name, int32_t value)
+{
+    writer.BeginNode(name);
+    writer.AddInt32(value);
+    writer.EndNode();
+}
+
+static void WriteInt64Node(FBXRecordWriter& writer, const char* name, int64_t value)
+{
+    writer.BeginNode(name);
+    writer.AddInt64(value);
+    writer.EndNode();
+}
+
+static void WriteStringNode(FBXRecordWriter& writer, const char* name, const string& value)
+{
+    writer.BeginNode(name);
+    writer.AddString(value);
+    writer.EndNode();
+}
+
+// Propiedades de Properties70: P: "nombre", "tipo", "etiqueta", "flags", valores...
+static void BeginProperty(FBXRecordWriter& writer, const char* name, const char* type, const char* label, const char* flags)
+{
+    writer.BeginNode("P");
+    writer.AddString(name);
+    writer.AddString(type);
+    writer.AddString(label);
+    writer.AddString(flags);
+}
+
+static void WriteIntProperty(FBXRecordWriter& writer, const char* name, int32_t value)
+{
+    BeginProperty(writer, name, "int", "Integer", "");
+    writer.AddInt32(value);
+    writer.EndNode();
+}
+
+static void WriteEnumProperty(FBXRecordWriter& writer, const char* name, int32_t value)
+{
+    BeginProperty(writer, name, "enum", "", "");
+    writer.AddInt32(value);
+    writer.EndNode();
+}
+
+static void WriteDoubleProperty(FBXRecordWriter& writer, const char* name, double value)
+{
+    BeginProperty(writer, name, "double", "Number", "");
+    writer.AddDouble(value);
+    writer.EndNode();
+}
+
+static void WriteNumberProperty(FBXRecordWriter& writer, const char* name, double value)
+{
+    BeginProperty(writer, name, "Number", "", "A");
+    writer.AddDouble(value);
+    writer.EndNode();
+}
+
+static void WriteTimeProperty(FBXRecordWriter& writer, const char* name, INT64 value)
+{
+    BeginProperty(writer, name, "KTime", "Time", "");
+    writer.AddInt64(value);
+    writer.EndNode();
+}
+
+static void WriteStringProperty(FBXRecordWriter& writer, const char* name, const string& value)
+{
+    BeginProperty(writer, name, "KString", "", "");
+    writer.AddString(value);
+    writer.EndNode();
+}
+
+static void WriteVector3Property(FBXRecordWriter& writer, const char* name, const char* type, const char* flags, double x, double y, double z)
+{
+    BeginProperty(writer, name, type, "", flags);
+    writer.AddDouble(x);
+    writer.AddDouble(y);
+    writer.AddDouble(z);
+    writer.EndNode();
+}
+
+static void WriteColorProperty(FBXRecordWriter& writer, const char* name, const D3DCOLORVALUE& color)
+{
+    WriteVector3Property(writer, name, "Color", "A", color.r, color.g, color.b);
+}
+
+// Matriz 4x4 como array de 16 doubles (mismo orden que FbxAMatrix)
+static void WriteMatrixNode(FBXRecordWriter& writer, const char* name, const D3DXMATRIX& matrix)
+{
+    double values[16];
+    for (int i = 0; i < 16; i++)
+        values[i] = matrix.m[i / 4][i % 4];
+
+    writer.BeginNode(name);
+    writer.AddDoubleArray(values, 16);
+    writer.EndNode();
+}
+
+// Matriz DirectX (LH) al espacio FBX (RH, Z invertida): S * M * S con
+// S = diag(1, 1, -1, 1), y escala global en la traslación
+static D3DXMATRIX ConvertMatrix_LH_to_RH(const D3DXMATRIX& matrix, float scale)
+{
+    D3DXMATRIX result = matrix;
+    result.m[0][2] = -result.m[0][2];
+    result.m[1][2] = -result.m[1][2];
+    result.m[2][0] = -result.m[2][0];
+    result.m[2][1] = -result.m[2][1];
+    result.m[2][3] = -result.m[2][3];
+    result.m[3][2] = -result.m[3][2];
+
+    result.m[3][0] *= scale;
+    result.m[3][1] *= scale;
+    result.m[3][2] *= scale;
+    return result;
+}
+
+// FbxTime::EMode según el FPS objetivo (igual que FBXExporter::SetupSceneProperties)
+static int32_t GetTimeMode(double fps)
+{
+    if (fps >= 59.0 && fps <= 61.0)
+        return 3;   // eFrames60
+    if (fps >= 29.0 && fps <= 31.0)
+        return 6;   // eFrames30
+    if (fps >= 23.0 && fps <= 25.0)
+        return 11;  // eFrames24
+    return 6;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+NativeFBXExporter::NativeFBXExporter()
+    : m_pSceneData(nullptr)
+    , m_IncludeMeshes(true)
+    , m_DocumentId(0)
+    , m_FirstAnimationId(0)
+{
+}
+
+// ============================================================================
+// Exportación Principal
+// ============================================================================
+
+bool NativeFBXExporter::ExportScene(
+    const SceneData& sceneData,
+    const string& filename,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+
+    Utils::Log("Starting native FBX export to: " + filename, options.verbose);
+
+    if (!Prepare(sceneData, true))
+    {
+        Utils::LogError(m_LastError);
+        return false;
+    }
+
+    // Un archivo FBX solo tiene un Take activo: con varios clips se escribe
+    // el primero (main exporta el resto como archivos separados)
+    const AnimationClip* clip = sceneData.animations.empty() ? nullptr : &sceneData.animations[0];
+    if (sceneData.animations.size() > 1)
+        Utils::LogWarning("Native FBX writer exports one animation per file; using '" + clip->name + "'");
+
+    bool result = WriteFile(filename, clip);
+
+    if (result)
+        Utils::Log("FBX export completed successfully", options.verbose);
+
+    return result;
+}
+
+bool NativeFBXExporter::ExportSingleAnimation(
+    const SceneData& sceneData,
+    const AnimationClip& animation,
+    const string& filename,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+
+    Utils::Log("Exporting animation '" + animation.name + "' to: " + filename, options.verbose);
+
+    if (!Prepare(sceneData, true))
+    {
+        Utils::LogError(m_LastError);
+        return false;
+    }
+
+    bool result = WriteFile(filename, &animation);
+
+    if (result)
+        Utils::Log("Animation export completed successfully", options.verbose);
+
+    return result;
+}
+
+bool NativeFBXExporter::BeginAnimationExport(
+    const SceneData& sceneData,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+
+    if (!Prepare(sceneData, false))
+    {
+        Utils::LogError(m_LastError);
+        return false;
+    }
+
+    return true;
+}
+
+bool NativeFBXExporter::ExportAnimationOnly(
+    const AnimationClip& animation,
+    const string& filename)
+{
+    if (!m_pSceneData)
+    {
+        m_LastError = "BeginAnimationExport() was not called";
+        return false;
+    }
+
+    Utils::Log("Exporting animation '" + animation.name + "' to: " + filename, m_Options.verbose);
+
+    bool result = WriteFile(filename, &animation);
+
+    if (result)
+        Utils::Log("Animation export completed successfully", m_Options.verbose);
+
+    return result;
+}
+
+bool NativeFBXExporter::WriteFile(const string& filename, const AnimationClip* clip)
+{
+    if (m_Options.nativeFbxAscii)
+    {
+        FBXAsciiWriter writer;
+        return WriteFileWith(writer, filename, clip);
+    }
+
+    FBXBinaryWriter writer;
+    writer.SetCompression(m_Options.fbxCompressionLevel, m_Options.fbxCompressionThreshold, m_Options.numThreads);
+    return WriteFileWith(writer, filename, clip);
+}
+
+template<class Writer>
+bool NativeFBXExporter::WriteFileWith(Writer& writer, const string& filename, const AnimationClip* clip)
+{
+    if (!writer.Open(filename, (uint32_t)m_Options.nativeFbxVersion))
+    {
+        m_LastError = writer.GetLastError();
+        return false;
+    }
+
+    WriteDocument(writer, clip);
+
+    if (!writer.Close())
+    {
+        m_LastError = "Failed to export FBX: " + writer.GetLastError();
+        return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Preparación de la escena
+// ============================================================================
+// Se aplana la jerarquía (padres antes que hijos), se marcan los huesos y se
+// calculan las transformaciones FBX de cada nodo por lotes. Los ids de los
+// objetos de la escena se asignan aquí una sola vez; los del clip se
+// asignan en cada archivo a partir de m_FirstAnimationId.
+// ============================================================================
+
+bool NativeFBXExporter::Prepare(const SceneData& sceneData, bool includeMeshes)
+{
+    m_pSceneData = nullptr;
+    m_IncludeMeshes = includeMeshes;
+    m_Nodes.clear();
+    m_NodeByName.clear();
+    m_Meshes.clear();
+    m_MaterialIds.clear();
+    m_TextureIds.clear();
+    m_TexturePaths.clear();
+    m_SharedCurveData.clear();
+
+    if (!sceneData.rootFrame)
+    {
+        m_LastError = "No root frame in scene data";
+        return false;
+    }
+
+    if (m_Options.targetCoordSystem != CoordinateSystem::RIGHT_HANDED || m_Options.upAxis != UpAxis::Y_AXIS)
+        Utils::LogWarning("Native FBX writer only supports right-handed Y-up output; axis options ignored");
+
+    m_pSceneData = &sceneData;
+    INT64 nextId = FBX_FIRST_OBJECT_ID;
+    m_DocumentId = nextId++;
+
+    // ========================================================================
+    // Nodos: un Model por frame
+    // ========================================================================
+    vector<const FrameData*> frames;
+    vector<int> parents;
+    PoseBaker::FlattenHierarchy(sceneData.rootFrame, frames, parents);
+
+    m_Nodes.resize(frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        NodeEntry& node = m_Nodes[i];
+        node.name = frames[i]->name;
+        node.localMatrix = &frames[i]->transformMatrix;
+        node.parent = parents[i];
+        node.isBone = false;
+
+        if (!node.name.empty())
+            m_NodeByName[node.name] = (int)i;
+    }
+
+    // ========================================================================
+    // Meshes y huesos de sus skins
+    // ========================================================================
+    // Los huesos se marcan también en modo solo skeleton para que los nodos
+    // tengan el mismo tipo (LimbNode) que en el archivo del modelo
+    for (size_t iFrame = 0; iFrame < frames.size(); iFrame++)
+    {
+        for (const MeshData* mesh : frames[iFrame]->meshes)
+        {
+            if (!mesh || mesh->vertices.empty())
+                continue;
+
+            const bool skinned = mesh->hasSkinning && !mesh->bones.empty();
+
+            MeshEntry entry;
+            entry.mesh = mesh;
+            entry.node = (int)iFrame;
+            entry.modelId = 0;
+            entry.geometryId = 0;
+            entry.skinId = 0;
+            entry.poseId = 0;
+
+            if (skinned)
+            {
+                for (const BoneData& bone : mesh->bones)
+                {
+                    int boneNode = -1;
+                    auto it = m_NodeByName.find(bone.name);
+                    if (it != m_NodeByName.end())
+                    {
+                        boneNode = it->second;
+                    }
+                    else if (includeMeshes)
+                    {
+                        // Hueso sin frame: nodo dummy bajo la raíz (FBXExporter::CreateBone)
+                        NodeEntry dummy;
+                        dummy.name = bone.name;
+                        dummy.localMatrix = &bone.transformMatrix;
+                        dummy.parent = -1;
+                        dummy.isBone = true;
+
+                        boneNode = (int)m_Nodes.size();
+                        m_Nodes.push_back(dummy);
+                        m_NodeByName[bone.name] = boneNode;
+                    }
+
+                    if (boneNode >= 0)
+                        m_Nodes[boneNode].isBone = true;
+
+                    entry.boneNodes.push_back(boneNode);
+                }
+            }
+
+            if (includeMeshes)
+                m_Meshes.push_back(entry);
+        }
+    }
+
+    // ========================================================================
+    // Transformaciones locales (TRS) y globales en espacio FBX
+    // ========================================================================
+    const size_t nodeCount = m_Nodes.size();
+    const float scale = m_Options.scale;
+
+    vector<D3DXMATRIX> locals(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++)
+        locals[i] = *m_Nodes[i].localMatrix;
+
+    DecomposedTransforms trs;
+    MatrixConverter::DecomposeMatrices(locals.data(), nodeCount, trs);
+
+    vector<float> rotationX(nodeCount), rotationY(nodeCount), rotationZ(nodeCount);
+    MatrixConverter::ConvertQuaternionsToEuler_LH_to_RH(
+        trs.rotations.data(), nodeCount, rotationX.data(), rotationY.data(), rotationZ.data());
+
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        NodeEntry& node = m_Nodes[i];
+
+        node.translation[0] = trs.translations[i].x * scale;
+        node.translation[1] = trs.translations[i].y * scale;
+        node.translation[2] = -trs.translations[i].z * scale;
+        node.rotation[0] = rotationX[i];
+        node.rotation[1] = rotationY[i];
+        node.rotation[2] = rotationZ[i];
+        node.scaling[0] = trs.scales[i].x;
+        node.scaling[1] = trs.scales[i].y;
+        node.scaling[2] = trs.scales[i].z;
+
+        // Vectores fila: global = local * global del padre
+        // (los padres están antes que los hijos; los dummies no tienen padre)
+        D3DXMATRIX local = ConvertMatrix_LH_to_RH(locals[i], scale);
+        if (node.parent >= 0)
+            D3DXMatrixMultiply(&node.global, &local, &m_Nodes[node.parent].global);
+        else
+            node.global = local;
+    }
+
+    // ========================================================================
+    // Ids de los objetos de la escena
+    // ========================================================================
+    for (NodeEntry& node : m_Nodes)
+    {
+        node.modelId = nextId++;
+        node.attributeId = node.isBone ? nextId++ : 0;
+    }
+
+    const vector<MaterialData>& materials = sceneData.materials;
+    m_MaterialIds.assign(materials.size(), 0);
+    m_TextureIds.assign(materials.size(), 0);
+    m_TexturePaths.assign(materials.size(), string());
+
+    for (MeshEntry& entry : m_Meshes)
+    {
+        entry.modelId = nextId++;
+        entry.geometryId = nextId++;
+
+        if (!entry.boneNodes.empty())
+        {
+            entry.skinId = nextId++;
+            entry.poseId = nextId++;
+            for (size_t iBone = 0; iBone < entry.boneNodes.size(); iBone++)
+                entry.clusterIds.push_back(nextId++);
+        }
+
+        // Materiales compartidos: un objeto por material de la escena usado
+        for (DWORD materialIndex : entry.mesh->materials)
+        {
+            if (materialIndex >= materials.size() || m_MaterialIds[materialIndex] != 0)
+                continue;
+
+            m_MaterialIds[materialIndex] = nextId++;
+
+            const MaterialData& material = materials[materialIndex];
+            if (!material.textureFilename.empty())
+            {
+                m_TextureIds[materialIndex] = nextId++;
+                m_TexturePaths[materialIndex] = m_Options.exportTextures
+                    ? FBXExporter::CopyTexture(material.textureFilename, m_Options.outputFile)
+                    : material.textureFilename;
+            }
+        }
+    }
+
+    m_FirstAnimationId = nextId;
+
+    if (m_Options.verbose)
+    {
+        Utils::LogStream() << "Native FBX: " << m_Nodes.size() << " nodes, "
+                           << m_Meshes.size() << " meshes\n";
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Documento
+// ============================================================================
+
+void NativeFBXExporter::WriteDocument(FBXRecordWriter& writer, const AnimationClip* clip)
+{
+    m_Connections.clear();
+
+    vector<ClipTrack> tracks;
+    if (clip)
+        CollectClipTracks(*clip, tracks);
+
+    WriteHeaderExtension(writer);
+
+    writer.BeginNode("FileId");
+    writer.AddRaw(FBX_FILE_ID, sizeof(FBX_FILE_ID));
+    writer.EndNode();
+    WriteStringNode(writer, "CreationTime", FBX_CREATION_TIME);
+    WriteStringNode(writer, "Creator", FBX_CREATOR);
+
+    WriteGlobalSettings(writer, clip);
+    WriteDocuments(writer, clip);
+
+    writer.BeginNode("References");
+    writer.EndNode();
+
+    WriteDefinitions(writer, tracks, clip);
+    WriteObjects(writer, tracks, clip);
+    WriteConnections(writer);
+    WriteTakes(writer, clip);
+}
+
+void NativeFBXExporter::WriteHeaderExtension(FBXRecordWriter& writer)
+{
+    tm local = {};
+    if (m_Options.nativeFbxAscii)
+    {
+        // ASCII: la misma fecha fija que CreationTime, para que dos
+        // conversiones de la misma entrada no difieran en el encabezado
+        local.tm_year = 70;
+        local.tm_mday = 1;
+        local.tm_hour = 10;
+    }
+    else
+    {
+        time_t now = time(nullptr);
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+    }
+
+    writer.BeginNode("FBXHeaderExtension");
+    WriteInt32Node(writer, "FBXHeaderVersion", 1003);
+    WriteInt32Node(writer, "FBXVersion", m_Options.nativeFbxVersion >= 7500 ? 7500 : 7400);
+    WriteInt32Node(writer, "EncryptionType", 0);
+
+    writer.BeginNode("CreationTimeStamp");
+    WriteInt32Node(writer, "Version", 1000);
+    WriteInt32Node(writer, "Year", local.tm_year + 1900);
+    WriteInt32Node(writer, "Month", local.tm_mon + 1);
+    WriteInt32Node(writer, "Day", local.tm_mday);
+    WriteInt32Node(writer, "Hour", local.tm_hour);
+    WriteInt32Node(writer, "Minute", local.tm_min);
+    WriteInt32Node(writer, "Second", local.tm_sec);
+    WriteInt32Node(writer, "Millisecond", 0);
+    writer.EndNode();
+
+    WriteStringNode(writer, "Creator", FBX_CREATOR);
+
+    // Metadatos de la escena (los mismos que FBXExporter::SetupSceneProperties)
+    writer.BeginNode("SceneInfo");
+    writer.AddObjectName("GlobalInfo", "SceneInfo");
+    writer.AddString("UserData");
+    WriteStringNode(writer, "Type", "UserData");
+    WriteInt32Node(writer, "Version", 100);
+    writer.BeginNode("MetaData");
+    WriteInt32Node(writer, "Version", 100);
+    WriteStringNode(writer, "Title", "Converted from DirectX .X");
+    WriteStringNode(writer, "Subject", "DirectX to FBX Conversion");
+    WriteStringNode(writer, "Author", "XtoFBX Converter");
+    WriteStringNode(writer, "Keywords", "");
+    WriteStringNode(writer, "Revision", "");
+    WriteStringNode(writer, "Comment", "Automatically converted using custom converter");
+    writer.EndNode();
+    writer.EndNode();
+
+    writer.EndNode();
+}
+
+void NativeFBXExporter::WriteGlobalSettings(FBXRecordWriter& writer, const AnimationClip* clip)
+{
+    writer.BeginNode("GlobalSettings");
+    WriteInt32Node(writer, "Version", 1000);
+
+    // Right-Handed, Y-Up (FbxAxisSystem::MayaYUp); la escala global ya está
+    // aplicada a los datos
+    writer.BeginNode("Properties70");
+    WriteIntProperty(writer, "UpAxis", 1);
+    WriteIntProperty(writer, "UpAxisSign", 1);
+    WriteIntProperty(writer, "FrontAxis", 2);
+    WriteIntProperty(writer, "FrontAxisSign", 1);
+    WriteIntProperty(writer, "CoordAxis", 0);
+    WriteIntProperty(writer, "CoordAxisSign", 1);
+    WriteIntProperty(writer, "OriginalUpAxis", 1);
+    WriteIntProperty(writer, "OriginalUpAxisSign", 1);
+    WriteDoubleProperty(writer, "UnitScaleFactor", 1.0);
+    WriteDoubleProperty(writer, "OriginalUnitScaleFactor", 1.0);
+    WriteVector3Property(writer, "AmbientColor", "ColorRGB", "", 0.0, 0.0, 0.0);
+    WriteStringProperty(writer, "DefaultCamera", "Producer Perspective");
+    WriteEnumProperty(writer, "TimeMode", GetTimeMode(m_Options.targetFPS));
+    WriteEnumProperty(writer, "TimeProtocol", 2);
+    WriteEnumProperty(writer, "SnapOnFrameMode", 0);
+    WriteTimeProperty(writer, "TimeSpanStart", 0);
+    WriteTimeProperty(writer, "TimeSpanStop", clip ? SecondsToKTime(clip->duration) : 0);
+    WriteDoubleProperty(writer, "CustomFrameRate", -1.0);
+    WriteIntProperty(writer, "CurrentTimeMarker", -1);
+    writer.EndNode();
+
+    writer.EndNode();
+
+    if (m_Options.verbose)
+    {
+        Utils::LogStream() << "FBX Scene framerate set to: " << m_Options.targetFPS << " FPS\n";
+    }
+}
+
+void NativeFBXExporter::WriteDocuments(FBXRecordWriter& writer, const AnimationClip* clip)
+{
+    writer.BeginNode("Documents");
+    WriteInt32Node(writer, "Count", 1);
+
+    writer.BeginNode("Document");
+    writer.AddInt64(m_DocumentId);
+    writer.AddString("");
+    writer.AddString("Scene");
+
+    writer.BeginNode("Properties70");
+    BeginProperty(writer, "SourceObject", "object", "", "");
+    writer.EndNode();
+    WriteStringProperty(writer, "ActiveAnimStackName", clip ? clip->name : string());
+    writer.EndNode();
+
+    WriteInt64Node(writer, "RootNode", 0);
+    writer.EndNode();
+
+    writer.EndNode();
+}
+
+// ============================================================================
+// Definitions: número de objetos por tipo
+// ============================================================================
+
+void NativeFBXExporter::WriteDefinitions(FBXRecordWriter& writer, const vector<ClipTrack>& tracks, const AnimationClip* clip)
+{
+    int32_t attributeCount = 0;
+    for (const NodeEntry& node : m_Nodes)
+    {
+        if (node.attributeId != 0)
+            attributeCount++;
+    }
+
+    int32_t deformerCount = 0;
+    int32_t poseCount = 0;
+    for (const MeshEntry& entry : m_Meshes)
+    {
+        if (entry.skinId != 0)
+        {
+            deformerCount += 1 + (int32_t)entry.clusterIds.size();
+            poseCount++;
+        }
+    }
+
+    int32_t materialCount = 0;
+    int32_t textureCount = 0;
+    for (size_t i = 0; i < m_MaterialIds.size(); i++)
+    {
+        if (m_MaterialIds[i] != 0)
+            materialCount++;
+        if (m_TextureIds[i] != 0)
+            textureCount++;
+    }
+
+    int32_t curveNodeCount = 0;
+    for (const ClipTrack& track : tracks)
+    {
+        for (int channel = 0; channel < 3; channel++)
+        {
+            if (track.channels & (1 << channel))
+                curveNodeCount++;
+        }
+    }
+
+    struct ObjectType
+    {
+        const char* name;
+        int32_t count;
+    };
+
+    const ObjectType types[] =
+    {
+        { "GlobalSettings", 1 },
+        { "Model", (int32_t)(m_Nodes.size() + m_Meshes.size()) },
+        { "NodeAttribute", attributeCount },
+        { "Geometry", (int32_t)m_Meshes.size() },
+        { "Material", materialCount },
+        { "Texture", textureCount },
+        { "Deformer", deformerCount },
+        { "Pose", poseCount },
+        { "AnimationStack", clip ? 1 : 0 },
+        { "AnimationLayer", clip ? 1 : 0 },
+        { "AnimationCurveNode", curveNodeCount },
+        { "AnimationCurve", curveNodeCount * 3 },
+    };
+
+    int32_t total = 0;
+    for (const ObjectType& type : types)
+        total += type.count;
+
+    writer.BeginNode("Definitions");
+    WriteInt32Node(writer, "Version", 100);
+    WriteInt32Node(writer, "Count", total);
+
+    for (const ObjectType& type : types)
+    {
+        if (type.count == 0)
+            continue;
+
+        writer.BeginNode("ObjectType");
+        writer.AddString(type.name);
+        WriteInt32Node(writer, "Count", type.count);
+        writer.EndNode();
+    }
+
+    writer.EndNode();
+}
+
+// ============================================================================
+// Objects
+// ============================================================================
+
+void NativeFBXExporter::WriteObjects(FBXRecordWriter& writer, const vector<ClipTrack>& tracks, const AnimationClip* clip)
+{
+    // Curvas de los arrays de keys compartidos entre clips: se convierten
+    // antes de repartir el trabajo (la caché solo se lee desde los hilos)
+    for (const ClipTrack& clipTrack : tracks)
+    {
+        const AnimationTrack& track = *clipTrack.track;
+        if (track.shared && m_SharedCurveData.find(track.keyData) == m_SharedCurveData.end())
+            BuildCurveData(track, m_SharedCurveData[track.keyData]);
+    }
+
+    // Un trabajo por objeto (o grupo de objetos que se conectan entre sí),
+    // en el orden del archivo; el costo estimado reparte los rangos
+    vector<ObjectJob> jobs;
+
+    for (const NodeEntry& node : m_Nodes)
+    {
+        jobs.push_back({ 1, [this, &node](FBXRecordWriter& w, vector<Connection>& c, CurveData&)
+        {
+            WriteModel(w, c, node);
+        } });
+    }
+
+    for (const MeshEntry& entry : m_Meshes)
+    {
+        size_t cost = entry.mesh->vertices.size() + entry.mesh->indices.size();
+        jobs.push_back({ cost, [this, &entry](FBXRecordWriter& w, vector<Connection>& c, CurveData&)
+        {
+            WriteMeshModel(w, c, entry);
+            WriteGeometry(w, entry);
+
+            if (entry.skinId != 0)
+            {
+                WriteSkin(w, c, entry);
+                WriteBindPose(w, entry);
+            }
+        } });
+    }
+
+    for (size_t i = 0; i < m_MaterialIds.size(); i++)
+    {
+        if (m_MaterialIds[i] == 0)
+            continue;
+
+        jobs.push_back({ 1, [this, i](FBXRecordWriter& w, vector<Connection>& c, CurveData&)
+        {
+            WriteMaterial(w, c, i);
+        } });
+    }
+
+    if (clip)
+    {
+        jobs.push_back({ 1, [this, clip](FBXRecordWriter& w, vector<Connection>& c, CurveData&)
+        {
+            WriteAnimationStack(w, c, *clip);
+        } });
+
+        for (const ClipTrack& clipTrack : tracks)
+        {
+            size_t cost = clipTrack.track->GetKeys().size() * 3;
+            jobs.push_back({ cost, [this, &clipTrack](FBXRecordWriter& w, vector<Connection>& c, CurveData& curveData)
+            {
+                WriteTrackCurves(w, c, clipTrack, curveData);
+            } });
+        }
+    }
+
+    writer.BeginNode("Objects");
+    WriteObjectJobs(writer, jobs);
+    writer.EndNode();
+}
+
+// ============================================================================
+// Serialización paralela de objetos
+// ============================================================================
+// Los objetos son independientes hasta que se escriben: los trabajos se
+// dividen en rangos contiguos de costo parecido (más rangos que hilos para
+// equilibrar la carga) y cada rango se serializa en su propio fragmento del
+// writer, con sus conexiones en una lista propia. Los fragmentos y las
+// conexiones se agregan en el orden original, así que el archivo es el
+// mismo que con un solo hilo.
+// ============================================================================
+
+void NativeFBXExporter::WriteObjectJobs(FBXRecordWriter& writer, const vector<ObjectJob>& jobs)
+{
+    const size_t threadCount = (size_t)Utils::GetThreadCount(m_Options.numThreads);
+    const size_t rangeCount = min(jobs.size(), threadCount * 4);
+
+    unique_ptr<FBXRecordWriter> firstFragment;
+    if (threadCount > 1 && rangeCount > 1)
+        firstFragment = writer.CreateFragment();
+
+    // Un hilo, o un formato sin fragmentos: en orden sobre el writer
+    if (!firstFragment)
+    {
+        CurveData curveData;
+        for (const ObjectJob& job : jobs)
+            job.write(writer, m_Connections, curveData);
+        return;
+    }
+
+    // Límites de los rangos por costo acumulado
+    size_t totalCost = 0;
+    for (const ObjectJob& job : jobs)
+        totalCost += max(job.cost, (size_t)1);
+
+    vector<size_t> rangeStart(1, 0);
+    size_t accumulated = 0;
+    for (size_t i = 0; i < jobs.size() && rangeStart.size() < rangeCount; i++)
+    {
+        accumulated += max(jobs[i].cost, (size_t)1);
+        if (accumulated * rangeCount >= totalCost * rangeStart.size() && i + 1 < jobs.size())
+            rangeStart.push_back(i + 1);
+    }
+    rangeStart.push_back(jobs.size());
+
+    const size_t ranges = rangeStart.size() - 1;
+    vector<unique_ptr<FBXRecordWriter>> fragments(ranges);
+    vector<vector<Connection>> rangeConnections(ranges);
+
+    fragments[0] = std::move(firstFragment);
+    for (size_t range = 1; range < ranges; range++)
+        fragments[range] = writer.CreateFragment();
+
+    Utils::ParallelFor(ranges, (int)threadCount, [&](size_t range)
+    {
+        CurveData curveData;
+        for (size_t i = rangeStart[range]; i < rangeStart[range + 1]; i++)
+            jobs[i].write(*fragments[range], rangeConnections[range], curveData);
+    });
+
+    writer.AppendFragments(fragments);
+
+    for (const vector<Connection>& connections : rangeConnections)
+        m_Connections.insert(m_Connections.end(), connections.begin(), connections.end());
+
+    if (m_Options.verbose)
+    {
+        Utils::LogStream() << "  Serialized " << jobs.size() << " FBX objects in "
+                           << ranges << " ranges on " << min(threadCount, ranges) << " threads\n";
+    }
+}
+
+void NativeFBXExporter::WriteModel(FBXRecordWriter& writer, vector<Connection>& connections, const NodeEntry& node)
+{
+    if (node.attributeId != 0)
+    {
+        // Atributo skeleton (FbxSkeleton::eLimbNode)
+        writer.BeginNode("NodeAttribute");
+        writer.AddInt64(node.attributeId);
+        writer.AddObjectName(node.name, "NodeAttribute");
+        writer.AddString("LimbNode");
+        WriteStringNode(writer, "TypeFlags", "Skeleton");
+        writer.EndNode();
+
+        Connect(connections, node.attributeId, node.modelId);
+    }
+
+    writer.BeginNode("Model");
+    writer.AddInt64(node.modelId);
+    writer.AddObjectName(node.name, "Model");
+    writer.AddString(node.isBone ? "LimbNode" : "Null");
+    WriteInt32Node(writer, "Version", 232);
+
+    writer.BeginNode("Properties70");
+    WriteEnumProperty(writer, "InheritType", 1);
+    if (node.attributeId != 0)
+        WriteIntProperty(writer, "DefaultAttributeIndex", 0);
+    WriteVector3Property(writer, "Lcl Translation", "Lcl Translation", "A",
+                         node.translation[0], node.translation[1], node.translation[2]);
+    WriteVector3Property(writer, "Lcl Rotation", "Lcl Rotation", "A",
+                         node.rotation[0], node.rotation[1], node.rotation[2]);
+    WriteVector3Property(writer, "Lcl Scaling", "Lcl Scaling", "A",
+                         node.scaling[0], node.scaling[1], node.scaling[2]);
+    writer.EndNode();
+
+    writer.BeginNode("Shading");
+    writer.AddBool(true);
+    writer.EndNode();
+    WriteStringNode(writer, "Culling", "CullingOff");
+
+    writer.EndNode();
+
+    Connect(connections, node.modelId, node.parent >= 0 ? m_Nodes[node.parent].modelId : 0);
+}
+
+void NativeFBXExporter::WriteMeshModel(FBXRecordWriter& writer, vector<Connection>& connections, const MeshEntry& entry)
+{
+    writer.BeginNode("Model");
+    writer.AddInt64(entry.modelId);
+    writer.AddObjectName(entry.mesh->name + "_node", "Model");
+    writer.AddString("Mesh");
+    WriteInt32Node(writer, "Version", 232);
+
+    writer.BeginNode("Properties70");
+    WriteEnumProperty(writer, "InheritType", 1);
+    WriteIntProperty(writer, "DefaultAttributeIndex", 0);
+    writer.EndNode();
+
+    writer.BeginNode("Shading");
+    writer.AddBool(true);
+    writer.EndNode();
+    WriteStringNode(writer, "Culling", "CullingOff");
+
+    writer.EndNode();
+
+    Connect(connections, entry.modelId, m_Nodes[entry.node].modelId);
+    Connect(connections, entry.geometryId, entry.modelId);
+
+    // Materiales en el orden de los índices del mesh (índices del layer de materiales)
+    for (DWORD materialIndex : entry.mesh->materials)
+    {
+        if (materialIndex < m_MaterialIds.size() && m_MaterialIds[materialIndex] != 0)
+            Connect(connections, m_MaterialIds[materialIndex], entry.modelId);
+    }
+}
+
+// ============================================================================
+// Geometry
+// ============================================================================
+// Mismos datos que FBXExporter::ExportGeometry/ExportUVs/ExportNormals/
+// ExportVertexColors/ExportMaterials: posiciones, normales, UVs y colores por
+// vértice ("ByVertice"/"Direct") y material por triángulo.
+// ============================================================================
+
+// Layer element con el encabezado común
+static void BeginLayerElement(FBXRecordWriter& writer, const char* type, int32_t index, const string& name,
+                              const char* mapping, const char* reference)
+{
+    writer.BeginNode(type);
+    writer.AddInt32(index);
+    WriteInt32Node(writer, "Version", 101);
+    WriteStringNode(writer, "Name", name);
+    WriteStringNode(writer, "MappingInformationType", mapping);
+    WriteStringNode(writer, "ReferenceInformationType", reference);
+}
+
+static void WriteLayerReference(FBXRecordWriter& writer, const char* type, int32_t index)
+{
+    writer.BeginNode("LayerElement");
+    WriteStringNode(writer, "Type", type);
+    WriteInt32Node(writer, "TypedIndex", index);
+    writer.EndNode();
+}
+
+void NativeFBXExporter::WriteGeometry(FBXRecordWriter& writer, const MeshEntry& entry)
+{
+    const MeshData* mesh = entry.mesh;
+    const vector<Vertex>& vertices = mesh->vertices;
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = mesh->indices.size() / 3;
+    const float scale = m_Options.scale;
+
+    writer.BeginNode("Geometry");
+    writer.AddInt64(entry.geometryId);
+    writer.AddObjectName(mesh->name, "Geometry");
+    writer.AddString("Mesh");
+    WriteInt32Node(writer, "GeometryVersion", 124);
+
+    // Posiciones: LH -> RH (Z invertida) y escala global
+    vector<double> values(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const D3DXVECTOR3& position = vertices[i].position;
+        values[i * 3 + 0] = position.x * scale;
+        values[i * 3 + 1] = position.y * scale;
+        values[i * 3 + 2] = -position.z * scale;
+    }
+
+    writer.BeginNode("Vertices");
+    writer.AddDoubleArray(values.data(), values.size());
+    writer.EndNode();
+
+    // Triángulos: el último índice de cada polígono se escribe como ~índice
+    // (mismo winding que el original, ver FBXExporter::ExportGeometry)
+    vector<int32_t> polygonIndices(triangleCount * 3);
+    for (size_t i = 0; i < polygonIndices.size(); i++)
+    {
+        int32_t index = (int32_t)mesh->indices[i];
+        polygonIndices[i] = (i % 3 == 2) ? ~index : index;
+    }
+
+    writer.BeginNode("PolygonVertexIndex");
+    writer.AddInt32Array(polygonIndices.data(), polygonIndices.size());
+    writer.EndNode();
+
+    // Normales
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const D3DXVECTOR3& normal = vertices[i].normal;
+        values[i * 3 + 0] = normal.x;
+        values[i * 3 + 1] = normal.y;
+        values[i * 3 + 2] = -normal.z;
+    }
+
+    BeginLayerElement(writer, "LayerElementNormal", 0, "", "ByVertice", "Direct");
+    writer.BeginNode("Normals");
+    writer.AddDoubleArray(values.data(), values.size());
+    writer.EndNode();
+    writer.EndNode();
+
+    // UVs: el set 0 siempre, los adicionales solo si existen (V invertida)
+    const DWORD uvSetCount = max(mesh->texCoordSetCount, (DWORD)1);
+    values.resize(vertexCount * 4);
+
+    for (DWORD set = 0; set < uvSetCount; set++)
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const D3DXVECTOR2& uv = (set == 0) ? vertices[i].texCoord : vertices[i].extraTexCoords[set - 1];
+            values[i * 2 + 0] = uv.x;
+            values[i * 2 + 1] = 1.0 - uv.y;
+        }
+
+        string layerName = (set == 0) ? "DiffuseUV" : "UV" + to_string(set);
+        BeginLayerElement(writer, "LayerElementUV", (int32_t)set, layerName, "ByVertice", "Direct");
+        writer.BeginNode("UV");
+        writer.AddDoubleArray(values.data(), vertexCount * 2);
+        writer.EndNode();
+        writer.EndNode();
+    }
+
+    // Colores de vértice
+    if (mesh->hasVertexColors)
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const D3DXCOLOR& color = vertices[i].color;
+            values[i * 4 + 0] = color.r;
+            values[i * 4 + 1] = color.g;
+            values[i * 4 + 2] = color.b;
+            values[i * 4 + 3] = color.a;
+        }
+
+        BeginLayerElement(writer, "LayerElementColor", 0, "", "ByVertice", "Direct");
+        writer.BeginNode("Colors");
+        writer.AddDoubleArray(values.data(), vertexCount * 4);
+        writer.EndNode();
+        writer.EndNode();
+    }
+
+    // Materiales: por triángulo si hay attribute buffer, si no el primero para todo
+    bool hasMaterials = false;
+    for (DWORD materialIndex : mesh->materials)
+    {
+        if (materialIndex < m_MaterialIds.size())
+            hasMaterials = true;
+    }
+
+    if (hasMaterials)
+    {
+        const bool byPolygon = (mesh->materialIndices.size() == triangleCount);
+
+        BeginLayerElement(writer, "LayerElementMaterial", 0, "",
+                          byPolygon ? "ByPolygon" : "AllSame", "IndexToDirect");
+
+        vector<int32_t> materialIndices(byPolygon ? triangleCount : 1, 0);
+        if (byPolygon)
+        {
+            for (size_t i = 0; i < triangleCount; i++)
+                materialIndices[i] = (int32_t)mesh->materialIndices[i];
+        }
+
+        writer.BeginNode("Materials");
+        writer.AddInt32Array(materialIndices.data(), materialIndices.size());
+        writer.EndNode();
+        writer.EndNode();
+    }
+
+    // Layer 0 con todos los elementos; un layer por set de UV adicional
+    writer.BeginNode("Layer");
+    writer.AddInt32(0);
+    WriteInt32Node(writer, "Version", 100);
+    WriteLayerReference(writer, "LayerElementNormal", 0);
+    if (hasMaterials)
+        WriteLayerReference(writer, "LayerElementMaterial", 0);
+    if (mesh->hasVertexColors)
+        WriteLayerReference(writer, "LayerElementColor", 0);
+    WriteLayerReference(writer, "LayerElementUV", 0);
+    writer.EndNode();
+
+    for (DWORD set = 1; set < uvSetCount; set++)
+    {
+        writer.BeginNode("Layer");
+        writer.AddInt32((int32_t)set);
+        WriteInt32Node(writer, "Version", 100);
+        WriteLayerReference(writer, "LayerElementUV", (int32_t)set);
+        writer.EndNode();
+    }
+
+    writer.EndNode();
+}
+
+// ============================================================================
+// Materiales
+// ============================================================================
+
+void NativeFBXExporter::WriteMaterial(FBXRecordWriter& writer, vector<Connection>& connections, size_t materialIndex)
+{
+    const MaterialData& material = m_pSceneData->materials[materialIndex];
+    const INT64 materialId = m_MaterialIds[materialIndex];
+
+    writer.BeginNode("Material");
+    writer.AddInt64(materialId);
+    writer.AddObjectName(material.name, "Material");
+    writer.AddString("");
+    WriteInt32Node(writer, "Version", 102);
+    WriteStringNode(writer, "ShadingModel", "phong");
+    WriteInt32Node(writer, "MultiLayer", 0);
+
+    writer.BeginNode("Properties70");
+    WriteStringProperty(writer, "ShadingModel", "phong");
+    WriteColorProperty(writer, "EmissiveColor", material.material.Emissive);
+    WriteColorProperty(writer, "AmbientColor", material.material.Ambient);
+    WriteColorProperty(writer, "DiffuseColor", material.material.Diffuse);
+    WriteColorProperty(writer, "SpecularColor", material.material.Specular);
+    WriteNumberProperty(writer, "ShininessExponent", material.material.Power);
+    writer.EndNode();
+
+    writer.EndNode();
+
+    const INT64 textureId = m_TextureIds[materialIndex];
+    if (textureId == 0)
+        return;
+
+    // Textura difusa (FbxFileTexture "DiffuseTexture" conectada a DiffuseColor)
+    const string& texturePath = m_TexturePaths[materialIndex];
+
+    writer.BeginNode("Texture");
+    writer.AddInt64(textureId);
+    writer.AddObjectName("DiffuseTexture", "Texture");
+    writer.AddString("");
+    WriteStringNode(writer, "Type", "TextureVideoClip");
+    WriteInt32Node(writer, "Version", 202);
+    writer.BeginNode("TextureName");
+    writer.AddObjectName("DiffuseTexture", "Texture");
+    writer.EndNode();
+
+    writer.BeginNode("Properties70");
+    BeginProperty(writer, "UseMaterial", "bool", "", "");
+    writer.AddInt32(1);
+    writer.EndNode();
+    writer.EndNode();
+
+    WriteStringNode(writer, "FileName", texturePath);
+    WriteStringNode(writer, "RelativeFilename", texturePath);
+
+    writer.BeginNode("ModelUVTranslation");
+    writer.AddDouble(0.0);
+    writer.AddDouble(0.0);
+    writer.EndNode();
+    writer.BeginNode("ModelUVScaling");
+    writer.AddDouble(1.0);
+    writer.AddDouble(1.0);
+    writer.EndNode();
+    WriteStringNode(writer, "Texture_Alpha_Source", "None");
+
+    writer.EndNode();
+
+    Connect(connections, textureId, materialId, "DiffuseColor");
+}
+
+// ============================================================================
+// Skinning
+// ============================================================================
+// Mismo contenido que FBXExporter::ExportSkinWeights: influencias agrupadas
+// por hueso en una pasada por los vértices, Transform = matriz global del
+// mesh y TransformLink = matriz global del hueso en bind pose.
+// ============================================================================
+
+void NativeFBXExporter::WriteSkin(FBXRecordWriter& writer, vector<Connection>& connections, const MeshEntry& entry)
+{
+    const MeshData* mesh = entry.mesh;
+    const size_t boneCount = mesh->bones.size();
+    const size_t vertexCount = mesh->vertices.size();
+
+    vector<size_t> boneStart(boneCount + 1, 0);
+
+    for (const Vertex& vertex : mesh->vertices)
+    {
+        for (int iInfl = 0; iInfl < MAX_BONE_INFLUENCES; iInfl++)
+        {
+            if (vertex.boneWeights[iInfl] > 0.0f && vertex.boneIndices[iInfl] < boneCount)
+                boneStart[vertex.boneIndices[iInfl] + 1]++;
+        }
+    }
+
+    for (size_t iBone = 0; iBone < boneCount; iBone++)
+        boneStart[iBone + 1] += boneStart[iBone];
+
+    vector<int32_t> influenceVertices(boneStart[boneCount]);
+    vector<double> influenceWeights(boneStart[boneCount]);
+    vector<size_t> cursor(boneStart.begin(), boneStart.end() - 1);
+
+    for (size_t iVert = 0; iVert < vertexCount; iVert++)
+    {
+        const Vertex& vertex = mesh->vertices[iVert];
+
+        for (int iInfl = 0; iInfl < MAX_BONE_INFLUENCES; iInfl++)
+        {
+            DWORD bone = vertex.boneIndices[iInfl];
+            if (vertex.boneWeights[iInfl] <= 0.0f || bone >= boneCount)
+                continue;
+
+            size_t slot = cursor[bone]++;
+            influenceVertices[slot] = (int32_t)iVert;
+            influenceWeights[slot] = vertex.boneWeights[iInfl];
+        }
+    }
+
+    const D3DXMATRIX& meshMatrix = m_Nodes[entry.node].global;
+
+    writer.BeginNode("Deformer");
+    writer.AddInt64(entry.skinId);
+    writer.AddObjectName("", "Deformer");
+    writer.AddString("Skin");
+    WriteInt32Node(writer, "Version", 101);
+    writer.BeginNode("Link_DeformAcuracy");
+    writer.AddDouble(50.0);
+    writer.EndNode();
+    writer.EndNode();
+
+    Connect(connections, entry.skinId, entry.geometryId);
+
+    for (size_t iBone = 0; iBone < boneCount; iBone++)
+    {
+        const int boneNode = entry.boneNodes[iBone];
+        const INT64 clusterId = entry.clusterIds[iBone];
+        const size_t first = boneStart[iBone];
+        const size_t count = boneStart[iBone + 1] - first;
+
+        writer.BeginNode("Deformer");
+        writer.AddInt64(clusterId);
+        writer.AddObjectName("", "SubDeformer");
+        writer.AddString("Cluster");
+        WriteInt32Node(writer, "Version", 100);
+
+        writer.BeginNode("UserData");
+        writer.AddString("");
+        writer.AddString("");
+        writer.EndNode();
+
+        if (count > 0)
+        {
+            writer.BeginNode("Indexes");
+            writer.AddInt32Array(influenceVertices.data() + first, count);
+            writer.EndNode();
+
+            writer.BeginNode("Weights");
+            writer.AddDoubleArray(influenceWeights.data() + first, count);
+            writer.EndNode();
+        }
+
+        // El bind se hace con la pose actual del hueso (ver FBXExporter)
+        D3DXMATRIX boneMatrix;
+        if (boneNode >= 0)
+            boneMatrix = m_Nodes[boneNode].global;
+        else
+            D3DXMatrixIdentity(&boneMatrix);
+
+        WriteMatrixNode(writer, "Transform", meshMatrix);
+        WriteMatrixNode(writer, "TransformLink", boneMatrix);
+
+        writer.EndNode();
+
+        Connect(connections, clusterId, entry.skinId);
+        if (boneNode >= 0)
+            Connect(connections, m_Nodes[boneNode].modelId, clusterId);
+    }
+}
+
+void NativeFBXExporter::WriteBindPose(FBXRecordWriter& writer, const MeshEntry& entry)
+{
+    vector<int> boneNodes;
+    for (int boneNode : entry.boneNodes)
+    {
+        if (boneNode >= 0)
+            boneNodes.push_back(boneNode);
+    }
+
+    writer.BeginNode("Pose");
+    writer.AddInt64(entry.poseId);
+    writer.AddObjectName("BindPose", "Pose");
+    writer.AddString("BindPose");
+    WriteStringNode(writer, "Type", "BindPose");
+    WriteInt32Node(writer, "Version", 100);
+    WriteInt32Node(writer, "NbPoseNodes", (int32_t)(boneNodes.size() + 1));
+
+    // El mesh y cada hueso con su matriz global en bind pose
+    writer.BeginNode("PoseNode");
+    WriteInt64Node(writer, "Node", entry.modelId);
+    WriteMatrixNode(writer, "Matrix", m_Nodes[entry.node].global);
+    writer.EndNode();
+
+    for (int boneNode : boneNodes)
+    {
+        writer.BeginNode("PoseNode");
+        WriteInt64Node(writer, "Node", m_Nodes[boneNode].modelId);
+        WriteMatrixNode(writer, "Matrix", m_Nodes[boneNode].global);
+        writer.EndNode();
+    }
+
+    writer.EndNode();
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// AnimationStack (clip) -> AnimationLayer ("BaseLayer") -> un
+// AnimationCurveNode por canal animado (T, R, S) conectado a la propiedad
+// Lcl * del nodo -> tres AnimationCurve (d|X, d|Y, d|Z). Los canales sin
+// keys no tienen curve node: el valor Lcl * del nodo es la pose de reposo.
+// ============================================================================
+
+void NativeFBXExporter::CollectClipTracks(const AnimationClip& clip, vector<ClipTrack>& tracks) const
+{
+    // Ids: AnimationStack, AnimationLayer y, por track, cada curve node
+    // seguido de sus tres curvas (asignados antes de serializar en paralelo)
+    INT64 nextId = m_FirstAnimationId + 2;
+
+    for (const AnimationTrack& track : clip.tracks)
+    {
+        auto it = m_NodeByName.find(track.boneName);
+        if (it == m_NodeByName.end())
+            continue;
+
+        BYTE channels = 0;
+        for (const AnimationKey& key : track.GetKeys())
+            channels |= key.channels;
+
+        if (channels == 0)
+            continue;
+
+        ClipTrack clipTrack;
+        clipTrack.track = &track;
+        clipTrack.node = it->second;
+        clipTrack.channels = channels;
+        clipTrack.firstId = nextId;
+        tracks.push_back(clipTrack);
+
+        for (int channel = 0; channel < 3; channel++)
+        {
+            if (channels & (1 << channel))
+                nextId += 4;
+        }
+    }
+}
+
+void NativeFBXExporter::BuildCurveData(const AnimationTrack& track, CurveData& data) const
+{
+    for (int c = 0; c < 3; c++)
+    {
+        data.times[c].clear();
+        data.seconds[c].clear();
+    }
+    for (int c = 0; c < 9; c++)
+        data.values[c].clear();
+
+    const vector<AnimationKey>& keys = track.GetKeys();
+    const float scale = m_Options.scale;
+    vector<D3DXQUATERNION> rotations;
+
+    for (const AnimationKey& key : keys)
+    {
+        INT64 keyTime = SecondsToKTime(key.time);
+
+        if (key.channels & KEY_TRANSLATION)
+        {
+            data.times[0].push_back(keyTime);
+            data.seconds[0].push_back(key.time);
+            data.values[0].push_back(key.translation.x * scale);
+            data.values[1].push_back(key.translation.y * scale);
+            data.values[2].push_back(-key.translation.z * scale);
+        }
+
+        if (key.channels & KEY_ROTATION)
+        {
+            data.times[1].push_back(keyTime);
+            data.seconds[1].push_back(key.time);
+            rotations.push_back(key.rotation);
+        }
+
+        if (key.channels & KEY_SCALE)
+        {
+            data.times[2].push_back(keyTime);
+            data.seconds[2].push_back(key.time);
+            data.values[6].push_back(key.scale.x);
+            data.values[7].push_back(key.scale.y);
+            data.values[8].push_back(key.scale.z);
+        }
+    }
+
+    size_t rotationCount = rotations.size();
+    for (int c = 3; c < 6; c++)
+        data.values[c].resize(rotationCount);
+
+    MatrixConverter::ConvertQuaternionsToEuler_LH_to_RH(
+        rotations.data(), rotationCount,
+        data.values[3].data(), data.values[4].data(), data.values[5].data());
+
+    MatrixConverter::FilterEulerContinuity(
+        data.values[3].data(), data.values[4].data(), data.values[5].data(), rotationCount);
+}
+
+void NativeFBXExporter::WriteAnimationStack(FBXRecordWriter& writer, vector<Connection>& connections, const AnimationClip& clip)
+{
+    const INT64 stackId = m_FirstAnimationId;
+    const INT64 layerId = m_FirstAnimationId + 1;
+    const INT64 stopTime = SecondsToKTime(clip.duration);
+
+    writer.BeginNode("AnimationStack");
+    writer.AddInt64(stackId);
+    writer.AddObjectName(clip.name, "AnimStack");
+    writer.AddString("");
+    writer.BeginNode("Properties70");
+    WriteTimeProperty(writer, "LocalStart", 0);
+    WriteTimeProperty(writer, "LocalStop", stopTime);
+    WriteTimeProperty(writer, "ReferenceStart", 0);
+    WriteTimeProperty(writer, "ReferenceStop", stopTime);
+    writer.EndNode();
+    writer.EndNode();
+
+    writer.BeginNode("AnimationLayer");
+    writer.AddInt64(layerId);
+    writer.AddObjectName("BaseLayer", "AnimLayer");
+    writer.AddString("");
+    writer.EndNode();
+
+    Connect(connections, layerId, stackId);
+}
+
+void NativeFBXExporter::WriteTrackCurves(
+    FBXRecordWriter& writer,
+    vector<Connection>& connections,
+    const ClipTrack& clipTrack,
+    CurveData& curveData)
+{
+    static const char* channelProperties[3] = { "Lcl Translation", "Lcl Rotation", "Lcl Scaling" };
+    static const char* channelNames[3] = { "T", "R", "S" };
+    static const char* componentNames[3] = { "d|X", "d|Y", "d|Z" };
+
+    const float tolerances[3] =
+    {
+        m_Options.keyPositionTolerance,
+        m_Options.keyRotationTolerance,
+        m_Options.keyScaleTolerance
+    };
+
+    const AnimationTrack& track = *clipTrack.track;
+    const NodeEntry& node = m_Nodes[clipTrack.node];
+    const INT64 layerId = m_FirstAnimationId + 1;
+
+    // Conversión una sola vez por exportación si el array de keys está
+    // compartido (ver AnimationOptimizer::ShareDuplicateTracks); la caché
+    // ya se llenó en WriteObjects()
+    const CurveData* trackData = &curveData;
+    auto cached = track.shared ? m_SharedCurveData.find(track.keyData) : m_SharedCurveData.end();
+    if (cached != m_SharedCurveData.end())
+    {
+        trackData = &cached->second;
+    }
+    else
+    {
+        BuildCurveData(track, curveData);
+    }
+
+    const double* restValues[3] = { node.translation, node.rotation, node.scaling };
+    INT64 nextId = clipTrack.firstId;
+
+    for (int channel = 0; channel < 3; channel++)
+    {
+        if (!(clipTrack.channels & (1 << channel)))
+            continue;
+
+        const INT64 curveNodeId = nextId++;
+
+        writer.BeginNode("AnimationCurveNode");
+        writer.AddInt64(curveNodeId);
+        writer.AddObjectName(channelNames[channel], "AnimCurveNode");
+        writer.AddString("");
+        writer.BeginNode("Properties70");
+        for (int component = 0; component < 3; component++)
+        {
+            BeginProperty(writer, componentNames[component], "Number", "", "A");
+            writer.AddDouble(restValues[channel][component]);
+            writer.EndNode();
+        }
+        writer.EndNode();
+        writer.EndNode();
+
+        Connect(connections, curveNodeId, layerId);
+        Connect(connections, curveNodeId, node.modelId, channelProperties[channel]);
+
+        for (int component = 0; component < 3; component++)
+        {
+            const INT64 curveId = nextId++;
+
+            WriteCurve(
+                writer,
+                curveId,
+                trackData->times[channel],
+                trackData->seconds[channel],
+                trackData->values[channel * 3 + component],
+                tolerances[channel]);
+
+            Connect(connections, curveId, curveNodeId, componentNames[component]);
+        }
+    }
+}
+
+// ============================================================================
+// AnimationCurve
+// ============================================================================
+// Lineal: una key por muestra, todas con el mismo atributo (flags
+// eInterpolationLinear), así que KeyAttrRefCount es un solo valor.
+// Cúbica (fitCurves): keys de CurveFitter::FitHermite con tangentes de
+// usuario; cada key guarda su pendiente derecha y la izquierda de la
+// siguiente, igual que FbxAnimCurve::KeySet(..., eTangentUser, ...).
+// ============================================================================
+
+void NativeFBXExporter::WriteCurve(
+    FBXRecordWriter& writer,
+    INT64 curveId,
+    const vector<int64_t>& times,
+    const vector<double>& seconds,
+    const vector<float>& values,
+    float tolerance)
+{
+    vector<int64_t> keyTimes;
+    vector<float> keyValues;
+    vector<int32_t> keyFlags;
+    vector<float> keyData;
+    vector<int32_t> keyRefCounts;
+
+    if (m_Options.fitCurves && !values.empty())
+    {
+        vector<HermiteKey> fitted;
+        CurveFitter::FitHermite(seconds, values, tolerance, fitted);
+
+        keyTimes.reserve(fitted.size());
+        keyValues.reserve(fitted.size());
+        keyData.reserve(fitted.size() * 4);
+
+        for (size_t k = 0; k < fitted.size(); k++)
+        {
+            float nextSlope = (k + 1 < fitted.size()) ? fitted[k + 1].slope : fitted[k].slope;
+
+            keyTimes.push_back(SecondsToKTime(fitted[k].time));
+            keyValues.push_back(fitted[k].value);
+
+            keyData.push_back(fitted[k].slope);     // RightSlope
+            keyData.push_back(nextSlope);           // NextLeftSlope
+            keyData.push_back(FBX_KEY_DEFAULT_WEIGHTS);
+            keyData.push_back(0.0f);                // Velocidades
+        }
+
+        keyFlags.assign(fitted.size(), FBX_KEY_CUBIC_USER);
+        keyRefCounts.assign(fitted.size(), 1);
+    }
+    else
+    {
+        keyTimes = times;
+        keyValues = values;
+
+        if (!values.empty())
+        {
+            keyFlags.push_back(FBX_KEY_LINEAR);
+            keyData.push_back(0.0f);
+            keyData.push_back(0.0f);
+            keyData.push_back(FBX_KEY_DEFAULT_WEIGHTS);
+            keyData.push_back(0.0f);
+            keyRefCounts.push_back((int32_t)values.size());
+        }
+    }
+
+    writer.BeginNode("AnimationCurve");
+    writer.AddInt64(curveId);
+    writer.AddObjectName("", "AnimCurve");
+    writer.AddString("");
+
+    writer.BeginNode("Default");
+    writer.AddDouble(values.empty() ? 0.0 : values[0]);
+    writer.EndNode();
+    WriteInt32Node(writer, "KeyVer", 4008);
+
+    writer.BeginNode("KeyTime");
+    writer.AddInt64Array(keyTimes.data(), keyTimes.size());
+    writer.EndNode();
+    writer.BeginNode("KeyValueFloat");
+    writer.AddFloatArray(keyValues.data(), keyValues.size());
+    writer.EndNode();
+    writer.BeginNode("KeyAttrFlags");
+    writer.AddInt32Array(keyFlags.data(), keyFlags.size());
+    writer.EndNode();
+    writer.BeginNode("KeyAttrDataFloat");
+    writer.AddFloatArray(keyData.data(), keyData.size());
+    writer.EndNode();
+    writer.BeginNode("KeyAttrRefCount");
+    writer.AddInt32Array(keyRefCounts.data(), keyRefCounts.size());
+    writer.EndNode();
+
+    writer.EndNode();
+}
+
+// ============================================================================
+// Connections y Takes
+// ============================================================================
+
+void NativeFBXExporter::WriteConnections(FBXRecordWriter& writer)
+{
+    writer.BeginNode("Connections");
+
+    for (const Connection& connection : m_Connections)
+    {
+        writer.BeginNode("C");
+        writer.AddString(connection.property ? "OP" : "OO");
+        writer.AddInt64(connection.child);
+        writer.AddInt64(connection.parent);
+        if (connection.property)
+            writer.AddString(connection.property);
+        writer.EndNode();
+    }
+
+    writer.EndNode();
+}
+
+void NativeFBXExporter::WriteTakes(FBXRecordWriter& writer, const AnimationClip* clip)
+{
+    writer.BeginNode("Takes");
+    WriteStringNode(writer, "Current", clip ? clip->name : string());
+
+    if (clip)
+    {
+        const INT64 stopTime = SecondsToKTime(clip->duration);
+
+        writer.BeginNode("Take");
+        writer.AddString(clip->name);
+        WriteStringNode(writer, "FileName", clip->name + ".tak");
+        writer.BeginNode("LocalTime");
+        writer.AddInt64(0);
+        writer.AddInt64(stopTime);
+        writer.EndNode();
+        writer.BeginNode("ReferenceTime");
+        writer.AddInt64(0);
+        writer.AddInt64(stopTime);
+        writer.EndNode();
+        writer.EndNode();
+    }
+
+    writer.EndNode();
+}
+
+void NativeFBXExporter::Connect(vector<Connection>& connections, INT64 child, INT64 parent, const char* property)
+{
+    Connection connection;
+    connection.child = child;
+    connection.parent = parent;
+    connection.property = property;
+    connections.push_back(connection);
+}
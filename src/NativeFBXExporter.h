@@ -0,0 +1,249 @@
+#pragma once
+
+#ifndef NATIVE_FBX_EXPORTER_H
+#define NATIVE_FBX_EXPORTER_H
+
+#include "../include/Common.h"
+#include "FBXRecordWriter.h"
+
+/**
+ * @class NativeFBXExporter
+ * @brief Exporta SceneData a FBX sin el FBX SDK
+ *
+ * Recorre la escena y emite los nodos del archivo directamente en un
+ * FBXRecordWriter (FBXBinaryWriter para FBX 7.4/7.5 binario, FBXAsciiWriter
+ * para ASCII):
+ *   FBXHeaderExtension, GlobalSettings, Documents, Definitions,
+ *   Objects (Model, NodeAttribute, Geometry, Material, Texture,
+ *   Deformer Skin/Cluster, Pose, AnimationStack/Layer/CurveNode/Curve),
+ *   Connections y Takes.
+ *
+ * No se construye un grafo de escena intermedio: solo tablas con los ids
+ * de los objetos y las matrices de la pose de enlace de cada nodo. El
+ * contenido es el mismo que escribe FBXExporter (nodo "<mesh>_node" por
+ * mesh, un cluster por hueso, un bind pose por mesh con skinning, curvas
+ * lineales o cúbicas ajustadas) en espacio Right-Handed, Y-Up.
+ *
+ * Misma interfaz que FBXExporter para usarlo desde main sin cambios.
+ */
+class NativeFBXExporter
+{
+public:
+    NativeFBXExporter();
+
+    /**
+     * Exportar escena completa a archivo FBX
+     * @param sceneData Datos de la escena a exportar
+     * @param filename Archivo FBX de salida
+     * @param options Opciones de conversión
+     * @return true si se exportó exitosamente
+     */
+    bool ExportScene(
+        const SceneData& sceneData,
+        const string& filename,
+        const ConversionOptions& options);
+
+    /**
+     * Exportar la escena con un único clip de animación
+     * @param sceneData Datos de la escena (sin animaciones)
+     * @param animation Clip de animación a exportar
+     * @param filename Archivo FBX de salida
+     * @param options Opciones de conversión
+     * @return true si se exportó exitosamente
+     */
+    bool ExportSingleAnimation(
+        const SceneData& sceneData,
+        const AnimationClip& animation,
+        const string& filename,
+        const ConversionOptions& options);
+
+    /**
+     * Preparar la exportación de animaciones en modo "solo skeleton"
+     * Las tablas de nodos se construyen una vez y se reutilizan por clip.
+     * @param sceneData Datos de la escena (solo se usa la jerarquía)
+     * @param options Opciones de conversión
+     * @return true si la escena tiene jerarquía
+     */
+    bool BeginAnimationExport(
+        const SceneData& sceneData,
+        const ConversionOptions& options);
+
+    /**
+     * Exportar un clip sobre el skeleton preparado por BeginAnimationExport()
+     * @param animation Clip de animación a exportar
+     * @param filename Archivo FBX de salida
+     * @return true si se exportó exitosamente
+     */
+    bool ExportAnimationOnly(
+        const AnimationClip& animation,
+        const string& filename);
+
+    /**
+     * Escribir la escena preparada y un clip opcional en un writer
+     * @param writer Destino de los nodos (binario o ASCII)
+     * @param clip Clip de animación (nullptr = sin animación)
+     */
+    void WriteDocument(FBXRecordWriter& writer, const AnimationClip* clip);
+
+    /**
+     * Obtener último mensaje de error
+     * @return Mensaje de error
+     */
+    string GetLastError() const { return m_LastError; }
+
+private:
+    // Nodo (Model) de la jerarquía: un frame o un hueso sin frame
+    struct NodeEntry
+    {
+        string name;
+        const D3DXMATRIX* localMatrix;  // Matriz local DirectX
+        int parent;                     // -1 = hijo de la raíz de la escena
+        bool isBone;                    // LimbNode (lo usa algún skin)
+        INT64 modelId;
+        INT64 attributeId;              // NodeAttribute (0 = sin atributo)
+        double translation[3];          // Lcl Translation/Rotation/Scaling (FBX)
+        double rotation[3];
+        double scaling[3];
+        D3DXMATRIX global;              // Matriz global en espacio FBX
+    };
+
+    // Mesh con su nodo, geometría y deformadores
+    struct MeshEntry
+    {
+        const MeshData* mesh;
+        int node;                       // Nodo del frame que lo contiene
+        INT64 modelId;
+        INT64 geometryId;
+        INT64 skinId;                   // 0 = sin skinning
+        INT64 poseId;
+        vector<int> boneNodes;          // Nodo de cada hueso de mesh->bones
+        vector<INT64> clusterIds;
+    };
+
+    // Track de un clip sobre un nodo de la jerarquía
+    struct ClipTrack
+    {
+        const AnimationTrack* track;
+        int node;
+        BYTE channels;                  // KEY_TRANSLATION | KEY_ROTATION | KEY_SCALE
+        INT64 firstId;                  // Id del primer curve node (seguido de sus curvas)
+    };
+
+    // Keys de un track por canal (T, R, S) en espacio FBX
+    struct CurveData
+    {
+        vector<int64_t> times[3];       // Tiempos FBX (KTime)
+        vector<double> seconds[3];
+        vector<float> values[9];        // TX, TY, TZ, RX, RY, RZ, SX, SY, SZ
+    };
+
+    struct Connection
+    {
+        INT64 child;
+        INT64 parent;
+        const char* property;           // nullptr = objeto-objeto (OO)
+    };
+
+    // Objeto (o grupo de objetos conectados) de Objects que se serializa
+    // de forma independiente
+    struct ObjectJob
+    {
+        size_t cost;                    // Costo estimado (para repartir los rangos)
+        function<void(FBXRecordWriter&, vector<Connection>&, CurveData&)> write;
+    };
+
+    ConversionOptions m_Options;
+    const SceneData* m_pSceneData;
+    bool m_IncludeMeshes;
+
+    vector<NodeEntry> m_Nodes;          // Orden DFS (padres antes que hijos)
+    map<string, int> m_NodeByName;
+    vector<MeshEntry> m_Meshes;
+    vector<INT64> m_MaterialIds;        // Por material de la escena (0 = sin uso)
+    vector<INT64> m_TextureIds;
+    vector<string> m_TexturePaths;
+    INT64 m_DocumentId;
+    INT64 m_FirstAnimationId;           // Primer id libre para los objetos del clip
+
+    // Conexiones del archivo en curso
+    vector<Connection> m_Connections;
+
+    // Curvas de los tracks compartidos (AnimationTrack::shared) de la
+    // exportación en curso; se vacía en Prepare()
+    map<shared_ptr<const vector<AnimationKey>>, CurveData> m_SharedCurveData;
+
+    string m_LastError;
+
+    /**
+     * Construir las tablas de nodos, meshes y materiales y asignar ids
+     * @param sceneData Escena a exportar
+     * @param includeMeshes false en modo solo skeleton
+     * @return false si la escena no tiene frame raíz
+     */
+    bool Prepare(const SceneData& sceneData, bool includeMeshes);
+
+    /**
+     * Escribir el archivo (binario o ASCII según las opciones) con la escena preparada
+     * @param filename Archivo de salida
+     * @param clip Clip de animación (nullptr = sin animación)
+     */
+    bool WriteFile(const string& filename, const AnimationClip* clip);
+
+    /**
+     * Abrir el writer (FBXBinaryWriter o FBXAsciiWriter), escribir el documento y cerrarlo
+     */
+    template<class Writer>
+    bool WriteFileWith(Writer& writer, const string& filename, const AnimationClip* clip);
+
+    // Secciones del documento
+    void WriteHeaderExtension(FBXRecordWriter& writer);
+    void WriteGlobalSettings(FBXRecordWriter& writer, const AnimationClip* clip);
+    void WriteDocuments(FBXRecordWriter& writer, const AnimationClip* clip);
+    void WriteDefinitions(FBXRecordWriter& writer, const vector<ClipTrack>& tracks, const AnimationClip* clip);
+    void WriteObjects(FBXRecordWriter& writer, const vector<ClipTrack>& tracks, const AnimationClip* clip);
+    void WriteConnections(FBXRecordWriter& writer);
+    void WriteTakes(FBXRecordWriter& writer, const AnimationClip* clip);
+
+    /**
+     * Serializar los objetos en orden, en paralelo si el writer admite fragmentos
+     * @param writer Writer con el nodo Objects abierto
+     * @param jobs Objetos en el orden del archivo
+     */
+    void WriteObjectJobs(FBXRecordWriter& writer, const vector<ObjectJob>& jobs);
+
+    // Objetos (pueden llamarse desde varios hilos: solo leen las tablas)
+    void WriteModel(FBXRecordWriter& writer, vector<Connection>& connections, const NodeEntry& node);
+    void WriteMeshModel(FBXRecordWriter& writer, vector<Connection>& connections, const MeshEntry& entry);
+    void WriteGeometry(FBXRecordWriter& writer, const MeshEntry& entry);
+    void WriteMaterial(FBXRecordWriter& writer, vector<Connection>& connections, size_t materialIndex);
+    void WriteSkin(FBXRecordWriter& writer, vector<Connection>& connections, const MeshEntry& entry);
+    void WriteBindPose(FBXRecordWriter& writer, const MeshEntry& entry);
+    void WriteAnimationStack(FBXRecordWriter& writer, vector<Connection>& connections, const AnimationClip& clip);
+    void WriteTrackCurves(FBXRecordWriter& writer, vector<Connection>& connections, const ClipTrack& clipTrack, CurveData& curveData);
+
+    /**
+     * Escribir una AnimationCurve (lineal, o cúbica ajustada con fitCurves)
+     */
+    void WriteCurve(
+        FBXRecordWriter& writer,
+        INT64 curveId,
+        const vector<int64_t>& times,
+        const vector<double>& seconds,
+        const vector<float>& values,
+        float tolerance);
+
+    /**
+     * Tracks del clip con nodo en la jerarquía y al menos un canal animado,
+     * con los ids de sus curve nodes y curvas
+     */
+    void CollectClipTracks(const AnimationClip& clip, vector<ClipTrack>& tracks) const;
+
+    /**
+     * Separar las keys de un track por canal, convertidas al espacio FBX
+     */
+    void BuildCurveData(const AnimationTrack& track, CurveData& data) const;
+
+    static void Connect(vector<Connection>& connections, INT64 child, INT64 parent, const char* property = nullptr);
+};
+
+#endif // NATIVE_FBX_EXPORTER_H
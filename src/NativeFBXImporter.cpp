@@ -0,0 +1,1024 @@
+#include "NativeFBXImporter.h"
+#include "AnimationResampler.h"
+#include "MatrixConverter.h"
+#include "CurveFitter.h"
+#include <cmath>
+
+// ============================================================================
+// Constantes del formato
+// ============================================================================
+
+// Unidades de FbxTime por segundo (KTime)
+static const double FBX_KTIME_PER_SECOND = 46186158000.0;
+
+// Interpolación de las keys (FbxAnimCurveDef::EInterpolationType)
+static const int32_t FBX_INTERPOLATION_CONSTANT = 0x00000002;
+static const int32_t FBX_INTERPOLATION_LINEAR = 0x00000004;
+static const int32_t FBX_INTERPOLATION_CUBIC = 0x00000008;
+
+// ============================================================================
+// Helpers de lectura
+// ============================================================================
+
+static INT64 GetObjectId(const FBXNode& object)
+{
+    return object.properties.empty() ? 0 : object.properties[0].AsInt();
+}
+
+static string GetObjectName(const FBXNode& object)
+{
+    string name, className;
+    const FBXProperty* property = object.Property(1);
+    if (property && property->IsString())
+        FBXReader::SplitObjectName(property->stringValue, name, className);
+    return name;
+}
+
+// Subtipo del objeto ("Mesh", "LimbNode", "Skin", "Cluster"...)
+static string GetObjectType(const FBXNode& object)
+{
+    const FBXProperty* property = object.Property(2);
+    return (property && property->IsString()) ? property->stringValue : string();
+}
+
+// Valor string de un nodo hijo ("MappingInformationType", "FileName"...)
+static string ReadStringNode(const FBXNode& parent, const char* name)
+{
+    const FBXNode* node = parent.Find(name);
+    if (!node || node->properties.empty())
+        return string();
+    return node->properties[0].stringValue;
+}
+
+// Array de un nodo hijo ("Vertices", "Normals"...)
+template<class T>
+static bool ReadArrayNode(const FBXNode& parent, const char* name, vector<T>& out)
+{
+    const FBXNode* node = parent.Find(name);
+    if (!node || node->properties.empty())
+    {
+        out.clear();
+        return false;
+    }
+
+    node->properties[0].GetArray(out);
+    return true;
+}
+
+// Valores de una propiedad de Properties70 (se dejan los valores por
+// defecto si no existe): P: "nombre", "tipo", "etiqueta", "flags", valores...
+static void ReadPropertyValues(const FBXNode& object, const char* name, double* values, int count)
+{
+    const FBXNode* properties = object.Find("Properties70");
+    if (!properties)
+        return;
+
+    for (const FBXNode& property : properties->children)
+    {
+        if (property.properties.empty() || property.properties[0].stringValue != name)
+            continue;
+
+        for (int i = 0; i < count && 4 + (size_t)i < property.properties.size(); i++)
+            values[i] = property.properties[4 + i].AsDouble();
+        return;
+    }
+}
+
+static void ReadColorProperty(const FBXNode& object, const char* name, D3DCOLORVALUE& color)
+{
+    double values[3] = { color.r, color.g, color.b };
+    ReadPropertyValues(object, name, values, 3);
+    color.r = (float)values[0];
+    color.g = (float)values[1];
+    color.b = (float)values[2];
+}
+
+// Matriz FBX (RH) a DirectX (LH): inversa de la conversión del exportador
+// (S * M * S con S = diag(1, 1, -1, 1) y escala global en la traslación)
+static D3DXMATRIX ConvertMatrix_RH_to_LH(const vector<double>& values, float scale)
+{
+    D3DXMATRIX result;
+    for (int i = 0; i < 16; i++)
+        result.m[i / 4][i % 4] = (float)values[i];
+
+    result.m[0][2] = -result.m[0][2];
+    result.m[1][2] = -result.m[1][2];
+    result.m[2][0] = -result.m[2][0];
+    result.m[2][1] = -result.m[2][1];
+    result.m[2][3] = -result.m[2][3];
+    result.m[3][2] = -result.m[3][2];
+
+    result.m[3][0] /= scale;
+    result.m[3][1] /= scale;
+    result.m[3][2] /= scale;
+    return result;
+}
+
+// Matriz local DirectX desde Lcl Translation/Rotation/Scaling (FBX)
+static D3DXMATRIX ComposeLocalMatrix(const double translation[3], const double rotation[3], const double scaling[3], float scale)
+{
+    float rx = (float)rotation[0], ry = (float)rotation[1], rz = (float)rotation[2];
+    D3DXQUATERNION q;
+    MatrixConverter::ConvertEulerToQuaternions_RH_to_LH(&rx, &ry, &rz, 1, &q);
+
+    D3DXMATRIX S, R, T;
+    D3DXMatrixScaling(&S, (float)scaling[0], (float)scaling[1], (float)scaling[2]);
+    D3DXMatrixRotationQuaternion(&R, &q);
+    D3DXMatrixTranslation(&T,
+        (float)(translation[0] / scale),
+        (float)(translation[1] / scale),
+        (float)(-translation[2] / scale));
+
+    return S * R * T;
+}
+
+static void UpdateCombinedMatrices(FrameData* frame, const D3DXMATRIX& parentMatrix)
+{
+    frame->combinedMatrix = frame->transformMatrix * parentMatrix;
+    for (FrameData* child : frame->children)
+        UpdateCombinedMatrices(child, frame->combinedMatrix);
+}
+
+// Valores de un layer element proyectados a los vértices (control points).
+// 'out' empieza con 'defaults' en cada vértice; con ByPolygonVertex el
+// último valor de cada vértice es el que queda
+static bool ReadLayerElement(
+    const FBXNode& element,
+    const char* dataName,
+    const char* indexName,
+    size_t components,
+    const double* defaults,
+    const vector<int32_t>& polygonVertices,
+    size_t vertexCount,
+    vector<double>& out)
+{
+    out.resize(vertexCount * components);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        for (size_t c = 0; c < components; c++)
+            out[i * components + c] = defaults[c];
+    }
+
+    vector<double> data;
+    if (!ReadArrayNode(element, dataName, data))
+        return false;
+
+    const string mapping = ReadStringNode(element, "MappingInformationType");
+    const string reference = ReadStringNode(element, "ReferenceInformationType");
+
+    vector<int32_t> indices;
+    const bool indexed = (reference == "IndexToDirect" || reference == "Index");
+    if (indexed)
+        ReadArrayNode(element, indexName, indices);
+
+    const bool byPolygonVertex = (mapping == "ByPolygonVertex");
+    const bool allSame = (mapping == "AllSame");
+    if (!byPolygonVertex && !allSame && mapping != "ByVertice" && mapping != "ByVertex" && mapping != "ByControlPoint")
+        return false;
+
+    const size_t elementCount = byPolygonVertex ? polygonVertices.size() : vertexCount;
+
+    for (size_t j = 0; j < elementCount; j++)
+    {
+        size_t valueIndex = allSame ? 0 : j;
+        if (indexed)
+        {
+            if (valueIndex >= indices.size() || indices[valueIndex] < 0)
+                continue;
+            valueIndex = (size_t)indices[valueIndex];
+        }
+
+        if ((valueIndex + 1) * components > data.size())
+            continue;
+
+        size_t vertex = byPolygonVertex ? (size_t)polygonVertices[j] : j;
+        for (size_t c = 0; c < components; c++)
+            out[vertex * components + c] = data[valueIndex * components + c];
+    }
+
+    return true;
+}
+
+// Agregar una influencia a un vértice (si no hay lugar, reemplaza la menor)
+static void AddInfluence(Vertex& vertex, DWORD bone, float weight)
+{
+    int slot = 0;
+    for (int i = 1; i < MAX_BONE_INFLUENCES; i++)
+    {
+        if (vertex.boneWeights[i] < vertex.boneWeights[slot])
+            slot = i;
+    }
+
+    if (vertex.boneWeights[slot] < weight)
+    {
+        vertex.boneIndices[slot] = bone;
+        vertex.boneWeights[slot] = weight;
+    }
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+NativeFBXImporter::NativeFBXImporter()
+{
+}
+
+// ============================================================================
+// Carga Principal
+// ============================================================================
+
+bool NativeFBXImporter::LoadScene(
+    const string& filename,
+    const ConversionOptions& options,
+    SceneData& sceneData)
+{
+    m_Options = options;
+    m_Objects.clear();
+    m_Children.clear();
+    m_Parents.clear();
+    m_Frames.clear();
+    m_MaterialIndices.clear();
+    m_LastError.clear();
+
+    if (m_Options.scale == 0.0f)
+        m_Options.scale = 1.0f;
+
+    Utils::Log("Loading FBX file: " + filename, options.verbose);
+
+    FBXReader reader;
+    if (!reader.Load(filename, m_Document))
+    {
+        m_LastError = reader.GetLastError();
+        return false;
+    }
+
+    if (!m_Document.Find("Objects"))
+    {
+        m_LastError = "No Objects section in FBX file: " + filename;
+        return false;
+    }
+
+    ReadObjects();
+    ReadMaterials(sceneData);
+
+    bool result = ReadModels(sceneData);
+    if (result)
+    {
+        ReadMeshes();
+        ReadAnimations(sceneData);
+    }
+
+    if (result && options.verbose)
+    {
+        Utils::LogStream() << "Loaded FBX " << reader.GetVersion() << (reader.IsBinary() ? " binary" : " ASCII")
+                           << ": " << m_Frames.size() << " nodes, " << sceneData.materials.size()
+                           << " materials, " << sceneData.animations.size() << " animation(s)\n";
+    }
+
+    // El documento y los índices solo se usan durante la carga
+    m_Document = FBXNode();
+    m_Objects.clear();
+    m_Children.clear();
+    m_Parents.clear();
+    m_Frames.clear();
+    m_MaterialIndices.clear();
+
+    return result;
+}
+
+// ============================================================================
+// Objetos y conexiones
+// ============================================================================
+
+void NativeFBXImporter::ReadObjects()
+{
+    const FBXNode* objects = m_Document.Find("Objects");
+    for (const FBXNode& object : objects->children)
+    {
+        if (!object.properties.empty())
+            m_Objects[GetObjectId(object)] = &object;
+    }
+
+    const FBXNode* connections = m_Document.Find("Connections");
+    if (!connections)
+        return;
+
+    // C: "OO", hijo, padre  /  C: "OP", hijo, padre, "propiedad"
+    for (const FBXNode& connection : connections->children)
+    {
+        if (connection.properties.size() < 3)
+            continue;
+
+        INT64 child = connection.properties[1].AsInt();
+        INT64 parent = connection.properties[2].AsInt();
+        const string* property = (connection.properties.size() > 3) ? &connection.properties[3].stringValue : nullptr;
+
+        Link toChild = { child, property };
+        Link toParent = { parent, property };
+        m_Children[parent].push_back(toChild);
+        m_Parents[child].push_back(toParent);
+    }
+}
+
+void NativeFBXImporter::FindChildren(INT64 id, const char* type, vector<INT64>& out) const
+{
+    out.clear();
+
+    auto links = m_Children.find(id);
+    if (links == m_Children.end())
+        return;
+
+    for (const Link& link : links->second)
+    {
+        auto object = m_Objects.find(link.id);
+        if (object != m_Objects.end() && object->second->name == type)
+            out.push_back(link.id);
+    }
+}
+
+bool NativeFBXImporter::FindParent(INT64 id, const char* type, INT64& parent) const
+{
+    auto links = m_Parents.find(id);
+    if (links == m_Parents.end())
+        return false;
+
+    for (const Link& link : links->second)
+    {
+        auto object = m_Objects.find(link.id);
+        if (object != m_Objects.end() && object->second->name == type)
+        {
+            parent = link.id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Materiales
+// ============================================================================
+
+void NativeFBXImporter::ReadMaterials(SceneData& sceneData)
+{
+    const FBXNode* objects = m_Document.Find("Objects");
+    for (const FBXNode& object : objects->children)
+    {
+        if (object.name != "Material")
+            continue;
+
+        const INT64 id = GetObjectId(object);
+
+        MaterialData material;
+        material.name = GetObjectName(object);
+        ReadColorProperty(object, "DiffuseColor", material.material.Diffuse);
+        ReadColorProperty(object, "AmbientColor", material.material.Ambient);
+        ReadColorProperty(object, "SpecularColor", material.material.Specular);
+        ReadColorProperty(object, "EmissiveColor", material.material.Emissive);
+
+        double power = material.material.Power;
+        ReadPropertyValues(object, "ShininessExponent", &power, 1);
+        material.material.Power = (float)power;
+
+        // Textura difusa conectada al material
+        vector<INT64> textures;
+        FindChildren(id, "Texture", textures);
+        if (!textures.empty())
+        {
+            const FBXNode& texture = *m_Objects[textures[0]];
+            material.textureFilename = ReadStringNode(texture, "FileName");
+            if (material.textureFilename.empty())
+                material.textureFilename = ReadStringNode(texture, "RelativeFilename");
+        }
+
+        m_MaterialIndices[id] = (DWORD)sceneData.materials.size();
+        sceneData.materials.push_back(material);
+    }
+}
+
+// ============================================================================
+// Jerarquía
+// ============================================================================
+
+bool NativeFBXImporter::ReadModels(SceneData& sceneData)
+{
+    const FBXNode* objects = m_Document.Find("Objects");
+    const float scale = m_Options.scale;
+
+    vector<FrameData*> frames;
+    for (const FBXNode& object : objects->children)
+    {
+        if (object.name != "Model")
+            continue;
+
+        double translation[3] = { 0.0, 0.0, 0.0 };
+        double rotation[3] = { 0.0, 0.0, 0.0 };
+        double scaling[3] = { 1.0, 1.0, 1.0 };
+        ReadPropertyValues(object, "Lcl Translation", translation, 3);
+        ReadPropertyValues(object, "Lcl Rotation", rotation, 3);
+        ReadPropertyValues(object, "Lcl Scaling", scaling, 3);
+
+        FrameData* frame = new FrameData();
+        frame->name = GetObjectName(object);
+        frame->transformMatrix = ComposeLocalMatrix(translation, rotation, scaling, scale);
+
+        m_Frames[GetObjectId(object)] = frame;
+        frames.push_back(frame);
+    }
+
+    if (frames.empty())
+    {
+        m_LastError = "No Model objects in FBX file";
+        return false;
+    }
+
+    // Model -> Model en el orden de las conexiones
+    const FBXNode* connections = m_Document.Find("Connections");
+    if (connections)
+    {
+        for (const FBXNode& connection : connections->children)
+        {
+            if (connection.properties.size() < 3)
+                continue;
+
+            auto child = m_Frames.find(connection.properties[1].AsInt());
+            auto parent = m_Frames.find(connection.properties[2].AsInt());
+            if (child == m_Frames.end() || parent == m_Frames.end() || child->second == parent->second)
+                continue;
+
+            if (child->second->parent)
+                continue;
+
+            child->second->parent = parent->second;
+            parent->second->children.push_back(child->second);
+        }
+    }
+
+    // Un solo nodo de primer nivel es la raíz; si hay varios (huesos sin
+    // frame en el original), cuelgan de una raíz sin nombre
+    vector<FrameData*> topLevel;
+    for (FrameData* frame : frames)
+    {
+        if (!frame->parent)
+            topLevel.push_back(frame);
+    }
+
+    if (topLevel.size() == 1)
+    {
+        sceneData.rootFrame = topLevel[0];
+    }
+    else
+    {
+        sceneData.rootFrame = new FrameData();
+        for (FrameData* frame : topLevel)
+        {
+            frame->parent = sceneData.rootFrame;
+            sceneData.rootFrame->children.push_back(frame);
+        }
+    }
+
+    D3DXMATRIX identity;
+    D3DXMatrixIdentity(&identity);
+    UpdateCombinedMatrices(sceneData.rootFrame, identity);
+
+    return true;
+}
+
+// ============================================================================
+// Meshes
+// ============================================================================
+
+void NativeFBXImporter::ReadMeshes()
+{
+    const FBXNode* objects = m_Document.Find("Objects");
+    for (const FBXNode& object : objects->children)
+    {
+        if (object.name != "Geometry" || GetObjectType(object) != "Mesh")
+            continue;
+
+        const INT64 geometryId = GetObjectId(object);
+        INT64 modelId = 0;
+        if (!FindParent(geometryId, "Model", modelId))
+            continue;
+
+        MeshData* mesh = new MeshData();
+        mesh->name = GetObjectName(object);
+
+        if (!ReadGeometry(object, *mesh))
+        {
+            Utils::LogWarning("Skipping invalid FBX geometry: " + mesh->name);
+            delete mesh;
+            continue;
+        }
+
+        // Materiales del Model en el orden de sus conexiones
+        vector<INT64> materials;
+        FindChildren(modelId, "Material", materials);
+        for (INT64 materialId : materials)
+            mesh->materials.push_back(m_MaterialIndices[materialId]);
+
+        ReadSkin(geometryId, *mesh);
+
+        m_Frames[modelId]->meshes.push_back(mesh);
+    }
+}
+
+bool NativeFBXImporter::ReadGeometry(const FBXNode& geometry, MeshData& mesh)
+{
+    const float inverseScale = 1.0f / m_Options.scale;
+
+    // Posiciones: RH -> LH (Z invertida) y escala global
+    vector<double> positions;
+    ReadArrayNode(geometry, "Vertices", positions);
+
+    const size_t vertexCount = positions.size() / 3;
+    mesh.vertices.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        mesh.vertices[i].position = D3DXVECTOR3(
+            (float)positions[i * 3 + 0] * inverseScale,
+            (float)positions[i * 3 + 1] * inverseScale,
+            (float)-positions[i * 3 + 2] * inverseScale);
+    }
+
+    // Polígonos (el último índice de cada uno como ~índice), en abanico
+    vector<int32_t> polygonVertices;
+    ReadArrayNode(geometry, "PolygonVertexIndex", polygonVertices);
+
+    vector<DWORD> trianglePolygon;
+    mesh.indices.reserve(polygonVertices.size());
+    trianglePolygon.reserve(polygonVertices.size() / 3);
+
+    size_t polygonStart = 0;
+    DWORD polygonIndex = 0;
+    for (size_t j = 0; j < polygonVertices.size(); j++)
+    {
+        int32_t index = polygonVertices[j];
+        const bool last = index < 0;
+        if (last)
+            index = ~index;
+
+        if ((size_t)index >= vertexCount)
+        {
+            m_LastError = "Polygon vertex index out of range";
+            return false;
+        }
+
+        polygonVertices[j] = index;
+
+        if (!last)
+            continue;
+
+        for (size_t k = polygonStart + 1; k + 1 <= j; k++)
+        {
+            mesh.indices.push_back((DWORD)polygonVertices[polygonStart]);
+            mesh.indices.push_back((DWORD)polygonVertices[k]);
+            mesh.indices.push_back((DWORD)polygonVertices[k + 1]);
+            trianglePolygon.push_back(polygonIndex);
+        }
+
+        polygonStart = j + 1;
+        polygonIndex++;
+    }
+
+    vector<double> values;
+
+    for (const FBXNode& element : geometry.children)
+    {
+        const int32_t layerIndex = element.properties.empty() ? 0 : (int32_t)element.properties[0].AsInt();
+
+        if (element.name == "LayerElementNormal" && layerIndex == 0)
+        {
+            static const double defaults[3] = { 0.0, 1.0, 0.0 };
+            if (!ReadLayerElement(element, "Normals", "NormalsIndex", 3, defaults, polygonVertices, vertexCount, values))
+                continue;
+
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                mesh.vertices[i].normal = D3DXVECTOR3(
+                    (float)values[i * 3 + 0], (float)values[i * 3 + 1], (float)-values[i * 3 + 2]);
+            }
+        }
+        else if (element.name == "LayerElementUV" && layerIndex >= 0 && layerIndex < MAX_TEXCOORD_SETS)
+        {
+            // V invertida: el valor por defecto (0, 1) vuelve a ser (0, 0)
+            static const double defaults[2] = { 0.0, 1.0 };
+            if (!ReadLayerElement(element, "UV", "UVIndex", 2, defaults, polygonVertices, vertexCount, values))
+                continue;
+
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                D3DXVECTOR2 uv((float)values[i * 2 + 0], (float)(1.0 - values[i * 2 + 1]));
+                if (layerIndex == 0)
+                    mesh.vertices[i].texCoord = uv;
+                else
+                    mesh.vertices[i].extraTexCoords[layerIndex - 1] = uv;
+            }
+
+            mesh.texCoordSetCount = max(mesh.texCoordSetCount, (DWORD)layerIndex + 1);
+        }
+        else if (element.name == "LayerElementColor" && layerIndex == 0)
+        {
+            static const double defaults[4] = { 1.0, 1.0, 1.0, 1.0 };
+            if (!ReadLayerElement(element, "Colors", "ColorIndex", 4, defaults, polygonVertices, vertexCount, values))
+                continue;
+
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                mesh.vertices[i].color = D3DXCOLOR(
+                    (float)values[i * 4 + 0], (float)values[i * 4 + 1],
+                    (float)values[i * 4 + 2], (float)values[i * 4 + 3]);
+            }
+            mesh.hasVertexColors = true;
+        }
+        else if (element.name == "LayerElementMaterial" && layerIndex == 0)
+        {
+            // Por polígono: cada triángulo del abanico hereda el de su polígono
+            if (ReadStringNode(element, "MappingInformationType") != "ByPolygon")
+                continue;
+
+            vector<int32_t> materials;
+            ReadArrayNode(element, "Materials", materials);
+
+            mesh.materialIndices.resize(trianglePolygon.size());
+            for (size_t t = 0; t < trianglePolygon.size(); t++)
+            {
+                DWORD polygon = trianglePolygon[t];
+                mesh.materialIndices[t] = (polygon < materials.size() && materials[polygon] >= 0)
+                    ? (DWORD)materials[polygon] : 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Skinning
+// ============================================================================
+// Un hueso por cluster, en el orden de conexión al skin. La matriz de
+// offset (vértice del mesh -> espacio del hueso) sale de Transform (mesh)
+// y TransformLink (hueso): offset = Transform * inversa(TransformLink).
+// ============================================================================
+
+void NativeFBXImporter::ReadSkin(INT64 geometryId, MeshData& mesh)
+{
+    const float scale = m_Options.scale;
+
+    vector<INT64> deformers;
+    FindChildren(geometryId, "Deformer", deformers);
+
+    for (INT64 skinId : deformers)
+    {
+        if (GetObjectType(*m_Objects[skinId]) != "Skin")
+            continue;
+
+        vector<INT64> clusters;
+        FindChildren(skinId, "Deformer", clusters);
+
+        vector<int32_t> indexes;
+        vector<double> weights, transform, transformLink;
+
+        for (INT64 clusterId : clusters)
+        {
+            const FBXNode& cluster = *m_Objects[clusterId];
+            if (GetObjectType(cluster) != "Cluster")
+                continue;
+
+            BoneData bone;
+
+            vector<INT64> models;
+            FindChildren(clusterId, "Model", models);
+            if (!models.empty())
+                bone.name = m_Frames[models[0]]->name;
+
+            ReadArrayNode(cluster, "Transform", transform);
+            ReadArrayNode(cluster, "TransformLink", transformLink);
+            if (transform.size() == 16 && transformLink.size() == 16)
+            {
+                D3DXMATRIX meshMatrix = ConvertMatrix_RH_to_LH(transform, scale);
+                D3DXMATRIX boneMatrix = ConvertMatrix_RH_to_LH(transformLink, scale);
+
+                D3DXMATRIX inverseBone;
+                D3DXMatrixInverse(&inverseBone, nullptr, &boneMatrix);
+
+                bone.offsetMatrix = meshMatrix * inverseBone;
+                bone.transformMatrix = boneMatrix;
+            }
+
+            const DWORD boneIndex = (DWORD)mesh.bones.size();
+            mesh.bones.push_back(bone);
+
+            ReadArrayNode(cluster, "Indexes", indexes);
+            ReadArrayNode(cluster, "Weights", weights);
+
+            const size_t count = min(indexes.size(), weights.size());
+            for (size_t k = 0; k < count; k++)
+            {
+                if (indexes[k] < 0 || (size_t)indexes[k] >= mesh.vertices.size() || weights[k] <= 0.0)
+                    continue;
+
+                AddInfluence(mesh.vertices[indexes[k]], boneIndex, (float)weights[k]);
+            }
+        }
+
+        mesh.hasSkinning = !mesh.bones.empty();
+        break;
+    }
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// AnimationStack -> AnimationLayer -> AnimationCurveNode (conectado con
+// "Lcl Translation/Rotation/Scaling" a un Model) -> AnimationCurve (d|X,
+// d|Y, d|Z). Los componentes sin curva toman el valor del curve node.
+// ============================================================================
+
+void NativeFBXImporter::ReadCurve(const FBXNode& node, Curve& curve)
+{
+    ReadArrayNode(node, "KeyTime", curve.times);
+    ReadArrayNode(node, "KeyValueFloat", curve.values);
+
+    const size_t count = min(curve.times.size(), curve.values.size());
+    curve.times.resize(count);
+    curve.values.resize(count);
+
+    vector<int32_t> flags, refCounts;
+    vector<float> data;
+    ReadArrayNode(node, "KeyAttrFlags", flags);
+    ReadArrayNode(node, "KeyAttrDataFloat", data);
+    ReadArrayNode(node, "KeyAttrRefCount", refCounts);
+
+    // Atributos compartidos por 'refCount' keys consecutivas
+    curve.flags.assign(count, FBX_INTERPOLATION_LINEAR);
+    curve.data.assign(count * 4, 0.0f);
+
+    size_t key = 0;
+    for (size_t a = 0; a < flags.size() && key < count; a++)
+    {
+        size_t run = refCounts.empty()
+            ? (flags.size() == 1 ? count : 1)
+            : (a < refCounts.size() ? (size_t)max(refCounts[a], 0) : 0);
+
+        for (size_t r = 0; r < run && key < count; r++, key++)
+        {
+            curve.flags[key] = flags[a];
+            for (size_t c = 0; c < 4 && a * 4 + c < data.size(); c++)
+                curve.data[key * 4 + c] = data[a * 4 + c];
+        }
+    }
+}
+
+float NativeFBXImporter::EvaluateCurve(const Curve& curve, int64_t time, size_t& cursor)
+{
+    const vector<int64_t>& times = curve.times;
+    const size_t count = times.size();
+
+    if (time <= times[0])
+        return curve.values[0];
+    if (time >= times[count - 1])
+        return curve.values[count - 1];
+
+    // Segmento [cursor, cursor + 1]: el del tiempo anterior, el siguiente
+    // (muestreo en orden) o búsqueda binaria
+    if (cursor + 1 >= count || times[cursor] > time)
+        cursor = 0;
+    if (times[cursor + 1] <= time)
+    {
+        if (cursor + 2 < count && times[cursor + 2] > time)
+            cursor++;
+        else
+            cursor = (size_t)(upper_bound(times.begin(), times.end(), time) - times.begin()) - 1;
+    }
+
+    const size_t k = cursor;
+    const float v0 = curve.values[k];
+    const float v1 = curve.values[k + 1];
+    const int32_t flags = curve.flags[k];
+
+    if (flags & FBX_INTERPOLATION_CONSTANT)
+        return v0;
+
+    if (flags & FBX_INTERPOLATION_CUBIC)
+    {
+        // Pendiente derecha de la key y pendiente izquierda de la siguiente
+        HermiteKey a, b;
+        a.time = times[k] / FBX_KTIME_PER_SECOND;
+        a.value = v0;
+        a.slope = curve.data[k * 4 + 0];
+        b.time = times[k + 1] / FBX_KTIME_PER_SECOND;
+        b.value = v1;
+        b.slope = curve.data[k * 4 + 1];
+        return CurveFitter::EvaluateHermite(a, b, time / FBX_KTIME_PER_SECOND);
+    }
+
+    double alpha = (double)(time - times[k]) / (double)(times[k + 1] - times[k]);
+    return (float)(v0 + (v1 - v0) * alpha);
+}
+
+void NativeFBXImporter::ReadAnimations(SceneData& sceneData)
+{
+    static const char* channelProperties[3] = { "Lcl Translation", "Lcl Rotation", "Lcl Scaling" };
+    static const char* componentNames[3] = { "d|X", "d|Y", "d|Z" };
+
+    const double sampleFPS = m_Options.resampleAnimation ? m_Options.targetFPS : 0.0;
+    const float inverseScale = 1.0f / m_Options.scale;
+
+    const FBXNode* objects = m_Document.Find("Objects");
+    for (const FBXNode& stack : objects->children)
+    {
+        if (stack.name != "AnimationStack")
+            continue;
+
+        const INT64 stackId = GetObjectId(stack);
+
+        AnimationClip clip;
+        clip.name = GetObjectName(stack);
+        clip.ticksPerSecond = (sampleFPS > 0.0) ? sampleFPS : m_Options.targetFPS;
+
+        double stopTime = 0.0;
+        ReadPropertyValues(stack, "LocalStop", &stopTime, 1);
+        clip.duration = stopTime / FBX_KTIME_PER_SECOND;
+
+        // Curvas de cada Model animado (en el orden en que aparecen)
+        map<INT64, Curve> curves;
+        map<INT64, NodeCurves> nodeCurves;
+        vector<INT64> nodeOrder;
+        int64_t lastKeyTime = 0;
+
+        vector<INT64> layers, curveNodes, curveIds;
+        FindChildren(stackId, "AnimationLayer", layers);
+
+        for (INT64 layerId : layers)
+        {
+            FindChildren(layerId, "AnimationCurveNode", curveNodes);
+
+            for (INT64 curveNodeId : curveNodes)
+            {
+                // Model y canal a los que está conectado el curve node
+                INT64 modelId = 0;
+                int channel = -1;
+                for (const Link& link : m_Parents[curveNodeId])
+                {
+                    if (!link.property || m_Frames.find(link.id) == m_Frames.end())
+                        continue;
+
+                    for (int c = 0; c < 3; c++)
+                    {
+                        if (*link.property == channelProperties[c])
+                        {
+                            modelId = link.id;
+                            channel = c;
+                        }
+                    }
+                }
+
+                if (channel < 0)
+                    continue;
+
+                auto inserted = nodeCurves.insert(make_pair(modelId, NodeCurves()));
+                NodeCurves& node = inserted.first->second;
+                if (inserted.second)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        for (int k = 0; k < 3; k++)
+                        {
+                            node.curves[c][k] = nullptr;
+                            node.defaults[c][k] = (c == 2) ? 1.0f : 0.0f;
+                        }
+                    }
+                    node.channels = 0;
+                    nodeOrder.push_back(modelId);
+                }
+
+                node.channels |= (BYTE)(1 << channel);
+
+                const FBXNode& curveNode = *m_Objects[curveNodeId];
+                for (int component = 0; component < 3; component++)
+                {
+                    double value = node.defaults[channel][component];
+                    ReadPropertyValues(curveNode, componentNames[component], &value, 1);
+                    node.defaults[channel][component] = (float)value;
+                }
+
+                FindChildren(curveNodeId, "AnimationCurve", curveIds);
+                for (const Link& link : m_Children[curveNodeId])
+                {
+                    if (!link.property || find(curveIds.begin(), curveIds.end(), link.id) == curveIds.end())
+                        continue;
+
+                    for (int component = 0; component < 3; component++)
+                    {
+                        if (*link.property != componentNames[component])
+                            continue;
+
+                        Curve& curve = curves[link.id];
+                        ReadCurve(*m_Objects[link.id], curve);
+                        if (curve.times.empty())
+                            continue;
+
+                        node.curves[channel][component] = &curve;
+                        lastKeyTime = max(lastKeyTime, curve.times.back());
+                    }
+                }
+            }
+        }
+
+        if (clip.duration <= 0.0)
+            clip.duration = lastKeyTime / FBX_KTIME_PER_SECOND;
+
+        // Tiempos de muestreo: la rejilla del FPS objetivo (como
+        // AnimationResampler) o las keys de las curvas del nodo
+        vector<double> gridTimes;
+        if (sampleFPS > 0.0)
+        {
+            size_t frameCount = AnimationResampler::GetFrameCount(clip.duration, sampleFPS);
+            gridTimes.resize(frameCount);
+            for (size_t f = 0; f < frameCount; f++)
+                gridTimes[f] = min((double)f / sampleFPS, clip.duration);
+        }
+
+        vector<double> keyTimes;
+        vector<float> rotationX, rotationY, rotationZ;
+        vector<D3DXQUATERNION> rotations;
+
+        for (INT64 modelId : nodeOrder)
+        {
+            const NodeCurves& node = nodeCurves[modelId];
+
+            if (sampleFPS > 0.0)
+            {
+                keyTimes = gridTimes;
+            }
+            else
+            {
+                vector<int64_t> times;
+                for (int c = 0; c < 3; c++)
+                {
+                    for (int k = 0; k < 3; k++)
+                    {
+                        if (node.curves[c][k])
+                            times.insert(times.end(), node.curves[c][k]->times.begin(), node.curves[c][k]->times.end());
+                    }
+                }
+                sort(times.begin(), times.end());
+                times.erase(unique(times.begin(), times.end()), times.end());
+
+                keyTimes.resize(times.size());
+                for (size_t i = 0; i < times.size(); i++)
+                    keyTimes[i] = times[i] / FBX_KTIME_PER_SECOND;
+            }
+
+            const size_t keyCount = keyTimes.size();
+            vector<AnimationKey> keys(keyCount);
+            rotationX.resize(keyCount);
+            rotationY.resize(keyCount);
+            rotationZ.resize(keyCount);
+            rotations.resize(keyCount);
+
+            size_t cursors[3][3] = {};
+            float values[3][3];
+
+            for (size_t i = 0; i < keyCount; i++)
+            {
+                const int64_t time = (int64_t)llround(keyTimes[i] * FBX_KTIME_PER_SECOND);
+
+                for (int c = 0; c < 3; c++)
+                {
+                    for (int k = 0; k < 3; k++)
+                    {
+                        const Curve* curve = node.curves[c][k];
+                        values[c][k] = curve ? EvaluateCurve(*curve, time, cursors[c][k]) : node.defaults[c][k];
+                    }
+                }
+
+                AnimationKey& key = keys[i];
+                key.time = keyTimes[i];
+                key.channels = node.channels;
+                key.translation = D3DXVECTOR3(
+                    values[0][0] * inverseScale, values[0][1] * inverseScale, -values[0][2] * inverseScale);
+                key.scale = D3DXVECTOR3(values[2][0], values[2][1], values[2][2]);
+
+                rotationX[i] = values[1][0];
+                rotationY[i] = values[1][1];
+                rotationZ[i] = values[1][2];
+            }
+
+            MatrixConverter::ConvertEulerToQuaternions_RH_to_LH(
+                rotationX.data(), rotationY.data(), rotationZ.data(), keyCount, rotations.data());
+
+            for (size_t i = 0; i < keyCount; i++)
+                keys[i].rotation = rotations[i];
+
+            AnimationTrack track;
+            track.boneName = m_Frames[modelId]->name;
+            track.SetKeys(std::move(keys));
+            clip.tracks.push_back(track);
+        }
+
+        sceneData.animations.push_back(clip);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#ifndef NATIVE_FBX_IMPORTER_H
+#define NATIVE_FBX_IMPORTER_H
+
+#include "../include/Common.h"
+#include "FBXReader.h"
+
+/**
+ * @class NativeFBXImporter
+ * @brief Carga un FBX 7.x (binario o ASCII) en SceneData sin el FBX SDK
+ *
+ * Lectura inversa de NativeFBXExporter, pensada para verificar lo que
+ * escribió el conversor (SceneVerifier): el resultado vuelve al espacio de
+ * DirectX (Left-Handed, Z invertida, V invertida, escala global deshecha).
+ *
+ *   Model               -> FrameData (Lcl Translation/Rotation/Scaling)
+ *   Geometry + Layers   -> MeshData del frame del Model (triángulos en
+ *                          abanico, layers ByVertice/ByPolygonVertex,
+ *                          Direct/IndexToDirect proyectados a los vértices)
+ *   Skin + Clusters     -> BoneData (un hueso por cluster) y pesos por vértice
+ *   Material + Texture  -> MaterialData
+ *   AnimationStack      -> AnimationClip; las curvas de cada nodo se
+ *                          muestrean en la rejilla del FPS objetivo (o en
+ *                          sus keys si no se remuestrea)
+ *
+ * Solo se leen las propiedades que escribe NativeFBXExporter (sin
+ * PreRotation ni órdenes de rotación distintos de XYZ).
+ */
+class NativeFBXImporter
+{
+public:
+    NativeFBXImporter();
+
+    /**
+     * Cargar un archivo FBX
+     * @param filename Archivo FBX
+     * @param options Escala global y FPS con los que se exportó
+     * @param sceneData [out] Escena cargada
+     * @return true si se cargó correctamente
+     */
+    bool LoadScene(
+        const string& filename,
+        const ConversionOptions& options,
+        SceneData& sceneData);
+
+    /**
+     * Obtener último mensaje de error
+     * @return Mensaje de error
+     */
+    string GetLastError() const { return m_LastError; }
+
+private:
+    // Extremo de una conexión (property nullptr = objeto-objeto)
+    struct Link
+    {
+        INT64 id;
+        const string* property;
+    };
+
+    // AnimationCurve con sus atributos expandidos a una entrada por key
+    struct Curve
+    {
+        vector<int64_t> times;
+        vector<float> values;
+        vector<int32_t> flags;
+        vector<float> data;            // 4 floats por key (pendientes, pesos)
+    };
+
+    // Curvas de un nodo animado: [canal T/R/S][componente X/Y/Z]
+    struct NodeCurves
+    {
+        const Curve* curves[3][3];
+        float defaults[3][3];
+        BYTE channels;
+    };
+
+    ConversionOptions m_Options;
+    FBXNode m_Document;
+    map<INT64, const FBXNode*> m_Objects;
+    map<INT64, vector<Link>> m_Children;   // Padre -> hijos en el orden del archivo
+    map<INT64, vector<Link>> m_Parents;    // Hijo -> padres
+    map<INT64, FrameData*> m_Frames;
+    map<INT64, DWORD> m_MaterialIndices;
+    string m_LastError;
+
+    // Índices de objetos y conexiones
+    void ReadObjects();
+
+    void ReadMaterials(SceneData& sceneData);
+    bool ReadModels(SceneData& sceneData);
+    void ReadMeshes();
+    bool ReadGeometry(const FBXNode& geometry, MeshData& mesh);
+    void ReadSkin(INT64 geometryId, MeshData& mesh);
+    void ReadAnimations(SceneData& sceneData);
+
+    // Hijos/padre de un objeto con el tipo de nodo dado
+    void FindChildren(INT64 id, const char* type, vector<INT64>& out) const;
+    bool FindParent(INT64 id, const char* type, INT64& parent) const;
+
+    static void ReadCurve(const FBXNode& node, Curve& curve);
+    static float EvaluateCurve(const Curve& curve, int64_t time, size_t& cursor);
+};
+
+#endif // NATIVE_FBX_IMPORTER_H
@@ -0,0 +1,173 @@
+#include "PoseBaker.h"
+#include "AnimationResampler.h"
+#include "MatrixConverter.h"
+#include "PoseEvaluator.h"
+#include "SimdMath.h"
+
+// Frames por tarea paralela (las matrices de un bloque quedan juntas en memoria)
+static const size_t BAKE_BLOCK_FRAMES = 16;
+
+// ============================================================================
+// Aplanar jerarquía
+// ============================================================================
+
+void PoseBaker::FlattenHierarchy(
+    const FrameData* root,
+    vector<const FrameData*>& frames,
+    vector<int>& parents)
+{
+    frames.clear();
+    parents.clear();
+
+    if (!root)
+        return;
+
+    // Pila de (frame, índice del padre); los hijos se apilan en orden inverso
+    // para conservar el orden original de la jerarquía
+    vector<pair<const FrameData*, int>> stack;
+    stack.push_back(make_pair(root, -1));
+
+    while (!stack.empty())
+    {
+        const FrameData* frame = stack.back().first;
+        int parent = stack.back().second;
+        stack.pop_back();
+
+        int index = (int)frames.size();
+        frames.push_back(frame);
+        parents.push_back(parent);
+
+        for (size_t i = frame->children.size(); i-- > 0;)
+            stack.push_back(make_pair((const FrameData*)frame->children[i], index));
+    }
+}
+
+// ============================================================================
+// Matriz local desde TRS
+// ============================================================================
+// Convención de vectores fila (D3D): M = S * R * T
+//   fila 0..2 = filas de la matriz de rotación escaladas por S
+//   fila 3    = traslación
+
+void PoseBaker::ComposeLocalMatrix(
+    const D3DXVECTOR3& translation,
+    const D3DXQUATERNION& rotation,
+    const D3DXVECTOR3& scale,
+    D3DXMATRIX& out)
+{
+    float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+
+    float xx = x * x, yy = y * y, zz = z * z;
+    float xy = x * y, xz = x * z, yz = y * z;
+    float wx = w * x, wy = w * y, wz = w * z;
+
+    out._11 = (1.0f - 2.0f * (yy + zz)) * scale.x;
+    out._12 = (2.0f * (xy + wz)) * scale.x;
+    out._13 = (2.0f * (xz - wy)) * scale.x;
+    out._14 = 0.0f;
+
+    out._21 = (2.0f * (xy - wz)) * scale.y;
+    out._22 = (1.0f - 2.0f * (xx + zz)) * scale.y;
+    out._23 = (2.0f * (yz + wx)) * scale.y;
+    out._24 = 0.0f;
+
+    out._31 = (2.0f * (xz + wy)) * scale.z;
+    out._32 = (2.0f * (yz - wx)) * scale.z;
+    out._33 = (1.0f - 2.0f * (xx + yy)) * scale.z;
+    out._34 = 0.0f;
+
+    out._41 = translation.x;
+    out._42 = translation.y;
+    out._43 = translation.z;
+    out._44 = 1.0f;
+}
+
+// ============================================================================
+// Hornear un clip
+// ============================================================================
+
+bool PoseBaker::BakeClip(
+    const AnimationClip& clip,
+    const FrameData* root,
+    double fps,
+    int numThreads,
+    BakedPose& out)
+{
+    out = BakedPose();
+
+    if (!root || fps <= 0.0)
+        return false;
+
+    FlattenHierarchy(root, out.bones, out.parents);
+    const size_t boneCount = out.bones.size();
+
+    // ========================================================================
+    // Pose de reposo de todos los huesos (descomposición por lotes)
+    // ========================================================================
+    vector<D3DXMATRIX> restMatrices(boneCount);
+    for (size_t b = 0; b < boneCount; b++)
+        restMatrices[b] = out.bones[b]->transformMatrix;
+
+    DecomposedTransforms rest;
+    MatrixConverter::DecomposeMatrices(restMatrices.data(), boneCount, rest);
+
+    vector<string> boneNames(boneCount);
+    LocalPose restPose;
+    restPose.Resize(boneCount);
+    for (size_t b = 0; b < boneCount; b++)
+    {
+        boneNames[b] = out.bones[b]->name;
+        restPose.Set(b, rest.translations[b], rest.rotations[b], rest.scales[b]);
+    }
+
+    // Un solo evaluador compartido; cada bloque usa su propia caché
+    PoseEvaluator evaluator;
+    evaluator.Initialize(clip, boneNames, restPose);
+
+    double endTime = (clip.duration > 0.0) ? clip.duration : evaluator.GetLastKeyTime();
+
+    out.fps = fps;
+    out.frameCount = AnimationResampler::GetFrameCount(endTime, fps);
+    out.globals.resize(out.frameCount * boneCount);
+
+    // ========================================================================
+    // Evaluar bloques de frames en paralelo
+    // ========================================================================
+    size_t blockCount = (out.frameCount + BAKE_BLOCK_FRAMES - 1) / BAKE_BLOCK_FRAMES;
+
+    Utils::ParallelFor(blockCount, numThreads, [&](size_t block)
+    {
+        size_t firstFrame = block * BAKE_BLOCK_FRAMES;
+        size_t lastFrame = min(firstFrame + BAKE_BLOCK_FRAMES, out.frameCount);
+
+        PoseEvaluationCache cache;
+        LocalPose pose;
+        D3DXMATRIX local;
+
+        for (size_t f = firstFrame; f < lastFrame; f++)
+        {
+            double time = min((double)f / fps, endTime);
+            D3DXMATRIX* globals = &out.globals[f * boneCount];
+
+            evaluator.Evaluate(time, cache, pose);
+
+            for (size_t b = 0; b < boneCount; b++)
+            {
+                // Huesos sin keys: matriz original (evita el error de descomponer)
+                if (evaluator.GetChannelMask(b) != 0)
+                    ComposeLocalMatrix(pose.GetTranslation(b), pose.GetRotation(b), pose.GetScale(b), local);
+                else
+                    local = out.bones[b]->transformMatrix;
+
+                // Global = Local * Global(padre); el padre ya está evaluado (orden DFS)
+                int parent = out.parents[b];
+                if (parent < 0)
+                    globals[b] = local;
+                else
+                    SimdMath::MatrixMultiply(local, globals[parent], globals[b]);
+            }
+        }
+    });
+
+    return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef POSE_BAKER_H
+#define POSE_BAKER_H
+
+#include "../include/Common.h"
+
+/**
+ * @struct BakedPose
+ * @brief Matrices globales de todos los huesos en cada frame de un clip
+ *
+ * Los huesos son los frames de la jerarquía aplanados en orden DFS
+ * (el padre siempre aparece antes que sus hijos). Las matrices están en
+ * espacio DirectX (convención de vectores fila, igual que combinedMatrix).
+ *
+ * globals tiene frameCount * BoneCount() matrices: todas las del frame 0,
+ * luego todas las del frame 1, etc.
+ */
+struct BakedPose
+{
+    vector<const FrameData*> bones;    // Frames en orden DFS
+    vector<int> parents;               // Índice del padre (-1 para la raíz)
+
+    double fps;
+    size_t frameCount;
+    vector<D3DXMATRIX> globals;        // [frame][bone]
+
+    BakedPose() : fps(30.0), frameCount(0) {}
+
+    size_t BoneCount() const { return bones.size(); }
+
+    // Matrices globales de un frame (BoneCount() elementos)
+    const D3DXMATRIX* Frame(size_t frame) const { return &globals[frame * bones.size()]; }
+
+    // Índice de un hueso por nombre (-1 si no existe)
+    int FindBone(const string& name) const
+    {
+        for (size_t i = 0; i < bones.size(); i++)
+        {
+            if (bones[i]->name == name)
+                return (int)i;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @class PoseBaker
+ * @brief Evalúa la pose global de todos los huesos en cada frame de un clip
+ *
+ * Para cada frame muestreado:
+ *   1. Se evalúa el TRS local de cada hueso (interpolando su track; los
+ *      canales sin keys y los huesos sin track usan la pose de reposo)
+ *   2. Se compone la matriz local S * R * T
+ *   3. Global = Local * Global(padre), con multiplicación SSE
+ *
+ * Los frames se reparten en bloques entre hilos; dentro de un bloque las
+ * matrices de cada frame son contiguas en memoria.
+ */
+class PoseBaker
+{
+public:
+    /**
+     * Aplanar la jerarquía en orden DFS (padres antes que hijos)
+     * @param root Frame raíz
+     * @param frames [out] Frames en orden
+     * @param parents [out] Índice del padre de cada frame (-1 = raíz)
+     */
+    static void FlattenHierarchy(
+        const FrameData* root,
+        vector<const FrameData*>& frames,
+        vector<int>& parents);
+
+    /**
+     * Hornear las matrices globales de un clip
+     * @param clip Clip de animación
+     * @param root Jerarquía de frames (poses de reposo)
+     * @param fps Frames por segundo del muestreo
+     * @param numThreads Número de hilos (0 = automático)
+     * @param out [out] Pose horneada [frame][bone]
+     * @return true si se horneó correctamente
+     */
+    static bool BakeClip(
+        const AnimationClip& clip,
+        const FrameData* root,
+        double fps,
+        int numThreads,
+        BakedPose& out);
+
+    /**
+     * Componer matriz local (S * R * T, vectores fila) desde TRS
+     */
+    static void ComposeLocalMatrix(
+        const D3DXVECTOR3& translation,
+        const D3DXQUATERNION& rotation,
+        const D3DXVECTOR3& scale,
+        D3DXMATRIX& out);
+};
+
+#endif // POSE_BAKER_H
@@ -0,0 +1,276 @@
+#include "PoseEvaluator.h"
+#include "SimdMath.h"
+
+using namespace SimdMath;
+
+PoseEvaluator::PoseEvaluator()
+    : m_LastKeyTime(0.0)
+{
+}
+
+// ============================================================================
+// Inicialización
+// ============================================================================
+
+void PoseEvaluator::Initialize(const AnimationClip& clip)
+{
+    // Un hueso por track, pose de reposo identidad
+    LocalPose rest;
+    rest.Resize(clip.tracks.size());
+    for (size_t i = 0; i < clip.tracks.size(); i++)
+        rest.Set(i, D3DXVECTOR3(0, 0, 0), D3DXQUATERNION(0, 0, 0, 1), D3DXVECTOR3(1, 1, 1));
+
+    vector<int> trackToBone(clip.tracks.size());
+    for (size_t i = 0; i < clip.tracks.size(); i++)
+        trackToBone[i] = (int)i;
+
+    m_RestPose = rest;
+    Build(clip, trackToBone);
+}
+
+void PoseEvaluator::Initialize(
+    const AnimationClip& clip,
+    const vector<string>& boneNames,
+    const LocalPose& restPose)
+{
+    map<string, int> boneIndex;
+    for (size_t i = 0; i < boneNames.size(); i++)
+    {
+        if (!boneNames[i].empty())
+            boneIndex[boneNames[i]] = (int)i;
+    }
+
+    // Tracks sin hueso en la lista se ignoran (-1)
+    vector<int> trackToBone(clip.tracks.size(), -1);
+    for (size_t i = 0; i < clip.tracks.size(); i++)
+    {
+        auto it = boneIndex.find(clip.tracks[i].boneName);
+        if (it != boneIndex.end())
+            trackToBone[i] = it->second;
+    }
+
+    m_RestPose = restPose;
+    Build(clip, trackToBone);
+}
+
+// ============================================================================
+// Conversión de tracks a datos SoA por canal
+// ============================================================================
+
+void PoseEvaluator::Build(const AnimationClip& clip, const vector<int>& trackToBone)
+{
+    const BYTE channelBits[3] = { KEY_TRANSLATION, KEY_ROTATION, KEY_SCALE };
+
+    m_ChannelMasks.assign(m_RestPose.Size(), 0);
+    m_LastKeyTime = 0.0;
+
+    for (int c = 0; c < 3; c++)
+    {
+        ChannelData& channel = m_Channels[c];
+        channel.bones.clear();
+        channel.offsets.assign(1, 0);
+        channel.times.clear();
+        for (int k = 0; k < 4; k++)
+            channel.values[k].clear();
+    }
+
+    for (size_t i = 0; i < clip.tracks.size(); i++)
+    {
+        int bone = trackToBone[i];
+        if (bone < 0)
+            continue;
+
+        const AnimationTrack& track = clip.tracks[i];
+
+        for (int c = 0; c < 3; c++)
+        {
+            ChannelData& channel = m_Channels[c];
+            size_t before = channel.times.size();
+
+            for (const AnimationKey& key : track.GetKeys())
+            {
+                if (!(key.channels & channelBits[c]))
+                    continue;
+
+                channel.times.push_back(key.time);
+
+                if (c == 0)
+                {
+                    channel.values[0].push_back(key.translation.x);
+                    channel.values[1].push_back(key.translation.y);
+                    channel.values[2].push_back(key.translation.z);
+                }
+                else if (c == 1)
+                {
+                    channel.values[0].push_back(key.rotation.x);
+                    channel.values[1].push_back(key.rotation.y);
+                    channel.values[2].push_back(key.rotation.z);
+                    channel.values[3].push_back(key.rotation.w);
+                }
+                else
+                {
+                    channel.values[0].push_back(key.scale.x);
+                    channel.values[1].push_back(key.scale.y);
+                    channel.values[2].push_back(key.scale.z);
+                }
+            }
+
+            if (channel.times.size() == before)
+                continue;
+
+            channel.bones.push_back((DWORD)bone);
+            channel.offsets.push_back((DWORD)channel.times.size());
+            m_ChannelMasks[bone] |= channelBits[c];
+            m_LastKeyTime = max(m_LastKeyTime, channel.times.back());
+        }
+    }
+}
+
+// ============================================================================
+// Buscar keys vecinas (con caché)
+// ============================================================================
+// Al muestrear en orden creciente el tiempo casi siempre cae en el mismo
+// intervalo o en el siguiente: se prueban primero y solo si no, búsqueda binaria.
+
+void PoseEvaluator::Bracket(
+    const double* times,
+    DWORD count,
+    double time,
+    DWORD& cursor,
+    DWORD& i0,
+    DWORD& i1,
+    float& alpha)
+{
+    if (cursor >= count)
+        cursor = 0;
+
+    if (times[cursor] <= time && (cursor + 1 >= count || time < times[cursor + 1]))
+    {
+        // Mismo intervalo que la evaluación anterior
+    }
+    else if (cursor + 1 < count && times[cursor + 1] <= time &&
+             (cursor + 2 >= count || time < times[cursor + 2]))
+    {
+        cursor++;
+    }
+    else
+    {
+        // Última key con times[k] <= time (0 si time es anterior a la primera)
+        const double* upper = upper_bound(times, times + count, time);
+        cursor = (upper == times) ? 0 : (DWORD)(upper - times - 1);
+    }
+
+    i0 = cursor;
+
+    if (cursor + 1 >= count || time <= times[cursor])
+    {
+        i1 = i0;
+        alpha = 0.0f;
+        return;
+    }
+
+    i1 = cursor + 1;
+    double span = times[i1] - times[i0];
+    alpha = (span > 1e-12) ? (float)((time - times[i0]) / span) : 0.0f;
+}
+
+// ============================================================================
+// Evaluación
+// ============================================================================
+
+void PoseEvaluator::Evaluate(double time, PoseEvaluationCache& cache, LocalPose& pose) const
+{
+    // Partir de la pose de reposo (canales sin keys)
+    pose = m_RestPose;
+
+    for (int c = 0; c < 3; c++)
+    {
+        const ChannelData& channel = m_Channels[c];
+        size_t entries = channel.bones.size();
+        if (entries == 0)
+            continue;
+
+        const int components = (c == 1) ? 4 : 3;
+        size_t padded = (entries + LANES - 1) / LANES * LANES;
+
+        if (cache.cursors[c].size() != entries)
+            cache.cursors[c].assign(entries, 0);
+
+        if (cache.alpha.size() < padded)
+        {
+            cache.alpha.resize(padded, 0.0f);
+            for (int k = 0; k < 4; k++)
+            {
+                cache.a[k].resize(padded, 0.0f);
+                cache.b[k].resize(padded, 0.0f);
+                cache.out[k].resize(padded, 0.0f);
+            }
+        }
+
+        // Reunir keys vecinas de cada hueso animado
+        for (size_t j = 0; j < entries; j++)
+        {
+            DWORD first = channel.offsets[j];
+            DWORD count = channel.offsets[j + 1] - first;
+            DWORD i0, i1;
+
+            Bracket(&channel.times[first], count, time, cache.cursors[c][j], i0, i1, cache.alpha[j]);
+
+            for (int k = 0; k < components; k++)
+            {
+                cache.a[k][j] = channel.values[k][first + i0];
+                cache.b[k][j] = channel.values[k][first + i1];
+            }
+        }
+
+        // Carriles de relleno: interpolar entre valores válidos (identidad)
+        for (size_t j = entries; j < padded; j++)
+        {
+            cache.alpha[j] = 0.0f;
+            for (int k = 0; k < 4; k++)
+            {
+                cache.a[k][j] = (k == 3) ? 1.0f : 0.0f;
+                cache.b[k][j] = cache.a[k][j];
+            }
+        }
+
+        // Interpolar 4 huesos por iteración
+        for (size_t j = 0; j < padded; j += LANES)
+        {
+            __m128 t = _mm_loadu_ps(&cache.alpha[j]);
+
+            if (c == 1)
+            {
+                __m128 ox, oy, oz, ow;
+                Nlerp(
+                    _mm_loadu_ps(&cache.a[0][j]), _mm_loadu_ps(&cache.a[1][j]),
+                    _mm_loadu_ps(&cache.a[2][j]), _mm_loadu_ps(&cache.a[3][j]),
+                    _mm_loadu_ps(&cache.b[0][j]), _mm_loadu_ps(&cache.b[1][j]),
+                    _mm_loadu_ps(&cache.b[2][j]), _mm_loadu_ps(&cache.b[3][j]),
+                    t, ox, oy, oz, ow);
+
+                _mm_storeu_ps(&cache.out[0][j], ox);
+                _mm_storeu_ps(&cache.out[1][j], oy);
+                _mm_storeu_ps(&cache.out[2][j], oz);
+                _mm_storeu_ps(&cache.out[3][j], ow);
+            }
+            else
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    _mm_storeu_ps(&cache.out[k][j],
+                        Lerp(_mm_loadu_ps(&cache.a[k][j]), _mm_loadu_ps(&cache.b[k][j]), t));
+                }
+            }
+        }
+
+        // Escribir en la pose
+        vector<float>* target = (c == 0) ? pose.t : (c == 1) ? pose.r : pose.s;
+        for (size_t j = 0; j < entries; j++)
+        {
+            DWORD bone = channel.bones[j];
+            for (int k = 0; k < components; k++)
+                target[k][bone] = cache.out[k][j];
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#ifndef POSE_EVALUATOR_H
+#define POSE_EVALUATOR_H
+
+#include "../include/Common.h"
+
+/**
+ * @struct LocalPose
+ * @brief Pose local (TRS) de un conjunto de huesos en formato SoA
+ *
+ * Cada componente es un array con un elemento por hueso:
+ *   t[0..2] = traslación X, Y, Z
+ *   r[0..3] = rotación X, Y, Z, W (quaternion DirectX)
+ *   s[0..2] = escala X, Y, Z
+ */
+struct LocalPose
+{
+    vector<float> t[3];
+    vector<float> r[4];
+    vector<float> s[3];
+
+    void Resize(size_t count)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            t[k].resize(count);
+            s[k].resize(count);
+        }
+        for (int k = 0; k < 4; k++)
+            r[k].resize(count);
+    }
+
+    size_t Size() const { return t[0].size(); }
+
+    D3DXVECTOR3 GetTranslation(size_t i) const { return D3DXVECTOR3(t[0][i], t[1][i], t[2][i]); }
+    D3DXQUATERNION GetRotation(size_t i) const { return D3DXQUATERNION(r[0][i], r[1][i], r[2][i], r[3][i]); }
+    D3DXVECTOR3 GetScale(size_t i) const { return D3DXVECTOR3(s[0][i], s[1][i], s[2][i]); }
+
+    void Set(size_t i, const D3DXVECTOR3& translation, const D3DXQUATERNION& rotation, const D3DXVECTOR3& scale)
+    {
+        t[0][i] = translation.x; t[1][i] = translation.y; t[2][i] = translation.z;
+        r[0][i] = rotation.x; r[1][i] = rotation.y; r[2][i] = rotation.z; r[3][i] = rotation.w;
+        s[0][i] = scale.x; s[1][i] = scale.y; s[2][i] = scale.z;
+    }
+};
+
+/**
+ * @struct PoseEvaluationCache
+ * @brief Estado por hilo de un PoseEvaluator
+ *
+ * Guarda la última key usada por cada canal (muestreo secuencial en O(1))
+ * y los buffers temporales de los lotes SSE. Un mismo PoseEvaluator se
+ * puede usar desde varios hilos, cada uno con su propia caché.
+ */
+struct PoseEvaluationCache
+{
+    vector<DWORD> cursors[3];          // Por canal (T, R, S), por hueso animado
+    vector<float> a[4], b[4], out[4];  // Keys vecinas y resultado (SoA)
+    vector<float> alpha;
+};
+
+/**
+ * @class PoseEvaluator
+ * @brief Muestrea un AnimationClip en cualquier tiempo a una pose local
+ *
+ * Los tracks del clip se convierten una vez a datos SoA por canal
+ * (tiempos y componentes contiguos por hueso). Cada evaluación:
+ *   1. Busca las keys vecinas de cada canal: primero la key de la
+ *      evaluación anterior (caché) y su siguiente, si no búsqueda binaria
+ *   2. Interpola 4 huesos por instrucción SSE: lerp para traslación y
+ *      escala, nlerp con corrección de t para rotación
+ *   3. Los canales sin keys toman el valor de la pose de reposo
+ *
+ * Los tiempos fuera del rango de keys mantienen la primera/última key.
+ */
+class PoseEvaluator
+{
+public:
+    PoseEvaluator();
+
+    /**
+     * Preparar el clip con un hueso por track (en el orden de clip.tracks)
+     * La pose de reposo es la identidad.
+     * @param clip Clip de animación
+     */
+    void Initialize(const AnimationClip& clip);
+
+    /**
+     * Preparar el clip para una lista de huesos dada
+     * @param clip Clip de animación
+     * @param boneNames Nombre de cada hueso de la pose de salida
+     * @param restPose Pose de reposo (mismo número de huesos que boneNames)
+     */
+    void Initialize(
+        const AnimationClip& clip,
+        const vector<string>& boneNames,
+        const LocalPose& restPose);
+
+    /**
+     * Evaluar la pose local en un tiempo
+     * @param time Tiempo en segundos
+     * @param cache Caché del hilo que evalúa
+     * @param pose [out] Pose local (BoneCount() huesos)
+     */
+    void Evaluate(double time, PoseEvaluationCache& cache, LocalPose& pose) const;
+
+    size_t BoneCount() const { return m_RestPose.Size(); }
+
+    // Canales con keys de un hueso (KEY_* combinados)
+    BYTE GetChannelMask(size_t bone) const { return m_ChannelMasks[bone]; }
+
+    // Tiempo de la última key de cualquier canal
+    double GetLastKeyTime() const { return m_LastKeyTime; }
+
+private:
+    // Keys de un tipo de canal para todos los huesos que lo tienen (SoA)
+    struct ChannelData
+    {
+        vector<DWORD> bones;           // Hueso de la pose de cada entrada
+        vector<DWORD> offsets;         // Primera key de cada entrada (bones.size() + 1)
+        vector<double> times;
+        vector<float> values[4];
+    };
+
+    ChannelData m_Channels[3];         // T, R, S
+    vector<BYTE> m_ChannelMasks;
+    LocalPose m_RestPose;
+    double m_LastKeyTime;
+
+    void Build(const AnimationClip& clip, const vector<int>& trackToBone);
+
+    // Buscar keys vecinas con caché del último índice
+    static void Bracket(
+        const double* times,
+        DWORD count,
+        double time,
+        DWORD& cursor,
+        DWORD& i0,
+        DWORD& i1,
+        float& alpha);
+};
+
+#endif // POSE_EVALUATOR_H
@@ -0,0 +1,727 @@
+#include "RuntimePackageWriter.h"
+#include "FBXExporter.h"
+#include "MatrixConverter.h"
+#include <cmath>
+#include <cstring>
+
+using namespace RuntimePackage;
+
+// ============================================================================
+// Helpers de conversión
+// ============================================================================
+
+// Matriz DirectX (LH) a RH (Z invertida) con escala global en la traslación
+// (igual que NativeFBXExporter y GLTFExporter)
+static D3DXMATRIX ConvertMatrix_LH_to_RH(const D3DXMATRIX& matrix, float scale)
+{
+    D3DXMATRIX result = matrix;
+    result.m[0][2] = -result.m[0][2];
+    result.m[1][2] = -result.m[1][2];
+    result.m[2][0] = -result.m[2][0];
+    result.m[2][1] = -result.m[2][1];
+    result.m[2][3] = -result.m[2][3];
+    result.m[3][2] = -result.m[3][2];
+
+    result.m[3][0] *= scale;
+    result.m[3][1] *= scale;
+    result.m[3][2] *= scale;
+    return result;
+}
+
+// Quaternion DirectX (LH) a RH: X e Y negadas, normalizado
+// (ver MatrixConverter::ConvertQuaternion_LH_to_RH)
+static void ConvertQuaternion_LH_to_RH(const D3DXQUATERNION& q, float* out)
+{
+    float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    float inverse = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+    out[0] = -q.x * inverse;
+    out[1] = -q.y * inverse;
+    out[2] = q.z * inverse;
+    out[3] = (length > 0.0f) ? q.w * inverse : 1.0f;
+}
+
+static BYTE ToUnorm8(float value)
+{
+    return (BYTE)(min(max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+RuntimePackageWriter::RuntimePackageWriter()
+{
+}
+
+// ============================================================================
+// Escritura Principal
+// ============================================================================
+
+bool RuntimePackageWriter::WritePackage(
+    const SceneData& sceneData,
+    const string& filename,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+    m_LastError.clear();
+    m_Blob.clear();
+    m_Strings.clear();
+    m_StringOffsets.clear();
+    m_NodeNames.clear();
+    m_NodeParents.clear();
+    m_NodeMatrices.clear();
+    m_NodeByName.clear();
+    m_Meshes.clear();
+    m_TrackData.clear();
+
+    if (!sceneData.rootFrame)
+    {
+        m_LastError = "No root frame in scene data";
+        return false;
+    }
+
+    if (m_Options.targetCoordSystem != CoordinateSystem::RIGHT_HANDED || m_Options.upAxis != UpAxis::Y_AXIS)
+        Utils::LogWarning("Runtime package is always right-handed Y-up; axis options ignored for " + filename);
+
+    Utils::Log("Writing runtime package: " + filename, options.verbose);
+
+    // La cabecera se completa al final; el offset 0 de strings es ""
+    Header header;
+    memset(&header, 0, sizeof(header));
+    m_Blob.resize(sizeof(Header));
+    m_Strings.push_back('\0');
+    m_StringOffsets[""] = 0;
+
+    CollectNodes(sceneData.rootFrame);
+    WriteNodes(header);
+    WriteMaterials(sceneData, filename, header);
+
+    vector<Mesh> meshes(m_Meshes.size());
+    for (size_t i = 0; i < m_Meshes.size(); i++)
+        WriteMesh(*m_Meshes[i].first, m_Meshes[i].second, meshes[i]);
+
+    vector<Clip> clips(sceneData.animations.size());
+    for (size_t i = 0; i < clips.size(); i++)
+        WriteClip(sceneData.animations[i], clips[i]);
+
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.headerSize = (uint16_t)sizeof(Header);
+    header.nodeCount = (uint32_t)m_NodeNames.size();
+    header.meshCount = (uint32_t)meshes.size();
+    header.clipCount = (uint32_t)clips.size();
+    header.meshes = Append(meshes.data(), meshes.size() * sizeof(Mesh));
+    header.clips = Append(clips.data(), clips.size() * sizeof(Clip));
+    header.strings = Append(m_Strings.data(), m_Strings.size());
+    header.stringsSize = m_Strings.size();
+
+    m_Blob.resize((m_Blob.size() + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1), 0);
+    header.fileSize = m_Blob.size();
+    memcpy(m_Blob.data(), &header, sizeof(header));
+
+    ofstream file(filename.c_str(), ios::binary | ios::out | ios::trunc);
+    if (!file.is_open())
+    {
+        m_LastError = "Cannot create file: " + filename;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(m_Blob.data()), (streamsize)m_Blob.size());
+    file.close();
+    if (file.fail())
+    {
+        m_LastError = "Error writing runtime package: " + filename;
+        return false;
+    }
+
+    if (options.verbose)
+    {
+        Utils::LogStream() << "  Package: " << header.nodeCount << " nodes, " << header.meshCount << " meshes, "
+                           << header.materialCount << " materials, " << header.clipCount << " clips, "
+                           << m_TrackData.size() << " unique tracks, " << m_Blob.size() << " bytes\n";
+    }
+
+    m_Blob.clear();
+    m_Blob.shrink_to_fit();
+    return true;
+}
+
+// ============================================================================
+// Nodos
+// ============================================================================
+// Frames en DFS y después los huesos sin frame como nodos raíz con su matriz
+// de enlace. Los meshes apuntan al nodo de su frame (sin nodo intermedio).
+// ============================================================================
+
+void RuntimePackageWriter::CollectNodes(const FrameData* root)
+{
+    vector<pair<const FrameData*, int32_t>> stack;
+    stack.push_back(make_pair(root, -1));
+
+    while (!stack.empty())
+    {
+        const FrameData* frame = stack.back().first;
+        const int32_t parent = stack.back().second;
+        stack.pop_back();
+
+        const uint32_t index = (uint32_t)m_NodeNames.size();
+        m_NodeNames.push_back(frame->name);
+        m_NodeParents.push_back(parent);
+        m_NodeMatrices.push_back(&frame->transformMatrix);
+        if (!frame->name.empty())
+            m_NodeByName[frame->name] = index;
+
+        for (const MeshData* mesh : frame->meshes)
+        {
+            if (mesh && !mesh->vertices.empty() && !mesh->indices.empty())
+                m_Meshes.push_back(make_pair(mesh, index));
+        }
+
+        for (size_t i = frame->children.size(); i-- > 0;)
+            stack.push_back(make_pair(frame->children[i], (int32_t)index));
+    }
+
+    for (const auto& entry : m_Meshes)
+    {
+        const MeshData* mesh = entry.first;
+        if (!mesh->hasSkinning)
+            continue;
+
+        for (const BoneData& bone : mesh->bones)
+        {
+            if (m_NodeByName.find(bone.name) != m_NodeByName.end())
+                continue;
+
+            m_NodeByName[bone.name] = (uint32_t)m_NodeNames.size();
+            m_NodeNames.push_back(bone.name);
+            m_NodeParents.push_back(-1);
+            m_NodeMatrices.push_back(&bone.transformMatrix);
+        }
+    }
+}
+
+void RuntimePackageWriter::WriteNodes(Header& header)
+{
+    const size_t nodeCount = m_NodeNames.size();
+    const float scale = m_Options.scale;
+
+    vector<D3DXMATRIX> locals(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++)
+        locals[i] = *m_NodeMatrices[i];
+
+    DecomposedTransforms trs;
+    MatrixConverter::DecomposeMatrices(locals.data(), nodeCount, trs);
+
+    vector<uint32_t> names(nodeCount);
+    vector<float> translations(nodeCount * 3);
+    vector<float> rotations(nodeCount * 4);
+    vector<float> scales(nodeCount * 3);
+
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        names[i] = AddString(m_NodeNames[i]);
+        translations[i * 3 + 0] = trs.translations[i].x * scale;
+        translations[i * 3 + 1] = trs.translations[i].y * scale;
+        translations[i * 3 + 2] = -trs.translations[i].z * scale;
+        ConvertQuaternion_LH_to_RH(trs.rotations[i], &rotations[i * 4]);
+        scales[i * 3 + 0] = trs.scales[i].x;
+        scales[i * 3 + 1] = trs.scales[i].y;
+        scales[i * 3 + 2] = trs.scales[i].z;
+    }
+
+    header.nodeParents = Append(m_NodeParents.data(), nodeCount * sizeof(int32_t));
+    header.nodeNames = Append(names.data(), nodeCount * sizeof(uint32_t));
+    header.nodeTranslations = Append(translations.data(), translations.size() * sizeof(float));
+    header.nodeRotations = Append(rotations.data(), rotations.size() * sizeof(float));
+    header.nodeScales = Append(scales.data(), scales.size() * sizeof(float));
+}
+
+// ============================================================================
+// Materiales
+// ============================================================================
+// D3DMATERIAL9 tal cual; la textura con la misma ruta que usa el glTF
+// (textures/<archivo> si se copian las texturas, si no la original).
+// ============================================================================
+
+void RuntimePackageWriter::WriteMaterials(const SceneData& sceneData, const string& filename, Header& header)
+{
+    vector<Material> materials(sceneData.materials.size());
+
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        const MaterialData& source = sceneData.materials[i];
+        const D3DMATERIAL9& m = source.material;
+        Material& material = materials[i];
+
+        material.name = AddString(source.name);
+        material.texture = NO_INDEX;
+        if (!source.textureFilename.empty())
+        {
+            string texture = source.textureFilename;
+            if (m_Options.exportTextures)
+            {
+                FBXExporter::CopyTexture(source.textureFilename, filename);
+
+                size_t slash = texture.find_last_of("\\/");
+                if (slash != string::npos)
+                    texture = texture.substr(slash + 1);
+                texture = "textures/" + texture;
+            }
+            material.texture = AddString(texture);
+        }
+
+        material.diffuse[0] = m.Diffuse.r;
+        material.diffuse[1] = m.Diffuse.g;
+        material.diffuse[2] = m.Diffuse.b;
+        material.diffuse[3] = m.Diffuse.a;
+        material.ambient[0] = m.Ambient.r;
+        material.ambient[1] = m.Ambient.g;
+        material.ambient[2] = m.Ambient.b;
+        material.specular[0] = m.Specular.r;
+        material.specular[1] = m.Specular.g;
+        material.specular[2] = m.Specular.b;
+        material.emissive[0] = m.Emissive.r;
+        material.emissive[1] = m.Emissive.g;
+        material.emissive[2] = m.Emissive.b;
+        material.power = m.Power;
+    }
+
+    header.materialCount = (uint32_t)materials.size();
+    header.materials = Append(materials.data(), materials.size() * sizeof(Material));
+}
+
+// ============================================================================
+// Meshes
+// ============================================================================
+// Streams separados (posiciones, normales, UVs, colores, skin), cada uno
+// alineado, para que el motor los suba a buffers de GPU sin reordenar.
+// ============================================================================
+
+void RuntimePackageWriter::WriteMesh(const MeshData& mesh, uint32_t node, Mesh& record)
+{
+    const vector<Vertex>& vertices = mesh.vertices;
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = mesh.indices.size() / 3;
+    const float scale = m_Options.scale;
+
+    memset(&record, 0, sizeof(record));
+    record.name = AddString(mesh.name);
+    record.node = node;
+    record.vertexCount = (uint32_t)vertexCount;
+    record.indexCount = (uint32_t)(triangleCount * 3);
+    record.streams = STREAM_NORMALS;
+
+    // Posiciones y normales (Z invertida, normales de longitud 1)
+    vector<float> positions(vertexCount * 3);
+    vector<float> normals(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        const D3DXVECTOR3& p = vertices[i].position;
+        positions[i * 3 + 0] = p.x * scale;
+        positions[i * 3 + 1] = p.y * scale;
+        positions[i * 3 + 2] = -p.z * scale;
+
+        const D3DXVECTOR3& n = vertices[i].normal;
+        float length = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+        float inverse = (length > 0.0f) ? 1.0f / length : 0.0f;
+        normals[i * 3 + 0] = n.x * inverse;
+        normals[i * 3 + 1] = (length > 0.0f) ? n.y * inverse : 1.0f;
+        normals[i * 3 + 2] = -n.z * inverse;
+    }
+    record.positions = Append(positions.data(), positions.size() * sizeof(float));
+    record.normals = Append(normals.data(), normals.size() * sizeof(float));
+
+    if (mesh.texCoordSetCount > 0)
+    {
+        vector<float> texCoords(vertexCount * 2);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            texCoords[i * 2 + 0] = vertices[i].texCoord.x;
+            texCoords[i * 2 + 1] = vertices[i].texCoord.y;
+        }
+        record.texCoords = Append(texCoords.data(), texCoords.size() * sizeof(float));
+        record.streams |= STREAM_TEXCOORDS;
+    }
+
+    if (mesh.hasVertexColors)
+    {
+        vector<BYTE> colors(vertexCount * 4);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const D3DXCOLOR& c = vertices[i].color;
+            colors[i * 4 + 0] = ToUnorm8(c.r);
+            colors[i * 4 + 1] = ToUnorm8(c.g);
+            colors[i * 4 + 2] = ToUnorm8(c.b);
+            colors[i * 4 + 3] = ToUnorm8(c.a);
+        }
+        record.colors = Append(colors.data(), colors.size());
+        record.streams |= STREAM_COLORS;
+    }
+
+    // Skin: 4 influencias por vértice, pesos unorm8 que suman 255
+    const size_t boneCount = mesh.bones.size();
+    if (mesh.hasSkinning && boneCount > 0)
+    {
+        record.boneCount = (uint32_t)boneCount;
+        record.boneIndexSize = (boneCount > 256) ? 2 : 1;
+        record.streams |= STREAM_SKIN;
+
+        vector<BYTE> boneIndices(vertexCount * 4 * record.boneIndexSize);
+        vector<BYTE> boneWeights(vertexCount * 4);
+
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const Vertex& vertex = vertices[i];
+
+            float total = 0.0f;
+            for (int k = 0; k < MAX_BONE_INFLUENCES; k++)
+            {
+                if (vertex.boneWeights[k] > 0.0f && vertex.boneIndices[k] < boneCount)
+                    total += vertex.boneWeights[k];
+            }
+
+            int sum = 0;
+            int largest = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                DWORD bone = 0;
+                int weight = 0;
+                if (k < MAX_BONE_INFLUENCES && total > 0.0f &&
+                    vertex.boneWeights[k] > 0.0f && vertex.boneIndices[k] < boneCount)
+                {
+                    bone = vertex.boneIndices[k];
+                    weight = (int)(vertex.boneWeights[k] / total * 255.0f + 0.5f);
+                }
+
+                if (record.boneIndexSize == 2)
+                {
+                    uint16_t wide = (uint16_t)bone;
+                    memcpy(&boneIndices[(i * 4 + k) * 2], &wide, sizeof(wide));
+                }
+                else
+                {
+                    boneIndices[i * 4 + k] = (BYTE)bone;
+                }
+
+                boneWeights[i * 4 + k] = (BYTE)weight;
+                sum += weight;
+                if (weight > boneWeights[i * 4 + largest])
+                    largest = k;
+            }
+
+            // El redondeo se corrige en la influencia mayor
+            if (sum > 0)
+                boneWeights[i * 4 + largest] = (BYTE)(boneWeights[i * 4 + largest] + 255 - sum);
+        }
+
+        record.boneIndices = Append(boneIndices.data(), boneIndices.size());
+        record.boneWeights = Append(boneWeights.data(), boneWeights.size());
+
+        vector<uint32_t> boneNodes(boneCount);
+        vector<float> inverseBind(boneCount * 16);
+        for (size_t b = 0; b < boneCount; b++)
+        {
+            boneNodes[b] = m_NodeByName[mesh.bones[b].name];
+
+            D3DXMATRIX offset = ConvertMatrix_LH_to_RH(mesh.bones[b].offsetMatrix, scale);
+            memcpy(&inverseBind[b * 16], &offset.m[0][0], 16 * sizeof(float));
+        }
+
+        record.boneNodes = Append(boneNodes.data(), boneNodes.size() * sizeof(uint32_t));
+        record.inverseBindMatrices = Append(inverseBind.data(), inverseBind.size() * sizeof(float));
+    }
+
+    // Índices: triángulos ordenados por material (counting sort), mismo
+    // winding que el original
+    const size_t groupCount = mesh.materials.size();
+    const bool split = groupCount > 1 && mesh.materialIndices.size() == triangleCount;
+
+    vector<Submesh> submeshes;
+    vector<DWORD> sorted;
+    const DWORD* indices = mesh.indices.data();
+
+    if (!split)
+    {
+        Submesh submesh;
+        submesh.firstIndex = 0;
+        submesh.indexCount = record.indexCount;
+        submesh.material = (groupCount > 0) ? mesh.materials[0] : NO_INDEX;
+        submesh.reserved = 0;
+        submeshes.push_back(submesh);
+    }
+    else
+    {
+        vector<size_t> groupStart(groupCount + 1, 0);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            DWORD group = mesh.materialIndices[t] < groupCount ? mesh.materialIndices[t] : 0;
+            groupStart[group + 1]++;
+        }
+        for (size_t g = 0; g < groupCount; g++)
+            groupStart[g + 1] += groupStart[g];
+
+        sorted.resize(triangleCount * 3);
+        vector<size_t> cursor(groupStart.begin(), groupStart.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            DWORD group = mesh.materialIndices[t] < groupCount ? mesh.materialIndices[t] : 0;
+            memcpy(&sorted[cursor[group]++ * 3], &mesh.indices[t * 3], 3 * sizeof(DWORD));
+        }
+        indices = sorted.data();
+
+        for (size_t g = 0; g < groupCount; g++)
+        {
+            const size_t count = groupStart[g + 1] - groupStart[g];
+            if (count == 0)
+                continue;
+
+            Submesh submesh;
+            submesh.firstIndex = (uint32_t)(groupStart[g] * 3);
+            submesh.indexCount = (uint32_t)(count * 3);
+            submesh.material = mesh.materials[g];
+            submesh.reserved = 0;
+            submeshes.push_back(submesh);
+        }
+    }
+
+    if (vertexCount <= 65536)
+    {
+        vector<uint16_t> narrow(triangleCount * 3);
+        for (size_t i = 0; i < narrow.size(); i++)
+            narrow[i] = (uint16_t)indices[i];
+
+        record.indexSize = 2;
+        record.indices = Append(narrow.data(), narrow.size() * sizeof(uint16_t));
+    }
+    else
+    {
+        record.indexSize = 4;
+        record.indices = Append(indices, triangleCount * 3 * sizeof(DWORD));
+    }
+
+    record.submeshCount = (uint32_t)submeshes.size();
+    record.submeshes = Append(submeshes.data(), submeshes.size() * sizeof(Submesh));
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// Un track por canal (T, R, S) con keys. Los canales sin keys no se
+// escriben: el motor usa la pose de reposo del nodo.
+// ============================================================================
+
+void RuntimePackageWriter::WriteClip(const AnimationClip& clip, Clip& record)
+{
+    vector<Track> tracks;
+
+    for (const AnimationTrack& track : clip.tracks)
+    {
+        auto node = m_NodeByName.find(track.boneName);
+        if (node == m_NodeByName.end() || track.GetKeys().empty())
+            continue;
+
+        // Datos compartidos entre tracks con el mismo array de keys
+        // (ver AnimationOptimizer::ShareDuplicateTracks)
+        auto it = m_TrackData.find(track.keyData.get());
+        if (it == m_TrackData.end())
+        {
+            TrackData data;
+            WriteTrackData(track, data);
+            it = m_TrackData.insert(make_pair(track.keyData.get(), data)).first;
+        }
+
+        for (int c = 0; c < 3; c++)
+        {
+            if (!it->second.present[c])
+                continue;
+
+            Track channel = it->second.channels[c];
+            channel.node = node->second;
+            tracks.push_back(channel);
+        }
+    }
+
+    record.name = AddString(clip.name);
+    record.trackCount = (uint32_t)tracks.size();
+    record.duration = (float)clip.duration;
+    record.sampleRate = (float)m_Options.targetFPS;
+    record.tracks = Append(tracks.data(), tracks.size() * sizeof(Track));
+}
+
+void RuntimePackageWriter::WriteTrackData(const AnimationTrack& track, TrackData& data)
+{
+    static const int components[3] = { 3, 4, 3 };
+
+    const vector<AnimationKey>& keys = track.GetKeys();
+    const float scale = m_Options.scale;
+    const double sampleRate = m_Options.targetFPS;
+
+    // Error de cuantización admitido: la mitad de la tolerancia de la
+    // reducción de keys (la otra mitad ya la usó la reducción)
+    const float rotationTolerance = m_Options.keyRotationTolerance * (float)(D3DX_PI / 180.0);
+    const float tolerances[3] =
+    {
+        m_Options.keyPositionTolerance * scale * 0.5f,
+        rotationTolerance * 0.5f,
+        m_Options.keyScaleTolerance * 0.5f
+    };
+
+    vector<float> times[3];
+    vector<float> values[3];
+
+    for (const AnimationKey& key : keys)
+    {
+        if (key.channels & KEY_TRANSLATION)
+        {
+            times[0].push_back((float)key.time);
+            values[0].push_back(key.translation.x * scale);
+            values[0].push_back(key.translation.y * scale);
+            values[0].push_back(-key.translation.z * scale);
+        }
+
+        if (key.channels & KEY_ROTATION)
+        {
+            float q[4];
+            ConvertQuaternion_LH_to_RH(key.rotation, q);
+
+            // Mismo hemisferio que la key anterior (camino más corto)
+            vector<float>& rotations = values[1];
+            if (!rotations.empty())
+            {
+                const float* previous = &rotations[rotations.size() - 4];
+                if (q[0] * previous[0] + q[1] * previous[1] + q[2] * previous[2] + q[3] * previous[3] < 0.0f)
+                {
+                    for (int k = 0; k < 4; k++)
+                        q[k] = -q[k];
+                }
+            }
+
+            times[1].push_back((float)key.time);
+            rotations.insert(rotations.end(), q, q + 4);
+        }
+
+        if (key.channels & KEY_SCALE)
+        {
+            times[2].push_back((float)key.time);
+            values[2].push_back(key.scale.x);
+            values[2].push_back(key.scale.y);
+            values[2].push_back(key.scale.z);
+        }
+    }
+
+    for (int c = 0; c < 3; c++)
+    {
+        Track& channel = data.channels[c];
+        memset(&channel, 0, sizeof(channel));
+
+        const size_t count = times[c].size();
+        data.present[c] = count > 0;
+        if (count == 0)
+            continue;
+
+        const int componentCount = components[c];
+        channel.channel = (uint16_t)c;
+        channel.keyCount = (uint32_t)count;
+        channel.components = (uint32_t)componentCount;
+
+        // Tiempos: frames de 16 bits si todas las keys caen en la rejilla
+        bool onGrid = sampleRate > 0.0;
+        vector<uint16_t> frames(count);
+        for (size_t i = 0; i < count && onGrid; i++)
+        {
+            double frame = times[c][i] * sampleRate;
+            double rounded = floor(frame + 0.5);
+            onGrid = rounded >= 0.0 && rounded <= 65535.0 && fabs(frame - rounded) < 1e-3;
+            frames[i] = (uint16_t)rounded;
+        }
+
+        if (onGrid)
+        {
+            channel.timeFormat = TIME_FRAME16;
+            channel.times = Append(frames.data(), count * sizeof(uint16_t));
+        }
+        else
+        {
+            channel.timeFormat = TIME_FLOAT32;
+            channel.times = Append(times[c].data(), count * sizeof(float));
+        }
+
+        // Valores: unorm16 sobre el rango de cada componente
+        const float* source = values[c].data();
+        float rangeMax[4];
+        for (int k = 0; k < componentCount; k++)
+        {
+            channel.rangeMin[k] = FLT_MAX;
+            rangeMax[k] = -FLT_MAX;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < componentCount; k++)
+            {
+                channel.rangeMin[k] = min(channel.rangeMin[k], source[i * componentCount + k]);
+                rangeMax[k] = max(rangeMax[k], source[i * componentCount + k]);
+            }
+        }
+
+        // Error máximo: medio paso de cuantización (en rotación, el ángulo
+        // es como mucho 2 * |dq|)
+        float error = 0.0f;
+        for (int k = 0; k < componentCount; k++)
+        {
+            channel.rangeExtent[k] = rangeMax[k] - channel.rangeMin[k];
+            float step = channel.rangeExtent[k] / 65535.0f * 0.5f;
+            error = (c == 1) ? error + step * step : max(error, step);
+        }
+        if (c == 1)
+            error = 2.0f * sqrtf(error);
+
+        if (error <= tolerances[c])
+        {
+            vector<uint16_t> quantized(count * componentCount);
+            for (size_t i = 0; i < quantized.size(); i++)
+            {
+                const int k = (int)(i % componentCount);
+                const float extent = channel.rangeExtent[k];
+                float normalized = (extent > 0.0f) ? (source[i] - channel.rangeMin[k]) / extent : 0.0f;
+                quantized[i] = (uint16_t)(min(max(normalized, 0.0f), 1.0f) * 65535.0f + 0.5f);
+            }
+
+            channel.valueFormat = VALUE_UNORM16;
+            channel.values = Append(quantized.data(), quantized.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            channel.valueFormat = VALUE_FLOAT32;
+            channel.values = Append(source, count * componentCount * sizeof(float));
+        }
+    }
+}
+
+// ============================================================================
+// Blob y Strings
+// ============================================================================
+
+uint64_t RuntimePackageWriter::Append(const void* data, size_t size)
+{
+    if (size == 0)
+        return 0;
+
+    const size_t offset = (m_Blob.size() + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+    m_Blob.resize(offset + size, 0);
+    memcpy(m_Blob.data() + offset, data, size);
+    return offset;
+}
+
+uint32_t RuntimePackageWriter::AddString(const string& value)
+{
+    auto it = m_StringOffsets.find(value);
+    if (it != m_StringOffsets.end())
+        return it->second;
+
+    const uint32_t offset = (uint32_t)m_Strings.size();
+    m_Strings.insert(m_Strings.end(), value.begin(), value.end());
+    m_Strings.push_back('\0');
+    m_StringOffsets[value] = offset;
+    return offset;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef RUNTIME_PACKAGE_WRITER_H
+#define RUNTIME_PACKAGE_WRITER_H
+
+#include "../include/Common.h"
+#include "../include/RuntimePackage.h"
+
+/**
+ * @class RuntimePackageWriter
+ * @brief Escribe SceneData como paquete de runtime (.xpkg, ver RuntimePackage.h)
+ *
+ * Mismo espacio que el FBX/glTF exportado (Right-Handed, Y-Up, Z invertida,
+ * escala global). UVs sin invertir, como en glTF.
+ *
+ *   Frame               -> nodo (pose de reposo en TRS, arrays SoA)
+ *   MeshData            -> mesh del nodo de su frame; índices de 16 bits si
+ *                          hay como mucho 65536 vértices, triángulos
+ *                          ordenados por material (un submesh por material)
+ *   BoneData            -> nodo + matriz inversa de enlace (offsetMatrix);
+ *                          los huesos sin frame son nodos raíz
+ *   AnimationClip       -> clip con un track por canal con keys
+ *
+ * Los tracks se comprimen: tiempos como frames de 16 bits cuando caen en
+ * la rejilla del FPS objetivo y valores cuantizados a 16 bits por
+ * componente (sobre el rango del canal) si el error de cuantización cabe
+ * en la mitad de las tolerancias de la reducción de keys; si no, float.
+ * Los tracks con el mismo array de keys comparten los datos.
+ */
+class RuntimePackageWriter
+{
+public:
+    RuntimePackageWriter();
+
+    /**
+     * Escribir la escena completa a un paquete .xpkg
+     * @param sceneData Datos de la escena (con animaciones)
+     * @param filename Archivo de salida
+     * @param options Opciones de conversión (escala, FPS, tolerancias, texturas)
+     * @return true si se escribió exitosamente
+     */
+    bool WritePackage(
+        const SceneData& sceneData,
+        const string& filename,
+        const ConversionOptions& options);
+
+    /**
+     * Obtener último mensaje de error
+     * @return Mensaje de error
+     */
+    string GetLastError() const { return m_LastError; }
+
+private:
+    // Datos de un track ya escritos (sin nodo), compartidos entre clips
+    struct TrackData
+    {
+        RuntimePackage::Track channels[3];
+        bool present[3];
+    };
+
+    ConversionOptions m_Options;
+    string m_LastError;
+
+    vector<BYTE> m_Blob;
+    vector<char> m_Strings;
+    map<string, uint32_t> m_StringOffsets;
+
+    // Nodos en DFS (padres antes que hijos)
+    vector<string> m_NodeNames;
+    vector<int32_t> m_NodeParents;
+    vector<const D3DXMATRIX*> m_NodeMatrices;
+    map<string, uint32_t> m_NodeByName;
+    vector<pair<const MeshData*, uint32_t>> m_Meshes;
+
+    map<const vector<AnimationKey>*, TrackData> m_TrackData;
+
+    void CollectNodes(const FrameData* root);
+    void WriteNodes(RuntimePackage::Header& header);
+    void WriteMaterials(const SceneData& sceneData, const string& filename, RuntimePackage::Header& header);
+    void WriteMesh(const MeshData& mesh, uint32_t node, RuntimePackage::Mesh& record);
+    void WriteClip(const AnimationClip& clip, RuntimePackage::Clip& record);
+    void WriteTrackData(const AnimationTrack& track, TrackData& data);
+
+    // Array alineado a RuntimePackage::ALIGNMENT (offset desde el inicio)
+    uint64_t Append(const void* data, size_t size);
+
+    // Offset del string en la tabla (los repetidos se comparten)
+    uint32_t AddString(const string& value);
+};
+
+#endif // RUNTIME_PACKAGE_WRITER_H
@@ -0,0 +1,492 @@
+#include "SceneVerifier.h"
+#include "AnimationResampler.h"
+#include "MatrixConverter.h"
+#include "PoseEvaluator.h"
+#include <cmath>
+
+// Errores guardados en el reporte (el resto solo se cuentan)
+static const size_t MAX_REPORTED_ERRORS = 16;
+
+// Geometría: error relativo a (1 + |valor|) (float y escala global)
+static const double GEOMETRY_TOLERANCE = 1e-4;
+
+// Transformaciones: margen sobre las tolerancias de keys (Euler en float)
+static const double TRANSLATION_EPSILON = 1e-4;
+static const double ROTATION_EPSILON = 0.01;       // Grados
+static const double SCALE_EPSILON = 1e-4;
+
+static const double RADIANS_TO_DEGREES = 57.29577951308232;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void CollectFrames(const FrameData* frame, vector<const FrameData*>& out)
+{
+    if (!frame)
+        return;
+
+    out.push_back(frame);
+    for (const FrameData* child : frame->children)
+        CollectFrames(child, out);
+}
+
+// Meshes en el orden en que los escribe NativeFBXExporter (DFS de frames)
+static void CollectMeshes(const FrameData* root, vector<const MeshData*>& out)
+{
+    vector<const FrameData*> frames;
+    CollectFrames(root, frames);
+
+    for (const FrameData* frame : frames)
+    {
+        for (const MeshData* mesh : frame->meshes)
+        {
+            if (mesh && !mesh->vertices.empty())
+                out.push_back(mesh);
+        }
+    }
+}
+
+static map<string, const FrameData*> MapFramesByName(const FrameData* root)
+{
+    vector<const FrameData*> frames;
+    CollectFrames(root, frames);
+
+    map<string, const FrameData*> result;
+    for (const FrameData* frame : frames)
+    {
+        if (!frame->name.empty())
+            result.insert(make_pair(frame->name, frame));
+    }
+    return result;
+}
+
+static double RelativeError(const float* a, const float* b, int count)
+{
+    double error = 0.0;
+    for (int i = 0; i < count; i++)
+        error = max(error, fabs((double)a[i] - b[i]) / (1.0 + fabs((double)a[i])));
+    return error;
+}
+
+static double AbsoluteError(const float* a, const float* b, int count)
+{
+    double error = 0.0;
+    for (int i = 0; i < count; i++)
+        error = max(error, fabs((double)a[i] - b[i]));
+    return error;
+}
+
+// Ángulo entre dos rotaciones (grados), sin importar el signo del quaternion
+static double RotationError(const D3DXQUATERNION& a, const D3DXQUATERNION& b)
+{
+    double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z + (double)a.w * b.w;
+    double lengths = sqrt(((double)a.x * a.x + (double)a.y * a.y + (double)a.z * a.z + (double)a.w * a.w) *
+                          ((double)b.x * b.x + (double)b.y * b.y + (double)b.z * b.z + (double)b.w * b.w));
+    if (lengths <= 0.0)
+        return 0.0;
+
+    return 2.0 * acos(min(1.0, fabs(dot) / lengths)) * RADIANS_TO_DEGREES;
+}
+
+static string FormatVector(const D3DXVECTOR3& v)
+{
+    ostringstream text;
+    text << "(" << v.x << ", " << v.y << ", " << v.z << ")";
+    return text.str();
+}
+
+// ============================================================================
+// Verificación
+// ============================================================================
+
+bool SceneVerifier::Verify(
+    const SceneData& source,
+    const AnimationClip* clip,
+    bool includeMeshes,
+    const SceneData& loaded,
+    const ConversionOptions& options,
+    VerificationReport& report)
+{
+    report = VerificationReport();
+
+    if (!source.rootFrame || !loaded.rootFrame)
+    {
+        AddError(report, "No root frame to compare");
+        return false;
+    }
+
+    VerifyHierarchy(source, loaded, report);
+
+    if (includeMeshes)
+        VerifyMeshes(source, loaded, report);
+
+    if (clip)
+        VerifyAnimation(source, *clip, loaded, options, report);
+
+    return report.errorCount == 0;
+}
+
+void SceneVerifier::AddError(VerificationReport& report, const string& message)
+{
+    if (report.errors.size() < MAX_REPORTED_ERRORS)
+        report.errors.push_back(message);
+    report.errorCount++;
+}
+
+// ============================================================================
+// Jerarquía
+// ============================================================================
+
+void SceneVerifier::VerifyHierarchy(
+    const SceneData& source,
+    const SceneData& loaded,
+    VerificationReport& report)
+{
+    vector<const FrameData*> sourceFrames;
+    CollectFrames(source.rootFrame, sourceFrames);
+    map<string, const FrameData*> loadedFrames = MapFramesByName(loaded.rootFrame);
+
+    vector<D3DXMATRIX> sourceLocals, loadedLocals;
+    vector<const FrameData*> matched;
+
+    for (const FrameData* frame : sourceFrames)
+    {
+        if (frame->name.empty())
+            continue;
+
+        auto it = loadedFrames.find(frame->name);
+        if (it == loadedFrames.end())
+        {
+            AddError(report, "Missing node: " + frame->name);
+            continue;
+        }
+
+        const FrameData* loadedFrame = it->second;
+        const string sourceParent = frame->parent ? frame->parent->name : string();
+        const string loadedParent = loadedFrame->parent ? loadedFrame->parent->name : string();
+        if (sourceParent != loadedParent)
+            AddError(report, "Node " + frame->name + ": parent " + loadedParent + " instead of " + sourceParent);
+
+        sourceLocals.push_back(frame->transformMatrix);
+        loadedLocals.push_back(loadedFrame->transformMatrix);
+        matched.push_back(frame);
+    }
+
+    report.frameCount = matched.size();
+
+    // Transformación local en TRS (la matriz puede diferir en el signo de
+    // la rotación o en el reparto de un espejo)
+    DecomposedTransforms sourceTRS, loadedTRS;
+    MatrixConverter::DecomposeMatrices(sourceLocals.data(), sourceLocals.size(), sourceTRS);
+    MatrixConverter::DecomposeMatrices(loadedLocals.data(), loadedLocals.size(), loadedTRS);
+
+    for (size_t i = 0; i < matched.size(); i++)
+    {
+        const D3DXVECTOR3& t = sourceTRS.translations[i];
+        double translationError = RelativeError(&t.x, &loadedTRS.translations[i].x, 3);
+        double rotationError = RotationError(sourceTRS.rotations[i], loadedTRS.rotations[i]);
+        double scaleError = AbsoluteError(&sourceTRS.scales[i].x, &loadedTRS.scales[i].x, 3);
+
+        report.maxTranslationError = max(report.maxTranslationError, translationError);
+        report.maxRotationError = max(report.maxRotationError, rotationError);
+        report.maxScaleError = max(report.maxScaleError, scaleError);
+
+        if (translationError > TRANSLATION_EPSILON || rotationError > ROTATION_EPSILON || scaleError > SCALE_EPSILON)
+        {
+            ostringstream message;
+            message << "Node " << matched[i]->name << ": local transform differs (T "
+                    << FormatVector(t) << " -> " << FormatVector(loadedTRS.translations[i])
+                    << ", rotation " << rotationError << " deg, scale error " << scaleError << ")";
+            AddError(report, message.str());
+        }
+    }
+}
+
+// ============================================================================
+// Meshes
+// ============================================================================
+
+void SceneVerifier::VerifyMeshes(
+    const SceneData& source,
+    const SceneData& loaded,
+    VerificationReport& report)
+{
+    vector<const MeshData*> sourceMeshes, loadedMeshes;
+    CollectMeshes(source.rootFrame, sourceMeshes);
+    CollectMeshes(loaded.rootFrame, loadedMeshes);
+
+    if (sourceMeshes.size() != loadedMeshes.size())
+    {
+        AddError(report, "Mesh count " + std::to_string(loadedMeshes.size()) +
+                         " instead of " + std::to_string(sourceMeshes.size()));
+    }
+
+    const size_t count = min(sourceMeshes.size(), loadedMeshes.size());
+    for (size_t i = 0; i < count; i++)
+        VerifyMesh(*sourceMeshes[i], *loadedMeshes[i], report);
+
+    report.meshCount = count;
+}
+
+void SceneVerifier::VerifyMesh(
+    const MeshData& source,
+    const MeshData& loaded,
+    VerificationReport& report)
+{
+    const string prefix = "Mesh " + source.name + ": ";
+
+    if (source.name != loaded.name)
+        AddError(report, prefix + "loaded as " + loaded.name);
+
+    if (source.vertices.size() != loaded.vertices.size())
+    {
+        AddError(report, prefix + std::to_string(loaded.vertices.size()) + " vertices instead of " +
+                         std::to_string(source.vertices.size()));
+        return;
+    }
+
+    if (source.indices != loaded.indices)
+        AddError(report, prefix + "triangle indices differ");
+
+    // Material por triángulo (solo si el original tenía uno por triángulo)
+    if (source.materialIndices.size() == source.indices.size() / 3 && source.materialIndices != loaded.materialIndices)
+        AddError(report, prefix + "triangle materials differ");
+
+    if (source.materials.size() != loaded.materials.size())
+        AddError(report, prefix + "material count differs");
+
+    // El set de UV 0 siempre se escribe
+    const DWORD texCoordSets = max(source.texCoordSetCount, (DWORD)1);
+    if (loaded.texCoordSetCount < texCoordSets)
+        AddError(report, prefix + "missing UV sets");
+
+    const bool compareColors = source.hasVertexColors;
+    if (compareColors && !loaded.hasVertexColors)
+        AddError(report, prefix + "missing vertex colors");
+
+    const bool compareWeights = source.hasSkinning && !source.bones.empty();
+    if (compareWeights && !loaded.hasSkinning)
+        AddError(report, prefix + "missing skin");
+
+    // Un mensaje por categoría (el primer vértice fuera de tolerancia)
+    bool positionFailed = false, normalFailed = false, texCoordFailed = false;
+    bool colorFailed = false, weightFailed = false;
+
+    for (size_t i = 0; i < source.vertices.size(); i++)
+    {
+        const Vertex& a = source.vertices[i];
+        const Vertex& b = loaded.vertices[i];
+
+        double positionError = RelativeError(&a.position.x, &b.position.x, 3);
+        double normalError = AbsoluteError(&a.normal.x, &b.normal.x, 3);
+
+        double texCoordError = AbsoluteError(&a.texCoord.x, &b.texCoord.x, 2);
+        for (DWORD set = 1; set < min(texCoordSets, loaded.texCoordSetCount); set++)
+        {
+            texCoordError = max(texCoordError,
+                AbsoluteError(&a.extraTexCoords[set - 1].x, &b.extraTexCoords[set - 1].x, 2));
+        }
+
+        report.maxPositionError = max(report.maxPositionError, positionError);
+        report.maxNormalError = max(report.maxNormalError, normalError);
+        report.maxTexCoordError = max(report.maxTexCoordError, texCoordError);
+
+        if (positionError > GEOMETRY_TOLERANCE && !positionFailed)
+        {
+            AddError(report, prefix + "vertex " + std::to_string(i) + " position " +
+                             FormatVector(b.position) + " instead of " + FormatVector(a.position));
+            positionFailed = true;
+        }
+        if (normalError > GEOMETRY_TOLERANCE && !normalFailed)
+        {
+            AddError(report, prefix + "vertex " + std::to_string(i) + " normal " +
+                             FormatVector(b.normal) + " instead of " + FormatVector(a.normal));
+            normalFailed = true;
+        }
+        if (texCoordError > GEOMETRY_TOLERANCE && !texCoordFailed)
+        {
+            AddError(report, prefix + "vertex " + std::to_string(i) + " UV differs");
+            texCoordFailed = true;
+        }
+
+        if (compareColors && loaded.hasVertexColors)
+        {
+            double colorError = AbsoluteError(&a.color.r, &b.color.r, 4);
+            report.maxColorError = max(report.maxColorError, colorError);
+
+            if (colorError > GEOMETRY_TOLERANCE && !colorFailed)
+            {
+                AddError(report, prefix + "vertex " + std::to_string(i) + " color differs");
+                colorFailed = true;
+            }
+        }
+
+        // Pesos: misma influencia por nombre de hueso (los índices pueden
+        // cambiar si hay clusters sin hueso)
+        if (compareWeights && loaded.hasSkinning)
+        {
+            for (int k = 0; k < MAX_BONE_INFLUENCES; k++)
+            {
+                if (a.boneWeights[k] <= 0.0f || a.boneIndices[k] >= source.bones.size())
+                    continue;
+
+                const string& boneName = source.bones[a.boneIndices[k]].name;
+                double weightError = a.boneWeights[k];
+
+                for (int j = 0; j < MAX_BONE_INFLUENCES; j++)
+                {
+                    if (b.boneWeights[j] > 0.0f && b.boneIndices[j] < loaded.bones.size() &&
+                        loaded.bones[b.boneIndices[j]].name == boneName)
+                    {
+                        weightError = fabs((double)a.boneWeights[k] - b.boneWeights[j]);
+                        break;
+                    }
+                }
+
+                report.maxWeightError = max(report.maxWeightError, weightError);
+
+                if (weightError > GEOMETRY_TOLERANCE && !weightFailed)
+                {
+                    AddError(report, prefix + "vertex " + std::to_string(i) + " weight of bone " + boneName + " differs");
+                    weightFailed = true;
+                }
+            }
+        }
+    }
+
+    report.vertexCount += source.vertices.size();
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// Las dos escenas se evalúan con PoseEvaluator (lerp/nlerp entre keys) con
+// su propia pose de reposo para los canales sin keys, en los tiempos de la
+// rejilla del FPS objetivo (los de AnimationResampler).
+// ============================================================================
+
+void SceneVerifier::VerifyAnimation(
+    const SceneData& source,
+    const AnimationClip& clip,
+    const SceneData& loaded,
+    const ConversionOptions& options,
+    VerificationReport& report)
+{
+    const AnimationClip* loadedClip = nullptr;
+    for (const AnimationClip& candidate : loaded.animations)
+    {
+        if (candidate.name == clip.name)
+            loadedClip = &candidate;
+    }
+    if (!loadedClip && loaded.animations.size() == 1)
+        loadedClip = &loaded.animations[0];
+
+    if (!loadedClip)
+    {
+        AddError(report, "Missing animation: " + clip.name);
+        return;
+    }
+
+    // Solo los tiempos exactos en KTime se conservan
+    if (fabs(loadedClip->duration - clip.duration) > 1e-6)
+    {
+        ostringstream message;
+        message << "Animation " << clip.name << ": duration " << loadedClip->duration
+                << " instead of " << clip.duration;
+        AddError(report, message.str());
+    }
+
+    // Huesos presentes en las dos jerarquías, con su pose de reposo
+    map<string, const FrameData*> sourceFrames = MapFramesByName(source.rootFrame);
+    map<string, const FrameData*> loadedFrames = MapFramesByName(loaded.rootFrame);
+
+    vector<string> boneNames;
+    vector<D3DXMATRIX> sourceLocals, loadedLocals;
+    for (const auto& entry : sourceFrames)
+    {
+        auto it = loadedFrames.find(entry.first);
+        if (it == loadedFrames.end())
+            continue;
+
+        boneNames.push_back(entry.first);
+        sourceLocals.push_back(entry.second->transformMatrix);
+        loadedLocals.push_back(it->second->transformMatrix);
+    }
+
+    const size_t boneCount = boneNames.size();
+    if (boneCount == 0)
+        return;
+
+    LocalPose sourceRest, loadedRest;
+    DecomposedTransforms trs;
+    sourceRest.Resize(boneCount);
+    loadedRest.Resize(boneCount);
+
+    MatrixConverter::DecomposeMatrices(sourceLocals.data(), boneCount, trs);
+    for (size_t i = 0; i < boneCount; i++)
+        sourceRest.Set(i, trs.translations[i], trs.rotations[i], trs.scales[i]);
+
+    MatrixConverter::DecomposeMatrices(loadedLocals.data(), boneCount, trs);
+    for (size_t i = 0; i < boneCount; i++)
+        loadedRest.Set(i, trs.translations[i], trs.rotations[i], trs.scales[i]);
+
+    PoseEvaluator sourceEvaluator, loadedEvaluator;
+    sourceEvaluator.Initialize(clip, boneNames, sourceRest);
+    loadedEvaluator.Initialize(*loadedClip, boneNames, loadedRest);
+
+    // Con --fit-curves la tolerancia de traslación es en unidades del FBX
+    const double positionTolerance = options.fitCurves && options.scale != 0.0f
+        ? options.keyPositionTolerance / fabs(options.scale) : options.keyPositionTolerance;
+    const double translationTolerance = 2.0 * positionTolerance;
+    const double rotationTolerance = 2.0 * options.keyRotationTolerance + ROTATION_EPSILON;
+    const double scaleTolerance = 2.0 * options.keyScaleTolerance + SCALE_EPSILON;
+
+    const double fps = options.targetFPS > 0.0 ? options.targetFPS : clip.ticksPerSecond;
+    const size_t frameCount = AnimationResampler::GetFrameCount(clip.duration, fps);
+
+    PoseEvaluationCache sourceCache, loadedCache;
+    LocalPose sourcePose, loadedPose;
+    vector<char> boneFailed(boneCount, 0);
+
+    for (size_t f = 0; f < frameCount; f++)
+    {
+        const double time = min((double)f / fps, clip.duration);
+        sourceEvaluator.Evaluate(time, sourceCache, sourcePose);
+        loadedEvaluator.Evaluate(time, loadedCache, loadedPose);
+
+        for (size_t i = 0; i < boneCount; i++)
+        {
+            D3DXVECTOR3 t = sourcePose.GetTranslation(i);
+            D3DXVECTOR3 loadedT = loadedPose.GetTranslation(i);
+            D3DXVECTOR3 s = sourcePose.GetScale(i);
+            D3DXVECTOR3 loadedS = loadedPose.GetScale(i);
+
+            double translationError = AbsoluteError(&t.x, &loadedT.x, 3);
+            double rotationError = RotationError(sourcePose.GetRotation(i), loadedPose.GetRotation(i));
+            double scaleError = AbsoluteError(&s.x, &loadedS.x, 3);
+
+            report.maxTranslationError = max(report.maxTranslationError, translationError);
+            report.maxRotationError = max(report.maxRotationError, rotationError);
+            report.maxScaleError = max(report.maxScaleError, scaleError);
+
+            const double magnitude = max(fabs(t.x), max(fabs(t.y), fabs(t.z)));
+            bool failed = translationError > translationTolerance + TRANSLATION_EPSILON * (1.0 + magnitude) ||
+                          rotationError > rotationTolerance ||
+                          scaleError > scaleTolerance;
+
+            // Un mensaje por hueso (el primer frame fuera de tolerancia)
+            if (failed && !boneFailed[i])
+            {
+                ostringstream message;
+                message << "Animation " << clip.name << ", bone " << boneNames[i] << " at " << time
+                        << "s: translation error " << translationError << ", rotation " << rotationError
+                        << " deg, scale error " << scaleError;
+                AddError(report, message.str());
+                boneFailed[i] = 1;
+            }
+        }
+    }
+
+    report.sampleCount += frameCount * boneCount;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#ifndef SCENE_VERIFIER_H
+#define SCENE_VERIFIER_H
+
+#include "../include/Common.h"
+
+/**
+ * @struct VerificationReport
+ * @brief Resultado de comparar una escena exportada con la original
+ *
+ * Los errores máximos están en el espacio de DirectX (unidades del .X):
+ * posiciones relativas a (1 + |p|), rotaciones en grados.
+ */
+struct VerificationReport
+{
+    size_t frameCount;                 // Nodos comparados
+    size_t meshCount;
+    size_t vertexCount;
+    size_t sampleCount;                // Poses comparadas (frames * huesos)
+
+    double maxPositionError;
+    double maxNormalError;
+    double maxTexCoordError;
+    double maxColorError;
+    double maxWeightError;
+    double maxTranslationError;
+    double maxRotationError;           // Grados
+    double maxScaleError;
+
+    size_t errorCount;
+    vector<string> errors;             // Los primeros errores encontrados
+
+    VerificationReport()
+    {
+        frameCount = meshCount = vertexCount = sampleCount = 0;
+        maxPositionError = maxNormalError = maxTexCoordError = maxColorError = maxWeightError = 0.0;
+        maxTranslationError = maxRotationError = maxScaleError = 0.0;
+        errorCount = 0;
+    }
+};
+
+/**
+ * @class SceneVerifier
+ * @brief Compara una escena recargada (NativeFBXImporter) con la original
+ *
+ *   - Jerarquía: cada nodo con nombre existe, con el mismo padre y la misma
+ *     transformación local (TRS)
+ *   - Meshes (en el orden de exportación): número de vértices, índices
+ *     exactos, posiciones, normales, UVs, colores, pesos por nombre de
+ *     hueso y material de cada triángulo
+ *   - Animación: las poses locales de ambos clips se muestrean con
+ *     PoseEvaluator en la rejilla del FPS objetivo
+ *
+ * Las tolerancias de animación son las de la reducción de keys / ajuste de
+ * curvas (ConversionOptions::key*Tolerance) con margen para la conversión
+ * a Euler y la precisión float del archivo.
+ */
+class SceneVerifier
+{
+public:
+    /**
+     * Verificar una escena exportada
+     * @param source Escena original (la que se pasó al exportador)
+     * @param clip Clip original exportado en el archivo (nullptr = sin animación)
+     * @param includeMeshes Si el archivo contiene los meshes
+     * @param loaded Escena cargada del archivo exportado
+     * @param options Opciones de la conversión (escala, FPS, tolerancias)
+     * @param report [out] Errores máximos y primeros errores
+     * @return true si todo está dentro de tolerancia
+     */
+    static bool Verify(
+        const SceneData& source,
+        const AnimationClip* clip,
+        bool includeMeshes,
+        const SceneData& loaded,
+        const ConversionOptions& options,
+        VerificationReport& report);
+
+private:
+    static void VerifyHierarchy(
+        const SceneData& source,
+        const SceneData& loaded,
+        VerificationReport& report);
+
+    static void VerifyMeshes(
+        const SceneData& source,
+        const SceneData& loaded,
+        VerificationReport& report);
+
+    static void VerifyMesh(
+        const MeshData& source,
+        const MeshData& loaded,
+        VerificationReport& report);
+
+    static void VerifyAnimation(
+        const SceneData& source,
+        const AnimationClip& clip,
+        const SceneData& loaded,
+        const ConversionOptions& options,
+        VerificationReport& report);
+
+    static void AddError(VerificationReport& report, const string& message);
+};
+
+#endif // SCENE_VERIFIER_H
@@ -0,0 +1,235 @@
+#pragma once
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+// SSE2 está garantizado en x64 (MSVC lo usa como base para float)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+/**
+ * @namespace SimdMath
+ * @brief Helpers SSE para procesar 4 elementos por instrucción
+ *
+ * Los kernels por lotes (descomposición de matrices, interpolación de keys,
+ * conversión quaternion -> Euler) trabajan en formato "SoA por carril":
+ * cada __m128 contiene la MISMA componente de 4 elementos distintos.
+ *
+ *   x = [x0, x1, x2, x3]
+ *   y = [y0, y1, y2, y3]
+ *   ...
+ */
+namespace SimdMath
+{
+    // Número de elementos procesados por registro
+    const int LANES = 4;
+
+    inline __m128 Splat(float value)
+    {
+        return _mm_set1_ps(value);
+    }
+
+    // Selección por máscara: mask ? a : b
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128 Abs(__m128 v)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+    }
+
+    // Copiar el signo de 'sign' sobre la magnitud de 'magnitude'
+    inline __m128 CopySign(__m128 magnitude, __m128 sign)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        return _mm_or_ps(_mm_andnot_ps(signMask, magnitude), _mm_and_ps(signMask, sign));
+    }
+
+    // a * b + c (sin FMA para mantener compatibilidad con SSE2)
+    inline __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    // Producto punto de 3 componentes por carril
+    inline __m128 Dot3(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+    {
+        return MulAdd(ax, bx, MulAdd(ay, by, _mm_mul_ps(az, bz)));
+    }
+
+    // Producto punto de 4 componentes por carril
+    inline __m128 Dot4(
+        __m128 ax, __m128 ay, __m128 az, __m128 aw,
+        __m128 bx, __m128 by, __m128 bz, __m128 bw)
+    {
+        return MulAdd(ax, bx, MulAdd(ay, by, MulAdd(az, bz, _mm_mul_ps(aw, bw))));
+    }
+
+    // Producto cruz por carril: out = a x b
+    inline void Cross3(
+        __m128 ax, __m128 ay, __m128 az,
+        __m128 bx, __m128 by, __m128 bz,
+        __m128& ox, __m128& oy, __m128& oz)
+    {
+        ox = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+        oy = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+        oz = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+    }
+
+    // 1/sqrt(v) con un paso de Newton-Raphson (precisión ~float completa)
+    inline __m128 RSqrt(__m128 v)
+    {
+        __m128 r = _mm_rsqrt_ps(v);
+        // r' = r * (1.5 - 0.5 * v * r * r)
+        __m128 halfV = _mm_mul_ps(_mm_set1_ps(0.5f), v);
+        return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfV, _mm_mul_ps(r, r))));
+    }
+
+    // Normalizar quaternions por carril (q = 0 se deja como identidad)
+    inline void NormalizeQuat(__m128& x, __m128& y, __m128& z, __m128& w)
+    {
+        __m128 lenSq = Dot4(x, y, z, w, x, y, z, w);
+        __m128 valid = _mm_cmpgt_ps(lenSq, _mm_set1_ps(1e-20f));
+        __m128 inv = RSqrt(_mm_max_ps(lenSq, _mm_set1_ps(1e-20f)));
+
+        x = _mm_and_ps(valid, _mm_mul_ps(x, inv));
+        y = _mm_and_ps(valid, _mm_mul_ps(y, inv));
+        z = _mm_and_ps(valid, _mm_mul_ps(z, inv));
+        w = Select(valid, _mm_mul_ps(w, inv), _mm_set1_ps(1.0f));
+    }
+
+    // atan(x) por carril (aproximación de Cephes atanf, error ~1e-7)
+    inline __m128 Atan(__m128 x)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 sign = _mm_and_ps(x, signMask);
+        x = Abs(x);
+
+        // Reducción de rango: x > tan(3π/8) -> π/2 + atan(-1/x)
+        //                     x > tan(π/8)  -> π/4 + atan((x-1)/(x+1))
+        __m128 big = _mm_cmpgt_ps(x, _mm_set1_ps(2.414213562373095f));
+        __m128 mid = _mm_andnot_ps(big, _mm_cmpgt_ps(x, _mm_set1_ps(0.4142135623730950f)));
+
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 xBig = _mm_div_ps(_mm_set1_ps(-1.0f), _mm_max_ps(x, _mm_set1_ps(1e-30f)));
+        __m128 xMid = _mm_div_ps(_mm_sub_ps(x, one), _mm_add_ps(x, one));
+        __m128 xr = Select(big, xBig, Select(mid, xMid, x));
+        __m128 y0 = Select(big, _mm_set1_ps(1.570796326794897f),
+                           _mm_and_ps(mid, _mm_set1_ps(0.7853981633974483f)));
+
+        __m128 z = _mm_mul_ps(xr, xr);
+        __m128 p = MulAdd(z, _mm_set1_ps(8.05374449538e-2f), _mm_set1_ps(-1.38776856032e-1f));
+        p = MulAdd(p, z, _mm_set1_ps(1.99777106478e-1f));
+        p = MulAdd(p, z, _mm_set1_ps(-3.33329491539e-1f));
+        p = MulAdd(_mm_mul_ps(p, z), xr, xr);
+
+        return _mm_xor_ps(_mm_add_ps(y0, p), sign);
+    }
+
+    // atan2(y, x) por carril, resultado en [-π, π]
+    inline __m128 Atan2(__m128 y, __m128 x)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 pi = _mm_set1_ps(3.141592653589793f);
+
+        __m128 xZero = _mm_cmpeq_ps(x, zero);
+        __m128 safeX = Select(xZero, _mm_set1_ps(1.0f), x);
+        __m128 angle = Atan(_mm_div_ps(y, safeX));
+
+        // Cuadrantes II y III: sumar ±π según el signo de y
+        __m128 xNeg = _mm_cmplt_ps(x, zero);
+        angle = _mm_add_ps(angle, _mm_and_ps(xNeg, CopySign(pi, y)));
+
+        // x == 0: ±π/2 (o 0 si y == 0)
+        __m128 halfPi = _mm_andnot_ps(_mm_cmpeq_ps(y, zero), CopySign(_mm_set1_ps(1.570796326794897f), y));
+        return Select(xZero, halfPi, angle);
+    }
+
+    // asin(s) por carril (s se limita a [-1, 1])
+    inline __m128 Asin(__m128 s)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        s = _mm_max_ps(_mm_min_ps(s, one), _mm_set1_ps(-1.0f));
+        __m128 c = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(s, s)), _mm_setzero_ps()));
+        return Atan2(s, c);
+    }
+
+    /**
+     * Multiplicación de matrices 4x4 (row-major, convención D3D): out = a * b
+     *
+     * Cada fila del resultado es una combinación lineal de las filas de b:
+     *   out.row(i) = a[i][0] * b.row(0) + ... + a[i][3] * b.row(3)
+     * 'out' puede ser la misma memoria que 'a' o 'b'.
+     */
+    inline void MatrixMultiply(const float* a, const float* b, float* out)
+    {
+        __m128 b0 = _mm_loadu_ps(b + 0);
+        __m128 b1 = _mm_loadu_ps(b + 4);
+        __m128 b2 = _mm_loadu_ps(b + 8);
+        __m128 b3 = _mm_loadu_ps(b + 12);
+
+        __m128 rows[4];
+        for (int i = 0; i < 4; i++)
+        {
+            const float* row = a + i * 4;
+            __m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+            r = MulAdd(_mm_set1_ps(row[1]), b1, r);
+            r = MulAdd(_mm_set1_ps(row[2]), b2, r);
+            rows[i] = MulAdd(_mm_set1_ps(row[3]), b3, r);
+        }
+
+        for (int i = 0; i < 4; i++)
+            _mm_storeu_ps(out + i * 4, rows[i]);
+    }
+
+    // Interpolación lineal por carril: a + (b - a) * t
+    inline __m128 Lerp(__m128 a, __m128 b, __m128 t)
+    {
+        return MulAdd(_mm_sub_ps(b, a), t, a);
+    }
+
+    /**
+     * @brief Nlerp con corrección de t (aproxima slerp con error < 1e-3 rad)
+     *
+     * Ajusta t con un polinomio en |dot(a,b)| para compensar la velocidad
+     * angular no uniforme de nlerp, elige el hemisferio más corto y
+     * normaliza el resultado. Resultado en (ox, oy, oz, ow).
+     */
+    inline void Nlerp(
+        __m128 ax, __m128 ay, __m128 az, __m128 aw,
+        __m128 bx, __m128 by, __m128 bz, __m128 bw,
+        __m128 t,
+        __m128& ox, __m128& oy, __m128& oz, __m128& ow)
+    {
+        __m128 d = Dot4(ax, ay, az, aw, bx, by, bz, bw);
+
+        // Camino más corto: invertir b si dot < 0
+        __m128 sign = _mm_and_ps(d, _mm_set1_ps(-0.0f));
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+        d = Abs(d);
+
+        // Corrección de t
+        __m128 ca = MulAdd(d, _mm_set1_ps(-1.43519f), _mm_set1_ps(3.55645f));
+        ca = MulAdd(d, ca, _mm_set1_ps(-3.2452f));
+        ca = MulAdd(d, ca, _mm_set1_ps(1.0904f));
+        __m128 cb = MulAdd(d, _mm_set1_ps(0.215638f), _mm_set1_ps(-1.06021f));
+        cb = MulAdd(d, cb, _mm_set1_ps(0.848013f));
+
+        __m128 tc = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+        __m128 k = MulAdd(ca, _mm_mul_ps(tc, tc), cb);
+        __m128 ot = MulAdd(_mm_mul_ps(_mm_mul_ps(t, tc), _mm_sub_ps(t, _mm_set1_ps(1.0f))), k, t);
+
+        ox = Lerp(ax, bx, ot);
+        oy = Lerp(ay, by, ot);
+        oz = Lerp(az, bz, ot);
+        ow = Lerp(aw, bw, ot);
+        NormalizeQuat(ox, oy, oz, ow);
+    }
+}
+
+#endif // SIMD_MATH_H
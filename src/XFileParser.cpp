@@ -247,6 +247,9 @@ MeshData* XFileParser::ConvertMeshContainer(LPD3DXMESHCONTAINER d3dMeshContainer
             materials,
             mesh
         );
+
+        // Sin el material por triángulo se usa el primero para todo el mesh
+        ExtractAttributes(pMesh, mesh);
     }
 
     // Extraer skin weights si existe skinning
@@ -263,51 +266,124 @@ MeshData* XFileParser::ConvertMeshContainer(LPD3DXMESHCONTAINER d3dMeshContainer
 // Extracción de Geometría
 // ============================================================================
 
+// Leer un elemento de la declaración de vértices como hasta 4 floats
+// Devuelve false si el tipo no se soporta
+static bool ReadVertexElement(const BYTE* data, BYTE type, float out[4])
+{
+    const float* values = (const float*)data;
+
+    switch (type)
+    {
+    case D3DDECLTYPE_FLOAT4: out[3] = values[3];  // fallthrough
+    case D3DDECLTYPE_FLOAT3: out[2] = values[2];  // fallthrough
+    case D3DDECLTYPE_FLOAT2: out[1] = values[1];  // fallthrough
+    case D3DDECLTYPE_FLOAT1: out[0] = values[0];
+        return true;
+
+    case D3DDECLTYPE_D3DCOLOR:
+    {
+        D3DXCOLOR color(*(const D3DCOLOR*)data);
+        out[0] = color.r;
+        out[1] = color.g;
+        out[2] = color.b;
+        out[3] = color.a;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
 bool XFileParser::ExtractVertices(LPD3DXMESH mesh, MeshData* meshData)
 {
     DWORD numVertices = mesh->GetNumVertices();
-    DWORD fvf = mesh->GetFVF();
+
+    // ========================================================================
+    // Formato del vertex buffer
+    // ========================================================================
+    // Los offsets se toman de la declaración de vértices y no de los flags
+    // FVF: así se respetan D3DFVF_DIFFUSE/SPECULAR/PSIZE, los pesos XYZBn,
+    // cualquier número de sets de UV y los meshes sin FVF
+    D3DVERTEXELEMENT9 declaration[MAX_FVF_DECL_SIZE];
+    HRESULT hr = mesh->GetDeclaration(declaration);
+    if (FAILED(hr))
+    {
+        Utils::LogError("Failed to get vertex declaration");
+        return false;
+    }
+
+    const D3DVERTEXELEMENT9* position = nullptr;
+    const D3DVERTEXELEMENT9* normal = nullptr;
+    const D3DVERTEXELEMENT9* color = nullptr;
+    const D3DVERTEXELEMENT9* texCoords[MAX_TEXCOORD_SETS] = {};
+
+    for (const D3DVERTEXELEMENT9* element = declaration; element->Stream != 0xFF; element++)
+    {
+        if (element->Stream != 0)
+            continue;
+
+        if (element->Usage == D3DDECLUSAGE_POSITION && element->UsageIndex == 0)
+            position = element;
+        else if (element->Usage == D3DDECLUSAGE_NORMAL && element->UsageIndex == 0)
+            normal = element;
+        else if (element->Usage == D3DDECLUSAGE_COLOR && element->UsageIndex == 0)
+            color = element;
+        else if (element->Usage == D3DDECLUSAGE_TEXCOORD && element->UsageIndex < MAX_TEXCOORD_SETS)
+            texCoords[element->UsageIndex] = element;
+    }
+
+    // Sets de UV consecutivos desde TEXCOORD0
+    meshData->texCoordSetCount = 0;
+    while (meshData->texCoordSetCount < MAX_TEXCOORD_SETS && texCoords[meshData->texCoordSetCount])
+    {
+        meshData->texCoordSetCount++;
+    }
+
+    meshData->hasVertexColors = (color != nullptr);
 
     BYTE* pVertices = nullptr;
-    HRESULT hr = mesh->LockVertexBuffer(D3DLOCK_READONLY, (void**)&pVertices);
+    hr = mesh->LockVertexBuffer(D3DLOCK_READONLY, (void**)&pVertices);
     if (FAILED(hr))
     {
         Utils::LogError("Failed to lock vertex buffer");
         return false;
     }
 
-    // Determinar stride basado en FVF
-    DWORD stride = D3DXGetFVFVertexSize(fvf);
+    DWORD stride = mesh->GetNumBytesPerVertex();
 
     meshData->vertices.resize(numVertices);
 
     for (DWORD i = 0; i < numVertices; i++)
     {
         Vertex& vertex = meshData->vertices[i];
-        BYTE* pVertex = pVertices + (i * stride);
+        const BYTE* pVertex = pVertices + (i * stride);
+        float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
 
-        // Posición (siempre presente)
-        if (fvf & D3DFVF_XYZ)
-        {
-            float* pPos = (float*)pVertex;
-            vertex.position = D3DXVECTOR3(pPos[0], pPos[1], pPos[2]);
-            pVertex += sizeof(float) * 3;
-        }
+        // Posición
+        if (position && ReadVertexElement(pVertex + position->Offset, position->Type, values))
+            vertex.position = D3DXVECTOR3(values[0], values[1], values[2]);
 
         // Normal
-        if (fvf & D3DFVF_NORMAL)
-        {
-            float* pNormal = (float*)pVertex;
-            vertex.normal = D3DXVECTOR3(pNormal[0], pNormal[1], pNormal[2]);
-            pVertex += sizeof(float) * 3;
-        }
+        if (normal && ReadVertexElement(pVertex + normal->Offset, normal->Type, values))
+            vertex.normal = D3DXVECTOR3(values[0], values[1], values[2]);
 
-        // Coordenadas de textura
-        if (fvf & D3DFVF_TEX1)
+        // Coordenadas de textura (set 0 en texCoord, el resto en extraTexCoords)
+        for (DWORD set = 0; set < meshData->texCoordSetCount; set++)
         {
-            float* pTexCoord = (float*)pVertex;
-            vertex.texCoord = D3DXVECTOR2(pTexCoord[0], pTexCoord[1]);
+            const D3DVERTEXELEMENT9* element = texCoords[set];
+            values[1] = 0.0f;
+            if (!ReadVertexElement(pVertex + element->Offset, element->Type, values))
+                continue;
+
+            D3DXVECTOR2& uv = (set == 0) ? vertex.texCoord : vertex.extraTexCoords[set - 1];
+            uv = D3DXVECTOR2(values[0], values[1]);
         }
+
+        // Color de vértice (alfa 1 si el tipo no lo incluye)
+        values[3] = 1.0f;
+        if (color && ReadVertexElement(pVertex + color->Offset, color->Type, values))
+            vertex.color = D3DXCOLOR(values[0], values[1], values[2], values[3]);
     }
 
     mesh->UnlockVertexBuffer();
@@ -578,6 +654,7 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
             for (UINT iAnim = 0; iAnim < numAnimations; iAnim++)
             {
                 AnimationTrack track;
+                vector<AnimationKey> keys;  // Se asignan al track al terminar
 
                 // Obtener nombre del hueso que esta animación controla
                 const char* boneName = nullptr;
@@ -603,7 +680,7 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
                     pKeyframedSet->GetRotationKeys(iAnim, pRotKeys);
 
                     // Pre-reservar memoria para eficiencia
-                    track.keys.reserve(numRotKeys);
+                    keys.reserve(numRotKeys);
 
                     // Crear keyframe para cada rotación
                     for (UINT iKey = 0; iKey < numRotKeys; iKey++)
@@ -612,12 +689,13 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
                         // CORRECCIÓN: Convertir ticks a segundos usando ticksPerSecond
                         key.time = pRotKeys[iKey].Time / clip.ticksPerSecond;
                         key.rotation = pRotKeys[iKey].Value;
+                        key.channels = KEY_ROTATION;
 
                         // Inicializar translation y scale por defecto
                         key.translation = D3DXVECTOR3(0, 0, 0);
                         key.scale = D3DXVECTOR3(1, 1, 1);
 
-                        track.keys.push_back(key);
+                        keys.push_back(key);
                     }
                     delete[] pRotKeys;
                 }
@@ -638,11 +716,12 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
 
                         // Buscar keyframe existente en ese tiempo
                         bool found = false;
-                        for (auto& existingKey : track.keys)
+                        for (auto& existingKey : keys)
                         {
                             if (fabs(existingKey.time - time) < 0.0001)  // Tolerancia
                             {
                                 existingKey.translation = pPosKeys[iKey].Value;
+                                existingKey.channels |= KEY_TRANSLATION;
                                 found = true;
                                 break;
                             }
@@ -656,7 +735,8 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
                             key.translation = pPosKeys[iKey].Value;
                             key.rotation = D3DXQUATERNION(0, 0, 0, 1);
                             key.scale = D3DXVECTOR3(1, 1, 1);
-                            track.keys.push_back(key);
+                            key.channels = KEY_TRANSLATION;
+                            keys.push_back(key);
                         }
                     }
                     delete[] pPosKeys;
@@ -678,11 +758,12 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
 
                         // Buscar keyframe existente en ese tiempo
                         bool found = false;
-                        for (auto& existingKey : track.keys)
+                        for (auto& existingKey : keys)
                         {
                             if (fabs(existingKey.time - time) < 0.0001)  // Tolerancia
                             {
                                 existingKey.scale = pScaleKeys[iKey].Value;
+                                existingKey.channels |= KEY_SCALE;
                                 found = true;
                                 break;
                             }
@@ -696,25 +777,33 @@ void XFileParser::LoadAnimations(ID3DXAnimationController* animController, Scene
                             key.scale = pScaleKeys[iKey].Value;
                             key.translation = D3DXVECTOR3(0, 0, 0);
                             key.rotation = D3DXQUATERNION(0, 0, 0, 1);
-                            track.keys.push_back(key);
+                            key.channels = KEY_SCALE;
+                            keys.push_back(key);
                         }
                     }
                     delete[] pScaleKeys;
                 }
 
                 // Solo agregar el track si tiene keyframes
-                if (!track.keys.empty())
+                if (!keys.empty())
                 {
+                    // Las keys de traslación/escala sin rotación se agregaron al
+                    // final: ordenar por tiempo para que las curvas sean monótonas
+                    stable_sort(keys.begin(), keys.end(),
+                        [](const AnimationKey& a, const AnimationKey& b) { return a.time < b.time; });
+
                     // ============================================================
                     // WARNING: Detectar cantidades anormales de keyframes
                     // ============================================================
-                    if (track.keys.size() > 10000)
+                    if (keys.size() > 10000)
                     {
                         cout << "  WARNING: Track '" << track.boneName
-                             << "' has " << track.keys.size()
+                             << "' has " << keys.size()
                              << " keyframes (unusually high)\n";
                     }
 
+                    keys.shrink_to_fit();
+                    track.SetKeys(std::move(keys));
                     clip.tracks.push_back(track);
                 }
             }
@@ -884,7 +973,32 @@ void XFileParser::ExtractMaterials(
 
         matData.name = "Material_" + to_string(materials.size());
 
+        meshData->materials.push_back((DWORD)materials.size());
         materials.push_back(matData);
-        meshData->materialIndices.push_back(i);
     }
 }
+
+bool XFileParser::ExtractAttributes(LPD3DXMESH mesh, MeshData* meshData)
+{
+    DWORD numFaces = mesh->GetNumFaces();
+
+    DWORD* pAttributes = nullptr;
+    HRESULT hr = mesh->LockAttributeBuffer(D3DLOCK_READONLY, &pAttributes);
+    if (FAILED(hr))
+    {
+        Utils::LogError("Failed to lock attribute buffer");
+        return false;
+    }
+
+    // El atributo de cada cara es el índice del material en el mesh container
+    DWORD materialCount = (DWORD)meshData->materials.size();
+    meshData->materialIndices.resize(numFaces);
+
+    for (DWORD i = 0; i < numFaces; i++)
+    {
+        meshData->materialIndices[i] = (pAttributes[i] < materialCount) ? pAttributes[i] : 0;
+    }
+
+    mesh->UnlockAttributeBuffer();
+    return true;
+}
@@ -121,6 +121,9 @@ private:
         vector<MaterialData>& materials,
         MeshData* meshData);
 
+    // Helper: Extraer el material de cada triángulo (attribute buffer)
+    bool ExtractAttributes(LPD3DXMESH mesh, MeshData* meshData);
+
     // Opciones de conversión actuales
     ConversionOptions m_Options;
 
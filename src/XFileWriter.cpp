@@ -0,0 +1,655 @@
+#include "XFileWriter.h"
+#include "MatrixConverter.h"
+#include <atomic>
+#include <cstring>
+#include <zlib.h>
+
+// ============================================================================
+// Constantes del formato
+// ============================================================================
+
+static const char XFILE_HEADER[] = "xof 0303bzip0032";     // Binario MSZIP, floats de 32 bits
+static const size_t XFILE_HEADER_SIZE = 16;
+static const size_t MSZIP_BLOCK_SIZE = 32768;               // Máximo de datos por bloque
+
+// Tokens del formato binario
+static const WORD TOKEN_NAME = 1;
+static const WORD TOKEN_STRING = 2;
+static const WORD TOKEN_INTEGER_LIST = 6;
+static const WORD TOKEN_FLOAT_LIST = 7;
+static const WORD TOKEN_OBRACE = 10;
+static const WORD TOKEN_CBRACE = 11;
+static const WORD TOKEN_SEMICOLON = 20;
+
+// Tipos de AnimationKey
+static const DWORD XKEY_ROTATION = 0;
+static const DWORD XKEY_SCALE = 1;
+static const DWORD XKEY_POSITION = 2;
+
+// Ticks por segundo de las keys (exacto para 24, 30, 60 y 120 FPS)
+static const DWORD XFILE_TICKS_PER_SECOND = 4800;
+
+// D3DDECLTYPE_FLOAT2 / D3DDECLMETHOD_DEFAULT / D3DDECLUSAGE_TEXCOORD (DeclData)
+static const DWORD XDECL_FLOAT2 = 1;
+static const DWORD XDECL_METHOD_DEFAULT = 0;
+static const DWORD XDECL_USAGE_TEXCOORD = 5;
+
+static DWORD FloatBits(float value)
+{
+    DWORD bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+XFileWriter::XFileWriter()
+{
+}
+
+// ============================================================================
+// Escritura Principal
+// ============================================================================
+
+bool XFileWriter::WriteScene(
+    const SceneData& sceneData,
+    const string& filename,
+    const ConversionOptions& options)
+{
+    m_Options = options;
+    m_LastError.clear();
+    m_Tokens.clear();
+    m_Blocks.clear();
+    m_RestPoses.clear();
+
+    if (!sceneData.rootFrame)
+    {
+        m_LastError = "No root frame in scene data";
+        return false;
+    }
+
+    Utils::Log("Writing binary .X: " + filename, options.verbose);
+
+    if (!sceneData.animations.empty())
+    {
+        const DWORD ticksPerSecond = XFILE_TICKS_PER_SECOND;
+        BeginObject("AnimTicksPerSecond");
+        WriteIntegers(&ticksPerSecond, 1);
+        EndObject();
+    }
+
+    WriteFrame(*sceneData.rootFrame, sceneData);
+
+    CollectRestPoses(sceneData.rootFrame);
+    for (const AnimationClip& clip : sceneData.animations)
+        WriteAnimationSet(clip);
+
+    if (!Compress())
+    {
+        m_LastError = "MSZIP compression failed for " + filename;
+        return false;
+    }
+
+    if (!WriteFile(filename))
+        return false;
+
+    if (options.verbose)
+    {
+        size_t compressed = XFILE_HEADER_SIZE + 4;
+        for (const vector<BYTE>& block : m_Blocks)
+            compressed += 4 + block.size();
+
+        Utils::LogStream() << "  .X: " << m_Tokens.size() << " bytes of tokens in " << m_Blocks.size()
+                           << " MSZIP blocks, " << compressed << " bytes on disk\n";
+    }
+
+    m_Tokens.clear();
+    m_Blocks.clear();
+    return true;
+}
+
+// ============================================================================
+// Frames y Meshes
+// ============================================================================
+
+void XFileWriter::WriteFrame(const FrameData& frame, const SceneData& sceneData)
+{
+    BeginObject("Frame", frame.name);
+
+    BeginObject("FrameTransformMatrix");
+    WriteFloats(&frame.transformMatrix.m[0][0], 16);
+    EndObject();
+
+    for (const MeshData* mesh : frame.meshes)
+    {
+        if (mesh && !mesh->vertices.empty())
+            WriteMesh(*mesh, sceneData);
+    }
+
+    for (const FrameData* child : frame.children)
+        WriteFrame(*child, sceneData);
+
+    EndObject();
+}
+
+void XFileWriter::WriteMesh(const MeshData& mesh, const SceneData& sceneData)
+{
+    const vector<Vertex>& vertices = mesh.vertices;
+    const size_t vertexCount = vertices.size();
+    const size_t faceCount = mesh.indices.size() / 3;
+
+    // Caras: 3;a,b,c por triángulo (mismo winding que el .X de entrada)
+    vector<DWORD> faces;
+    faces.reserve(1 + faceCount * 4);
+    faces.push_back((DWORD)faceCount);
+    for (size_t f = 0; f < faceCount; f++)
+    {
+        faces.push_back(3);
+        faces.insert(faces.end(), mesh.indices.begin() + f * 3, mesh.indices.begin() + f * 3 + 3);
+    }
+
+    BeginObject("Mesh", mesh.name);
+
+    const DWORD count = (DWORD)vertexCount;
+    vector<float> values(vertexCount * 3);
+    for (size_t i = 0; i < vertexCount; i++)
+        memcpy(&values[i * 3], &vertices[i].position, 3 * sizeof(float));
+
+    WriteIntegers(&count, 1);
+    WriteFloats(values.data(), values.size());
+    WriteIntegers(faces.data(), faces.size());
+
+    // Normales por vértice (las caras de normales son las mismas)
+    for (size_t i = 0; i < vertexCount; i++)
+        memcpy(&values[i * 3], &vertices[i].normal, 3 * sizeof(float));
+
+    BeginObject("MeshNormals");
+    WriteIntegers(&count, 1);
+    WriteFloats(values.data(), values.size());
+    WriteIntegers(faces.data(), faces.size());
+    EndObject();
+
+    if (mesh.texCoordSetCount > 0)
+    {
+        values.resize(vertexCount * 2);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            values[i * 2 + 0] = vertices[i].texCoord.x;
+            values[i * 2 + 1] = vertices[i].texCoord.y;
+        }
+
+        BeginObject("MeshTextureCoords");
+        WriteIntegers(&count, 1);
+        WriteFloats(values.data(), values.size());
+        EndObject();
+    }
+
+    // Sets de UV extra: DeclData con un elemento TEXCOORD por set,
+    // intercalados por vértice
+    const DWORD extraSets = (mesh.texCoordSetCount > 1) ? min(mesh.texCoordSetCount, (DWORD)MAX_TEXCOORD_SETS) - 1 : 0;
+    if (extraSets > 0)
+    {
+        vector<DWORD> decl;
+        decl.push_back(extraSets);
+        for (DWORD set = 1; set <= extraSets; set++)
+        {
+            decl.push_back(XDECL_FLOAT2);
+            decl.push_back(XDECL_METHOD_DEFAULT);
+            decl.push_back(XDECL_USAGE_TEXCOORD);
+            decl.push_back(set);
+        }
+
+        decl.push_back((DWORD)(vertexCount * extraSets * 2));
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            for (DWORD set = 0; set < extraSets; set++)
+            {
+                decl.push_back(FloatBits(vertices[i].extraTexCoords[set].x));
+                decl.push_back(FloatBits(vertices[i].extraTexCoords[set].y));
+            }
+        }
+
+        BeginObject("DeclData");
+        WriteIntegers(decl.data(), decl.size());
+        EndObject();
+    }
+
+    if (mesh.hasVertexColors)
+    {
+        BeginObject("MeshVertexColors");
+        WriteIntegers(&count, 1);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const DWORD index = (DWORD)i;
+            const D3DXCOLOR& c = vertices[i].color;
+            const float color[4] = { c.r, c.g, c.b, c.a };
+            WriteIntegers(&index, 1);
+            WriteFloats(color, 4);
+        }
+        EndObject();
+    }
+
+    // Materiales inline (D3DX no usa los nombres)
+    if (!mesh.materials.empty())
+    {
+        const DWORD materialCount = (DWORD)mesh.materials.size();
+        vector<DWORD> list;
+        list.reserve(2 + faceCount);
+        list.push_back(materialCount);
+        list.push_back((DWORD)faceCount);
+        for (size_t f = 0; f < faceCount; f++)
+        {
+            DWORD group = (f < mesh.materialIndices.size()) ? mesh.materialIndices[f] : 0;
+            list.push_back(group < materialCount ? group : 0);
+        }
+
+        BeginObject("MeshMaterialList");
+        WriteIntegers(list.data(), list.size());
+        for (DWORD material : mesh.materials)
+        {
+            if (material < sceneData.materials.size())
+                WriteMaterial(sceneData.materials[material]);
+            else
+                WriteMaterial(MaterialData());
+        }
+        EndObject();
+    }
+
+    if (mesh.hasSkinning && !mesh.bones.empty())
+        WriteSkin(mesh);
+
+    EndObject();
+}
+
+void XFileWriter::WriteMaterial(const MaterialData& material)
+{
+    const D3DMATERIAL9& m = material.material;
+    const float values[11] =
+    {
+        m.Diffuse.r, m.Diffuse.g, m.Diffuse.b, m.Diffuse.a,
+        m.Power,
+        m.Specular.r, m.Specular.g, m.Specular.b,
+        m.Emissive.r, m.Emissive.g, m.Emissive.b
+    };
+
+    BeginObject("Material");
+    WriteFloats(values, 11);
+
+    if (!material.textureFilename.empty())
+    {
+        BeginObject("TextureFilename");
+        WriteString(material.textureFilename);
+        EndObject();
+    }
+
+    EndObject();
+}
+
+// ============================================================================
+// Skinning
+// ============================================================================
+// Un SkinWeights por hueso, en el orden de MeshData::bones (es el índice
+// de hueso que verá ID3DXSkinInfo), con los pesos ya limpiados.
+// ============================================================================
+
+void XFileWriter::WriteSkin(const MeshData& mesh)
+{
+    const size_t boneCount = mesh.bones.size();
+    vector<vector<DWORD>> boneVertices(boneCount);
+    vector<vector<float>> boneWeights(boneCount);
+    DWORD maxPerVertex = 0;
+
+    for (size_t i = 0; i < mesh.vertices.size(); i++)
+    {
+        const Vertex& vertex = mesh.vertices[i];
+        DWORD influences = 0;
+
+        for (int k = 0; k < MAX_BONE_INFLUENCES; k++)
+        {
+            const DWORD bone = vertex.boneIndices[k];
+            if (vertex.boneWeights[k] <= 0.0f || bone >= boneCount)
+                continue;
+
+            boneVertices[bone].push_back((DWORD)i);
+            boneWeights[bone].push_back(vertex.boneWeights[k]);
+            influences++;
+        }
+        maxPerVertex = max(maxPerVertex, influences);
+    }
+
+    // Huesos distintos por cara
+    DWORD maxPerFace = 0;
+    for (size_t f = 0; f + 2 < mesh.indices.size(); f += 3)
+    {
+        DWORD bones[3 * MAX_BONE_INFLUENCES];
+        DWORD distinct = 0;
+        for (int corner = 0; corner < 3; corner++)
+        {
+            const Vertex& vertex = mesh.vertices[mesh.indices[f + corner]];
+            for (int k = 0; k < MAX_BONE_INFLUENCES; k++)
+            {
+                if (vertex.boneWeights[k] <= 0.0f || vertex.boneIndices[k] >= boneCount)
+                    continue;
+                if (find(bones, bones + distinct, vertex.boneIndices[k]) == bones + distinct)
+                    bones[distinct++] = vertex.boneIndices[k];
+            }
+        }
+        maxPerFace = max(maxPerFace, distinct);
+    }
+
+    const DWORD header[3] = { maxPerVertex, maxPerFace, (DWORD)boneCount };
+    BeginObject("XSkinMeshHeader");
+    WriteIntegers(header, 3);
+    EndObject();
+
+    for (size_t b = 0; b < boneCount; b++)
+    {
+        vector<DWORD> indices;
+        indices.reserve(1 + boneVertices[b].size());
+        indices.push_back((DWORD)boneVertices[b].size());
+        indices.insert(indices.end(), boneVertices[b].begin(), boneVertices[b].end());
+
+        vector<float> weights = boneWeights[b];
+        weights.insert(weights.end(), &mesh.bones[b].offsetMatrix.m[0][0], &mesh.bones[b].offsetMatrix.m[0][0] + 16);
+
+        BeginObject("SkinWeights");
+        WriteString(mesh.bones[b].name);
+        WriteIntegers(indices.data(), indices.size());
+        WriteFloats(weights.data(), weights.size());
+        EndObject();
+    }
+}
+
+// ============================================================================
+// Animación
+// ============================================================================
+// Un AnimationKey por canal con keys. Los canales sin keys (eliminados por
+// AnimationOptimizer por ser iguales a la pose de reposo) se escriben con
+// una key de la pose de reposo: D3DX no toma el canal del FrameTransformMatrix.
+//
+// Las rotaciones se guardan como w, x, y, z del conjugado: D3DX invierte
+// los quaternions del archivo al cargarlos.
+// ============================================================================
+
+void XFileWriter::CollectRestPoses(const FrameData* root)
+{
+    vector<const FrameData*> frames;
+    vector<const FrameData*> stack(1, root);
+    while (!stack.empty())
+    {
+        const FrameData* frame = stack.back();
+        stack.pop_back();
+        frames.push_back(frame);
+        stack.insert(stack.end(), frame->children.begin(), frame->children.end());
+    }
+
+    vector<D3DXMATRIX> locals(frames.size());
+    for (size_t i = 0; i < frames.size(); i++)
+        locals[i] = frames[i]->transformMatrix;
+
+    DecomposedTransforms trs;
+    MatrixConverter::DecomposeMatrices(locals.data(), locals.size(), trs);
+
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        if (frames[i]->name.empty())
+            continue;
+
+        RestPose& pose = m_RestPoses[frames[i]->name];
+        pose.translation = trs.translations[i];
+        pose.rotation = trs.rotations[i];
+        pose.scale = trs.scales[i];
+    }
+}
+
+void XFileWriter::WriteAnimationSet(const AnimationClip& clip)
+{
+    BeginObject("AnimationSet", clip.name);
+
+    vector<DWORD> ticks[3];
+    vector<float> values[3];
+
+    for (const AnimationTrack& track : clip.tracks)
+    {
+        auto rest = m_RestPoses.find(track.boneName);
+        if (rest == m_RestPoses.end() || track.GetKeys().empty())
+            continue;
+
+        for (int c = 0; c < 3; c++)
+        {
+            ticks[c].clear();
+            values[c].clear();
+        }
+
+        for (const AnimationKey& key : track.GetKeys())
+        {
+            const DWORD tick = (DWORD)(max(key.time, 0.0) * XFILE_TICKS_PER_SECOND + 0.5);
+
+            if (key.channels & KEY_ROTATION)
+            {
+                ticks[0].push_back(tick);
+                const float q[4] = { key.rotation.w, -key.rotation.x, -key.rotation.y, -key.rotation.z };
+                values[0].insert(values[0].end(), q, q + 4);
+            }
+
+            if (key.channels & KEY_SCALE)
+            {
+                ticks[1].push_back(tick);
+                values[1].insert(values[1].end(), &key.scale.x, &key.scale.x + 3);
+            }
+
+            if (key.channels & KEY_TRANSLATION)
+            {
+                ticks[2].push_back(tick);
+                values[2].insert(values[2].end(), &key.translation.x, &key.translation.x + 3);
+            }
+        }
+
+        // Canales sin keys: una key con la pose de reposo
+        const RestPose& pose = rest->second;
+        if (ticks[0].empty())
+        {
+            ticks[0].push_back(0);
+            const float q[4] = { pose.rotation.w, -pose.rotation.x, -pose.rotation.y, -pose.rotation.z };
+            values[0].assign(q, q + 4);
+        }
+        if (ticks[1].empty())
+        {
+            ticks[1].push_back(0);
+            values[1].assign(&pose.scale.x, &pose.scale.x + 3);
+        }
+        if (ticks[2].empty())
+        {
+            ticks[2].push_back(0);
+            values[2].assign(&pose.translation.x, &pose.translation.x + 3);
+        }
+
+        BeginObject("Animation");
+        WriteReference(track.boneName);
+        WriteAnimationKey(XKEY_ROTATION, ticks[0], values[0], 4);
+        WriteAnimationKey(XKEY_SCALE, ticks[1], values[1], 3);
+        WriteAnimationKey(XKEY_POSITION, ticks[2], values[2], 3);
+        EndObject();
+    }
+
+    EndObject();
+}
+
+void XFileWriter::WriteAnimationKey(DWORD keyType, const vector<DWORD>& ticks, const vector<float>& values, DWORD components)
+{
+    BeginObject("AnimationKey");
+
+    const DWORD header[2] = { keyType, (DWORD)ticks.size() };
+    WriteIntegers(header, 2);
+
+    // TimedFloatKeys: time; nValues; values (listas alternadas)
+    for (size_t i = 0; i < ticks.size(); i++)
+    {
+        const DWORD key[2] = { ticks[i], components };
+        WriteIntegers(key, 2);
+        WriteFloats(&values[i * components], components);
+    }
+
+    EndObject();
+}
+
+// ============================================================================
+// Tokens
+// ============================================================================
+
+void XFileWriter::WriteToken(WORD token)
+{
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&token);
+    m_Tokens.insert(m_Tokens.end(), bytes, bytes + sizeof(token));
+}
+
+void XFileWriter::WriteName(const string& name)
+{
+    const DWORD length = (DWORD)name.size();
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&length);
+
+    WriteToken(TOKEN_NAME);
+    m_Tokens.insert(m_Tokens.end(), bytes, bytes + sizeof(length));
+    m_Tokens.insert(m_Tokens.end(), name.begin(), name.end());
+}
+
+void XFileWriter::WriteString(const string& value)
+{
+    const DWORD length = (DWORD)value.size();
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&length);
+
+    WriteToken(TOKEN_STRING);
+    m_Tokens.insert(m_Tokens.end(), bytes, bytes + sizeof(length));
+    m_Tokens.insert(m_Tokens.end(), value.begin(), value.end());
+    WriteToken(TOKEN_SEMICOLON);
+}
+
+void XFileWriter::WriteIntegers(const DWORD* values, size_t count)
+{
+    const DWORD length = (DWORD)count;
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&length);
+
+    WriteToken(TOKEN_INTEGER_LIST);
+    m_Tokens.insert(m_Tokens.end(), bytes, bytes + sizeof(length));
+
+    const BYTE* data = reinterpret_cast<const BYTE*>(values);
+    m_Tokens.insert(m_Tokens.end(), data, data + count * sizeof(DWORD));
+}
+
+void XFileWriter::WriteFloats(const float* values, size_t count)
+{
+    const DWORD length = (DWORD)count;
+    const BYTE* bytes = reinterpret_cast<const BYTE*>(&length);
+
+    WriteToken(TOKEN_FLOAT_LIST);
+    m_Tokens.insert(m_Tokens.end(), bytes, bytes + sizeof(length));
+
+    const BYTE* data = reinterpret_cast<const BYTE*>(values);
+    m_Tokens.insert(m_Tokens.end(), data, data + count * sizeof(float));
+}
+
+void XFileWriter::BeginObject(const char* templateName, const string& name)
+{
+    WriteName(templateName);
+    if (!name.empty())
+        WriteName(name);
+    WriteToken(TOKEN_OBRACE);
+}
+
+void XFileWriter::EndObject()
+{
+    WriteToken(TOKEN_CBRACE);
+}
+
+void XFileWriter::WriteReference(const string& name)
+{
+    WriteToken(TOKEN_OBRACE);
+    WriteName(name);
+    WriteToken(TOKEN_CBRACE);
+}
+
+// ============================================================================
+// Compresión MSZIP y archivo
+// ============================================================================
+// Archivo = cabecera de 16 bytes + tamaño descomprimido (DWORD, incluye la
+// cabecera) + bloques. Cada bloque: tamaño descomprimido (WORD), tamaño
+// comprimido (WORD, incluye la firma) y "CK" + deflate crudo terminado con
+// Z_FINISH.
+// ============================================================================
+
+bool XFileWriter::Compress()
+{
+    const size_t size = m_Tokens.size();
+    const size_t blockCount = (size + MSZIP_BLOCK_SIZE - 1) / MSZIP_BLOCK_SIZE;
+    m_Blocks.assign(blockCount, vector<BYTE>());
+
+    std::atomic<bool> failed(false);
+
+    // El archivo se escribe una vez: máxima compresión (la descompresión
+    // cuesta lo mismo con cualquier nivel)
+    Utils::ParallelFor(blockCount, m_Options.numThreads, [&](size_t block)
+    {
+        const size_t offset = block * MSZIP_BLOCK_SIZE;
+        const size_t length = min(MSZIP_BLOCK_SIZE, size - offset);
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            failed = true;
+            return;
+        }
+
+        vector<BYTE>& out = m_Blocks[block];
+        out.resize(2 + deflateBound(&stream, (uLong)length));
+        out[0] = 'C';
+        out[1] = 'K';
+
+        stream.next_in = m_Tokens.data() + offset;
+        stream.avail_in = (uInt)length;
+        stream.next_out = out.data() + 2;
+        stream.avail_out = (uInt)(out.size() - 2);
+
+        if (deflate(&stream, Z_FINISH) != Z_STREAM_END || 2 + stream.total_out > 0xFFFF)
+            failed = true;
+
+        out.resize(2 + stream.total_out);
+        deflateEnd(&stream);
+    });
+
+    return !failed;
+}
+
+bool XFileWriter::WriteFile(const string& filename)
+{
+    ofstream file(filename.c_str(), ios::binary | ios::out | ios::trunc);
+    if (!file.is_open())
+    {
+        m_LastError = "Cannot create file: " + filename;
+        return false;
+    }
+
+    const DWORD decompressedSize = (DWORD)(XFILE_HEADER_SIZE + m_Tokens.size());
+    file.write(XFILE_HEADER, XFILE_HEADER_SIZE);
+    file.write(reinterpret_cast<const char*>(&decompressedSize), sizeof(decompressedSize));
+
+    for (size_t block = 0; block < m_Blocks.size(); block++)
+    {
+        const size_t length = min(MSZIP_BLOCK_SIZE, m_Tokens.size() - block * MSZIP_BLOCK_SIZE);
+        const WORD sizes[2] = { (WORD)length, (WORD)m_Blocks[block].size() };
+
+        file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        file.write(reinterpret_cast<const char*>(m_Blocks[block].data()), (streamsize)m_Blocks[block].size());
+    }
+
+    file.close();
+    if (file.fail())
+    {
+        m_LastError = "Error writing .X file: " + filename;
+        return false;
+    }
+
+    return true;
+}
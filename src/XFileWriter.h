@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef XFILE_WRITER_H
+#define XFILE_WRITER_H
+
+#include "../include/Common.h"
+
+/**
+ * @class XFileWriter
+ * @brief Escribe SceneData como .X binario comprimido ("xof 0303bzip0032")
+ *
+ * Para runtimes antiguos que cargan .X con D3DX: la escena ya procesada
+ * (meshes optimizados, pesos limpiados, keys reducidas) vuelve al formato
+ * original, sin cambiar de sistema de coordenadas ni aplicar la escala
+ * (Left-Handed, mismas unidades y winding que el .X de entrada).
+ *
+ *   Frame               -> Frame + FrameTransformMatrix
+ *   MeshData            -> Mesh con MeshNormals, MeshTextureCoords,
+ *                          DeclData (sets de UV extra), MeshVertexColors,
+ *                          MeshMaterialList y XSkinMeshHeader/SkinWeights
+ *   AnimationClip       -> AnimationSet con un Animation por track y un
+ *                          AnimationKey por canal (ticks a 4800 por segundo)
+ *
+ * Los templates no se escriben: D3DXLoadMeshHierarchyFromX registra los
+ * estándar y los de skinning. El stream de tokens se divide en bloques
+ * MSZIP de 32 KB que se comprimen en paralelo; cada bloque es un stream
+ * deflate independiente (sin historial del anterior), que cualquier
+ * descompresor MSZIP acepta.
+ */
+class XFileWriter
+{
+public:
+    XFileWriter();
+
+    /**
+     * Escribir la escena completa (modelo y todos los clips) a un .X
+     * @param sceneData Datos de la escena (con animaciones)
+     * @param filename Archivo .X de salida
+     * @param options Opciones de conversión (hilos, verbose)
+     * @return true si se escribió exitosamente
+     */
+    bool WriteScene(
+        const SceneData& sceneData,
+        const string& filename,
+        const ConversionOptions& options);
+
+    /**
+     * Obtener último mensaje de error
+     * @return Mensaje de error
+     */
+    string GetLastError() const { return m_LastError; }
+
+private:
+    // Pose de reposo de un frame (para los canales sin keys)
+    struct RestPose
+    {
+        D3DXVECTOR3 translation;
+        D3DXQUATERNION rotation;
+        D3DXVECTOR3 scale;
+    };
+
+    ConversionOptions m_Options;
+    string m_LastError;
+
+    vector<BYTE> m_Tokens;
+    vector<vector<BYTE>> m_Blocks;
+    map<string, RestPose> m_RestPoses;
+
+    void CollectRestPoses(const FrameData* root);
+    void WriteFrame(const FrameData& frame, const SceneData& sceneData);
+    void WriteMesh(const MeshData& mesh, const SceneData& sceneData);
+    void WriteMaterial(const MaterialData& material);
+    void WriteSkin(const MeshData& mesh);
+    void WriteAnimationSet(const AnimationClip& clip);
+    void WriteAnimationKey(DWORD keyType, const vector<DWORD>& ticks, const vector<float>& values, DWORD components);
+
+    // Tokens del formato binario
+    void WriteToken(WORD token);
+    void WriteName(const string& name);
+    void WriteString(const string& value);
+    void WriteIntegers(const DWORD* values, size_t count);
+    void WriteFloats(const float* values, size_t count);
+    void BeginObject(const char* templateName, const string& name = string());
+    void EndObject();
+    void WriteReference(const string& name);
+
+    // Comprimir m_Tokens en bloques MSZIP (m_Blocks)
+    bool Compress();
+    bool WriteFile(const string& filename);
+};
+
+#endif // XFILE_WRITER_H
@@ -10,7 +10,17 @@
 #include "../include/Common.h"
 #include "XFileParser.h"
 #include "FBXExporter.h"
+#include "NativeFBXExporter.h"
+#include "NativeFBXImporter.h"
+#include "SceneVerifier.h"
+#include "GLTFExporter.h"
+#include "RuntimePackageWriter.h"
+#include "XFileWriter.h"
 #include "MatrixConverter.h"
+#include "AnimationResampler.h"
+#include "AnimationOptimizer.h"
+#include "AnimationBounds.h"
+#include "MeshOptimizer.h"
 
 // ============================================================================
 // Funciones Auxiliares
@@ -25,6 +35,15 @@ void PrintUsage()
     cout << "  XtoFBXConverter.exe <input.x> <output.fbx> [options]\n";
     cout << "\nOPTIONS:\n";
     cout << "  --fbx-version <2020|2019|2018>     FBX version (default: 2020)\n";
+    cout << "  --native-fbx-version <7400|7500>   FBX file version of the native writer (default: 7400)\n";
+    cout << "  --native-fbx                       Write FBX files without the FBX SDK (RH, Y-up)\n";
+    cout << "  --fbx-ascii                        Write ASCII FBX with the native writer (implies --native-fbx)\n";
+    cout << "  --fbx-compression <0-9>            zlib level for native FBX arrays (default: 1, 0 = off)\n";
+    cout << "  --fbx-compress-threshold <bytes>   Smallest native FBX array to compress (default: 1024)\n";
+    cout << "  --verify                           Reload each native FBX and compare it with the source\n";
+    cout << "  --glb                              Also write <output>.glb (glTF 2.0) with the scene and all clips\n";
+    cout << "  --package                          Also write <output>.xpkg (memory-mappable runtime package)\n";
+    cout << "  --xfile                            Also write <output>_bin.x (compressed binary .X for D3DX)\n";
     cout << "  --up-axis <Y|Z>                    Up axis (default: Y)\n";
     cout << "  --coordinate-system <RH|LH>        Right/Left handed (default: RH)\n";
     cout << "  --scale <float>                    Global scale factor (default: 1.0)\n";
@@ -32,6 +51,18 @@ void PrintUsage()
     cout << "  --no-export-textures               Don't copy textures (default)\n";
     cout << "  --triangulate                      Triangulate polygons (default: on)\n";
     cout << "  --fps <30|60>                      Target FPS for animations (default: 30)\n";
+    cout << "  --no-resample                      Keep original animation keys (no resampling)\n";
+    cout << "  --anim-skeleton-only               Animation files contain only the skeleton (no meshes)\n";
+    cout << "  --keep-constant-channels           Export constant T/R/S channels as full curves\n";
+    cout << "  --no-reduce-keys                   Keep every (resampled) key\n";
+    cout << "  --pos-tolerance <float>            Key reduction position error (default: 0.001)\n";
+    cout << "  --rot-tolerance <degrees>          Key reduction rotation error (default: 0.01)\n";
+    cout << "  --scale-tolerance <float>          Key reduction scale error (default: 0.001)\n";
+    cout << "  --fit-curves                       Export cubic curves fitted within the tolerances\n";
+    cout << "  --bake-rigid-skins                 Bake unanimated/single-bone skins to static meshes\n";
+    cout << "  --bone-palette <N>                 Split skinned meshes to at most N bones each\n";
+    cout << "  --export-bounds                    Write per-frame skinned mesh AABBs (<clip>.bounds)\n";
+    cout << "  --threads <N>                      Worker threads (default: 0 = auto)\n";
     cout << "  --verbose                          Show detailed information\n";
     cout << "  --help                             Show this help message\n";
     cout << "\nEXAMPLES:\n";
@@ -46,6 +77,90 @@ void PrintUsage()
     cout << "\n=============================================================================\n";
 }
 
+// Exportar un clip con el exportador del worker (FBX SDK o escritor propio)
+template<class Exporter>
+bool ExportClip(
+    unique_ptr<Exporter>& exporter,
+    char& ready,
+    const SceneData& modelData,
+    const AnimationClip& anim,
+    const string& path,
+    const ConversionOptions& options,
+    string& error)
+{
+    if (!exporter)
+        exporter.reset(new Exporter());
+
+    bool exported = false;
+
+    if (options.animSkeletonOnly)
+    {
+        // Modo solo skeleton: la jerarquía se crea una vez por worker
+        if (!ready)
+            ready = exporter->BeginAnimationExport(modelData, options) ? 1 : 0;
+
+        exported = ready && exporter->ExportAnimationOnly(anim, path);
+    }
+    else
+    {
+        exported = exporter->ExportSingleAnimation(modelData, anim, path, options);
+    }
+
+    if (!exported)
+        error = exporter->GetLastError();
+
+    return exported;
+}
+
+// Recargar un FBX escrito con el lector propio y compararlo con la escena
+bool VerifyExport(
+    const string& path,
+    const SceneData& source,
+    const AnimationClip* clip,
+    bool includeMeshes,
+    const ConversionOptions& options)
+{
+    auto start = chrono::steady_clock::now();
+
+    NativeFBXImporter importer;
+    SceneData loaded;
+    if (!importer.LoadScene(path, options, loaded))
+    {
+        Utils::LogError("  ✗ Verification failed: " + importer.GetLastError());
+        return false;
+    }
+
+    VerificationReport report;
+    bool verified = SceneVerifier::Verify(source, clip, includeMeshes, loaded, options, report);
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    if (verified)
+    {
+        Utils::LogStream() << "  ✓ Verified: " << report.frameCount << " nodes, " << report.vertexCount
+                           << " vertices, " << report.sampleCount << " pose samples (" << elapsed << " ms)\n";
+    }
+    else
+    {
+        Utils::LogError("  ✗ Verification failed with " + std::to_string(report.errorCount) + " error(s):");
+        for (const string& error : report.errors)
+            Utils::LogError("    " + error);
+    }
+
+    if (options.verbose)
+    {
+        Utils::LogStream() << "    Max errors: position " << report.maxPositionError
+                           << ", normal " << report.maxNormalError
+                           << ", UV " << report.maxTexCoordError
+                           << ", color " << report.maxColorError
+                           << ", weight " << report.maxWeightError
+                           << ", translation " << report.maxTranslationError
+                           << ", rotation " << report.maxRotationError << " deg"
+                           << ", scale " << report.maxScaleError << "\n";
+    }
+
+    return verified;
+}
+
 bool ParseArguments(int argc, char* argv[], ConversionOptions& options)
 {
     if (argc < 3)
@@ -73,6 +188,58 @@ bool ParseArguments(int argc, char* argv[], ConversionOptions& options)
             // We'll use format IDs from the registry instead
             if (version == "2020" || version == "2019" || version == "2018")
                 options.fbxVersion = 0; // Will use default format
+            else
+                Utils::LogWarning("Unknown --fbx-version " + version + ", using default");
+        }
+        else if (arg == "--native-fbx-version" && i + 1 < argc)
+        {
+            string version = argv[++i];
+            if (version == "7400" || version == "7500")
+                options.nativeFbxVersion = atoi(version.c_str());
+            else
+            {
+                Utils::LogWarning("Unknown --native-fbx-version " + version + ", using 7400");
+                options.nativeFbxVersion = 7400;
+            }
+        }
+        else if (arg == "--native-fbx")
+        {
+            options.nativeFbx = true;
+        }
+        else if (arg == "--fbx-ascii")
+        {
+            options.nativeFbx = true;
+            options.nativeFbxAscii = true;
+        }
+        else if (arg == "--fbx-compression" && i + 1 < argc)
+        {
+            options.fbxCompressionLevel = atoi(argv[++i]);
+            if (options.fbxCompressionLevel < 0 || options.fbxCompressionLevel > 9)
+            {
+                Utils::LogWarning("Invalid FBX compression level, using default 1");
+                options.fbxCompressionLevel = 1;
+            }
+        }
+        else if (arg == "--glb")
+        {
+            options.exportGltf = true;
+        }
+        else if (arg == "--package")
+        {
+            options.exportPackage = true;
+        }
+        else if (arg == "--xfile")
+        {
+            options.exportXFile = true;
+        }
+        else if (arg == "--verify")
+        {
+            options.verifyOutput = true;
+        }
+        else if (arg == "--fbx-compress-threshold" && i + 1 < argc)
+        {
+            int threshold = atoi(argv[++i]);
+            options.fbxCompressionThreshold = (size_t)(threshold > 0 ? threshold : 0);
         }
         else if (arg == "--up-axis" && i + 1 < argc)
         {
@@ -118,6 +285,57 @@ bool ParseArguments(int argc, char* argv[], ConversionOptions& options)
                 options.targetFPS = 30.0;
             }
         }
+        else if (arg == "--no-resample")
+        {
+            options.resampleAnimation = false;
+        }
+        else if (arg == "--anim-skeleton-only")
+        {
+            options.animSkeletonOnly = true;
+        }
+        else if (arg == "--keep-constant-channels")
+        {
+            options.removeConstantChannels = false;
+        }
+        else if (arg == "--no-reduce-keys")
+        {
+            options.reduceKeys = false;
+        }
+        else if (arg == "--pos-tolerance" && i + 1 < argc)
+        {
+            options.keyPositionTolerance = (float)atof(argv[++i]);
+        }
+        else if (arg == "--rot-tolerance" && i + 1 < argc)
+        {
+            options.keyRotationTolerance = (float)atof(argv[++i]);
+        }
+        else if (arg == "--scale-tolerance" && i + 1 < argc)
+        {
+            options.keyScaleTolerance = (float)atof(argv[++i]);
+        }
+        else if (arg == "--fit-curves")
+        {
+            options.fitCurves = true;
+        }
+        else if (arg == "--bake-rigid-skins")
+        {
+            options.bakeRigidSkins = true;
+        }
+        else if (arg == "--bone-palette" && i + 1 < argc)
+        {
+            int bones = atoi(argv[++i]);
+            options.maxPaletteBones = (bones > 0) ? (size_t)bones : 0;
+        }
+        else if (arg == "--export-bounds")
+        {
+            options.exportBounds = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            options.numThreads = atoi(argv[++i]);
+            if (options.numThreads < 0)
+                options.numThreads = 0;
+        }
         else if (arg == "--verbose" || arg == "-v")
         {
             options.verbose = true;
@@ -128,6 +346,20 @@ bool ParseArguments(int argc, char* argv[], ConversionOptions& options)
         }
     }
 
+    // La verificación usa el lector propio (misma convención RH, Y-up)
+    if (options.verifyOutput && !options.nativeFbx)
+    {
+        Utils::LogWarning("--verify requires the native FBX writer, verification disabled");
+        options.verifyOutput = false;
+    }
+
+    // Las cajas se calculan en el espacio Y-up del FBX (solo cambia Z y escala)
+    if (options.exportBounds && options.upAxis != UpAxis::Y_AXIS)
+    {
+        Utils::LogWarning("--export-bounds only supports Y-up output, bounds disabled");
+        options.exportBounds = false;
+    }
+
     return true;
 }
 
@@ -141,6 +373,22 @@ void PrintOptions(const ConversionOptions& options)
     cout << "Global scale:       " << options.scale << "\n";
     cout << "Export textures:    " << (options.exportTextures ? "Yes" : "No") << "\n";
     cout << "Triangulate:        " << (options.triangulate ? "Yes" : "No") << "\n";
+    cout << "Resample animation: " << (options.resampleAnimation ? "Yes" : "No") << " (" << options.targetFPS << " FPS)\n";
+    cout << "Anim skeleton only: " << (options.animSkeletonOnly ? "Yes" : "No") << "\n";
+    cout << "Remove constants:   " << (options.removeConstantChannels ? "Yes" : "No") << "\n";
+    cout << "Reduce keys:        " << (options.reduceKeys ? "Yes" : "No") << "\n";
+    cout << "Fit cubic curves:   " << (options.fitCurves ? "Yes" : "No") << "\n";
+    cout << "Bake rigid skins:   " << (options.bakeRigidSkins ? "Yes" : "No") << "\n";
+    cout << "Bone palette:       " << (options.maxPaletteBones > 0 ? std::to_string(options.maxPaletteBones) : string("Unlimited")) << "\n";
+    cout << "Export bounds:      " << (options.exportBounds ? "Yes" : "No") << "\n";
+    cout << "FBX writer:         " << (options.nativeFbx ? "Native (FBX " + std::to_string(options.nativeFbxVersion) + (options.nativeFbxAscii ? " ASCII)" : " binary)") : string("FBX SDK")) << "\n";
+    if (options.nativeFbx && !options.nativeFbxAscii)
+        cout << "FBX compression:    " << (options.fbxCompressionLevel > 0 ? "zlib level " + std::to_string(options.fbxCompressionLevel) + ", arrays >= " + std::to_string(options.fbxCompressionThreshold) + " bytes" : string("Off")) << "\n";
+    cout << "Export GLB:         " << (options.exportGltf ? "Yes" : "No") << "\n";
+    cout << "Runtime package:    " << (options.exportPackage ? "Yes" : "No") << "\n";
+    cout << "Export binary .X:   " << (options.exportXFile ? "Yes" : "No") << "\n";
+    cout << "Verify output:      " << (options.verifyOutput ? "Yes" : "No") << "\n";
+    cout << "Threads:            " << Utils::GetThreadCount(options.numThreads) << "\n";
     cout << "Verbose:            " << (options.verbose ? "Yes" : "No") << "\n";
     cout << "--------------------------\n\n";
 }
@@ -197,25 +445,104 @@ int main(int argc, char* argv[])
     cout << "  - Animations: " << sceneData.animations.size() << "\n";
     cout << "\n";
 
+    // Skins que no se deforman: geometría estática (menos clusters y huesos)
+    if (options.bakeRigidSkins)
+    {
+        cout << "Baking rigid skins...\n";
+        MeshOptimizer::BakeRigidSkins(sceneData, options);
+        cout << "\n";
+    }
+
+    // Paletas de huesos de tamaño fijo (skinning en GPU)
+    if (options.maxPaletteBones > 0)
+    {
+        cout << "Partitioning bone palettes...\n";
+        MeshOptimizer::PartitionBonePalettes(sceneData, options);
+        cout << "\n";
+    }
+
+    // Tracks idénticos entre clips (huesos quietos, props...) comparten sus keys
+    if (sceneData.animations.size() > 1)
+    {
+        cout << "Sharing duplicate animation tracks...\n";
+        AnimationOptimizer::ShareDuplicateTracks(sceneData.animations, options);
+        cout << "\n";
+    }
+
+    // Remuestrear animaciones a la rejilla de frames del FPS objetivo
+    if (options.resampleAnimation && !sceneData.animations.empty())
+    {
+        cout << "Resampling animations to " << options.targetFPS << " FPS...\n";
+        AnimationResampler::ResampleClips(sceneData.animations, options.targetFPS,
+                                          options.numThreads, options.verbose);
+
+        // El remuestreo crea arrays nuevos: volver a compartir los idénticos
+        if (sceneData.animations.size() > 1)
+            AnimationOptimizer::ShareDuplicateTracks(sceneData.animations, options);
+        cout << "\n";
+    }
+
+    // Referencia para --verify: las animaciones antes de eliminar canales y
+    // keys (las keys son compartidas, la copia no duplica los arrays)
+    vector<AnimationClip> referenceClips;
+    if (options.verifyOutput)
+        referenceClips = sceneData.animations;
+
+    // Colapsar canales constantes (y eliminar los que son la pose de reposo)
+    if (options.removeConstantChannels && !sceneData.animations.empty())
+    {
+        cout << "Removing constant animation channels...\n";
+        AnimationOptimizer::EliminateConstantChannels(sceneData.animations, sceneData.rootFrame, options);
+        cout << "\n";
+    }
+
+    // Eliminar keys redundantes dentro de la tolerancia de error
+    // (con --fit-curves el exportador ajusta sobre las muestras densas)
+    if (options.reduceKeys && !options.fitCurves && !sceneData.animations.empty())
+    {
+        cout << "Reducing animation keys...\n";
+        AnimationOptimizer::ReduceClips(sceneData.animations, options);
+        cout << "\n";
+    }
+
     // ========================================================================
     // PASO 2: Exportar modelo principal a FBX (sin animaciones)
     // ========================================================================
 
     cout << "STEP 2: Exporting model to FBX...\n";
 
-    FBXExporter exporter;
-
     // Crear una copia de sceneData sin animaciones para el modelo principal
     SceneData modelData = sceneData;
     modelData.animations.clear(); // No incluir animaciones en el modelo principal
 
-    if (!exporter.ExportScene(modelData, options.outputFile, options))
+    bool modelExported = false;
+    string exportError;
+
+    if (options.nativeFbx)
+    {
+        NativeFBXExporter exporter;
+        modelExported = exporter.ExportScene(modelData, options.outputFile, options);
+        exportError = exporter.GetLastError();
+    }
+    else
+    {
+        FBXExporter exporter;
+        modelExported = exporter.ExportScene(modelData, options.outputFile, options);
+        exportError = exporter.GetLastError();
+    }
+
+    if (!modelExported)
     {
-        Utils::LogError("Failed to export FBX: " + exporter.GetLastError());
+        Utils::LogError("Failed to export FBX: " + exportError);
         return 1;
     }
 
     cout << "Successfully exported model to FBX!\n";
+
+    int verifyFailures = 0;
+    if (options.verifyOutput && !VerifyExport(options.outputFile, modelData, nullptr, true, options))
+        verifyFailures++;
+
     cout << "\n";
 
     // ========================================================================
@@ -261,44 +588,230 @@ int main(int argc, char* argv[])
         cout << "Animations directory: " << animationsDir << "\n\n";
 
         // ====================================================================
-        // Exportar cada animación en un archivo FBX separado
+        // Nombres de archivo (antes de repartir el trabajo, para que sean
+        // deterministas e independientes del orden de ejecución)
         // ====================================================================
-        int exportedCount = 0;
-        for (size_t i = 0; i < sceneData.animations.size(); i++)
-        {
-            const AnimationClip& anim = sceneData.animations[i];
+        const size_t clipCount = sceneData.animations.size();
+        vector<string> animPaths(clipCount);
+        map<string, int> usedNames;
 
+        for (size_t i = 0; i < clipCount; i++)
+        {
             // Limpiar nombre de animación para usar como nombre de archivo
-            string animFilename = Utils::SanitizeFilename(anim.name);
+            string animFilename = Utils::SanitizeFilename(sceneData.animations[i].name);
             if (animFilename.empty())
                 animFilename = "Animation_" + std::to_string(i + 1);
 
-            string animPath = animationsDir + "\\" + animFilename + ".fbx";
+            // Dos clips con el mismo nombre no pueden escribir el mismo archivo
+            // (sin distinguir mayúsculas, como el sistema de archivos). El
+            // sufijo también puede coincidir con el nombre de otro clip
+            // ("Walk", "Walk", "Walk_2"), así que se busca uno libre
+            auto fileKey = [](string name)
+            {
+                transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)tolower(c); });
+                return name;
+            };
+
+            if (usedNames.count(fileKey(animFilename)))
+            {
+                string baseName = animFilename;
+                int suffix = (int)i + 1;
+                do
+                {
+                    animFilename = baseName + "_" + std::to_string(suffix++);
+                } while (usedNames.count(fileKey(animFilename)));
+            }
+            usedNames[fileKey(animFilename)] = (int)i;
+
+            animPaths[i] = animationsDir + "\\" + animFilename + ".fbx";
+        }
+
+        // ====================================================================
+        // Exportar cada animación en un archivo FBX separado (en paralelo)
+        // ====================================================================
+        // Cada worker tiene su propio FBXExporter (FbxManager + FbxScene), así
+        // que los clips no comparten estado del SDK. El log de cada clip se
+        // acumula en un buffer y se imprime en el orden original de los clips.
+        size_t workerCount = Utils::GetWorkerCount(clipCount, options.numThreads);
+        vector<unique_ptr<FBXExporter>> workerExporters(workerCount);
+        vector<unique_ptr<NativeFBXExporter>> nativeExporters(workerCount);
+        vector<char> workerReady(workerCount, 0);
+
+        vector<string> clipLogs(clipCount);
+        vector<char> clipDone(clipCount, 0);
+        size_t nextToPrint = 0;
+        mutex printMutex;
+        atomic<int> exportedCount(0);
+        atomic<int> verifyFailedCount(0);
+
+        if (workerCount > 1)
+            cout << "Exporting with " << workerCount << " worker(s)\n\n";
+
+        // Con varios clips en paralelo cada exportador comprime en un solo hilo
+        ConversionOptions clipOptions = options;
+        if (workerCount > 1)
+            clipOptions.numThreads = 1;
+
+        Utils::ParallelForWorker(clipCount, options.numThreads, [&](size_t i, size_t worker)
+        {
+            const AnimationClip& anim = sceneData.animations[i];
+
+            ostringstream log;
+            Utils::LogCapture() = &log;
+
+            log << "Exporting animation " << (i + 1) << "/" << clipCount
+                << ": " << anim.name << " -> " << animPaths[i] << "\n";
 
-            cout << "Exporting animation " << (i + 1) << "/" << sceneData.animations.size()
-                 << ": " << anim.name << " -> " << animPath << "\n";
+            string clipError;
+            bool exported = options.nativeFbx
+                ? ExportClip(nativeExporters[worker], workerReady[worker], modelData, anim, animPaths[i], clipOptions, clipError)
+                : ExportClip(workerExporters[worker], workerReady[worker], modelData, anim, animPaths[i], clipOptions, clipError);
 
-            if (exporter.ExportSingleAnimation(modelData, anim, animPath, options))
+            if (exported)
             {
                 exportedCount++;
-                cout << "  ✓ Successfully exported\n";
+                log << "  ✓ Successfully exported\n";
+
+                if (options.verifyOutput &&
+                    !VerifyExport(animPaths[i], modelData, &referenceClips[i], !options.animSkeletonOnly, clipOptions))
+                {
+                    verifyFailedCount++;
+                }
+
+                // Cajas por frame para culling (junto al FBX del clip)
+                if (options.exportBounds)
+                {
+                    // Con varios workers cada clip se procesa en un solo hilo
+                    vector<SkinnedMeshBounds> bounds;
+                    if (AnimationBounds::ComputeClipBounds(anim, modelData.rootFrame, options,
+                                                           workerCount > 1 ? 1 : options.numThreads, bounds))
+                    {
+                        string boundsPath = animPaths[i].substr(0, animPaths[i].size() - 4) + ".bounds";
+                        if (AnimationBounds::WriteBoundsFile(boundsPath, anim, options.targetFPS, bounds))
+                            log << "  ✓ Bounds: " << boundsPath << "\n";
+                    }
+                }
             }
             else
             {
-                Utils::LogError("  ✗ Failed to export: " + exporter.GetLastError());
+                Utils::LogError("  ✗ Failed to export: " + clipError);
             }
-        }
+
+            Utils::LogCapture() = nullptr;
+
+            // Imprimir todos los clips consecutivos ya terminados, en orden
+            lock_guard<mutex> lock(printMutex);
+            clipLogs[i] = log.str();
+            clipDone[i] = 1;
+
+            while (nextToPrint < clipCount && clipDone[nextToPrint])
+            {
+                Utils::FlushLog(clipLogs[nextToPrint]);
+                clipLogs[nextToPrint].clear();
+                nextToPrint++;
+            }
+        });
+
+        // Liberar los FbxManager de los workers
+        workerExporters.clear();
+        nativeExporters.clear();
 
         cout << "\n";
-        cout << "Exported " << exportedCount << "/" << sceneData.animations.size()
+        cout << "Exported " << exportedCount.load() << "/" << sceneData.animations.size()
              << " animation(s) successfully\n";
         cout << "Animations saved in: " << animationsDir << "\n\n";
+
+        verifyFailures += verifyFailedCount.load();
     }
     else
     {
         cout << "STEP 3: No animations found in the file.\n\n";
     }
 
+    // ========================================================================
+    // glTF binario: la escena completa con todos los clips en un archivo
+    // ========================================================================
+
+    string glbFile;
+    if (options.exportGltf)
+    {
+        glbFile = Utils::GetDirectory(options.outputFile) + Utils::GetFilenameWithoutExtension(options.outputFile) + ".glb";
+        cout << "Exporting glTF binary: " << glbFile << "\n";
+
+        GLTFExporter gltfExporter;
+        if (!gltfExporter.ExportScene(sceneData, glbFile, options))
+        {
+            Utils::LogError("Failed to export GLB: " + gltfExporter.GetLastError());
+            return 1;
+        }
+
+        cout << "Successfully exported GLB!\n\n";
+    }
+
+    // ========================================================================
+    // Paquete de runtime: la escena completa lista para mapear en el motor
+    // ========================================================================
+
+    string packageFile;
+    if (options.exportPackage)
+    {
+        packageFile = Utils::GetDirectory(options.outputFile) + Utils::GetFilenameWithoutExtension(options.outputFile) + ".xpkg";
+        cout << "Writing runtime package: " << packageFile << "\n";
+
+        RuntimePackageWriter packageWriter;
+        if (!packageWriter.WritePackage(sceneData, packageFile, options))
+        {
+            Utils::LogError("Failed to write runtime package: " + packageWriter.GetLastError());
+            return 1;
+        }
+
+        // Cargar el paquete como lo hará el motor (mapeo + validación)
+        auto start = chrono::steady_clock::now();
+        RuntimePackage::MappedPackage package;
+        if (!package.Open(packageFile.c_str()))
+        {
+            Utils::LogError("Runtime package failed validation: " + packageFile);
+            return 1;
+        }
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        const RuntimePackage::Header& header = package.View().GetHeader();
+        cout << "Successfully written runtime package! (" << header.meshCount << " meshes, "
+             << header.clipCount << " clips, mapped in " << elapsed << " ms)\n\n";
+    }
+
+    // ========================================================================
+    // .X binario comprimido para los runtimes que cargan con D3DX
+    // ========================================================================
+
+    string xFile;
+    if (options.exportXFile)
+    {
+        xFile = Utils::GetDirectory(options.outputFile) + Utils::GetFilenameWithoutExtension(options.outputFile) + "_bin.x";
+        if (_stricmp(xFile.c_str(), options.inputFile.c_str()) == 0)
+        {
+            Utils::LogError("Binary .X output would overwrite the input file: " + xFile);
+            return 1;
+        }
+
+        cout << "Writing binary .X: " << xFile << "\n";
+
+        XFileWriter xWriter;
+        if (!xWriter.WriteScene(sceneData, xFile, options))
+        {
+            Utils::LogError("Failed to write binary .X: " + xWriter.GetLastError());
+            return 1;
+        }
+
+        cout << "Successfully written binary .X!\n\n";
+    }
+
+    if (verifyFailures > 0)
+    {
+        Utils::LogError("Verification failed for " + std::to_string(verifyFailures) + " file(s)");
+        return 1;
+    }
+
     // ========================================================================
     // Resumen
     // ========================================================================
@@ -316,6 +829,21 @@ int main(int argc, char* argv[])
         cout << "Animations exported to: " << animationsDir << "\\\n";
     }
 
+    if (!glbFile.empty())
+    {
+        cout << "glTF binary: " << glbFile << "\n";
+    }
+
+    if (!packageFile.empty())
+    {
+        cout << "Runtime package: " << packageFile << "\n";
+    }
+
+    if (!xFile.empty())
+    {
+        cout << "Binary .X: " << xFile << "\n";
+    }
+
     if (options.exportTextures)
     {
         cout << "Textures exported to: " << Utils::GetDirectory(options.outputFile) << "textures\\\n";
@@ -0,0 +1,474 @@
+// ============================================================================
+// Test: escritura y lectura de FBX sin SDKs (FBXBinaryWriter, FBXAsciiWriter,
+// FBXReader)
+// ============================================================================
+// Se construye un documento con todos los tipos de propiedad (escalares,
+// strings, nombres de objeto, bytes sin interpretar y arrays pequeños y
+// grandes), se escribe con cada formato, versión y nivel de compresión,
+// se vuelve a leer con FBXReader y se compara nodo a nodo. Los hijos de
+// "Objects" se escriben con fragmentos cuando el formato los admite.
+//
+// Devuelve 0 si todas las combinaciones coinciden.
+// ============================================================================
+
+#include "../src/FBXAsciiWriter.h"
+#include "../src/FBXBinaryWriter.h"
+#include "../src/FBXReader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    // Separador de los nombres de objeto en el árbol esperado (como en binario)
+    const string OBJECT_SEPARATOR("\x00\x01", 2);
+
+    // Número de fragmentos en los que se reparten los hijos de "Objects"
+    const size_t FRAGMENT_COUNT = 3;
+
+    int g_Failures = 0;
+
+    void Fail(const string& config, const string& path, const string& message)
+    {
+        fprintf(stderr, "[FAIL] %s: %s: %s\n", config.c_str(), path.c_str(), message.c_str());
+        g_Failures++;
+    }
+
+    // ========================================================================
+    // Documento esperado
+    // ========================================================================
+
+    FBXProperty Scalar(char type, int64_t intValue, double doubleValue = 0.0)
+    {
+        FBXProperty property;
+        property.type = type;
+        property.intValue = intValue;
+        property.doubleValue = doubleValue;
+        return property;
+    }
+
+    FBXProperty String(char type, const string& value)
+    {
+        FBXProperty property;
+        property.type = type;
+        property.stringValue = value;
+        return property;
+    }
+
+    FBXProperty ObjectName(const string& name, const string& className)
+    {
+        return String('S', name + OBJECT_SEPARATOR + className);
+    }
+
+    FBXProperty IntArray(char type, const vector<int64_t>& values)
+    {
+        FBXProperty property;
+        property.type = type;
+        property.intArray = values;
+        return property;
+    }
+
+    FBXProperty DoubleArray(char type, const vector<double>& values)
+    {
+        FBXProperty property;
+        property.type = type;
+        property.doubleArray = values;
+        return property;
+    }
+
+    FBXNode Node(const char* name, const vector<FBXProperty>& properties = vector<FBXProperty>(),
+                 const vector<FBXNode>& children = vector<FBXNode>())
+    {
+        FBXNode node;
+        node.name = name;
+        node.properties = properties;
+        node.children = children;
+        return node;
+    }
+
+    FBXNode BuildDocument(bool binary)
+    {
+        // Arrays grandes: varios bloques de compresión en paralelo
+        vector<double> bigDoubles(300000);
+        for (size_t i = 0; i < bigDoubles.size(); i++)
+            bigDoubles[i] = sin((double)i * 0.001) * 1000.0;
+
+        vector<int64_t> bigInts(200000);
+        for (size_t i = 0; i < bigInts.size(); i++)
+            bigInts[i] = (i % 3 == 2) ? -(int64_t)i - 1 : (int64_t)i;
+
+        vector<double> floats;
+        for (int i = 0; i < 100; i++)
+            floats.push_back((double)(float)(i * 0.37f - 12.5f));
+
+        string raw;
+        for (int i = 0; i < 300; i++)
+            raw.push_back((char)(i * 7));
+
+        // Un string con '\0' solo se puede representar en binario
+        string quoted = binary ? string("with \"quotes\" and \0 null", 24) : "with \"quotes\"";
+
+        vector<FBXNode> objects;
+        for (int i = 0; i < 10; i++)
+        {
+            string name = "Object" + to_string(i);
+            objects.push_back(Node("Model",
+                { Scalar('L', 1000000000LL + i), ObjectName(name, "Model"), String('S', "Mesh") },
+                {
+                    Node("Version", { Scalar('I', 232) }),
+                    Node("Properties70", {}, {
+                        Node("P", { String('S', "Lcl Translation"), String('S', "Lcl Translation"),
+                                    String('S', ""), String('S', "A"),
+                                    Scalar('D', 0, i * 1.5), Scalar('D', 0, -2.25), Scalar('D', 0, 1e-7) }),
+                    }),
+                    Node("Vertices", { DoubleArray('d', { 0.0, 1.0, -1.0, 0.5 * i, 3.14159265358979 }) }),
+                    Node("PolygonVertexIndex", { IntArray('i', { 0, 1, -3, 2, 1, -(int64_t)i - 1 }) }),
+                }));
+        }
+
+        objects.push_back(Node("Geometry", { Scalar('L', 42), ObjectName("Big", "Geometry"), String('S', "Mesh") },
+        {
+            Node("Vertices", { DoubleArray('d', bigDoubles) }),
+            Node("KeyTime", { IntArray('l', bigInts) }),
+            Node("Weights", { DoubleArray('f', floats) }),
+            Node("Empty", { DoubleArray('d', {}) }),
+        }));
+
+        FBXNode root;
+        root.children.push_back(Node("FBXHeaderExtension", {},
+        {
+            Node("FBXHeaderVersion", { Scalar('I', 1003) }),
+            Node("Creator", { String('S', "FBXRoundTripTest") }),
+        }));
+        root.children.push_back(Node("Scalars",
+        {
+            Scalar('C', 1), Scalar('C', 0),
+            Scalar('I', -2147483647 - 1), Scalar('I', 2147483647),
+            Scalar('L', -9000000000000000000LL), Scalar('L', 46186158000LL),
+            Scalar('F', 0, (double)1.1f), Scalar('F', 0, (double)-0.0001f),
+            Scalar('D', 0, 0.1), Scalar('D', 0, -123456.789e10),
+            String('S', quoted),
+            String('R', raw),
+        }));
+        root.children.push_back(Node("NoProperties"));
+        root.children.push_back(Node("Objects", {}, objects));
+        root.children.push_back(Node("Connections", {},
+        {
+            Node("C", { String('S', "OO"), Scalar('L', 1000000000LL), Scalar('L', 0) }),
+        }));
+        return root;
+    }
+
+    // ========================================================================
+    // Escritura del documento
+    // ========================================================================
+
+    void WriteNode(FBXRecordWriter& writer, const FBXNode& node, bool useFragments);
+
+    void WriteProperties(FBXRecordWriter& writer, const FBXNode& node)
+    {
+        for (const FBXProperty& property : node.properties)
+        {
+            switch (property.type)
+            {
+            case 'C': writer.AddBool(property.intValue != 0); break;
+            case 'I': writer.AddInt32((int32_t)property.intValue); break;
+            case 'L': writer.AddInt64(property.intValue); break;
+            case 'F': writer.AddFloat((float)property.doubleValue); break;
+            case 'D': writer.AddDouble(property.doubleValue); break;
+            case 'R': writer.AddRaw(property.stringValue.data(), property.stringValue.size()); break;
+            case 'S':
+            {
+                size_t separator = property.stringValue.find(OBJECT_SEPARATOR);
+                if (separator != string::npos)
+                    writer.AddObjectName(property.stringValue.substr(0, separator),
+                                         property.stringValue.c_str() + separator + 2);
+                else
+                    writer.AddString(property.stringValue);
+                break;
+            }
+            case 'i':
+            {
+                vector<int32_t> values(property.intArray.begin(), property.intArray.end());
+                writer.AddInt32Array(values.data(), values.size());
+                break;
+            }
+            case 'l': writer.AddInt64Array(property.intArray.data(), property.intArray.size()); break;
+            case 'f':
+            {
+                vector<float> values(property.doubleArray.begin(), property.doubleArray.end());
+                writer.AddFloatArray(values.data(), values.size());
+                break;
+            }
+            case 'd': writer.AddDoubleArray(property.doubleArray.data(), property.doubleArray.size()); break;
+            }
+        }
+    }
+
+    void WriteNode(FBXRecordWriter& writer, const FBXNode& node, bool useFragments)
+    {
+        writer.BeginNode(node.name.c_str());
+        WriteProperties(writer, node);
+
+        // Hijos de "Objects" repartidos en fragmentos contiguos
+        vector<unique_ptr<FBXRecordWriter>> fragments;
+        if (useFragments && node.name == "Objects")
+        {
+            for (size_t f = 0; f < FRAGMENT_COUNT; f++)
+            {
+                unique_ptr<FBXRecordWriter> fragment = writer.CreateFragment();
+                if (!fragment)
+                    break;
+                fragments.push_back(std::move(fragment));
+            }
+        }
+
+        if (fragments.empty())
+        {
+            for (const FBXNode& child : node.children)
+                WriteNode(writer, child, useFragments);
+        }
+        else
+        {
+            size_t perFragment = (node.children.size() + fragments.size() - 1) / fragments.size();
+            for (size_t i = 0; i < node.children.size(); i++)
+                WriteNode(*fragments[i / perFragment], node.children[i], false);
+            writer.AppendFragments(fragments);
+        }
+
+        writer.EndNode();
+    }
+
+    // ========================================================================
+    // Comparación
+    // ========================================================================
+
+    string Base64(const string& data)
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        string encoded;
+        for (size_t i = 0; i < data.size(); i += 3)
+        {
+            uint32_t group = (uint32_t)(unsigned char)data[i] << 16;
+            if (i + 1 < data.size()) group |= (uint32_t)(unsigned char)data[i + 1] << 8;
+            if (i + 2 < data.size()) group |= (uint32_t)(unsigned char)data[i + 2];
+
+            encoded.push_back(alphabet[(group >> 18) & 63]);
+            encoded.push_back(alphabet[(group >> 12) & 63]);
+            encoded.push_back(i + 1 < data.size() ? alphabet[(group >> 6) & 63] : '=');
+            encoded.push_back(i + 2 < data.size() ? alphabet[group & 63] : '=');
+        }
+        return encoded;
+    }
+
+    void CompareProperty(const string& config, const string& path, const FBXProperty& expected,
+                         const FBXProperty& actual, bool binary)
+    {
+        if (expected.IsArray() != actual.IsArray() || expected.IsString() != actual.IsString())
+        {
+            Fail(config, path, string("type '") + expected.type + "' read as '" + actual.type + "'");
+            return;
+        }
+
+        switch (expected.type)
+        {
+        case 'C':
+        case 'I':
+        case 'L':
+            if (actual.AsInt() != expected.intValue)
+                Fail(config, path, to_string(expected.intValue) + " read as " + to_string(actual.AsInt()));
+            break;
+
+        case 'F':
+            if ((float)actual.AsDouble() != (float)expected.doubleValue)
+                Fail(config, path, "float mismatch");
+            break;
+
+        case 'D':
+            if (actual.AsDouble() != expected.doubleValue)
+                Fail(config, path, "double mismatch");
+            break;
+
+        case 'S':
+        {
+            string expectedName, expectedClass, actualName, actualClass;
+            FBXReader::SplitObjectName(expected.stringValue, expectedName, expectedClass);
+            FBXReader::SplitObjectName(actual.stringValue, actualName, actualClass);
+            if (expectedName != actualName || expectedClass != actualClass)
+                Fail(config, path, "string \"" + actual.stringValue + "\"");
+            break;
+        }
+
+        case 'R':
+        {
+            // ASCII guarda los bytes en base64
+            const string expectedValue = binary ? expected.stringValue : Base64(expected.stringValue);
+            if (actual.stringValue != expectedValue)
+                Fail(config, path, "raw bytes mismatch");
+            break;
+        }
+
+        case 'i':
+        case 'l':
+        {
+            vector<int64_t> values;
+            actual.GetArray(values);
+            if (values != expected.intArray)
+                Fail(config, path, "integer array mismatch (" + to_string(values.size()) + " elements)");
+            break;
+        }
+
+        case 'f':
+        {
+            vector<float> values;
+            actual.GetArray(values);
+            vector<float> expectedValues(expected.doubleArray.begin(), expected.doubleArray.end());
+            if (values != expectedValues)
+                Fail(config, path, "float array mismatch (" + to_string(values.size()) + " elements)");
+            break;
+        }
+
+        case 'd':
+        {
+            vector<double> values;
+            actual.GetArray(values);
+            if (values != expected.doubleArray)
+                Fail(config, path, "double array mismatch (" + to_string(values.size()) + " elements)");
+            break;
+        }
+        }
+    }
+
+    void CompareNode(const string& config, const string& path, const FBXNode& expected,
+                     const FBXNode& actual, bool binary)
+    {
+        if (expected.name != actual.name)
+        {
+            Fail(config, path, "node \"" + expected.name + "\" read as \"" + actual.name + "\"");
+            return;
+        }
+
+        if (expected.properties.size() != actual.properties.size())
+        {
+            Fail(config, path, to_string(expected.properties.size()) + " properties read as " +
+                               to_string(actual.properties.size()));
+            return;
+        }
+
+        for (size_t i = 0; i < expected.properties.size(); i++)
+            CompareProperty(config, path + "[" + to_string(i) + "]", expected.properties[i], actual.properties[i], binary);
+
+        if (expected.children.size() != actual.children.size())
+        {
+            Fail(config, path, to_string(expected.children.size()) + " children read as " +
+                               to_string(actual.children.size()));
+            return;
+        }
+
+        for (size_t i = 0; i < expected.children.size(); i++)
+            CompareNode(config, path + "/" + expected.children[i].name, expected.children[i], actual.children[i], binary);
+    }
+
+    // ========================================================================
+    // Una combinación de formato, versión y compresión
+    // ========================================================================
+
+    void RunCase(bool binary, uint32_t version, int level, int threads)
+    {
+        string config = string(binary ? "binary" : "ascii") + " " + to_string(version);
+        if (binary)
+            config += " level " + to_string(level) + " threads " + to_string(threads);
+
+        string filename = (filesystem::temp_directory_path() /
+                           ("FBXRoundTripTest_" + to_string(version) + "_" + to_string(level) + "_" +
+                            to_string(threads) + (binary ? ".fbx" : "_ascii.fbx"))).string();
+
+        const FBXNode document = BuildDocument(binary);
+        const int failuresBefore = g_Failures;
+
+        bool written = false;
+        if (binary)
+        {
+            FBXBinaryWriter writer;
+            if (!writer.Open(filename, version))
+            {
+                Fail(config, filename, writer.GetLastError());
+                return;
+            }
+            writer.SetCompression(level, 64, threads);
+            for (const FBXNode& node : document.children)
+                WriteNode(writer, node, true);
+            written = writer.Close();
+            if (!written)
+                Fail(config, filename, writer.GetLastError());
+        }
+        else
+        {
+            FBXAsciiWriter writer;
+            if (!writer.Open(filename, version))
+            {
+                Fail(config, filename, writer.GetLastError());
+                return;
+            }
+            for (const FBXNode& node : document.children)
+                WriteNode(writer, node, true);
+            written = writer.Close();
+            if (!written)
+                Fail(config, filename, writer.GetLastError());
+        }
+
+        if (written)
+        {
+            FBXReader reader;
+            FBXNode root;
+            if (!reader.Load(filename, root))
+            {
+                Fail(config, filename, "read failed: " + reader.GetLastError());
+            }
+            else
+            {
+                if (reader.GetVersion() != version)
+                    Fail(config, filename, "version read as " + to_string(reader.GetVersion()));
+                if (reader.IsBinary() != binary)
+                    Fail(config, filename, "format mismatch");
+
+                CompareNode(config, "", document, root, binary);
+            }
+        }
+
+        error_code ignored;
+        filesystem::remove(filename, ignored);
+        printf("%-40s %s\n", config.c_str(), g_Failures == failuresBefore ? "ok" : "FAILED");
+    }
+}
+
+int main()
+{
+    const uint32_t versions[2] = { 7400, 7500 };
+    const int levels[4] = { 0, 1, 6, 9 };
+
+    for (uint32_t version : versions)
+    {
+        for (int level : levels)
+        {
+            RunCase(true, version, level, 1);
+            RunCase(true, version, level, 4);
+        }
+        RunCase(false, version, 0, 1);
+    }
+
+    if (g_Failures > 0)
+    {
+        fprintf(stderr, "%d failure(s)\n", g_Failures);
+        return 1;
+    }
+
+    printf("All FBX round trips passed\n");
+    return 0;
+}